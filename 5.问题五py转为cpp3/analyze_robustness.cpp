@@ -0,0 +1,36 @@
+#include "robustness_analyzer.hpp"
+#include <iostream>
+#include <string>
+
+/**
+ * @brief 对问题三最优策略做执行噪声下的鲁棒性分析
+ *
+ * 用法: analyze_robustness [样本数] [线程数]
+ */
+int main(int argc, char* argv[]) {
+    try {
+        RobustnessAnalyzer::RobustnessSettings settings;
+        settings.num_samples = argc > 1 ? std::stoi(argv[1]) : 100000;
+        settings.num_threads = argc > 2 ? std::stoi(argv[2]) : -1;
+
+        // 问题三求解器得到的最优策略
+        Optimizer::UAVStrategy fy1;
+        fy1.speed = 139.6956;
+        fy1.angle = 3.1338;
+        fy1.grenades = {
+            {0.2281, 3.7869},
+            {3.3818, 5.2772},
+            {4.8330, 5.9929}
+        };
+
+        Optimizer::StrategyMap strategy;
+        strategy["FY1"] = fy1;
+
+        RobustnessAnalyzer::NoiseModel noise;
+        RobustnessAnalyzer::analyze(strategy, {"M1"}, noise, settings);
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "鲁棒性分析失败: " << e.what() << std::endl;
+        return 1;
+    }
+}
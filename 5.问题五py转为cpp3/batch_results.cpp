@@ -0,0 +1,129 @@
+#include "batch_results.hpp"
+#include "mini_json.hpp"
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+
+namespace BatchResults {
+
+const char* const CSV_HEADER =
+    "id,name,seed,scenario,scenario_hash,problem,status,error,objective,elapsed_s,invalid_trials,strategy";
+
+namespace {
+
+// CSV_HEADER 中 id 与 status 的列号
+constexpr size_t CSV_ID = 0;
+constexpr size_t CSV_STATUS = 6;
+
+std::string csv_quote(const std::string& field) {
+    if (field.find_first_of(",\"\n") == std::string::npos) {
+        return field;
+    }
+    std::string out = "\"";
+    for (char c : field) {
+        out += c == '"' ? "\"\"" : std::string(1, c);
+    }
+    return out + "\"";
+}
+
+std::string hash_hex(uint64_t hash) {
+    std::ostringstream out;
+    out << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return out.str();
+}
+
+} // namespace
+
+std::string format_record(OutputFormat format, const Record& r) {
+    const std::string status = r.ok ? "ok" : "error";
+    if (format == OutputFormat::CSV) {
+        return csv_quote(r.id) + "," + csv_quote(r.name) + "," + std::to_string(r.seed) + ","
+            + csv_quote(r.scenario) + "," + hash_hex(r.scenario_hash) + "," + r.problem + ","
+            + status + "," + csv_quote(r.error) + "," + MiniJson::format_number(r.objective) + ","
+            + MiniJson::format_number(r.elapsed_s) + "," + std::to_string(r.invalid_trials) + ","
+            + csv_quote(r.strategy_json);
+    }
+    return "{\"id\": \"" + MiniJson::escape(r.id) + "\", \"name\": \"" + MiniJson::escape(r.name)
+        + "\", \"seed\": " + std::to_string(r.seed) + ", \"scenario\": \"" + MiniJson::escape(r.scenario)
+        + "\", \"scenario_hash\": \"" + hash_hex(r.scenario_hash) + "\", \"problem\": \"" + r.problem
+        + "\", \"status\": \"" + status + "\", \"error\": " + (r.ok ? "null" : "\"" + MiniJson::escape(r.error) + "\"")
+        + ", \"objective\": " + MiniJson::format_number(r.objective)
+        + ", \"elapsed_s\": " + MiniJson::format_number(r.elapsed_s)
+        + ", \"invalid_trials\": " + std::to_string(r.invalid_trials)
+        + ", \"strategy\": " + (r.ok ? r.strategy_json : "null") + "}";
+}
+
+std::vector<std::string> csv_fields(const std::string& line) {
+    std::vector<std::string> fields(1);
+    bool quoted = false;
+    for (size_t i = 0; i < line.size(); ++i) {
+        const char c = line[i];
+        if (quoted) {
+            if (c != '"') {
+                fields.back() += c;
+            } else if (i + 1 < line.size() && line[i + 1] == '"') {
+                fields.back() += '"';
+                ++i;
+            } else {
+                quoted = false;
+            }
+        } else if (c == '"') {
+            quoted = true;
+        } else if (c == ',') {
+            fields.emplace_back();
+        } else {
+            fields.back() += c;
+        }
+    }
+    return fields;
+}
+
+std::set<std::string> read_completed(const std::string& path, OutputFormat format) {
+    std::set<std::string> completed;
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return completed;
+    }
+    std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+
+    size_t complete_size = text.rfind('\n');
+    complete_size = complete_size == std::string::npos ? 0 : complete_size + 1;
+    if (complete_size != text.size()) {
+        std::cerr << "结果文件末行不完整，已截断" << std::endl;
+        std::filesystem::resize_file(path, complete_size);
+        text.resize(complete_size);
+    }
+
+    std::istringstream lines(text);
+    std::string line;
+    while (std::getline(lines, line)) {
+        if (line.empty()) {
+            continue;
+        }
+        if (format == OutputFormat::CSV) {
+            const std::vector<std::string> fields = csv_fields(line);
+            if (line != CSV_HEADER && fields.size() > CSV_STATUS && fields[CSV_STATUS] == "ok") {
+                completed.insert(fields[CSV_ID]);
+            }
+            continue;
+        }
+        try {
+            MiniJson::Value record = MiniJson::parse(line, "结果文件");
+            const MiniJson::Value* id = record.find("id");
+            const MiniJson::Value* status = record.find("status");
+            if (id != nullptr && id->type == MiniJson::Type::STRING && status != nullptr &&
+                status->type == MiniJson::Type::STRING && status->string == "ok") {
+                completed.insert(id->string);
+            }
+        } catch (const std::exception&) {
+            // 损坏的行视为未完成，对应作业会重新运行
+        }
+    }
+    return completed;
+}
+
+} // namespace BatchResults
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <set>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 批量运行的结果文件 (JSONL 或 CSV，每次运行一行，按完成顺序追加)
+ *
+ * 续跑时只有 status 为 ok 的运行视为已完成，失败的运行会重新执行并追加新的一行，
+ * 因此同一运行ID可能有多行记录，以最后一行为准。
+ */
+namespace BatchResults {
+
+enum class OutputFormat { JSONL, CSV };
+
+extern const char* const CSV_HEADER;
+
+/**
+ * @brief 一次运行的结果记录
+ */
+struct Record {
+    std::string id;                 // "作业名#种子"，用于断点续跑
+    std::string name;
+    unsigned int seed = 0;
+    std::string scenario;
+    uint64_t scenario_hash = 0;
+    std::string problem;
+    bool ok = false;
+    std::string error;
+    double objective = 0.0;
+    double elapsed_s = 0.0;
+    long long invalid_trials = 0;
+    std::string strategy_json;      // 失败时不输出
+};
+
+/**
+ * @brief 格式化为一行 (不含换行符)
+ */
+std::string format_record(OutputFormat format, const Record& record);
+
+/**
+ * @brief 拆分一行 CSV (字段可用双引号包围，"" 表示引号)
+ */
+std::vector<std::string> csv_fields(const std::string& line);
+
+/**
+ * @brief 读取已有结果文件中成功完成的运行ID
+ *
+ * 中断时可能留下不完整的末行，将其截掉以便续写。status 不是 ok 的记录和无法解析的行不计入。
+ */
+std::set<std::string> read_completed(const std::string& path, OutputFormat format);
+
+} // namespace BatchResults
@@ -0,0 +1,455 @@
+#include "solve_problem_5.hpp"
+#include "scenario.hpp"
+#include "mini_json.hpp"
+#include "batch_results.hpp"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <chrono>
+#include <algorithm>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <omp.h>
+
+namespace {
+
+/**
+ * @brief 丢弃输出的缓冲区，作业运行期间屏蔽求解器的打印
+ */
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+};
+
+/**
+ * @brief 一次运行 (作业 × 种子)
+ */
+struct RunSpec {
+    std::string id;                 // "作业名#种子"，用于断点续跑
+    std::string name;
+    unsigned int seed = 0;
+    std::string scenario;           // 场景文件路径，"default" 表示编译期默认场景
+    std::string problem;            // "intercept" 或 "problem5"
+    std::string missile;            // intercept: 目标导弹
+    std::unordered_map<std::string, int> uavs;  // intercept: {无人机ID: 弹药数量}
+    int population_size = 0;        // 0 表示 population_per_dimension × 维度
+    int population_per_dimension = 15;
+    int max_iterations = 1000;
+    double tolerance = 0.01;
+    int threads = 1;                // -1 表示使用全部线程预算
+};
+
+/**
+ * @brief 一次运行的结果
+ */
+struct RunResult {
+    bool ok = false;
+    std::string error;
+    double objective = 0.0;         // intercept: 遮蔽时间; problem5: 加权综合得分
+    double elapsed_s = 0.0;
+    long long invalid_trials = 0;
+    std::string strategy_json;      // {导弹ID: {无人机ID: {speed, angle, grenades}}}
+};
+
+// ------------------------------------------------------------------
+// 任务清单解析
+// ------------------------------------------------------------------
+
+const MiniJson::Value* find_field(const MiniJson::Value& job, const MiniJson::Value* defaults, const char* key) {
+    if (const MiniJson::Value* value = job.find(key)) {
+        return value;
+    }
+    return defaults != nullptr ? defaults->find(key) : nullptr;
+}
+
+double number_field(const MiniJson::Value& job, const MiniJson::Value* defaults, const char* key,
+                    double fallback, const std::string& job_name) {
+    const MiniJson::Value* value = find_field(job, defaults, key);
+    if (value == nullptr) {
+        return fallback;
+    }
+    if (value->type != MiniJson::Type::NUMBER) {
+        throw std::runtime_error("作业 " + job_name + " 的字段 " + key + " 应为数字");
+    }
+    return value->number;
+}
+
+std::string string_field(const MiniJson::Value& job, const MiniJson::Value* defaults, const char* key,
+                         const std::string& fallback, const std::string& job_name) {
+    const MiniJson::Value* value = find_field(job, defaults, key);
+    if (value == nullptr) {
+        return fallback;
+    }
+    if (value->type != MiniJson::Type::STRING) {
+        throw std::runtime_error("作业 " + job_name + " 的字段 " + key + " 应为字符串");
+    }
+    return value->string;
+}
+
+/**
+ * @brief 读取任务清单并按种子展开为运行列表
+ *
+ * 场景路径相对于清单文件所在目录解析。
+ */
+std::vector<RunSpec> load_manifest(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("无法打开任务清单: " + path);
+    }
+    std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    MiniJson::Value root = MiniJson::parse(text, "任务清单");
+
+    const MiniJson::Value* defaults = root.find("defaults");
+    if (defaults != nullptr && defaults->type != MiniJson::Type::OBJECT) {
+        throw std::runtime_error("任务清单的 defaults 应为对象");
+    }
+    const MiniJson::Value* jobs = root.find("jobs");
+    if (jobs == nullptr || jobs->type != MiniJson::Type::ARRAY) {
+        throw std::runtime_error("任务清单缺少 jobs 数组");
+    }
+
+    const std::filesystem::path base_dir = std::filesystem::path(path).parent_path();
+    std::vector<RunSpec> runs;
+    std::set<std::string> ids;
+
+    for (size_t j = 0; j < jobs->array.size(); ++j) {
+        const MiniJson::Value& job = jobs->array[j];
+        if (job.type != MiniJson::Type::OBJECT) {
+            throw std::runtime_error("第 " + std::to_string(j + 1) + " 个作业应为对象");
+        }
+
+        RunSpec spec;
+        spec.name = string_field(job, nullptr, "name", "job" + std::to_string(j + 1), "");
+        const std::string& name = spec.name;
+        spec.problem = string_field(job, defaults, "problem", "problem5", name);
+        spec.scenario = string_field(job, defaults, "scenario", "default", name);
+        if (spec.scenario != "default" && std::filesystem::path(spec.scenario).is_relative()) {
+            spec.scenario = (base_dir / spec.scenario).lexically_normal().string();
+        }
+        spec.population_size = static_cast<int>(number_field(job, defaults, "population_size", 0, name));
+        spec.population_per_dimension = static_cast<int>(
+            number_field(job, defaults, "population_per_dimension", spec.population_per_dimension, name));
+        spec.max_iterations = static_cast<int>(number_field(job, defaults, "max_iterations", spec.max_iterations, name));
+        spec.tolerance = number_field(job, defaults, "tolerance", spec.tolerance, name);
+        spec.threads = static_cast<int>(number_field(job, defaults, "threads", spec.threads, name));
+
+        if (spec.problem == "intercept") {
+            spec.missile = string_field(job, defaults, "missile", "", name);
+            const MiniJson::Value* uavs = find_field(job, defaults, "uavs");
+            if (spec.missile.empty() || uavs == nullptr || uavs->type != MiniJson::Type::OBJECT || uavs->object.empty()) {
+                throw std::runtime_error("作业 " + name + " (intercept) 需要 missile 和非空 uavs 对象");
+            }
+            for (const auto& [uav_id, grenades] : uavs->object) {
+                if (grenades.type != MiniJson::Type::NUMBER || grenades.number < 1) {
+                    throw std::runtime_error("作业 " + name + " 中无人机 " + uav_id + " 的弹药数应为正整数");
+                }
+                spec.uavs[uav_id] = static_cast<int>(grenades.number);
+            }
+        } else if (spec.problem != "problem5") {
+            throw std::runtime_error("作业 " + name + " 的问题类型未知: " + spec.problem);
+        }
+        if (spec.max_iterations < 0 || spec.population_per_dimension <= 0 || spec.threads == 0 || spec.threads < -1) {
+            throw std::runtime_error("作业 " + name + " 的优化参数无效");
+        }
+
+        std::vector<unsigned int> seeds;
+        if (const MiniJson::Value* seed_list = find_field(job, defaults, "seeds")) {
+            if (seed_list->type != MiniJson::Type::ARRAY || seed_list->array.empty()) {
+                throw std::runtime_error("作业 " + name + " 的 seeds 应为非空数组");
+            }
+            for (const auto& seed : seed_list->array) {
+                if (seed.type != MiniJson::Type::NUMBER || seed.number < 1) {
+                    throw std::runtime_error("作业 " + name + " 的种子应为正整数");
+                }
+                seeds.push_back(static_cast<unsigned int>(seed.number));
+            }
+        } else {
+            seeds.push_back(1);
+        }
+
+        for (unsigned int seed : seeds) {
+            RunSpec run = spec;
+            run.seed = seed;
+            run.id = name + "#" + std::to_string(seed);
+            if (!ids.insert(run.id).second) {
+                throw std::runtime_error("运行ID重复: " + run.id);
+            }
+            runs.push_back(std::move(run));
+        }
+    }
+    return runs;
+}
+
+// ------------------------------------------------------------------
+// 作业执行
+// ------------------------------------------------------------------
+
+std::string strategy_to_json(const Optimizer::StrategyMap& strategy) {
+    std::vector<std::string> uav_ids;
+    for (const auto& [uav_id, _] : strategy) {
+        uav_ids.push_back(uav_id);
+    }
+    std::sort(uav_ids.begin(), uav_ids.end());
+
+    std::string out = "{";
+    for (size_t i = 0; i < uav_ids.size(); ++i) {
+        const auto& s = strategy.at(uav_ids[i]);
+        out += (i ? ", \"" : "\"") + MiniJson::escape(uav_ids[i]) + "\": {\"speed\": "
+            + MiniJson::format_number(s.speed) + ", \"angle\": " + MiniJson::format_number(s.angle)
+            + ", \"grenades\": [";
+        for (size_t g = 0; g < s.grenades.size(); ++g) {
+            out += (g ? ", [" : "[") + MiniJson::format_number(s.grenades[g].t_deploy) + ", "
+                + MiniJson::format_number(s.grenades[g].t_fuse) + "]";
+        }
+        out += "]}";
+    }
+    return out + "}";
+}
+
+RunResult execute_run(const RunSpec& spec, int num_threads) {
+    RunResult result;
+    auto start = std::chrono::steady_clock::now();
+    try {
+        Optimizer::DESettings settings;
+        settings.max_iterations = spec.max_iterations;
+        settings.tolerance = spec.tolerance;
+        settings.num_threads = num_threads;
+        settings.verbose = false;
+        settings.seed = spec.seed;
+
+        std::string strategies = "{";
+        if (spec.problem == "intercept") {
+            auto bounds = Problem5::build_bounds(spec.missile, spec.uavs);
+            Problem5::Problem5SubOptimizer optimizer(spec.missile, spec.uavs);
+            settings.population_size = spec.population_size > 0
+                ? spec.population_size
+                : spec.population_per_dimension * static_cast<int>(bounds.size());
+            auto [strategy, obscuration_time] = optimizer.solve(bounds, settings);
+            result.objective = obscuration_time;
+            result.invalid_trials = optimizer.invalid_trial_count();
+            strategies += "\"" + MiniJson::escape(spec.missile) + "\": " + strategy_to_json(strategy);
+        } else {
+            Problem5::Problem5Options options;
+            options.de = settings;
+            options.population_per_dimension = spec.population_per_dimension;
+            auto solution = Problem5::run_problem_5(options);
+            result.objective = solution.weighted_score;
+            result.invalid_trials = solution.invalid_trials;
+
+            std::map<std::string, const Optimizer::StrategyMap*> sorted;
+            for (const auto& [missile_id, entry] : solution.results) {
+                sorted[missile_id] = &entry.first;
+            }
+            for (const auto& [missile_id, strategy] : sorted) {
+                strategies += (strategies.size() > 1 ? ", \"" : "\"") + MiniJson::escape(missile_id)
+                    + "\": " + strategy_to_json(*strategy);
+            }
+        }
+        result.strategy_json = strategies + "}";
+        result.ok = true;
+    } catch (const std::exception& e) {
+        result.error = e.what();
+    }
+    result.elapsed_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+/**
+ * @brief 全局线程预算：并发作业占用的线程总数不超过上限
+ */
+class ThreadBudget {
+public:
+    explicit ThreadBudget(int total) : available_(total) {}
+
+    void acquire(int n) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [&] { return available_ >= n; });
+        available_ -= n;
+    }
+
+    void release(int n) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            available_ += n;
+        }
+        cv_.notify_all();
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    int available_;
+};
+
+// ------------------------------------------------------------------
+// 结果输出
+// ------------------------------------------------------------------
+
+BatchResults::Record make_record(const RunSpec& spec, uint64_t scenario_hash, const RunResult& r) {
+    BatchResults::Record record;
+    record.id = spec.id;
+    record.name = spec.name;
+    record.seed = spec.seed;
+    record.scenario = spec.scenario;
+    record.scenario_hash = scenario_hash;
+    record.problem = spec.problem;
+    record.ok = r.ok;
+    record.error = r.error;
+    record.objective = r.objective;
+    record.elapsed_s = r.elapsed_s;
+    record.invalid_trials = r.invalid_trials;
+    record.strategy_json = r.strategy_json;
+    return record;
+}
+
+ScenarioLoader::Scenario load_scenario(const std::string& path) {
+    return path == "default" ? ScenarioLoader::from_config() : ScenarioLoader::load_file(path);
+}
+
+void print_usage() {
+    std::cout << "用法: batch_runner <任务清单.json> [--output 结果文件] [--format jsonl|csv] [--threads N]\n"
+              << "  结果文件默认为 batch_results.jsonl，扩展名为 .csv 时默认输出 CSV\n"
+              << "  --threads 为所有并发作业共享的线程预算，默认使用全部线程\n"
+              << "  已存在的结果文件中成功完成的运行会被跳过 (断点续跑)，失败的运行会重新执行" << std::endl;
+}
+
+} // namespace
+
+/**
+ * @brief 批量运行任务清单中的作业，每完成一次运行即追加一行结果
+ *
+ * 同一场景的运行在线程预算内并发执行；场景是进程级全局状态，不同场景按清单顺序分组依次运行。
+ */
+int main(int argc, char* argv[]) {
+    try {
+        if (argc < 2) {
+            print_usage();
+            return 1;
+        }
+
+        std::string manifest_path = argv[1];
+        std::string output_path = "batch_results.jsonl";
+        std::string format_name;
+        int thread_budget = omp_get_max_threads();
+        for (int i = 2; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (i + 1 >= argc) {
+                print_usage();
+                return 1;
+            }
+            if (arg == "--output") {
+                output_path = argv[++i];
+            } else if (arg == "--format") {
+                format_name = argv[++i];
+            } else if (arg == "--threads") {
+                int n = std::stoi(argv[++i]);
+                thread_budget = n > 0 ? n : omp_get_max_threads();
+            } else {
+                print_usage();
+                return 1;
+            }
+        }
+        if (format_name.empty()) {
+            format_name = std::filesystem::path(output_path).extension() == ".csv" ? "csv" : "jsonl";
+        }
+        if (format_name != "jsonl" && format_name != "csv") {
+            throw std::runtime_error("未知的输出格式: " + format_name);
+        }
+        using BatchResults::OutputFormat;
+        const OutputFormat format = format_name == "csv" ? OutputFormat::CSV : OutputFormat::JSONL;
+
+        std::vector<RunSpec> runs = load_manifest(manifest_path);
+        std::set<std::string> completed = BatchResults::read_completed(output_path, format);
+
+        // 按场景分组 (保持清单中首次出现的顺序)，跳过已完成的运行
+        std::vector<std::string> scenario_order;
+        std::map<std::string, std::vector<const RunSpec*>> groups;
+        int pending = 0;
+        for (const auto& run : runs) {
+            if (completed.count(run.id)) {
+                continue;
+            }
+            if (!groups.count(run.scenario)) {
+                scenario_order.push_back(run.scenario);
+            }
+            groups[run.scenario].push_back(&run);
+            ++pending;
+        }
+        std::cerr << "任务清单共 " << runs.size() << " 次运行，已完成 " << (runs.size() - pending)
+                  << "，待运行 " << pending << "，线程预算 " << thread_budget << std::endl;
+        if (pending == 0) {
+            return 0;
+        }
+
+        // 先加载并校验全部场景，避免运行到一半才发现文件错误
+        std::map<std::string, ScenarioLoader::Scenario> scenarios;
+        for (const auto& path : scenario_order) {
+            scenarios.emplace(path, load_scenario(path));
+        }
+
+        const bool write_header = format == OutputFormat::CSV
+            && (!std::filesystem::exists(output_path) || std::filesystem::file_size(output_path) == 0);
+        std::ofstream out(output_path, std::ios::app | std::ios::binary);
+        if (!out) {
+            throw std::runtime_error("无法写入结果文件: " + output_path);
+        }
+        if (write_header) {
+            out << BatchResults::CSV_HEADER << '\n' << std::flush;
+        }
+
+        NullBuffer null_buffer;
+        std::streambuf* saved = std::cout.rdbuf(&null_buffer);
+
+        ThreadBudget budget(thread_budget);
+        std::mutex output_mutex;
+        int finished = 0;
+        int failed = 0;
+
+        for (const auto& path : scenario_order) {
+            const ScenarioLoader::Scenario& scenario = scenarios.at(path);
+            ScenarioLoader::set_active(scenario);
+            const uint64_t hash = ScenarioLoader::active().content_hash;
+
+            std::vector<std::thread> workers;
+            for (const RunSpec* spec : groups.at(path)) {
+                const int threads = spec->threads < 0 ? thread_budget : std::min(spec->threads, thread_budget);
+                budget.acquire(threads);
+                workers.emplace_back([&, spec, threads] {
+                    RunResult result = execute_run(*spec, threads);
+                    budget.release(threads);
+
+                    std::lock_guard<std::mutex> lock(output_mutex);
+                    out << BatchResults::format_record(format, make_record(*spec, hash, result)) << '\n' << std::flush;
+                    ++finished;
+                    failed += !result.ok;
+                    std::cerr << "[" << finished << "/" << pending << "] " << spec->id << " ";
+                    if (result.ok) {
+                        std::cerr << "目标值 " << std::fixed << std::setprecision(4) << result.objective;
+                    } else {
+                        std::cerr << "失败: " << result.error;
+                    }
+                    std::cerr << "，耗时 " << std::fixed << std::setprecision(2) << result.elapsed_s << " s" << std::endl;
+                });
+            }
+            // 场景切换前等待本组全部完成
+            for (auto& worker : workers) {
+                worker.join();
+            }
+        }
+
+        std::cout.rdbuf(saved);
+        std::cerr << "批处理完成: " << finished << " 次运行，失败 " << failed << " 次，结果写入 " << output_path << std::endl;
+        return failed == 0 ? 0 : 2;
+    } catch (const std::exception& e) {
+        std::cerr << "批处理出错: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,142 @@
+#include "de_core.hpp"
+#include "optimizer.hpp"
+#include "shaped_objective.hpp"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <omp.h>
+
+namespace {
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief 几乎不耗时的目标函数，计时结果即差分进化自身每代的开销
+ *
+ * 按下标顺序累加 (squaredNorm 对定长与动态向量的归约顺序不同，末位差异会使同种子轨迹分叉)。
+ */
+template <class V>
+double sphere(const V& x) {
+    double sum = 0.0;
+    for (int i = 0; i < x.size(); ++i) {
+        sum += x[i] * x[i];
+    }
+    return sum;
+}
+
+struct Timing {
+    double seconds = 0.0;
+    double best = 0.0;
+};
+
+template <int Dim>
+Timing run_core(const std::vector<Optimizer::Bounds>& bounds, const DECore::Settings& settings) {
+    const auto box = DECore::make_box<Dim>(bounds);
+    const auto start = std::chrono::steady_clock::now();
+    auto result = DECore::optimize(
+        [](const DECore::Vector<Dim>& x) { return sphere(x); }, box, settings,
+        DECore::SerialFor{}, [](int, double, bool) {});
+    return {seconds_since(start), result.best_fitness};
+}
+
+/**
+ * @brief 三种入口的每代开销：经典前端 (动态维度，种群评估经常驻线程池分派)、DECore 动态维度 (串行)、DECore 定长维度
+ */
+template <int Dim>
+void report(int generations, int population_per_dimension, double objective_seconds) {
+    std::vector<Optimizer::Bounds> bounds(Dim, Optimizer::Bounds(-5.0, 5.0));
+
+    Optimizer::DESettings settings;
+    settings.population_size = population_per_dimension * Dim;
+    settings.max_iterations = generations;
+    settings.tolerance = 0.0;
+    settings.verbose = false;
+    settings.num_threads = 1;
+    settings.seed = 20240907;
+
+    DECore::Settings core;
+    core.population_size = settings.population_size;
+    core.max_iterations = settings.max_iterations;
+    core.tolerance = settings.tolerance;
+    core.differential_weight = settings.differential_weight;
+    core.crossover_rate = settings.crossover_rate;
+    core.seed = settings.seed;
+
+    auto start = std::chrono::steady_clock::now();
+    const double front_best = Optimizer::DifferentialEvolution::optimize(
+        [](const Eigen::VectorXd& x) { return sphere(x); }, bounds, settings).second;
+    const double front_seconds = seconds_since(start);
+    const Timing dynamic = run_core<Eigen::Dynamic>(bounds, core);
+    const Timing fixed = run_core<Dim>(bounds, core);
+
+    const double per_generation = 1e6 / (generations + 1);
+    const double objective_per_generation = objective_seconds * settings.population_size * 1e6;
+    std::cout << std::setw(6) << Dim << std::setw(8) << settings.population_size << std::fixed << std::setprecision(1)
+              << std::setw(14) << front_seconds * per_generation
+              << std::setw(14) << dynamic.seconds * per_generation
+              << std::setw(14) << fixed.seconds * per_generation
+              << std::setw(16) << objective_per_generation
+              << std::setw(10) << std::setprecision(2)
+              << 100.0 * fixed.seconds * per_generation / objective_per_generation << "%"
+              << "   " << std::setw(8) << (front_best == dynamic.best ? "相同" : "不同")
+              << std::setw(10) << (dynamic.best == fixed.best ? "相同" : "不同")
+              << std::endl;
+}
+
+/**
+ * @brief 问题 2 形状 (1 机 1 弹) 的单次目标函数耗时，作为对比基准
+ */
+double measure_objective_seconds() {
+    const auto& scenario = ScenarioLoader::active();
+    auto objective = ShapedObjective::make_objective({0}, 1, {0}, scenario);
+    Eigen::VectorXd x(4);
+    x << 120.0, 3.1, 1.5, 3.6;
+    const int repeats = 2000;
+    volatile double sink = 0.0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeats; ++i) {
+        x[3] = 3.6 + 1e-4 * (i % 7);
+        sink = sink + objective(x);
+    }
+    return seconds_since(start) / repeats;
+}
+
+} // namespace
+
+/**
+ * @brief 差分进化每代开销 (与目标函数耗时分开计量)
+ *
+ * 使用几乎不耗时的球函数，比较经典前端与 DECore 动态/定长维度实例的每代耗时 (单线程)，
+ * 并与问题 2 目标函数一代的评估耗时对比。同一种子下前端与动态维度实例的结果相同；
+ * 定长维度的向量化宽度不同，FMA 合并可能使变异结果在末位不同，轨迹随之分叉。
+ *
+ * 用法: bench_de_core [代数] [每维种群系数]
+ */
+int main(int argc, char* argv[]) {
+    try {
+        const int generations = argc > 1 ? std::stoi(argv[1]) : 300;
+        const int population_per_dimension = argc > 2 ? std::stoi(argv[2]) : 15;
+        omp_set_num_threads(1);
+
+        const double objective_seconds = measure_objective_seconds();
+        std::cout << "问题2目标函数单次评估 " << std::fixed << std::setprecision(1)
+                  << objective_seconds * 1e6 << " us" << std::endl;
+        std::cout << std::setw(6) << "维度" << std::setw(8) << "种群"
+                  << std::setw(14) << "前端(us/代)" << std::setw(14) << "动态(us/代)"
+                  << std::setw(14) << "定长(us/代)" << std::setw(16) << "目标(us/代)"
+                  << std::setw(11) << "开销占比" << "   前端/动态  动态/定长" << std::endl;
+
+        report<4>(generations, population_per_dimension, objective_seconds);
+        report<8>(generations, population_per_dimension, objective_seconds);
+        report<16>(generations, population_per_dimension, objective_seconds);
+        report<40>(generations, population_per_dimension, objective_seconds);
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "差分进化内核基准出错: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,266 @@
+#include "high_performance_adaptive_de.hpp"
+#include "shaped_objective.hpp"
+#include "solve_problem_5.hpp"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using HighPerformanceDE::DEVariant;
+using HighPerformanceDE::Vector;
+
+/**
+ * @brief 丢弃输出的缓冲区，屏蔽被测模块的打印
+ */
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+};
+
+struct Problem {
+    std::string name;
+    HighPerformanceDE::ObjectiveFunction objective;
+    Vector lower;
+    Vector upper;
+    double target;      // 未给定 (NaN) 时取全部运行最好值的 95%
+};
+
+/**
+ * @brief 一次运行：最终值与首次达到目标时的评估次数 (未达到为 -1)
+ */
+struct Run {
+    double best = 0.0;
+    long long evaluations = 0;
+    long long to_target = -1;
+};
+
+/**
+ * @brief 平移旋转测试函数 (CEC 风格)：z = R (x - o)，o 在 [-80, 80]^D 内，R 为随机正交矩阵
+ */
+struct ShiftedRotated {
+    Vector shift;
+    Eigen::MatrixXd rotation;
+
+    ShiftedRotated(int dim, uint32_t seed) : shift(dim) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<double> uniform(-80.0, 80.0);
+        std::normal_distribution<double> normal;
+        for (int k = 0; k < dim; ++k) {
+            shift[k] = uniform(rng);
+        }
+        Eigen::MatrixXd gaussian(dim, dim);
+        for (int r = 0; r < dim; ++r) {
+            for (int c = 0; c < dim; ++c) {
+                gaussian(r, c) = normal(rng);
+            }
+        }
+        rotation = Eigen::HouseholderQR<Eigen::MatrixXd>(gaussian).householderQ();
+    }
+
+    Vector map(const Vector& x) const { return rotation * (x - shift); }
+};
+
+std::vector<Problem> cec_problems(int dim) {
+    std::vector<Problem> problems;
+    const Vector lower = Vector::Constant(dim, -100.0), upper = Vector::Constant(dim, 100.0);
+
+    auto ellipsoid = std::make_shared<ShiftedRotated>(dim, 1);
+    problems.push_back({"高条件数椭球 (平移旋转)", [ellipsoid](const Vector& x) {
+        const Vector z = ellipsoid->map(x);
+        double sum = 0.0;
+        for (int k = 0; k < z.size(); ++k) {
+            sum += std::pow(1e6, static_cast<double>(k) / std::max<Eigen::Index>(1, z.size() - 1)) * z[k] * z[k];
+        }
+        return sum;
+    }, lower, upper, 1e-8});
+
+    auto rosenbrock = std::make_shared<ShiftedRotated>(dim, 2);
+    problems.push_back({"Rosenbrock (平移旋转)", [rosenbrock](const Vector& x) {
+        const Vector z = 0.02048 * rosenbrock->map(x) + Vector::Ones(x.size());
+        double sum = 0.0;
+        for (int k = 0; k + 1 < z.size(); ++k) {
+            sum += 100.0 * std::pow(z[k] * z[k] - z[k + 1], 2) + std::pow(z[k] - 1.0, 2);
+        }
+        return sum;
+    }, lower, upper, 1e-2});
+
+    auto rastrigin = std::make_shared<ShiftedRotated>(dim, 3);
+    problems.push_back({"Rastrigin (平移旋转)", [rastrigin](const Vector& x) {
+        const Vector z = 0.0512 * rastrigin->map(x);
+        double sum = 10.0 * z.size();
+        for (int k = 0; k < z.size(); ++k) {
+            sum += z[k] * z[k] - 10.0 * std::cos(2.0 * M_PI * z[k]);
+        }
+        return sum;
+    }, lower, upper, 5.0});
+
+    auto ackley = std::make_shared<ShiftedRotated>(dim, 4);
+    problems.push_back({"Ackley (平移旋转)", [ackley](const Vector& x) {
+        const Vector z = 0.32 * ackley->map(x);
+        const double n = static_cast<double>(z.size());
+        double cosines = 0.0;
+        for (int k = 0; k < z.size(); ++k) {
+            cosines += std::cos(2.0 * M_PI * z[k]);
+        }
+        return -20.0 * std::exp(-0.2 * std::sqrt(z.squaredNorm() / n)) - std::exp(cosines / n) + 20.0 + M_E;
+    }, lower, upper, 1e-4});
+    return problems;
+}
+
+/**
+ * @brief 运行一次，并用包装的目标函数记录首次不高于 target 的评估序号
+ */
+Run run_once(const Problem& problem, DEVariant variant, long long budget, int seed, int num_threads, double target) {
+    std::atomic<long long> counter{0};
+    std::atomic<long long> first{-1};
+    auto objective = [&](const Vector& x) {
+        const double value = problem.objective(x);
+        const long long n = counter.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (value <= target) {
+            long long seen = first.load(std::memory_order_relaxed);
+            while ((seen < 0 || n < seen) && !first.compare_exchange_weak(seen, n, std::memory_order_relaxed)) {
+            }
+        }
+        return value;
+    };
+
+    HighPerformanceDE::AdaptiveDESettings settings;
+    settings.variant = variant;
+    settings.max_evaluations = budget;
+    settings.max_iterations = 1000000;
+    settings.max_stagnant_generations = 1000000;
+    settings.tolerance = 0.0;
+    settings.random_seed = seed;
+    settings.num_threads = num_threads;
+    settings.verbose = false;
+
+    HighPerformanceDE::HighPerformanceAdaptiveDE optimizer(objective, problem.lower, problem.upper, settings);
+    const auto result = optimizer.optimize();
+    return {result.best_fitness, counter.load(), first.load()};
+}
+
+} // namespace
+
+/**
+ * @brief 自适应DE各算法变体的达到目标评估次数对比
+ *
+ * 问题3 (FY1 三弹)、问题4 (三机各一弹)、问题5子问题 (三机各三弹，均针对 M1) 和四个平移旋转测试函数上，
+ * 相同评估预算下运行多策略SHADE、JADE、L-SHADE 与 jSO。遮蔽问题的目标取全部运行最好值的 95%，
+ * 测试函数的目标为固定的误差阈值。报告平均最终值、达到目标的运行数、达到目标的平均评估次数和
+ * ERT (全部运行的评估次数之和 / 达到目标的运行数，未达到的运行按整个预算计)。
+ *
+ * 用法: bench_de_variants [遮蔽问题评估预算] [测试函数评估预算] [种子数] [测试函数维度] [线程数]
+ */
+int main(int argc, char* argv[]) {
+    try {
+        const long long budget = argc > 1 ? std::stoll(argv[1]) : 6000;
+        const long long cec_budget = argc > 2 ? std::stoll(argv[2]) : 100000;
+        const int num_seeds = argc > 3 ? std::stoi(argv[3]) : 5;
+        const int cec_dim = argc > 4 ? std::stoi(argv[4]) : 10;
+        const int num_threads = argc > 5 ? std::stoi(argv[5]) : -1;
+
+        std::vector<std::pair<Problem, long long>> problems;
+        const auto& scenario = ScenarioLoader::active();
+        const std::vector<std::pair<std::string, std::vector<std::string>>> shapes = {
+            {"问题3 (1x3, M1)", {"FY1"}},
+            {"问题4 (3x1, M1)", {"FY1", "FY2", "FY3"}},
+            {"问题5子问题 (3x3, M1)", {"FY1", "FY2", "FY3"}},
+        };
+        const std::vector<int> grenades = {3, 1, 3};
+        for (size_t p = 0; p < shapes.size(); ++p) {
+            std::unordered_map<std::string, int> uavs;
+            std::vector<int> indices;
+            for (const auto& id : shapes[p].second) {
+                uavs[id] = grenades[p];
+                indices.push_back(scenario.entities.uav_index(id));
+            }
+            NullBuffer null_buffer;
+            std::streambuf* saved = std::cout.rdbuf(&null_buffer);
+            const auto bounds = Problem5::build_bounds("M1", uavs);
+            std::cout.rdbuf(saved);
+            Vector lower(bounds.size()), upper(bounds.size());
+            for (size_t k = 0; k < bounds.size(); ++k) {
+                lower[k] = bounds[k].lower;
+                upper[k] = bounds[k].upper;
+            }
+            auto objective = ShapedObjective::make_objective(indices, grenades[p],
+                                                             {scenario.entities.missile_index("M1")}, scenario, 0.1);
+            if (!objective) {
+                throw std::runtime_error("当前场景不支持该问题形状");
+            }
+            problems.push_back({{shapes[p].first, objective, lower, upper, std::nan("")}, budget});
+        }
+        for (auto& problem : cec_problems(cec_dim)) {
+            problem.name += " D=" + std::to_string(cec_dim);
+            problems.push_back({std::move(problem), cec_budget});
+        }
+
+        const std::vector<DEVariant> variants = {DEVariant::MULTI_STRATEGY, DEVariant::JADE, DEVariant::LSHADE,
+                                                 DEVariant::JSO};
+        for (const auto& [problem, problem_budget] : problems) {
+            // 目标未给定时先各运行一次 (不设目标)，取全部运行最好值的 95%，再用相同种子复现以记录达到目标的时刻
+            double target = problem.target;
+            std::vector<std::vector<Run>> runs(variants.size());
+            for (size_t v = 0; v < variants.size(); ++v) {
+                for (int s = 0; s < num_seeds; ++s) {
+                    runs[v].push_back(run_once(problem, variants[v], problem_budget, 1000 + s, num_threads,
+                                               std::isnan(target) ? -std::numeric_limits<double>::infinity() : target));
+                }
+            }
+            if (std::isnan(target)) {
+                double best = std::numeric_limits<double>::infinity();
+                for (const auto& variant_runs : runs) {
+                    for (const auto& run : variant_runs) {
+                        best = std::min(best, run.best);
+                    }
+                }
+                target = 0.95 * best;
+                for (size_t v = 0; v < variants.size(); ++v) {
+                    for (int s = 0; s < num_seeds; ++s) {
+                        runs[v][s] = run_once(problem, variants[v], problem_budget, 1000 + s, num_threads, target);
+                    }
+                }
+            }
+
+            std::cout << "=== " << problem.name << "：维度 " << problem.lower.size() << "，评估预算 "
+                      << problem_budget << "，" << num_seeds << " 个种子，目标 " << std::setprecision(6) << target
+                      << " ===" << std::endl;
+            std::cout << std::left << std::setw(14) << "算法" << std::right << std::setw(16) << "平均最终值"
+                      << std::setw(8) << "达到" << std::setw(16) << "达到目标评估" << std::setw(14) << "ERT"
+                      << std::endl;
+            for (size_t v = 0; v < variants.size(); ++v) {
+                double mean_best = 0.0, to_target = 0.0, spent = 0.0;
+                int reached = 0;
+                for (const auto& run : runs[v]) {
+                    mean_best += run.best / num_seeds;
+                    if (run.to_target > 0) {
+                        ++reached;
+                        to_target += static_cast<double>(run.to_target);
+                        spent += static_cast<double>(run.to_target);
+                    } else {
+                        spent += static_cast<double>(run.evaluations);
+                    }
+                }
+                std::cout << std::left << std::setw(14) << HighPerformanceDE::variant_name(variants[v]) << std::right
+                          << std::setw(16) << std::setprecision(6) << mean_best << std::setw(6) << reached << "/"
+                          << num_seeds << std::fixed << std::setprecision(0) << std::setw(16)
+                          << (reached > 0 ? to_target / reached : -1.0) << std::setw(14)
+                          << (reached > 0 ? spent / reached : -1.0) << std::endl;
+                std::cout.unsetf(std::ios::fixed);
+            }
+            std::cout << std::endl;
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "算法变体基准出错: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,205 @@
+#include "solve_problem_5.hpp"
+#include "eval_log.hpp"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief 丢弃输出的缓冲区，屏蔽被测模块的打印
+ */
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+};
+
+struct LogConfig {
+    std::string name;
+    bool enabled;
+    EvalLog::LogOptions options;
+};
+
+struct RunStats {
+    double seconds = 0.0;
+    double obscured = 0.0;
+    uint64_t offered = 0;
+    uint64_t recorded = 0;
+    long long file_bytes = 0;
+    bool read_back = true;      // 读回的行数、列数与记录数一致
+};
+
+/**
+ * @brief 24 维 Rastrigin 函数，单次评估约数百纳秒，用来衡量日志在廉价目标函数下的最坏开销
+ */
+double rastrigin(const Eigen::VectorXd& x) {
+    double sum = 10.0 * x.size();
+    for (int i = 0; i < x.size(); ++i) {
+        sum += x[i] * x[i] - 10.0 * std::cos(2.0 * M_PI * x[i]);
+    }
+    return sum;
+}
+
+// 以给定日志 (可能为空) 运行一次优化，返回最优值
+using Solver = std::function<double(EvalLog::Logger*)>;
+
+RunStats run(const LogConfig& config, const Solver& solve, const std::string& path) {
+    std::unique_ptr<EvalLog::Logger> log;
+    if (config.enabled) {
+        log = std::make_unique<EvalLog::Logger>(path, config.options);
+    }
+
+    RunStats stats;
+    const auto start = std::chrono::steady_clock::now();
+    stats.obscured = solve(log.get());
+    if (log) {
+        log->close();
+    }
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (log) {
+        stats.offered = log->offered();
+        stats.recorded = log->recorded();
+        stats.file_bytes = std::ifstream(path, std::ios::binary | std::ios::ate).tellg();
+        const auto data = EvalLog::read_log(path);
+        stats.read_back = data.complete && data.offered == stats.offered && data.rows() == stats.recorded &&
+                          static_cast<int>(data.variables.size()) == config.options.dimension &&
+                          data.outputs.size() == 1 && data.outputs[0].size() == stats.recorded;
+        std::remove(path.c_str());
+    }
+    return stats;
+}
+
+void run_table(const std::string& title, const std::vector<LogConfig>& configs, const Solver& solve,
+               int repeats, const std::string& path) {
+    std::cout << title << "，取 " << repeats << " 次最小值" << std::endl;
+    std::cout << std::left << std::setw(14) << "配置" << std::right << std::setw(12) << "墙钟(s)"
+              << std::setw(10) << "开销" << std::setw(14) << "ns/评估" << std::setw(12) << "评估次数"
+              << std::setw(12) << "记录行数" << std::setw(12) << "文件(MB)" << std::setw(10) << "B/行"
+              << "   读回/结果" << std::endl;
+
+    double baseline = 0.0;
+    double baseline_best = 0.0;
+    uint64_t evaluations = 0;
+    for (const auto& config : configs) {
+        RunStats best;
+        best.seconds = 1e30;
+        bool read_back = true;
+        for (int r = 0; r < repeats; ++r) {
+            RunStats stats = run(config, solve, path);
+            read_back = read_back && stats.read_back;
+            if (stats.seconds < best.seconds) {
+                best = stats;
+            }
+        }
+        if (!config.enabled) {
+            baseline = best.seconds;
+            baseline_best = best.obscured;
+        } else {
+            evaluations = best.offered;
+        }
+
+        std::cout << std::left << std::setw(14) << config.name << std::right << std::fixed
+                  << std::setprecision(3) << std::setw(12) << best.seconds
+                  << std::setprecision(1) << std::setw(9) << 100.0 * (best.seconds / baseline - 1.0) << "%"
+                  << std::setw(14) << (evaluations > 0 ? (best.seconds - baseline) / evaluations * 1e9 : 0.0)
+                  << std::setw(12) << best.offered << std::setw(12) << best.recorded
+                  << std::setprecision(2) << std::setw(12) << best.file_bytes / 1e6
+                  << std::setprecision(1) << std::setw(10)
+                  << (best.recorded > 0 ? static_cast<double>(best.file_bytes) / best.recorded : 0.0)
+                  << "   " << (read_back ? "一致" : "不一致") << "/"
+                  << (best.obscured == baseline_best ? "相同" : "不同") << std::endl;
+        std::cout.unsetf(std::ios::fixed);
+    }
+    std::cout << std::endl;
+}
+
+} // namespace
+
+/**
+ * @brief 评估日志对优化吞吐量的影响
+ *
+ * 同一种子下对比不记录、全量记录、全量记录加压缩、抽稀和抽样的墙钟时间 (每种配置取多次运行的最小值)，
+ * 并读回日志校验行数。第一张表为问题5子问题 (M1，三机各三弹，24 维，特化目标函数)，第二张表为单次评估
+ * 仅数百纳秒的 24 维 Rastrigin 函数 (经 EvalLog::logged 包装)，给出每次评估的日志开销上限。
+ * 线程数取 OMP_NUM_THREADS。
+ *
+ * 用法: bench_eval_log [子问题代数] [Rastrigin 代数] [重复次数] [日志路径]
+ */
+int main(int argc, char* argv[]) {
+    try {
+        const int problem_iterations = argc > 1 ? std::stoi(argv[1]) : 20;
+        const int synthetic_iterations = argc > 2 ? std::stoi(argv[2]) : 2000;
+        const int repeats = argc > 3 ? std::stoi(argv[3]) : 3;
+        const std::string path = argc > 4 ? argv[4] : "bench_eval_log.evlg";
+
+        NullBuffer null_buffer;
+        std::streambuf* saved = std::cout.rdbuf(&null_buffer);
+        const std::unordered_map<std::string, int> uavs = {{"FY1", 3}, {"FY2", 3}, {"FY3", 3}};
+        const auto bounds = Problem5::build_bounds("M1", uavs);
+        std::cout.rdbuf(saved);
+        const int dimension = static_cast<int>(bounds.size());
+
+        Optimizer::DESettings settings;
+        settings.population_size = 15 * dimension;
+        settings.tolerance = 0.0;
+        settings.verbose = false;
+        settings.seed = 20240907;
+
+        EvalLog::LogOptions full;
+        full.dimension = dimension;
+        EvalLog::LogOptions untimed = full;
+        untimed.record_cost = false;
+        EvalLog::LogOptions compressed = full;
+        compressed.compression = EvalLog::Compression::ZLIB;
+        EvalLog::LogOptions decimated = full;
+        decimated.decimation = 10;
+        EvalLog::LogOptions sampled = full;
+        sampled.sample_rate = 0.1;
+
+        std::vector<LogConfig> configs = {{"不记录", false, full}, {"全量", true, full}, {"全量 (不计时)", true, untimed}};
+        if (EvalLog::compression_available(EvalLog::Compression::ZLIB)) {
+            configs.push_back({"全量+zlib", true, compressed});
+        }
+        configs.push_back({"抽稀 1/10", true, decimated});
+        configs.push_back({"抽样 10%", true, sampled});
+
+        Optimizer::DESettings problem_settings = settings;
+        problem_settings.max_iterations = problem_iterations;
+        run_table("问题5子问题: 维度 " + std::to_string(dimension) + "，种群 " +
+                      std::to_string(settings.population_size) + "，代数 " + std::to_string(problem_iterations),
+                  configs,
+                  [&](EvalLog::Logger* log) {
+                      Problem5::Problem5SubOptimizer optimizer("M1", uavs);
+                      optimizer.set_evaluation_log(log);
+                      return optimizer.solve(bounds, problem_settings).second;
+                  },
+                  repeats, path);
+
+        Optimizer::DESettings synthetic_settings = settings;
+        synthetic_settings.max_iterations = synthetic_iterations;
+        const std::vector<Optimizer::Bounds> box(dimension, Optimizer::Bounds(-5.12, 5.12));
+        run_table("Rastrigin: 维度 " + std::to_string(dimension) + "，种群 " +
+                      std::to_string(settings.population_size) + "，代数 " + std::to_string(synthetic_iterations),
+                  configs,
+                  [&](EvalLog::Logger* log) {
+                      Optimizer::DifferentialEvolution::ObjectiveFunction objective = rastrigin;
+                      if (log != nullptr) {
+                          objective = EvalLog::logged(rastrigin, *log);
+                      }
+                      return Optimizer::DifferentialEvolution::optimize(objective, box, synthetic_settings).second;
+                  },
+                  repeats, path);
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "评估日志基准出错: " << e.what() << std::endl;
+        return 1;
+    }
+}
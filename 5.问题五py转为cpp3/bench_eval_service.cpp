@@ -0,0 +1,250 @@
+#include "eval_service.hpp"
+#include "golden_corpus.hpp"
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief 一组测试策略 (按维度连续存放)
+ */
+struct Workload {
+    GoldenCorpus::ProblemShape shape;
+    int dimension = 0;
+    std::vector<double> variables;
+
+    size_t size() const { return variables.size() / dimension; }
+    const double* strategy(size_t i) const { return variables.data() + (i % size()) * dimension; }
+};
+
+/**
+ * @brief 取黄金语料生成器的策略组合 (随机、瞄准、擦边、边界)；参考值用粗设置，这里不使用
+ */
+Workload make_workload(const GoldenCorpus::ProblemShape& shape, size_t count) {
+    GoldenCorpus::ReferenceSettings coarse;
+    coarse.time_step = 1.0;
+    coarse.tolerance = 0.5;
+    coarse.circ_samples = 4;
+    coarse.height_samples = 1;
+    const auto corpus = GoldenCorpus::generate(shape, count, 20240907, ScenarioLoader::active(), coarse);
+    Workload workload;
+    workload.shape = shape;
+    workload.dimension = corpus.dimension();
+    for (size_t i = 0; i < corpus.size(); ++i) {
+        const auto x = corpus.decode(i);
+        workload.variables.insert(workload.variables.end(), x.data(), x.data() + x.size());
+    }
+    return workload;
+}
+
+struct RowResult {
+    std::vector<double> latencies_us;
+    double seconds = 0.0;
+    long long requests = 0;
+    long long strategies = 0;
+};
+
+double percentile(const std::vector<double>& sorted, double q) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    return sorted[std::min(sorted.size() - 1, static_cast<size_t>(q * sorted.size()))];
+}
+
+void print_row(const std::string& name, RowResult& result) {
+    auto& lat = result.latencies_us;
+    std::sort(lat.begin(), lat.end());
+    std::cout << std::left << std::setw(34) << name << std::right << std::fixed << std::setprecision(0)
+              << std::setw(11) << result.requests / result.seconds << std::setw(12)
+              << result.strategies / result.seconds << std::setprecision(1) << std::setw(9) << percentile(lat, 0.5)
+              << std::setw(9) << percentile(lat, 0.99) << std::setw(11) << percentile(lat, 0.999) << std::setw(10)
+              << (lat.empty() ? 0.0 : lat.back()) << std::endl;
+    std::cout.unsetf(std::ios::fixed);
+}
+
+/**
+ * @brief 进程内直接评估 (无套接字与协议)，作为延迟下限
+ */
+RowResult run_direct(const Workload& workload, long long requests) {
+    const auto& scenario = ScenarioLoader::active();
+    std::vector<Registry::EntityIndex> uavs;
+    std::vector<Registry::EntityIndex> missiles;
+    for (const auto& id : workload.shape.uavs) {
+        uavs.push_back(scenario.entities.uav_index(id));
+    }
+    for (const auto& id : workload.shape.missiles) {
+        missiles.push_back(scenario.entities.missile_index(id));
+    }
+    FastEvaluator::ObscurationEvaluator evaluator(missiles, scenario);
+    evaluator.set_time_chunks(-1);
+    const int grenades = workload.shape.grenades_per_uav;
+
+    RowResult result;
+    Optimizer::FlatStrategy flat(uavs.size());
+    std::vector<FastEvaluator::CloudState> clouds;
+    std::vector<double> times(missiles.size());
+    const auto start = Clock::now();
+    for (long long r = 0; r < requests; ++r) {
+        const auto begin = Clock::now();
+        const double* v = workload.strategy(r);
+        for (size_t u = 0; u < uavs.size(); ++u, v += 2 + 2 * grenades) {
+            auto& record = flat[u];
+            record.uav = uavs[u];
+            record.num_grenades = grenades;
+            record.speed = v[0];
+            record.angle = v[1];
+            double t_deploy = v[2];
+            for (int g = 0; g < grenades; ++g) {
+                t_deploy += g > 0 ? v[2 + 2 * g] : 0.0;
+                record.grenades[g] = {t_deploy, v[3 + 2 * g]};
+            }
+        }
+        std::sort(flat.begin(), flat.end(), [](const auto& a, const auto& b) { return a.uav < b.uav; });
+        if (FastEvaluator::try_build_clouds(flat, clouds, scenario) == Optimizer::StrategyStatus::OK) {
+            evaluator.evaluate(clouds, times.data());
+        }
+        result.latencies_us.push_back(std::chrono::duration<double, std::micro>(Clock::now() - begin).count());
+    }
+    result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    result.requests = requests;
+    result.strategies = requests;
+    return result;
+}
+
+/**
+ * @brief 经评估服务：每个连接一个线程，保持 depth 个未完成请求，记录每个请求从发出到收到应答的时间
+ */
+RowResult run_service(const std::string& socket_path, const Workload& workload, int batch, int depth,
+                      int connections, long long requests) {
+    RowResult result;
+    std::mutex merge_mutex;
+    std::exception_ptr error;
+    const long long per_connection = std::max<long long>(1, requests / connections);
+
+    auto connection = [&](int c) {
+        EvalService::Client client(socket_path);
+        const EvalService::Shape shape =
+            client.shape(workload.shape.uavs, workload.shape.grenades_per_uav, workload.shape.missiles);
+        std::vector<double> latencies;
+        latencies.reserve(per_connection);
+        std::deque<Clock::time_point> sent;
+        long long issued = 0;
+        size_t cursor = static_cast<size_t>(c) * 7919;
+        auto issue = [&] {
+            cursor = (cursor + batch) % (workload.size() - batch + 1);
+            client.send_evaluate(shape, workload.strategy(cursor), static_cast<uint32_t>(batch));
+            sent.push_back(Clock::now());
+            ++issued;
+        };
+
+        while (issued < std::min<long long>(depth, per_connection)) {
+            issue();
+        }
+        EvalService::Response response;
+        for (long long done = 0; done < per_connection; ++done) {
+            client.receive(response);
+            latencies.push_back(std::chrono::duration<double, std::micro>(Clock::now() - sent.front()).count());
+            sent.pop_front();
+            if (response.status != EvalService::Status::OK) {
+                throw std::runtime_error("评估请求失败: " + response.error);
+            }
+            if (issued < per_connection) {
+                issue();
+            }
+        }
+        std::lock_guard<std::mutex> lock(merge_mutex);
+        result.latencies_us.insert(result.latencies_us.end(), latencies.begin(), latencies.end());
+    };
+    auto worker = [&](int c) {
+        try {
+            connection(c);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(merge_mutex);
+            error = std::current_exception();
+        }
+    };
+
+    const auto start = Clock::now();
+    std::vector<std::thread> threads;
+    for (int c = 0; c < connections; ++c) {
+        threads.emplace_back(worker, c);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    result.requests = per_connection * connections;
+    result.strategies = result.requests * batch;
+    return result;
+}
+
+} // namespace
+
+/**
+ * @brief 评估服务的负载生成器：吞吐量与 p50/p99/p99.9 延迟
+ *
+ * 套接字路径为 "-" 时在进程内启动一个服务；否则连接已运行的 eval_server。
+ * 策略取自黄金语料生成器 (随机、瞄准视线、擦边、边界值混合)，每行与进程内直接评估对比。
+ *
+ * 用法: bench_eval_service [套接字路径=-] [每行请求数=20000] [并发连接数=2]
+ */
+int main(int argc, char* argv[]) {
+    try {
+        std::string socket_path = argc > 1 ? argv[1] : "-";
+        const long long requests = argc > 2 ? std::stoll(argv[2]) : 20000;
+        const int connections = argc > 3 ? std::stoi(argv[3]) : 2;
+
+        std::unique_ptr<EvalService::Server> server;
+        if (socket_path == "-") {
+            EvalService::ServerSettings settings;
+            settings.socket_path = "/tmp/smoke_eval_bench_" + std::to_string(::getpid()) + ".sock";
+            server = std::make_unique<EvalService::Server>(ScenarioLoader::active(), settings);
+            server->start();
+            socket_path = settings.socket_path;
+        }
+
+        const auto problems = GoldenCorpus::standard_problems();
+        const Workload problem2 = make_workload(problems[0], 4096);
+        const Workload problem5 = make_workload(problems[3], 1024);
+        const std::string conns = std::to_string(connections) + "连接";
+
+        std::cout << std::left << std::setw(34) << "负载" << std::right << std::setw(11) << "请求/s" << std::setw(12)
+                  << "策略/s" << std::setw(9) << "p50(us)" << std::setw(9) << "p99(us)" << std::setw(11) << "p99.9(us)"
+                  << std::setw(12) << "最大(us)" << std::endl;
+
+        auto row = [](const std::string& name, RowResult result) { print_row(name, result); };
+        row("问题2 直接评估", run_direct(problem2, requests));
+        row("问题2 单策略 1连接 深度1", run_service(socket_path, problem2, 1, 1, 1, requests));
+        row("问题2 单策略 " + conns + " 深度8", run_service(socket_path, problem2, 1, 8, connections, requests));
+        row("问题2 批量64 " + conns + " 深度2",
+            run_service(socket_path, problem2, 64, 2, connections, std::max(1LL, requests / 32)));
+        row("问题5全局 直接评估", run_direct(problem5, requests / 8));
+        row("问题5全局 单策略 1连接 深度1", run_service(socket_path, problem5, 1, 1, 1, requests / 8));
+        row("问题5全局 批量64 " + conns + " 深度2",
+            run_service(socket_path, problem5, 64, 2, connections, std::max(1LL, requests / 256)));
+
+        EvalService::Client client(socket_path);
+        const auto stats = client.stats();
+        std::cout << std::endl << "服务端累计：连接 " << stats.connections << "，请求 " << stats.requests << "，策略 "
+                  << stats.strategies << "，出错请求 " << stats.errors << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "评估服务基准出错: " << e.what() << std::endl;
+        return 1;
+    }
+}
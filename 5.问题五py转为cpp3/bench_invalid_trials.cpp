@@ -0,0 +1,158 @@
+#include "optimizer.hpp"
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <cmath>
+#include <omp.h>
+
+namespace {
+
+/**
+ * @brief FY1 三枚弹药干扰 M1，决策变量布局与 Problem5SubOptimizer 相同
+ */
+class SingleUAVOptimizer : public Optimizer::ObscurationOptimizer {
+public:
+    SingleUAVOptimizer() : ObscurationOptimizer("M1", {{"FY1", 3}}) {}
+
+    double evaluate(const Eigen::VectorXd& x) { return objective_function(x); }
+
+protected:
+    Optimizer::StrategyMap parse_decision_variables(const Eigen::VectorXd& x) override {
+        Optimizer::UAVStrategy fy1;
+        fy1.speed = x[0];
+        fy1.angle = x[1];
+        double t_deploy = x[2];
+        fy1.grenades.push_back({t_deploy, x[3]});
+        for (int i = 1; i < 3; ++i) {
+            t_deploy += x[2 + 2 * i];
+            fy1.grenades.push_back({t_deploy, x[3 + 2 * i]});
+        }
+        return {{"FY1", fy1}};
+    }
+};
+
+/**
+ * @brief 旧的异常路径：解析时发现无效即抛出，由 objective_function 捕获
+ */
+class ExceptionPathOptimizer : public SingleUAVOptimizer {
+protected:
+    Optimizer::StrategyStatus try_parse_decision_variables(const Eigen::VectorXd& x,
+                                                           Optimizer::StrategyMap& strategy) override {
+        if (x.size() != 8) {
+            throw std::invalid_argument("Decision variables must have 8 elements");
+        }
+        strategy = parse_decision_variables(x);
+        for (const auto& [uav_id, s] : strategy) {
+            if (s.speed < Config::UAV_SPEED_MIN || s.speed > Config::UAV_SPEED_MAX) {
+                throw std::invalid_argument("UAV speed out of range");
+            }
+            for (const auto& g : s.grenades) {
+                if (g.t_deploy < 0.0 || g.t_fuse < 0.0) {
+                    throw std::invalid_argument("Negative deploy or fuse time");
+                }
+            }
+        }
+        return Optimizer::StrategyStatus::OK;
+    }
+};
+
+/**
+ * @brief 生成一批试验解，其中 invalid_fraction 比例越界 (模拟早期代未修复的变异结果)
+ */
+std::vector<Eigen::VectorXd> make_trials(int count, double invalid_fraction, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> u01(0.0, 1.0);
+    std::vector<Eigen::VectorXd> trials;
+    trials.reserve(count);
+
+    for (int i = 0; i < count; ++i) {
+        Eigen::VectorXd x(8);
+        x << 70.0 + 70.0 * u01(rng), 2.0 * M_PI * u01(rng),
+             0.1 + 5.0 * u01(rng), 0.1 + 6.0 * u01(rng),
+             1.0 + 3.0 * u01(rng), 0.1 + 6.0 * u01(rng),
+             1.0 + 3.0 * u01(rng), 0.1 + 6.0 * u01(rng);
+        if (u01(rng) < invalid_fraction) {
+            if (u01(rng) < 0.5) {
+                x[0] = 150.0 + 50.0 * u01(rng);    // 速度越界
+            } else {
+                x[3] = -1.0 - u01(rng);            // 负引信时间
+            }
+        }
+        trials.push_back(x);
+    }
+    return trials;
+}
+
+template <typename OptimizerType>
+double measure_throughput(OptimizerType& optimizer, const std::vector<Eigen::VectorXd>& trials,
+                          int num_threads, double& checksum) {
+    const int count = trials.size();
+    double sum = 0.0;
+    auto start = std::chrono::steady_clock::now();
+
+    #pragma omp parallel for num_threads(num_threads) schedule(dynamic, 8) reduction(+:sum)
+    for (int i = 0; i < count; ++i) {
+        sum += optimizer.evaluate(trials[i]);
+    }
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    checksum = sum;
+    return count / elapsed;
+}
+
+} // namespace
+
+/**
+ * @brief 无效试验解比例较高时，状态码校验与异常路径的吞吐量对比
+ *
+ * 用法: bench_invalid_trials [试验解数] [线程数]
+ */
+int main(int argc, char* argv[]) {
+    try {
+        int count = argc > 1 ? std::stoi(argv[1]) : 4000;
+        int num_threads = argc > 2 ? std::stoi(argv[2]) : -1;
+        if (num_threads <= 0) {
+            num_threads = omp_get_max_threads();
+        }
+
+        std::cout << "无效试验解吞吐量基准 (试验解 " << count << ", 线程 " << num_threads << ")" << std::endl;
+        std::cout << std::string(72, '-') << std::endl;
+        std::cout << "无效比例    异常路径(次/秒)   状态码(次/秒)    加速比    无效计数" << std::endl;
+
+        // 预热：首次评估会触发关键点与配置表的缓存加载
+        {
+            SingleUAVOptimizer warmup;
+            double unused = 0.0;
+            measure_throughput(warmup, make_trials(count / 4 + 1, 0.0, 1), num_threads, unused);
+        }
+
+        for (double fraction : {0.0, 0.5, 0.9, 0.99}) {
+            auto trials = make_trials(count, fraction, 12345);
+
+            ExceptionPathOptimizer legacy;
+            SingleUAVOptimizer status_path;
+            double legacy_sum = 0.0, status_sum = 0.0;
+            double legacy_rate = measure_throughput(legacy, trials, num_threads, legacy_sum);
+            double status_rate = measure_throughput(status_path, trials, num_threads, status_sum);
+
+            if (std::abs(legacy_sum - status_sum) > 1e-9) {
+                std::cerr << "两条路径结果不一致: " << legacy_sum << " vs " << status_sum << std::endl;
+                return 1;
+            }
+
+            std::cout << std::fixed << std::setprecision(2)
+                      << std::setw(8) << fraction
+                      << std::setw(18) << std::setprecision(0) << legacy_rate
+                      << std::setw(18) << status_rate
+                      << std::setw(9) << std::setprecision(2) << (status_rate / legacy_rate) << "x"
+                      << std::setw(12) << status_path.invalid_trial_count() << std::endl;
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "基准测试失败: " << e.what() << std::endl;
+        return 1;
+    }
+}
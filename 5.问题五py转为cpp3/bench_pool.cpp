@@ -0,0 +1,155 @@
+#include "de_core.hpp"
+#include "optimizer.hpp"
+#include "work_pool.hpp"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <omp.h>
+
+namespace {
+
+constexpr int DIMENSION = 10;
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief 几乎不耗时的目标函数，计时结果即差分进化与并行框架自身每代的开销
+ */
+double sphere(const DECore::Vector<DIMENSION>& x) {
+    double sum = 0.0;
+    for (int i = 0; i < DIMENSION; ++i) {
+        sum += x[i] * x[i];
+    }
+    return sum;
+}
+
+/**
+ * @brief 每代一个 OpenMP 并行区 (线程池改造前各优化器的做法)
+ */
+struct OpenMPFor {
+    int num_threads;
+
+    template <class Body>
+    bool operator()(int count, Body&& body) const {
+        #pragma omp parallel for schedule(dynamic) num_threads(num_threads)
+        for (int i = 0; i < count; ++i) {
+            body(i);
+        }
+        return true;
+    }
+};
+
+struct PoolFor {
+    WorkPool::Pool& pool;
+
+    template <class Body>
+    bool operator()(int count, Body&& body) const {
+        pool.parallel_for(count, body);
+        return true;
+    }
+};
+
+template <class ParallelFor>
+double run_de(int population_size, int generations, unsigned int seed, ParallelFor parallel_for, double& best) {
+    const std::vector<Optimizer::Bounds> bounds(DIMENSION, Optimizer::Bounds(-5.0, 5.0));
+    DECore::Settings settings;
+    settings.population_size = population_size;
+    settings.max_iterations = generations;
+    settings.tolerance = 0.0;
+    settings.seed = seed;
+
+    const auto start = std::chrono::steady_clock::now();
+    auto result = DECore::optimize(sphere, DECore::make_box<DIMENSION>(bounds), settings,
+                                   parallel_for, [](int, double, bool) {});
+    best = result.best_fitness;
+    return seconds_since(start);
+}
+
+/**
+ * @brief num_optimizers 个优化器各在自己的线程中同时运行，返回平均每代墙钟时间
+ */
+template <class MakeFor>
+double run_concurrent(int num_optimizers, int population_size, int generations, MakeFor make_for,
+                      std::vector<double>& best) {
+    best.assign(num_optimizers, 0.0);
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int k = 0; k < num_optimizers; ++k) {
+        threads.emplace_back([&, k] {
+            run_de(population_size, generations, 1000 + k, make_for(), best[k]);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return seconds_since(start) / generations;
+}
+
+} // namespace
+
+/**
+ * @brief 常驻线程池与每代 OpenMP 并行区的每代开销对比
+ *
+ * 10 维球函数，种群 50-1000；同一种子下两种执行方式的结果相同 (随机数按个体分流)。
+ * 第二张表为 4 个优化器同时运行：OpenMP 方式各自开线程组，线程池方式共用同一组工作线程。
+ *
+ * 用法: bench_pool [代数] [线程数]
+ */
+int main(int argc, char* argv[]) {
+    try {
+        const int generations = argc > 1 ? std::stoi(argv[1]) : 200;
+        const int num_threads = argc > 2 ? std::stoi(argv[2]) : omp_get_max_threads();
+
+        WorkPool::PoolOptions options;
+        options.num_threads = num_threads;
+        options.pin_threads = true;     // 基准独占机器运行
+        WorkPool::Pool pool(options);
+        std::cout << "线程数 " << pool.num_threads() << "，NUMA 节点 " << pool.num_numa_nodes()
+                  << "，维度 " << DIMENSION << "，代数 " << generations << std::endl;
+
+        std::cout << std::setw(8) << "种群" << std::setw(16) << "OpenMP(us/代)"
+                  << std::setw(14) << "线程池(us/代)" << std::setw(10) << "加速比" << "   结果" << std::endl;
+        for (int population_size : {50, 100, 200, 500, 1000}) {
+            double best_omp = 0.0;
+            double best_pool = 0.0;
+            // 先各跑一次预热 (OpenMP 线程组与线程池的工作线程都在首次使用时就绪)
+            run_de(population_size, 5, 1, OpenMPFor{num_threads}, best_omp);
+            run_de(population_size, 5, 1, PoolFor{pool}, best_pool);
+
+            const double omp_seconds = run_de(population_size, generations, 7, OpenMPFor{num_threads}, best_omp);
+            const double pool_seconds = run_de(population_size, generations, 7, PoolFor{pool}, best_pool);
+            std::cout << std::setw(8) << population_size << std::fixed << std::setprecision(1)
+                      << std::setw(16) << omp_seconds / generations * 1e6
+                      << std::setw(14) << pool_seconds / generations * 1e6
+                      << std::setprecision(2) << std::setw(10) << omp_seconds / pool_seconds
+                      << "   " << (best_omp == best_pool ? "相同" : "不同") << std::endl;
+        }
+
+        const int num_optimizers = 4;
+        std::cout << std::endl << num_optimizers << " 个优化器同时运行" << std::endl;
+        std::cout << std::setw(8) << "种群" << std::setw(16) << "OpenMP(us/代)"
+                  << std::setw(14) << "线程池(us/代)" << std::setw(10) << "加速比" << "   结果" << std::endl;
+        for (int population_size : {50, 200, 1000}) {
+            std::vector<double> best_omp;
+            std::vector<double> best_pool;
+            const double omp_seconds = run_concurrent(num_optimizers, population_size, generations,
+                                                      [&] { return OpenMPFor{num_threads}; }, best_omp);
+            const double pool_seconds = run_concurrent(num_optimizers, population_size, generations,
+                                                       [&] { return PoolFor{pool}; }, best_pool);
+            std::cout << std::setw(8) << population_size << std::fixed << std::setprecision(1)
+                      << std::setw(16) << omp_seconds * 1e6
+                      << std::setw(14) << pool_seconds * 1e6
+                      << std::setprecision(2) << std::setw(10) << omp_seconds / pool_seconds
+                      << "   " << (best_omp == best_pool ? "相同" : "不同") << std::endl;
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "线程池基准出错: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,182 @@
+#include "portfolio.hpp"
+#include "shaped_objective.hpp"
+#include "solve_problem_5.hpp"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief 丢弃输出的缓冲区，屏蔽被测模块的打印
+ */
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+};
+
+struct Problem {
+    std::string name;
+    std::unordered_map<std::string, int> uavs;
+};
+
+struct Variant {
+    std::string name;
+    std::vector<Portfolio::Method> methods;
+    bool racing;
+};
+
+/**
+ * @brief 收敛曲线上首次不高于 target 的轮次 (秒, 评估次数)，未达到时为 (-1, -1)
+ */
+std::pair<double, long long> time_to(const Portfolio::Result& result, double target) {
+    for (const auto& point : result.history) {
+        if (point.best_fitness <= target) {
+            return {point.seconds, point.evaluations};
+        }
+    }
+    return {-1.0, -1};
+}
+
+} // namespace
+
+/**
+ * @brief 算法组合竞速与单个优化器的达到目标时间对比
+ *
+ * 问题4 (M1，三机各一弹) 与问题5子问题 (M1，三机各三弹) 上，相同评估预算下分别运行四种单个优化器
+ * (各自带重启)、份额固定的组合和竞速组合。目标取最好的单个优化器平均最终遮蔽时间的 90%，
+ * 报告各配置的平均最终遮蔽时间和达到目标所需的墙钟时间与评估次数 (按轮统计，只对达到目标的种子平均)。
+ *
+ * 用法: bench_portfolio [评估预算] [种子数] [线程数]
+ */
+int main(int argc, char* argv[]) {
+    try {
+        const long long budget = argc > 1 ? std::stoll(argv[1]) : 6000;
+        const int num_seeds = argc > 2 ? std::stoi(argv[2]) : 3;
+        const int num_threads = argc > 3 ? std::stoi(argv[3]) : -1;
+
+        const std::vector<Problem> problems = {
+            {"问题4 (3x1, M1)", {{"FY1", 1}, {"FY2", 1}, {"FY3", 1}}},
+            {"问题5子问题 (3x3, M1)", {{"FY1", 3}, {"FY2", 3}, {"FY3", 3}}},
+        };
+        using Portfolio::Method;
+        const std::vector<Method> all = {Method::ADAPTIVE_DE, Method::CLASSIC_DE, Method::CMA_ES, Method::LOCAL_SEARCH};
+        std::vector<Variant> configs;
+        for (Method method : all) {
+            configs.push_back({Portfolio::method_name(method), {method}, false});
+        }
+        configs.push_back({"组合 (等份额)", all, false});
+        configs.push_back({"组合 (竞速)", all, true});
+        const size_t num_singles = all.size();
+
+        const auto& scenario = ScenarioLoader::active();
+        for (const auto& problem : problems) {
+            NullBuffer null_buffer;
+            std::streambuf* saved = std::cout.rdbuf(&null_buffer);
+            const auto bounds = Problem5::build_bounds("M1", problem.uavs);
+            std::cout.rdbuf(saved);
+            const int dim = static_cast<int>(bounds.size());
+            Portfolio::Vector lower(dim), upper(dim);
+            for (int k = 0; k < dim; ++k) {
+                lower[k] = bounds[k].lower;
+                upper[k] = bounds[k].upper;
+            }
+
+            const auto objective = ShapedObjective::make_objective(
+                {scenario.entities.uav_index("FY1"), scenario.entities.uav_index("FY2"), scenario.entities.uav_index("FY3")},
+                problem.uavs.begin()->second, {scenario.entities.missile_index("M1")}, scenario, 0.1);
+            if (!objective) {
+                throw std::runtime_error("当前场景不支持该问题形状");
+            }
+
+            std::cout << "=== " << problem.name << "：维度 " << dim << "，评估预算 " << budget << "，"
+                      << num_seeds << " 个种子 ===" << std::endl;
+
+            std::vector<std::vector<Portfolio::Result>> results(configs.size());
+            for (size_t c = 0; c < configs.size(); ++c) {
+                for (int s = 0; s < num_seeds; ++s) {
+                    Portfolio::Settings settings;
+                    settings.methods = configs[c].methods;
+                    settings.racing = configs[c].racing;
+                    settings.max_evaluations = budget;
+                    settings.num_threads = num_threads;
+                    settings.seed = 1000 + s;
+                    results[c].push_back(Portfolio::optimize(objective, lower, upper, settings));
+                }
+            }
+
+            // 目标：最好的单个优化器平均最终值的 90% (目标值为负的遮蔽时间)
+            std::vector<double> mean_final(configs.size(), 0.0);
+            for (size_t c = 0; c < configs.size(); ++c) {
+                for (const auto& result : results[c]) {
+                    mean_final[c] += result.best_fitness / num_seeds;
+                }
+            }
+            const size_t best_single = std::min_element(mean_final.begin(), mean_final.begin() + num_singles) -
+                                       mean_final.begin();
+            const double target = 0.9 * mean_final[best_single];
+            std::cout << "目标遮蔽 " << std::fixed << std::setprecision(3) << -target << " s (最好的单个优化器 "
+                      << configs[best_single].name << " 平均值的 90%)" << std::endl;
+
+            std::cout << std::left << std::setw(18) << "配置" << std::right << std::setw(14) << "平均遮蔽(s)"
+                      << std::setw(12) << "墙钟(s)" << std::setw(16) << "达到目标(s)" << std::setw(16)
+                      << "达到目标评估" << std::setw(8) << "达到" << std::setw(12) << "缓存命中" << std::endl;
+            double best_single_seconds = 0.0;
+            for (size_t c = 0; c < configs.size(); ++c) {
+                double seconds = 0.0, to_seconds = 0.0, to_evaluations = 0.0, hits = 0.0;
+                int reached = 0;
+                for (const auto& result : results[c]) {
+                    seconds += result.seconds / num_seeds;
+                    hits += static_cast<double>(result.cache_hits) / num_seeds;
+                    const auto [t, e] = time_to(result, target);
+                    if (t >= 0.0) {
+                        to_seconds += t;
+                        to_evaluations += static_cast<double>(e);
+                        ++reached;
+                    }
+                }
+                if (reached > 0) {
+                    to_seconds /= reached;
+                    to_evaluations /= reached;
+                }
+                if (c == best_single) {
+                    best_single_seconds = to_seconds;
+                }
+                std::cout << std::left << std::setw(18) << configs[c].name << std::right << std::setprecision(3)
+                          << std::setw(14) << -mean_final[c] << std::setw(12) << seconds << std::setw(16)
+                          << (reached > 0 ? to_seconds : -1.0) << std::setprecision(0) << std::setw(16)
+                          << (reached > 0 ? to_evaluations : -1.0) << std::setw(6) << reached << "/" << num_seeds
+                          << std::setw(12) << hits << std::endl;
+                if (c + 1 == configs.size() && reached > 0 && best_single_seconds > 0.0) {
+                    std::cout << "竞速组合相对 " << configs[best_single].name << " 的达到目标加速比 "
+                              << std::setprecision(2) << best_single_seconds / to_seconds << std::endl;
+                }
+            }
+
+            // 竞速组合中各成员的平均份额与评估次数
+            std::cout << "竞速组合成员 (平均份额 / 评估次数 / 改进全局最优的轮数 / 重启次数):" << std::endl;
+            const auto& raced = results.back();
+            for (size_t m = 0; m < all.size(); ++m) {
+                double share = 0.0, evaluations = 0.0, improvements = 0.0, restarts = 0.0;
+                for (const auto& result : raced) {
+                    share += result.members[m].mean_share / num_seeds;
+                    evaluations += static_cast<double>(result.members[m].evaluations) / num_seeds;
+                    improvements += static_cast<double>(result.members[m].improvements) / num_seeds;
+                    restarts += static_cast<double>(result.members[m].restarts) / num_seeds;
+                }
+                std::cout << "  " << std::left << std::setw(12) << raced[0].members[m].name << std::right
+                          << std::setprecision(2) << std::setw(8) << share << std::setprecision(0)
+                          << std::setw(10) << evaluations << std::setprecision(1) << std::setw(8) << improvements
+                          << std::setw(8) << restarts << std::endl;
+            }
+            std::cout.unsetf(std::ios::fixed);
+            std::cout << std::endl;
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "算法组合基准出错: " << e.what() << std::endl;
+        return 1;
+    }
+}
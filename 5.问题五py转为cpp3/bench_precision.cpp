@@ -0,0 +1,175 @@
+#include "fast_evaluator.hpp"
+#include "scenario.hpp"
+#include "counter_rng.hpp"
+#include "cpu_dispatch.hpp"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief 随机的全机队策略，大部分弹药瞄准导弹视线上的点
+ *
+ * 对每枚弹药随机取导弹飞行时刻 tm，在该时刻导弹到目标的视线上找到与起爆高度 (忽略阻力的自由落体)
+ * 相同的点，反推航向和投放时刻，再叠加扰动。完全均匀的抽样几乎不产生遮蔽，
+ * 这样的语料才能覆盖锥体边界附近的判断。找不到可行解时退化为随机参数。
+ */
+Optimizer::FlatStrategy random_fleet_strategy(const ScenarioLoader::Scenario& scenario,
+                                              uint64_t seed, uint64_t index) {
+    const auto& entities = scenario.entities;
+    const auto& physics = scenario.physics;
+    const Vector3d target = scenario.target.center_bottom + Vector3d(0.0, 0.0, 0.5 * scenario.target.height);
+    CounterRNG::CounterRng rng(seed, index);
+
+    Optimizer::FlatStrategy strategy(entities.num_uavs());
+    for (int u = 0; u < entities.num_uavs(); ++u) {
+        const auto& uav = entities.uav(u);
+        const auto& missile = entities.missile(rng.uniform_int(entities.num_missiles()));
+
+        auto& record = strategy[u];
+        record.uav = u;
+        record.num_grenades = uav.grenade_budget;
+        record.speed = rng.uniform(physics.uav_speed_min, physics.uav_speed_max);
+        record.angle = rng.uniform(0.0, 2.0 * M_PI);
+        double t_deploy = rng.uniform(0.1, 20.0);
+        double t_fuse = rng.uniform(0.1, 8.0);
+
+        for (int attempt = 0; attempt < 8; ++attempt) {
+            double tm = rng.uniform(3.0, 50.0);
+            double fuse = rng.uniform(0.3, 6.0);
+            double z = uav.start_pos.z() - 0.5 * physics.g * fuse * fuse;
+            Vector3d p = missile.start_pos + missile.unit_vec * missile.speed * tm;
+            if (p.z() - target.z() < 1e-6 || z < target.z() || z > p.z()) {
+                continue;
+            }
+            Vector3d q = p + (target - p) * ((p.z() - z) / (p.z() - target.z()));
+            Vector3d offset = q - uav.start_pos;
+            double range = std::hypot(offset.x(), offset.y());
+            double deploy = range / record.speed - fuse;
+            double detonate = deploy + fuse;
+            if (deploy < 0.1 || detonate > tm || tm - detonate > physics.cloud_duration) {
+                continue;
+            }
+            record.angle = std::atan2(offset.y(), offset.x()) + rng.uniform(-0.01, 0.01);
+            t_deploy = deploy * rng.uniform(0.97, 1.03);
+            t_fuse = fuse * rng.uniform(0.9, 1.1);
+            break;
+        }
+
+        for (int g = 0; g < record.num_grenades; ++g) {
+            record.grenades[g] = {t_deploy, t_fuse};
+            t_deploy += physics.grenade_interval + rng.uniform(0.0, 3.0);
+            t_fuse = rng.uniform(0.1, 8.0);
+        }
+    }
+    return strategy;
+}
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+/**
+ * @brief 单精度 (带保护带复核) 与双精度遮蔽评估的一致性验证和加速比
+ *
+ * 用法: bench_precision [策略数] [场景文件] [种子]
+ */
+int main(int argc, char* argv[]) {
+    try {
+        const int num_strategies = argc > 1 ? std::stoi(argv[1]) : 20000;
+        if (argc > 2) {
+            ScenarioLoader::set_active(ScenarioLoader::load_file(argv[2]));
+        }
+        const uint64_t seed = argc > 3 ? std::stoull(argv[3]) : 20240907;
+        const auto& scenario = ScenarioLoader::active();
+
+        std::vector<Registry::EntityIndex> missiles;
+        for (int m = 0; m < scenario.entities.num_missiles(); ++m) {
+            missiles.push_back(m);
+        }
+        FastEvaluator::ObscurationEvaluator evaluator(missiles, scenario);
+        const int num_missiles = evaluator.num_missiles();
+
+        // 语料：预先生成云团，计时只包含时间扫描与锥体判断
+        std::vector<std::vector<FastEvaluator::CloudState>> corpus(num_strategies);
+        for (int i = 0; i < num_strategies; ++i) {
+            FastEvaluator::try_build_clouds(random_fleet_strategy(scenario, seed, i), corpus[i], scenario);
+        }
+
+        std::vector<double> reference(static_cast<size_t>(num_strategies) * num_missiles);
+        std::vector<double> single(reference.size());
+
+        evaluator.set_precision(FastEvaluator::Precision::DOUBLE);
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < num_strategies; ++i) {
+            evaluator.evaluate(corpus[i], reference.data() + static_cast<size_t>(i) * num_missiles);
+        }
+        const double double_seconds = seconds_since(start);
+
+        long long rechecks = 0;
+        evaluator.set_precision(FastEvaluator::Precision::FLOAT32);
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < num_strategies; ++i) {
+            evaluator.evaluate(corpus[i], single.data() + static_cast<size_t>(i) * num_missiles, &rechecks);
+        }
+        const double float_seconds = seconds_since(start);
+
+        long long mismatches = 0;
+        long long obscuring = 0;
+        double max_difference = 0.0;
+        double total_obscured = 0.0;
+        for (size_t k = 0; k < reference.size(); ++k) {
+            mismatches += reference[k] != single[k];
+            obscuring += reference[k] > 0.0;
+            max_difference = std::max(max_difference, std::abs(reference[k] - single[k]));
+            total_obscured += reference[k];
+        }
+
+        std::cout << "场景: " << scenario.name << "，策略 " << num_strategies << " 个 × 导弹 " << num_missiles
+                  << " 枚，有遮蔽的 (策略, 导弹) 对 " << obscuring
+                  << "，总遮蔽时间 " << std::fixed << std::setprecision(1) << total_obscured << " s" << std::endl;
+        std::cout << "不一致 " << mismatches << " 对，最大差 " << std::setprecision(3) << max_difference
+                  << " s，保护带复核 " << rechecks << " 次" << std::endl;
+        std::cout << "双精度 " << std::setprecision(3) << double_seconds * 1e6 / num_strategies
+                  << " us/策略，单精度 " << float_seconds * 1e6 / num_strategies
+                  << " us/策略，加速比 " << std::setprecision(2) << double_seconds / float_seconds << "x" << std::endl;
+
+        // 单精度锥体内核的各指令集档位 (运行时分派)：结论须与双精度一致
+        std::cout << "SIMD 档位 (检测到 " << CpuDispatch::isa_name(CpuDispatch::detected()) << "):" << std::endl;
+        long long isa_mismatches = 0;
+        for (CpuDispatch::IsaLevel level : {CpuDispatch::IsaLevel::SCALAR, CpuDispatch::IsaLevel::SSE42,
+                                            CpuDispatch::IsaLevel::AVX2, CpuDispatch::IsaLevel::AVX512}) {
+            if (level > CpuDispatch::detected()) {
+                std::cout << "  " << std::setw(8) << CpuDispatch::isa_name(level) << "  本机不支持，跳过" << std::endl;
+                continue;
+            }
+            CpuDispatch::force(level);
+            long long level_rechecks = 0;
+            start = std::chrono::steady_clock::now();
+            for (int i = 0; i < num_strategies; ++i) {
+                evaluator.evaluate(corpus[i], single.data() + static_cast<size_t>(i) * num_missiles, &level_rechecks);
+            }
+            const double level_seconds = seconds_since(start);
+            long long level_mismatches = 0;
+            for (size_t k = 0; k < reference.size(); ++k) {
+                level_mismatches += reference[k] != single[k];
+            }
+            isa_mismatches += level_mismatches;
+            std::cout << "  " << std::setw(8) << CpuDispatch::isa_name(level) << std::setprecision(3)
+                      << std::setw(10) << level_seconds * 1e6 / num_strategies << " us/策略，相对双精度 "
+                      << std::setprecision(2) << double_seconds / level_seconds << "x，不一致 " << level_mismatches
+                      << " 对，保护带复核 " << level_rechecks << " 次" << std::endl;
+        }
+        CpuDispatch::reset();
+        return mismatches == 0 && isa_mismatches == 0 ? 0 : 1;
+    } catch (const std::exception& e) {
+        std::cerr << "精度基准出错: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,192 @@
+#include "scenario_generator.hpp"
+#include "threat_assessor.hpp"
+#include "task_allocator.hpp"
+#include "fast_evaluator.hpp"
+#include "counter_rng.hpp"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+#include <cmath>
+#include <numeric>
+#include <string>
+#include <functional>
+#include <omp.h>
+
+namespace {
+
+/**
+ * @brief 丢弃输出的缓冲区，计时期间屏蔽被测模块的打印
+ */
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+};
+
+/**
+ * @brief 读取 /proc/self/status 中的内存字段 (kB)，非 Linux 平台返回 0
+ */
+long read_status_kb(const std::string& field) {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, field.size(), field) == 0 && line[field.size()] == ':') {
+            return std::stol(line.substr(field.size() + 1));
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief 重复执行直到累计至少 min_seconds，返回单次平均耗时 (秒)
+ */
+double time_repeated(const std::function<void()>& fn, double min_seconds) {
+    NullBuffer null_buffer;
+    std::streambuf* saved = std::cout.rdbuf(&null_buffer);
+
+    int runs = 0;
+    auto start = std::chrono::steady_clock::now();
+    double elapsed = 0.0;
+    do {
+        fn();
+        ++runs;
+        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    } while (elapsed < min_seconds);
+
+    std::cout.rdbuf(saved);
+    return elapsed / runs;
+}
+
+/**
+ * @brief 随机的全机队策略：每架无人机用满弹药预算，大致朝所在走廊的瞄准点飞行
+ */
+Optimizer::FlatStrategy random_fleet_strategy(const ScenarioLoader::Scenario& scenario,
+                                              uint64_t seed, uint64_t index) {
+    const auto& entities = scenario.entities;
+    const auto& physics = scenario.physics;
+    CounterRNG::CounterRng rng(seed, index);
+
+    Optimizer::FlatStrategy strategy(entities.num_uavs());
+    for (int u = 0; u < entities.num_uavs(); ++u) {
+        const auto& uav = entities.uav(u);
+        const auto& missile = entities.missile(u % entities.num_missiles());
+        Vector3d heading = missile.target - uav.start_pos;
+
+        auto& record = strategy[u];
+        record.uav = u;
+        record.num_grenades = uav.grenade_budget;
+        record.speed = rng.uniform(physics.uav_speed_min, physics.uav_speed_max);
+        record.angle = std::atan2(heading.y(), heading.x()) + rng.uniform(-0.3, 0.3);
+
+        double t_deploy = rng.uniform(0.1, 10.0);
+        for (int g = 0; g < record.num_grenades; ++g) {
+            record.grenades[g] = {t_deploy, rng.uniform(0.1, 8.0)};
+            t_deploy += physics.grenade_interval + rng.uniform(0.0, 3.0);
+        }
+    }
+    return strategy;
+}
+
+struct ScaleCase {
+    int missiles;
+    int uavs;
+    int aim_points;
+};
+
+} // namespace
+
+/**
+ * @brief 威胁评估、任务分配与全局遮蔽评估随场景规模的耗时和内存
+ *
+ * 用法: bench_scaling [每个规模的评估策略数] [线程数] [种子]
+ */
+int main(int argc, char* argv[]) {
+    try {
+        int num_strategies = argc > 1 ? std::stoi(argv[1]) : 64;
+        int num_threads = argc > 2 ? std::stoi(argv[2]) : -1;
+        uint64_t seed = argc > 3 ? std::stoull(argv[3]) : 20240907;
+        if (num_threads <= 0) {
+            num_threads = omp_get_max_threads();
+        }
+
+        const std::vector<ScaleCase> cases = {
+            {3, 5, 1}, {10, 20, 2}, {25, 50, 3}, {50, 100, 4}, {100, 200, 5}
+        };
+
+        std::cout << "场景规模基准 (每个规模评估 " << num_strategies << " 个全机队策略, 线程 "
+                  << num_threads << ", 种子 " << seed << ")" << std::endl;
+        std::cout << std::string(110, '-') << std::endl;
+        std::cout << "导弹  无人机  瞄准点  云团   威胁评估(ms)  任务分配(ms)  评估器构建(ms)  单策略CPU(ms)"
+                     "  策略/秒    RSS(MB)  峰值(MB)" << std::endl;
+
+        for (const auto& c : cases) {
+            ScenarioGenerator::GeneratorSettings gen;
+            gen.num_missiles = c.missiles;
+            gen.num_uavs = c.uavs;
+            gen.num_aim_points = c.aim_points;
+            gen.seed = seed;
+            ScenarioLoader::set_active(ScenarioGenerator::generate(gen));
+            const auto& scenario = ScenarioLoader::active();
+
+            std::unordered_map<std::string, double> weights;
+            double threat_time = time_repeated([&] {
+                weights = ThreatAssessor::assess_threat_weights();
+            }, 0.2);
+
+            double alloc_time = time_repeated([&] {
+                TaskAllocator::assign_tasks_by_threat(weights);
+            }, 0.2);
+
+            std::vector<Registry::EntityIndex> all_missiles(scenario.entities.num_missiles());
+            std::iota(all_missiles.begin(), all_missiles.end(), 0);
+            std::unique_ptr<FastEvaluator::ObscurationEvaluator> evaluator;
+            double build_time = time_repeated([&] {
+                evaluator = std::make_unique<FastEvaluator::ObscurationEvaluator>(all_missiles, scenario);
+            }, 0.05);
+
+            std::vector<Optimizer::FlatStrategy> strategies;
+            for (int s = 0; s < num_strategies; ++s) {
+                strategies.push_back(random_fleet_strategy(scenario, seed, s));
+            }
+
+            // 全局评估：构建全部云团并统计所有导弹的遮蔽时间
+            const int num_missiles = evaluator->num_missiles();
+            std::vector<double> obscured(static_cast<size_t>(num_strategies) * num_missiles, 0.0);
+            size_t num_clouds = 0;
+            auto start = std::chrono::steady_clock::now();
+            #pragma omp parallel num_threads(num_threads) reduction(max:num_clouds)
+            {
+                std::vector<FastEvaluator::CloudState> clouds;
+                #pragma omp for schedule(dynamic, 1)
+                for (int s = 0; s < num_strategies; ++s) {
+                    FastEvaluator::try_build_clouds(strategies[s], clouds, scenario);
+                    evaluator->evaluate(clouds, obscured.data() + static_cast<size_t>(s) * num_missiles);
+                    num_clouds = std::max(num_clouds, clouds.size());
+                }
+            }
+            double eval_elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            double checksum = std::accumulate(obscured.begin(), obscured.end(), 0.0);
+
+            // 单策略CPU时间按 墙钟时间 x 线程数 折算
+            std::cout << std::fixed << std::setprecision(3)
+                      << std::setw(4) << c.missiles << std::setw(8) << c.uavs << std::setw(8) << c.aim_points
+                      << std::setw(6) << num_clouds
+                      << std::setw(14) << threat_time * 1e3
+                      << std::setw(14) << alloc_time * 1e3
+                      << std::setw(16) << build_time * 1e3
+                      << std::setw(16) << eval_elapsed / num_strategies * num_threads * 1e3
+                      << std::setw(10) << std::setprecision(1) << num_strategies / eval_elapsed
+                      << std::setw(11) << read_status_kb("VmRSS") / 1024.0
+                      << std::setw(10) << read_status_kb("VmHWM") / 1024.0
+                      << "   (遮蔽合计 " << std::setprecision(1) << checksum << " s)" << std::endl;
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "规模基准失败: " << e.what() << std::endl;
+        return 1;
+    }
+}
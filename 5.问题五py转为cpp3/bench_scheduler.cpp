@@ -0,0 +1,170 @@
+#include "job_scheduler.hpp"
+#include "solve_problem_5.hpp"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/resource.h>
+#include <omp.h>
+
+namespace {
+
+/**
+ * @brief 丢弃输出的缓冲区，计时期间屏蔽被测模块的打印
+ */
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+};
+
+double process_cpu_seconds() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec
+         + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1e-6;
+}
+
+struct RunStats {
+    double wall_seconds = 0.0;
+    double cpu_seconds = 0.0;
+    long long evaluations = 0;
+};
+
+/**
+ * @brief 并发运行 num_jobs 个拦截子问题优化
+ *
+ * scheduler 为空时每个作业在自己的线程里使用 OpenMP (全部线程)，即原来的运行方式。
+ */
+RunStats run_concurrent(int num_jobs, int iterations_per_job, int population_size,
+                        const std::vector<Optimizer::Bounds>& bounds,
+                        const std::unordered_map<std::string, int>& uavs,
+                        JobScheduler::Scheduler* scheduler) {
+    RunStats stats;
+    const double cpu_start = process_cpu_seconds();
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+    for (int j = 0; j < num_jobs; ++j) {
+        threads.emplace_back([&, j] {
+            std::unique_ptr<JobScheduler::Job> job;
+            Optimizer::DESettings settings;
+            settings.population_size = population_size;
+            settings.max_iterations = iterations_per_job;
+            settings.tolerance = 0.0;
+            settings.verbose = false;
+            settings.seed = j + 1;
+            if (scheduler != nullptr) {
+                job = scheduler->submit({"job" + std::to_string(j)});
+                settings.job = job.get();
+            }
+            Problem5::Problem5SubOptimizer optimizer("M1", uavs);
+            optimizer.solve(bounds, settings);
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    stats.wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    stats.cpu_seconds = process_cpu_seconds() - cpu_start;
+    stats.evaluations = static_cast<long long>(num_jobs) * population_size * (iterations_per_job + 1);
+    return stats;
+}
+
+/**
+ * @brief 十个同时提交的作业中优先级最高者应最先完成
+ */
+void priority_demo(JobScheduler::Scheduler& scheduler) {
+    using JobScheduler::Clock;
+    std::vector<std::unique_ptr<JobScheduler::Job>> jobs;
+    for (int j = 0; j < 10; ++j) {
+        JobScheduler::JobOptions options;
+        options.name = "job" + std::to_string(j);
+        options.priority = j == 7 ? 1 : 0;
+        jobs.push_back(scheduler.submit(options));
+    }
+
+    std::vector<double> finish(jobs.size());
+    const auto start = Clock::now();
+    std::vector<std::thread> threads;
+    for (size_t j = 0; j < jobs.size(); ++j) {
+        threads.emplace_back([&, j] {
+            volatile double sink = 0.0;
+            for (int round = 0; round < 20; ++round) {
+                jobs[j]->parallel_for(256, [&](int i) {
+                    double x = i;
+                    for (int k = 0; k < 2000; ++k) x = x * 0.999 + 1.0;
+                    sink = sink + x;
+                });
+            }
+            finish[j] = std::chrono::duration<double>(Clock::now() - start).count();
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    std::cout << "\n优先级: 作业 7 (priority=1) 完成于 " << std::fixed << std::setprecision(3) << finish[7]
+              << " s，其余作业完成时间 ";
+    double earliest_other = 1e300;
+    double latest_other = 0.0;
+    for (size_t j = 0; j < finish.size(); ++j) {
+        if (j != 7) {
+            earliest_other = std::min(earliest_other, finish[j]);
+            latest_other = std::max(latest_other, finish[j]);
+        }
+    }
+    std::cout << "[" << earliest_other << ", " << latest_other << "] s" << std::endl;
+}
+
+} // namespace
+
+/**
+ * @brief 共享调度器与"每个优化器各自 OpenMP"的并发吞吐量对比
+ *
+ * 总评估量固定，分别以 1、10、100 个并发作业完成；利用率 = 进程 CPU 时间 / (墙钟时间 × 核数)。
+ *
+ * 用法: bench_scheduler [总迭代数]
+ */
+int main(int argc, char* argv[]) {
+    try {
+        const int total_iterations = argc > 1 ? std::stoi(argv[1]) : 400;
+        const int population_size = 40;
+        const std::unordered_map<std::string, int> uavs = {{"FY1", 3}, {"FY2", 2}};
+
+        NullBuffer null_buffer;
+        std::streambuf* saved = std::cout.rdbuf(&null_buffer);
+        const auto bounds = Problem5::build_bounds("M1", uavs);
+        std::cout.rdbuf(saved);
+
+        JobScheduler::Scheduler scheduler(-1);
+        const int cores = scheduler.pool().num_threads();
+        std::cout << "核数 " << cores << "，种群 " << population_size << "，总迭代数 " << total_iterations << std::endl;
+        std::cout << std::left << std::setw(8) << "作业数" << std::setw(12) << "模式"
+                  << std::right << std::setw(12) << "墙钟(s)" << std::setw(14) << "评估/秒"
+                  << std::setw(10) << "利用率" << std::setw(10) << "线程数" << std::endl;
+
+        for (int num_jobs : {1, 10, 100}) {
+            const int iterations = std::max(1, total_iterations / num_jobs);
+            for (bool shared : {false, true}) {
+                RunStats stats = run_concurrent(num_jobs, iterations, population_size, bounds, uavs,
+                                                shared ? &scheduler : nullptr);
+                const int threads = shared ? cores : num_jobs * omp_get_max_threads();
+                std::cout << std::left << std::setw(8) << num_jobs << std::setw(12) << (shared ? "调度器" : "OpenMP")
+                          << std::right << std::fixed << std::setprecision(3) << std::setw(12) << stats.wall_seconds
+                          << std::setprecision(0) << std::setw(14) << stats.evaluations / stats.wall_seconds
+                          << std::setprecision(2) << std::setw(10) << stats.cpu_seconds / (stats.wall_seconds * cores)
+                          << std::setw(10) << threads << std::endl;
+            }
+        }
+
+        priority_demo(scheduler);
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "调度器基准出错: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,246 @@
+#include "solve_problem_5.hpp"
+#include "sensitivity.hpp"
+#include "shaped_objective.hpp"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief 丢弃输出的缓冲区，屏蔽被测模块的打印
+ */
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+};
+
+/**
+ * @brief 记录每次评估的目标值，运行结束后按评估顺序求前缀最小值得到收敛曲线
+ */
+class Trace {
+public:
+    explicit Trace(size_t capacity) : values_(capacity) {}
+
+    double operator()(const Optimizer::DifferentialEvolution::ObjectiveFunction& objective, const Eigen::VectorXd& x) {
+        const double value = objective(x);
+        const size_t i = count_.fetch_add(1, std::memory_order_relaxed);
+        if (i < values_.size()) {
+            values_[i] = value;
+        }
+        return value;
+    }
+
+    /**
+     * @brief 最优值首次不高于 target 时的评估次数 (未达到时为 -1)
+     */
+    long long evaluations_to(double target) const {
+        const size_t n = std::min(values_.size(), count_.load());
+        for (size_t i = 0; i < n; ++i) {
+            if (values_[i] <= target) {
+                return static_cast<long long>(i + 1);
+            }
+        }
+        return -1;
+    }
+
+    long long evaluations() const { return static_cast<long long>(count_.load()); }
+
+private:
+    std::vector<double> values_;
+    std::atomic<size_t> count_{0};
+};
+
+// 标准布局的变量名：各机 (按ID排序) 的速度、角度、投放1、引信1、间隔k、引信k
+std::vector<std::string> variable_names(const std::unordered_map<std::string, int>& uavs) {
+    std::vector<std::string> names;
+    for (const auto& [uav, grenades] : std::map<std::string, int>(uavs.begin(), uavs.end())) {
+        names.push_back(uav + ".速度");
+        names.push_back(uav + ".角度");
+        for (int g = 1; g <= grenades; ++g) {
+            names.push_back(uav + (g == 1 ? ".投放1" : ".间隔" + std::to_string(g)));
+            names.push_back(uav + ".引信" + std::to_string(g));
+        }
+    }
+    return names;
+}
+
+struct Problem {
+    std::string name;
+    std::unordered_map<std::string, int> uavs;
+};
+
+} // namespace
+
+/**
+ * @brief 敏感性分析与分阶段降维的差分进化
+ *
+ * 问题4 (M1，三机各一弹) 与问题5子问题 (M1，三机各三弹) 上：先在短时试探得到的较优解附近用 Morris 和
+ * Sobol 两种方法给出各变量的重要性；再在相同代数下对比普通 DE、冻结低重要性变量、粗化低重要性变量的
+ * 最终遮蔽时间，以及达到普通 DE 平均最终结果 95% 所需的评估次数 (含敏感性分析的评估)。
+ *
+ * 用法: bench_sensitivity [代数] [种子数] [种群系数]
+ */
+int main(int argc, char* argv[]) {
+    try {
+        const int iterations = argc > 1 ? std::stoi(argv[1]) : 100;
+        const int num_seeds = argc > 2 ? std::stoi(argv[2]) : 3;
+        const int population_factor = argc > 3 ? std::stoi(argv[3]) : 10;
+
+        const std::vector<Problem> problems = {
+            {"问题4 (3x1, M1)", {{"FY1", 1}, {"FY2", 1}, {"FY3", 1}}},
+            {"问题5子问题 (3x3, M1)", {{"FY1", 3}, {"FY2", 3}, {"FY3", 3}}},
+        };
+
+        const auto& scenario = ScenarioLoader::active();
+        for (const auto& problem : problems) {
+            NullBuffer null_buffer;
+            std::streambuf* saved = std::cout.rdbuf(&null_buffer);
+            const auto bounds = Problem5::build_bounds("M1", problem.uavs);
+            std::cout.rdbuf(saved);
+            const int dim = static_cast<int>(bounds.size());
+            const auto names = variable_names(problem.uavs);
+
+            const auto objective = ShapedObjective::make_objective(
+                {scenario.entities.uav_index("FY1"), scenario.entities.uav_index("FY2"), scenario.entities.uav_index("FY3")},
+                problem.uavs.begin()->second, {scenario.entities.missile_index("M1")}, scenario, 0.1);
+            if (!objective) {
+                throw std::runtime_error("当前场景不支持该问题形状");
+            }
+
+            Optimizer::DESettings settings;
+            settings.population_size = population_factor * dim;
+            settings.max_iterations = iterations;
+            settings.tolerance = 0.0;
+            settings.verbose = false;
+
+            Sensitivity::ReductionSettings reduction;
+            reduction.analysis.samples = 2 * dim;
+
+            std::cout << "=== " << problem.name << "：维度 " << dim << "，种群 " << settings.population_size
+                      << "，代数 " << iterations << "，" << num_seeds << " 个种子 ===" << std::endl;
+
+            // 各变量的重要性：试探阶段最优解附近，Morris 与 Sobol 对照
+            Optimizer::DESettings pilot = settings;
+            pilot.seed = 1;
+            pilot.max_iterations = std::max(1, static_cast<int>(iterations * reduction.pilot_fraction));
+            const Eigen::VectorXd anchor = Optimizer::DifferentialEvolution::optimize(objective, bounds, pilot).first;
+            Eigen::VectorXd lower(dim), upper(dim);
+            for (int k = 0; k < dim; ++k) {
+                const double radius = reduction.local_radius * (bounds[k].upper - bounds[k].lower);
+                lower[k] = std::max(bounds[k].lower, anchor[k] - radius);
+                upper[k] = std::min(bounds[k].upper, anchor[k] + radius);
+            }
+            Sensitivity::AnalysisSettings sobol_settings;
+            sobol_settings.method = Sensitivity::Method::SOBOL;
+            sobol_settings.samples = 64;
+            const auto morris = Sensitivity::analyze(objective, lower, upper, reduction.analysis);
+            const auto sobol = Sensitivity::analyze(objective, lower, upper, sobol_settings);
+            const auto inert = morris.inert_variables(reduction.importance_threshold);
+
+            std::cout << "试探最优遮蔽 " << std::fixed << std::setprecision(3) << -objective(anchor)
+                      << " s，Morris " << morris.evaluations << " 次评估，Sobol " << sobol.evaluations << " 次评估"
+                      << std::endl;
+            std::cout << std::left << std::setw(14) << "变量" << std::right << std::setw(12) << "Morris mu*"
+                      << std::setw(12) << "sigma" << std::setw(12) << "Morris占比" << std::setw(12) << "Sobol ST"
+                      << std::setw(12) << "Sobol S1" << "   低重要性" << std::endl;
+            for (int k = 0; k < dim; ++k) {
+                const bool is_inert = std::find(inert.begin(), inert.end(), k) != inert.end();
+                std::cout << std::left << std::setw(14) << names[k] << std::right << std::setprecision(4)
+                          << std::setw(12) << morris.mu_star[k] << std::setw(12) << morris.sigma[k]
+                          << std::setw(12) << morris.importance[k] << std::setw(12) << sobol.total_order[k]
+                          << std::setw(12) << sobol.first_order[k] << "   " << (is_inert ? "是" : "") << std::endl;
+            }
+
+            // 相同代数下的收敛对比
+            struct Variant {
+                std::string name;
+                bool reduced;
+                Sensitivity::ReductionMode mode;
+            };
+            const std::vector<Variant> variants = {
+                {"普通DE", false, Sensitivity::ReductionMode::FREEZE},
+                {"冻结低重要性", true, Sensitivity::ReductionMode::FREEZE},
+                {"粗化低重要性", true, Sensitivity::ReductionMode::COARSEN},
+            };
+            const size_t capacity = static_cast<size_t>(settings.population_size) * (iterations + 4) +
+                                    static_cast<size_t>(reduction.analysis.samples) * (dim + 2);
+
+            std::vector<std::vector<std::unique_ptr<Trace>>> traces(variants.size());
+            std::vector<std::vector<double>> finals(variants.size());
+            std::vector<size_t> reduced_dims;
+            for (size_t v = 0; v < variants.size(); ++v) {
+                for (int s = 0; s < num_seeds; ++s) {
+                    traces[v].push_back(std::make_unique<Trace>(capacity));
+                    Trace& trace = *traces[v].back();
+                    auto traced = [&](const Eigen::VectorXd& x) { return trace(objective, x); };
+                    settings.seed = 1000 + s;
+                    double best;
+                    if (variants[v].reduced) {
+                        Sensitivity::ReductionSettings r = reduction;
+                        r.mode = variants[v].mode;
+                        Sensitivity::Analysis analysis;
+                        best = Optimizer::DifferentialEvolution::optimize_reduced(traced, bounds, settings, r, &analysis).second;
+                        if (v == 1) {
+                            reduced_dims.push_back(analysis.inert_variables(r.importance_threshold).size());
+                        }
+                    } else {
+                        best = Optimizer::DifferentialEvolution::optimize(traced, bounds, settings).second;
+                    }
+                    finals[v].push_back(best);
+                }
+            }
+
+            double plain_mean = 0.0;
+            for (double f : finals[0]) {
+                plain_mean += f / num_seeds;
+            }
+            const double target = 0.95 * plain_mean;    // 目标值为负的遮蔽时间
+
+            std::cout << "低重要性变量数 (各种子):";
+            for (size_t n : reduced_dims) {
+                std::cout << " " << n;
+            }
+            std::cout << " / " << dim << std::endl;
+            std::cout << std::left << std::setw(16) << "配置" << std::right << std::setw(14) << "平均遮蔽(s)"
+                      << std::setw(14) << "评估次数" << std::setw(20) << "达到95%所需评估" << std::setw(10) << "加速比"
+                      << std::endl;
+            double plain_to_target = 0.0;
+            for (size_t v = 0; v < variants.size(); ++v) {
+                double mean = 0.0;
+                double evaluations = 0.0;
+                double to_target = 0.0;
+                int reached = 0;
+                for (int s = 0; s < num_seeds; ++s) {
+                    mean += -finals[v][s] / num_seeds;
+                    evaluations += static_cast<double>(traces[v][s]->evaluations()) / num_seeds;
+                    const long long n = traces[v][s]->evaluations_to(target);
+                    if (n > 0) {
+                        to_target += static_cast<double>(n);
+                        ++reached;
+                    }
+                }
+                to_target = reached > 0 ? to_target / reached : 0.0;
+                if (v == 0) {
+                    plain_to_target = to_target;
+                }
+                std::cout << std::left << std::setw(16) << variants[v].name << std::right << std::setprecision(3)
+                          << std::setw(14) << mean << std::setprecision(0) << std::setw(14) << evaluations
+                          << std::setw(14) << to_target << " (" << reached << "/" << num_seeds << ")"
+                          << std::setprecision(2) << std::setw(10)
+                          << (to_target > 0.0 ? plain_to_target / to_target : 0.0) << std::endl;
+            }
+            std::cout.unsetf(std::ios::fixed);
+            std::cout << std::endl;
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "敏感性分析基准出错: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,257 @@
+#include "shaped_objective.hpp"
+#include "solve_problem_5.hpp"
+#include "counter_rng.hpp"
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <map>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief 丢弃输出的缓冲区，屏蔽边界计算与优化过程的打印
+ */
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+};
+
+/**
+ * @brief 暴露通用目标函数，作为对照
+ */
+class ProbeOptimizer : public Problem5::Problem5SubOptimizer {
+public:
+    using Problem5::Problem5SubOptimizer::Problem5SubOptimizer;
+    using Optimizer::ObscurationOptimizer::objective_function;
+};
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief 测试语料：一半在边界内均匀抽样，一半在较优解附近扰动 (覆盖锥体边界附近的判断)
+ */
+std::vector<Eigen::VectorXd> build_corpus(const std::vector<Optimizer::Bounds>& bounds,
+                                          const Eigen::VectorXd& center, int count, uint64_t seed) {
+    CounterRNG::CounterRng rng(seed, 1);
+    std::vector<Eigen::VectorXd> corpus(count, Eigen::VectorXd(bounds.size()));
+    for (int i = 0; i < count; ++i) {
+        for (size_t d = 0; d < bounds.size(); ++d) {
+            const auto [low, high] = bounds[d];
+            corpus[i][d] = i % 2 == 0
+                ? rng.uniform(low, high)
+                : std::clamp(center[d] + 0.02 * (high - low) * rng.uniform(-1.0, 1.0), low, high);
+        }
+    }
+    return corpus;
+}
+
+/**
+ * @brief 标准布局的决策变量转为扁平策略 (全局评估的通用路径)
+ */
+Optimizer::FlatStrategy to_flat(const Eigen::VectorXd& x, const std::vector<Registry::EntityIndex>& uavs,
+                                int grenades_per_uav) {
+    Optimizer::FlatStrategy strategy(uavs.size());
+    int k = 0;
+    for (size_t u = 0; u < uavs.size(); ++u) {
+        auto& record = strategy[u];
+        record.uav = uavs[u];
+        record.num_grenades = grenades_per_uav;
+        record.speed = x[k++];
+        record.angle = x[k++];
+        double t_deploy = 0.0;
+        for (int g = 0; g < grenades_per_uav; ++g) {
+            t_deploy = g == 0 ? x[k] : t_deploy + x[k];
+            record.grenades[g] = {t_deploy, x[k + 1]};
+            k += 2;
+        }
+    }
+    return strategy;
+}
+
+struct Comparison {
+    long long mismatches = 0;
+    long long obscuring = 0;
+    double generic_seconds = 0.0;
+    double shaped_seconds = 0.0;
+};
+
+template <typename Generic, typename Shaped>
+Comparison compare(const std::vector<Eigen::VectorXd>& corpus, Generic generic, Shaped shaped, int repeats) {
+    Comparison result;
+    std::vector<double> reference(corpus.size());
+    std::vector<double> values(corpus.size());
+
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeats; ++r) {
+        for (size_t i = 0; i < corpus.size(); ++i) {
+            reference[i] = generic(corpus[i]);
+        }
+    }
+    result.generic_seconds = seconds_since(start);
+
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeats; ++r) {
+        for (size_t i = 0; i < corpus.size(); ++i) {
+            values[i] = shaped(corpus[i]);
+        }
+    }
+    result.shaped_seconds = seconds_since(start);
+
+    for (size_t i = 0; i < corpus.size(); ++i) {
+        result.mismatches += reference[i] != values[i];
+        result.obscuring += reference[i] < 0.0;
+    }
+    return result;
+}
+
+void print_row(const std::string& name, int dimension, const Comparison& c, long long evaluations,
+               const std::string& de_check) {
+    std::cout << std::left << std::setw(22) << name << std::right << std::setw(6) << dimension
+              << std::setw(8) << c.obscuring << std::setw(8) << c.mismatches
+              << std::fixed << std::setprecision(2)
+              << std::setw(12) << c.generic_seconds * 1e6 / evaluations
+              << std::setw(12) << c.shaped_seconds * 1e6 / evaluations
+              << std::setw(9) << c.generic_seconds / c.shaped_seconds << "x"
+              << "   " << de_check << std::endl;
+}
+
+} // namespace
+
+/**
+ * @brief 编译期特化目标函数与通用目标函数的一致性验证和单次评估耗时
+ *
+ * 对每个问题形状：在同一批决策变量上比较两条路径的目标值 (要求逐位相同)，
+ * 并用相同种子各跑一次短的差分进化，检查最优值是否一致。
+ *
+ * 用法: bench_shaped [每形状语料数] [重复次数]
+ */
+int main(int argc, char* argv[]) {
+    try {
+        const int corpus_size = argc > 1 ? std::stoi(argv[1]) : 2000;
+        const int repeats = argc > 2 ? std::stoi(argv[2]) : 3;
+        const auto& scenario = ScenarioLoader::active();
+
+        struct SubProblem {
+            std::string name;
+            std::unordered_map<std::string, int> uavs;
+        };
+        const std::vector<SubProblem> problems = {
+            {"问题2 (1x1, M1)", {{"FY1", 1}}},
+            {"问题3 (1x3, M1)", {{"FY1", 3}}},
+            {"问题4 (3x1, M1)", {{"FY1", 1}, {"FY2", 1}, {"FY3", 1}}},
+            {"问题5子 (2x3, M1)", {{"FY1", 3}, {"FY2", 3}}},
+            {"问题5子 (3x3, M2)", {{"FY3", 3}, {"FY4", 3}, {"FY5", 3}}},
+        };
+
+        Optimizer::DESettings settings;
+        settings.max_iterations = 40;
+        settings.tolerance = 0.0;
+        settings.verbose = false;
+        settings.num_threads = 1;
+        settings.seed = 20240907;
+
+        NullBuffer null_buffer;
+        std::cout << std::left << std::setw(22) << "形状" << std::right << std::setw(6) << "维度"
+                  << std::setw(8) << "有遮蔽" << std::setw(8) << "不一致"
+                  << std::setw(12) << "通用(us)" << std::setw(12) << "特化(us)"
+                  << std::setw(10) << "加速比" << "   DE(同种子)" << std::endl;
+
+        long long total_mismatches = 0;
+        bool de_consistent = true;
+        for (const auto& problem : problems) {
+            const std::string missile_id = problem.name.find("M2") != std::string::npos ? "M2" : "M1";
+            std::streambuf* saved = std::cout.rdbuf(&null_buffer);
+            const auto bounds = Problem5::build_bounds(missile_id, problem.uavs);
+            settings.population_size = 10 * static_cast<int>(bounds.size());
+
+            // 同种子的两次优化：特化路径与通用路径应走出完全相同的轨迹
+            ProbeOptimizer generic(missile_id, problem.uavs);
+            generic.set_shaped_objective(false);
+            ProbeOptimizer shaped(missile_id, problem.uavs);
+            auto start = std::chrono::steady_clock::now();
+            const double generic_best = generic.solve(bounds, settings).second;
+            const double generic_de_seconds = seconds_since(start);
+            start = std::chrono::steady_clock::now();
+            const double shaped_best = shaped.solve(bounds, settings).second;
+            const double shaped_de_seconds = seconds_since(start);
+
+            std::map<std::string, int> sorted(problem.uavs.begin(), problem.uavs.end());
+            std::vector<Registry::EntityIndex> uav_indices;
+            for (const auto& [uav_id, _] : sorted) {
+                uav_indices.push_back(scenario.entities.uav_index(uav_id));
+            }
+            auto objective = ShapedObjective::make_objective(
+                uav_indices, sorted.begin()->second, {scenario.entities.missile_index(missile_id)}, scenario);
+            const auto center = Optimizer::DifferentialEvolution::optimize(objective, bounds, settings).first;
+            std::cout.rdbuf(saved);
+
+            const auto corpus = build_corpus(bounds, center, corpus_size, settings.seed);
+            const Comparison c = compare(corpus,
+                                         [&](const Eigen::VectorXd& x) { return generic.objective_function(x); },
+                                         objective, repeats);
+            total_mismatches += c.mismatches;
+            de_consistent = de_consistent && generic_best == shaped_best;
+
+            std::ostringstream de_check;
+            de_check << std::fixed << std::setprecision(1) << generic_best << " s / " << shaped_best << " s，"
+                     << std::setprecision(2) << generic_de_seconds / shaped_de_seconds << "x";
+            print_row(problem.name, static_cast<int>(bounds.size()), c,
+                      static_cast<long long>(corpus.size()) * repeats, de_check.str());
+        }
+
+        // 问题5 全局评估：5 机各 3 弹，同时统计 3 枚导弹
+        {
+            std::vector<Registry::EntityIndex> uavs;
+            std::vector<Registry::EntityIndex> missiles;
+            std::unordered_map<std::string, int> all_uavs;
+            for (int u = 0; u < scenario.entities.num_uavs(); ++u) {
+                uavs.push_back(u);
+                all_uavs[scenario.entities.uav(u).id] = 3;
+            }
+            for (int m = 0; m < scenario.entities.num_missiles(); ++m) {
+                missiles.push_back(m);
+            }
+            auto objective = ShapedObjective::make_objective(uavs, 3, missiles, scenario);
+            if (!objective) {
+                std::cout << "当前场景没有 5x3x3 形状，跳过全局评估" << std::endl;
+            } else {
+                std::streambuf* saved = std::cout.rdbuf(&null_buffer);
+                const auto bounds = Problem5::build_bounds("M1", all_uavs);
+                settings.population_size = 4 * static_cast<int>(bounds.size());
+                const auto center = Optimizer::DifferentialEvolution::optimize(objective, bounds, settings).first;
+                std::cout.rdbuf(saved);
+
+                FastEvaluator::ObscurationEvaluator evaluator(missiles, scenario);
+                auto generic = [&](const Eigen::VectorXd& x) {
+                    thread_local std::vector<FastEvaluator::CloudState> clouds;
+                    if (FastEvaluator::try_build_clouds(to_flat(x, uavs, 3), clouds, scenario)
+                            != Optimizer::StrategyStatus::OK) {
+                        return 0.0;
+                    }
+                    double obscured[3];
+                    evaluator.evaluate(clouds, obscured);
+                    return -(obscured[0] + obscured[1] + obscured[2]);
+                };
+                const auto corpus = build_corpus(bounds, center, corpus_size, settings.seed);
+                const Comparison c = compare(corpus, generic, objective, repeats);
+                total_mismatches += c.mismatches;
+                print_row("问题5全局 (5x3, 3弹)", static_cast<int>(bounds.size()), c,
+                          static_cast<long long>(corpus.size()) * repeats, "-");
+            }
+        }
+
+        std::cout << "目标值不一致 " << total_mismatches << " 个，同种子优化结果"
+                  << (de_consistent ? "一致" : "不一致") << std::endl;
+        return total_mismatches == 0 && de_consistent ? 0 : 1;
+    } catch (const std::exception& e) {
+        std::cerr << "特化目标函数基准出错: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,81 @@
+#include "benchmark_suite.hpp"
+#include "high_performance_adaptive_de.hpp"
+#include "portfolio.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using BenchmarkSuite::Objective;
+using BenchmarkSuite::Vector;
+
+/**
+ * @brief 自适应DE的一个变体；批量运行已在作业之间并行，单次运行只用一个线程
+ */
+BenchmarkSuite::SolverEntry adaptive_de(HighPerformanceDE::DEVariant variant) {
+    return {HighPerformanceDE::variant_name(variant),
+            [variant](const Objective& objective, const Vector& lower, const Vector& upper, long long budget,
+                      uint64_t seed) {
+                HighPerformanceDE::AdaptiveDESettings settings;
+                settings.variant = variant;
+                settings.max_evaluations = budget;
+                settings.max_iterations = 1000000;
+                settings.max_stagnant_generations = 1000000;
+                settings.tolerance = 0.0;
+                settings.random_seed = static_cast<int>(seed);
+                settings.num_threads = 1;
+                settings.verbose = false;
+                HighPerformanceDE::HighPerformanceAdaptiveDE optimizer(objective, lower, upper, settings);
+                optimizer.optimize();
+            }};
+}
+
+BenchmarkSuite::SolverEntry portfolio() {
+    return {"组合竞速", [](const Objective& objective, const Vector& lower, const Vector& upper, long long budget,
+                       uint64_t seed) {
+        Portfolio::Settings settings;
+        settings.max_evaluations = budget;
+        settings.num_threads = 1;
+        settings.seed = seed;
+        Portfolio::optimize(objective, lower, upper, settings);
+    }};
+}
+
+} // namespace
+
+/**
+ * @brief 平移旋转基准函数集 (仿 CEC2017，含台阶与量化平台函数) 上的优化器对比
+ *
+ * 全部 (函数, 求解器, 种子) 作业在线程池上并发执行，报告各函数的中位最终误差、ERT 和按类别的 ECDF；
+ * 给出 CSV 前缀时另写出每次运行的记录和 ECDF 曲线，供跨版本跟踪优化器性能。
+ *
+ * 用法: bench_suite [维度] [每维评估预算] [种子数] [CSV前缀] [并发作业数]
+ */
+int main(int argc, char* argv[]) {
+    try {
+        const int dimension = argc > 1 ? std::stoi(argv[1]) : 10;
+        BenchmarkSuite::BatchSettings settings;
+        settings.budget_per_dimension = argc > 2 ? std::stoll(argv[2]) : 2000;
+        settings.num_seeds = argc > 3 ? std::stoi(argv[3]) : 5;
+        const std::string csv_prefix = argc > 4 ? argv[4] : "";
+        settings.num_threads = argc > 5 ? std::stoi(argv[5]) : -1;
+
+        using HighPerformanceDE::DEVariant;
+        const std::vector<BenchmarkSuite::SolverEntry> solvers = {
+            adaptive_de(DEVariant::MULTI_STRATEGY), adaptive_de(DEVariant::JADE), adaptive_de(DEVariant::LSHADE),
+            adaptive_de(DEVariant::JSO), portfolio()};
+
+        const auto suite = BenchmarkSuite::make_suite(dimension);
+        const auto result = BenchmarkSuite::run_batch(suite, solvers, settings);
+        BenchmarkSuite::print_report(result, std::cout);
+        if (!csv_prefix.empty()) {
+            BenchmarkSuite::write_csv(result, csv_prefix);
+            std::cout << std::endl << "已写出 " << csv_prefix << "_runs.csv 和 " << csv_prefix << "_ecdf.csv" << std::endl;
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "基准函数集运行出错: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,131 @@
+#include "high_performance_adaptive_de.hpp"
+#include "shaped_objective.hpp"
+#include "solve_problem_5.hpp"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief 丢弃输出的缓冲区，屏蔽被测模块的打印
+ */
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+};
+
+struct RunStats {
+    double seconds = 0.0;
+    double evaluations = 0.0;
+    double skipped = 0.0;
+    double obscured = 0.0;      // 最优遮蔽时间 (s)
+};
+
+RunStats run(const HighPerformanceDE::ObjectiveFunction& objective,
+             const HighPerformanceDE::Vector& lower, const HighPerformanceDE::Vector& upper,
+             int iterations, bool use_surrogate, int seed) {
+    HighPerformanceDE::AdaptiveDESettings settings;
+    settings.population_size = 60;
+    settings.max_iterations = iterations;
+    settings.max_stagnant_generations = iterations;
+    settings.tolerance = 0.0;     // 遮蔽时间可能为零，不使用适应度阈值收敛
+    settings.adaptive_population = false;
+    settings.enable_caching = false;
+    settings.verbose = false;
+    settings.random_seed = seed;
+    settings.use_surrogate = use_surrogate;
+
+    HighPerformanceDE::HighPerformanceAdaptiveDE de(objective, lower, upper, settings);
+    const auto start = std::chrono::steady_clock::now();
+    auto result = de.optimize();
+    RunStats stats;
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    stats.evaluations = result.performance_stats.total_evaluations;
+    stats.skipped = result.performance_stats.surrogate_skipped;
+    stats.obscured = -result.best_fitness;
+    return stats;
+}
+
+void print_row(const std::string& name, const RunStats& stats) {
+    std::cout << std::left << std::setw(28) << name << std::right << std::fixed
+              << std::setprecision(0) << std::setw(10) << stats.evaluations
+              << std::setw(10) << stats.skipped
+              << std::setprecision(3) << std::setw(10) << stats.seconds
+              << std::setw(14) << stats.obscured
+              << std::setw(14) << stats.obscured / stats.seconds << std::endl;
+}
+
+} // namespace
+
+/**
+ * @brief 代理模型预筛选与普通自适应 DE 的对比
+ *
+ * 问题5子问题形状 (M1，三机各三弹，24 维)，细时间步使单次评估变贵。每种配置取多个种子的平均：
+ * 相同代数下预筛选节省的评估次数与最优遮蔽时间，以及普通 DE 在与预筛选相同评估次数下的结果。
+ *
+ * 用法: bench_surrogate [代数] [种子数] [时间步长]
+ */
+int main(int argc, char* argv[]) {
+    try {
+        const int iterations = argc > 1 ? std::stoi(argv[1]) : 200;
+        const int num_seeds = argc > 2 ? std::stoi(argv[2]) : 5;
+        const double time_step = argc > 3 ? std::stod(argv[3]) : 0.02;
+
+        NullBuffer null_buffer;
+        std::streambuf* saved = std::cout.rdbuf(&null_buffer);
+        const std::unordered_map<std::string, int> uavs = {{"FY1", 3}, {"FY2", 3}, {"FY3", 3}};
+        const auto bounds = Problem5::build_bounds("M1", uavs);
+        std::cout.rdbuf(saved);
+
+        const auto& scenario = ScenarioLoader::active();
+        const auto objective = ShapedObjective::make_objective(
+            {scenario.entities.uav_index("FY1"), scenario.entities.uav_index("FY2"), scenario.entities.uav_index("FY3")},
+            3, {scenario.entities.missile_index("M1")}, scenario, time_step);
+        if (!objective) {
+            throw std::runtime_error("当前场景不支持该问题形状");
+        }
+
+        HighPerformanceDE::Vector lower(bounds.size()), upper(bounds.size());
+        for (size_t i = 0; i < bounds.size(); ++i) {
+            lower[i] = bounds[i].lower;
+            upper[i] = bounds[i].upper;
+        }
+
+        auto average = [&](int generations, bool use_surrogate) {
+            RunStats total;
+            for (int s = 0; s < num_seeds; ++s) {
+                RunStats stats = run(objective, lower, upper, generations, use_surrogate, 1000 + s);
+                total.seconds += stats.seconds / num_seeds;
+                total.evaluations += stats.evaluations / num_seeds;
+                total.skipped += stats.skipped / num_seeds;
+                total.obscured += stats.obscured / num_seeds;
+            }
+            return total;
+        };
+
+        std::cout << "维度 " << bounds.size() << "，种群 60，代数 " << iterations << "，时间步长 " << time_step
+                  << "，" << num_seeds << " 个种子平均" << std::endl;
+        std::cout << std::left << std::setw(28) << "配置" << std::right << std::setw(10) << "评估次数"
+                  << std::setw(10) << "筛掉" << std::setw(10) << "墙钟(s)" << std::setw(14) << "最优遮蔽(s)"
+                  << std::setw(14) << "遮蔽/墙钟秒" << std::endl;
+
+        const RunStats plain = average(iterations, false);
+        const RunStats screened = average(iterations, true);
+        // 普通 DE 在与预筛选相同的评估预算下 (按每代评估数折算代数)
+        const int budget_generations = std::max(1, static_cast<int>(screened.evaluations / 60.0) - 1);
+        const RunStats plain_budget = average(budget_generations, false);
+
+        print_row("普通DE", plain);
+        print_row("代理预筛选", screened);
+        print_row("普通DE (" + std::to_string(budget_generations) + " 代，同等评估)", plain_budget);
+        std::cout << "节省评估 " << std::setprecision(1) << 100.0 * (1.0 - screened.evaluations / plain.evaluations)
+                  << "%" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "代理模型基准出错: " << e.what() << std::endl;
+        return 1;
+    }
+}
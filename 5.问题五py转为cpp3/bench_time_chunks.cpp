@@ -0,0 +1,152 @@
+#include "scenario_generator.hpp"
+#include "fast_evaluator.hpp"
+#include "counter_rng.hpp"
+#include "work_pool.hpp"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace {
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief 随机的全机队策略：每架无人机用满弹药预算，大致朝所在走廊的瞄准点飞行
+ */
+Optimizer::FlatStrategy random_fleet_strategy(const ScenarioLoader::Scenario& scenario,
+                                              uint64_t seed, uint64_t index) {
+    const auto& entities = scenario.entities;
+    const auto& physics = scenario.physics;
+    CounterRNG::CounterRng rng(seed, index);
+
+    Optimizer::FlatStrategy strategy(entities.num_uavs());
+    for (int u = 0; u < entities.num_uavs(); ++u) {
+        const auto& uav = entities.uav(u);
+        const auto& missile = entities.missile(u % entities.num_missiles());
+        Vector3d heading = missile.target - uav.start_pos;
+
+        auto& record = strategy[u];
+        record.uav = u;
+        record.num_grenades = uav.grenade_budget;
+        record.speed = rng.uniform(physics.uav_speed_min, physics.uav_speed_max);
+        record.angle = std::atan2(heading.y(), heading.x()) + rng.uniform(-0.3, 0.3);
+
+        double t_deploy = rng.uniform(0.1, 10.0);
+        for (int g = 0; g < record.num_grenades; ++g) {
+            record.grenades[g] = {t_deploy, rng.uniform(0.1, 8.0)};
+            t_deploy += physics.grenade_interval + rng.uniform(0.0, 3.0);
+        }
+    }
+    return strategy;
+}
+
+struct Case {
+    int missiles;
+    int uavs;
+    double time_step;
+};
+
+/**
+ * @brief 按种群大小分批并行评估 (种群级并行)，重复直到累计至少 min_seconds，返回每秒评估数
+ */
+double measure(const FastEvaluator::ObscurationEvaluator& evaluator,
+               const std::vector<std::vector<FastEvaluator::CloudState>>& population,
+               std::vector<double>& obscured, double min_seconds) {
+    const int num_missiles = evaluator.num_missiles();
+    const int size = static_cast<int>(population.size());
+    obscured.assign(static_cast<size_t>(size) * num_missiles, 0.0);
+
+    long long evaluations = 0;
+    const auto start = std::chrono::steady_clock::now();
+    double elapsed = 0.0;
+    do {
+        WorkPool::Pool::global().parallel_for(size, [&](int i) {
+            evaluator.evaluate(population[i], obscured.data() + static_cast<size_t>(i) * num_missiles);
+        }, -1, 1);
+        evaluations += size;
+        elapsed = seconds_since(start);
+    } while (elapsed < min_seconds);
+    return evaluations / elapsed;
+}
+
+} // namespace
+
+/**
+ * @brief 单次评估内按时间分段并行的吞吐量
+ *
+ * 合成的大场景 (数十个云团、多枚导弹、细时间步) 上以小种群做种群级并行评估，
+ * 对比不拆分时间扫描与按代价模型拆分 (嵌套在种群级任务内，共用同一线程池) 的每秒评估数。
+ * 线程数取 OMP_NUM_THREADS。
+ *
+ * 用法: bench_time_chunks [每项最短计时秒数] [种子]
+ */
+int main(int argc, char* argv[]) {
+    try {
+        const double min_seconds = argc > 1 ? std::stod(argv[1]) : 0.5;
+        const uint64_t seed = argc > 2 ? std::stoull(argv[2]) : 20240907;
+        const int threads = WorkPool::Pool::global().num_threads();
+
+        const std::vector<Case> cases = {{3, 5, 0.1}, {5, 10, 0.02}, {10, 20, 0.02}, {10, 20, 0.005}};
+        std::cout << "线程数 " << threads << std::endl;
+        std::cout << std::setw(6) << "导弹" << std::setw(6) << "云团" << std::setw(8) << "步长"
+                  << std::setw(8) << "种群" << std::setw(10) << "段数" << std::setw(14) << "单次(ms)"
+                  << std::setw(14) << "不拆分(次/秒)" << std::setw(14) << "分段(次/秒)"
+                  << std::setw(10) << "加速比" << "   结果" << std::endl;
+
+        for (const auto& c : cases) {
+            ScenarioGenerator::GeneratorSettings gen;
+            gen.num_missiles = c.missiles;
+            gen.num_uavs = c.uavs;
+            gen.seed = seed;
+            const auto scenario = ScenarioGenerator::generate(gen);
+
+            std::vector<Registry::EntityIndex> missiles(scenario.entities.num_missiles());
+            std::iota(missiles.begin(), missiles.end(), 0);
+            FastEvaluator::ObscurationEvaluator evaluator(missiles, scenario, c.time_step);
+
+            for (int population_size : {1, 4, 16}) {
+                std::vector<std::vector<FastEvaluator::CloudState>> population(population_size);
+                for (int i = 0; i < population_size; ++i) {
+                    FastEvaluator::try_build_clouds(random_fleet_strategy(scenario, seed, i), population[i], scenario);
+                }
+
+                evaluator.set_time_chunks(1);
+                std::vector<double> serial;
+                const double serial_rate = measure(evaluator, population, serial, min_seconds);
+
+                evaluator.set_time_chunks(-1);
+                std::vector<double> split;
+                const double split_rate = measure(evaluator, population, split, min_seconds);
+
+                const auto& clouds = population[0];
+                double end_time = 0.0;
+                double start_time = clouds.empty() ? 0.0 : clouds[0].start_time;
+                for (const auto& cloud : clouds) {
+                    start_time = std::min(start_time, cloud.start_time);
+                    end_time = std::max(end_time, cloud.end_time);
+                }
+                const long long steps = static_cast<long long>((end_time - start_time) / c.time_step);
+
+                std::cout << std::setw(6) << c.missiles << std::setw(6) << clouds.size()
+                          << std::setw(8) << c.time_step << std::setw(8) << population_size
+                          << std::setw(10) << evaluator.plan_time_chunks(clouds, steps)
+                          << std::fixed << std::setprecision(3) << std::setw(14) << std::min(population_size, threads) / serial_rate * 1e3
+                          << std::setprecision(1) << std::setw(14) << serial_rate << std::setw(14) << split_rate
+                          << std::setprecision(2) << std::setw(10) << split_rate / serial_rate
+                          << "   " << (serial == split ? "相同" : "不同") << std::endl;
+                std::cout.unsetf(std::ios::fixed);
+            }
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "时间分段基准出错: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,657 @@
+#include "benchmark_suite.hpp"
+#include "counter_rng.hpp"
+#include "work_pool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+
+namespace BenchmarkSuite {
+
+namespace {
+
+using Matrix = Eigen::MatrixXd;
+using Segment = Eigen::Ref<const Vector>;
+
+constexpr double BOUND = 100.0;         // 搜索区间 [-BOUND, BOUND]^D
+constexpr double SHIFT_RANGE = 80.0;    // 最优点所在的区间
+
+/**
+ * @brief 平移旋转：z = scale · R (x - o)，基函数的最优点都在 z = 0
+ */
+struct Transform {
+    Vector shift;
+    Matrix rotation;
+    double scale;
+
+    Vector apply(const Vector& x) const { return scale * (rotation * (x - shift)); }
+};
+
+Transform random_transform(int dim, double scale, CounterRNG::CounterRng& rng) {
+    Transform transform;
+    transform.shift.resize(dim);
+    for (int k = 0; k < dim; ++k) {
+        transform.shift[k] = rng.uniform(-SHIFT_RANGE, SHIFT_RANGE);
+    }
+    // 高斯矩阵 QR 分解的 Q 为随机正交矩阵
+    Matrix gaussian(dim, dim);
+    for (int c = 0; c < dim; ++c) {
+        for (int r = 0; r < dim; ++r) {
+            gaussian(r, c) = rng.normal();
+        }
+    }
+    transform.rotation = Eigen::HouseholderQR<Matrix>(gaussian).householderQ();
+    transform.scale = scale;
+    return transform;
+}
+
+// =============================================================================
+// 基函数：最优点在 z = 0，最优值为 0
+// =============================================================================
+
+double bent_cigar(const Segment& z) {
+    return z[0] * z[0] + 1e6 * z.tail(z.size() - 1).squaredNorm();
+}
+
+double zakharov(const Segment& z) {
+    double weighted = 0.0;
+    for (int i = 0; i < z.size(); ++i) {
+        weighted += 0.5 * (i + 1) * z[i];
+    }
+    const double w2 = weighted * weighted;
+    return z.squaredNorm() + w2 + w2 * w2;
+}
+
+double elliptic(const Segment& z) {
+    const int n = static_cast<int>(z.size());
+    double sum = 0.0;
+    for (int i = 0; i < n; ++i) {
+        sum += std::pow(1e6, n > 1 ? static_cast<double>(i) / (n - 1) : 0.0) * z[i] * z[i];
+    }
+    return sum;
+}
+
+double rosenbrock(const Segment& z) {
+    double sum = 0.0;
+    for (int i = 0; i + 1 < z.size(); ++i) {
+        const double a = z[i] + 1.0, b = z[i + 1] + 1.0;
+        sum += 100.0 * (a * a - b) * (a * a - b) + (a - 1.0) * (a - 1.0);
+    }
+    return sum;
+}
+
+double rastrigin(const Segment& z) {
+    double sum = 0.0;
+    for (int i = 0; i < z.size(); ++i) {
+        sum += z[i] * z[i] - 10.0 * std::cos(2.0 * M_PI * z[i]) + 10.0;
+    }
+    return sum;
+}
+
+// 离整半点超过 0.5 的坐标取整到 0.5 的倍数 (CEC 的不连续 Rastrigin)
+double noncontinuous_rastrigin(const Segment& z) {
+    Vector y = z;
+    for (int i = 0; i < y.size(); ++i) {
+        if (std::abs(y[i]) > 0.5) {
+            y[i] = std::round(2.0 * y[i]) / 2.0;
+        }
+    }
+    return rastrigin(y);
+}
+
+double expanded_schaffer_f6(const Segment& z) {
+    const int n = static_cast<int>(z.size());
+    double sum = 0.0;
+    for (int i = 0; i < n; ++i) {
+        const double r2 = z[i] * z[i] + z[(i + 1) % n] * z[(i + 1) % n];
+        const double s = std::sin(std::sqrt(r2));
+        const double d = 1.0 + 0.001 * r2;
+        sum += 0.5 + (s * s - 0.5) / (d * d);
+    }
+    return sum;
+}
+
+double levy(const Segment& z) {
+    const int n = static_cast<int>(z.size());
+    auto w = [&](int i) { return 1.0 + z[i] / 4.0; };
+    const double first = std::sin(M_PI * w(0));
+    double sum = first * first;
+    for (int i = 0; i + 1 < n; ++i) {
+        const double s = std::sin(M_PI * w(i) + 1.0);
+        sum += (w(i) - 1.0) * (w(i) - 1.0) * (1.0 + 10.0 * s * s);
+    }
+    const double last = std::sin(2.0 * M_PI * w(n - 1));
+    return sum + (w(n - 1) - 1.0) * (w(n - 1) - 1.0) * (1.0 + last * last);
+}
+
+// CEC2017 的修正 Schwefel：超出 [-500, 500] 的坐标折回并加二次惩罚；最优值只近似为 0，误差以 f(最优点) 为基准
+double modified_schwefel(const Segment& z) {
+    const int n = static_cast<int>(z.size());
+    double sum = 0.0;
+    for (int i = 0; i < n; ++i) {
+        const double y = z[i] + 4.209687462275036e2;
+        double g;
+        if (y > 500.0) {
+            const double folded = 500.0 - std::fmod(y, 500.0);
+            g = folded * std::sin(std::sqrt(std::abs(folded))) - (y - 500.0) * (y - 500.0) / (10000.0 * n);
+        } else if (y < -500.0) {
+            const double folded = std::fmod(std::abs(y), 500.0) - 500.0;
+            g = folded * std::sin(std::sqrt(std::abs(folded))) - (y + 500.0) * (y + 500.0) / (10000.0 * n);
+        } else {
+            g = y * std::sin(std::sqrt(std::abs(y)));
+        }
+        sum += g;
+    }
+    return 418.9828872724338 * n - sum;
+}
+
+double ackley(const Segment& z) {
+    const double n = static_cast<double>(z.size());
+    double cosines = 0.0;
+    for (int i = 0; i < z.size(); ++i) {
+        cosines += std::cos(2.0 * M_PI * z[i]);
+    }
+    return -20.0 * std::exp(-0.2 * std::sqrt(z.squaredNorm() / n)) - std::exp(cosines / n) + 20.0 + M_E;
+}
+
+// BBOB f7 的台阶椭球：|z_i| > 0.5 时取整，否则取到 0.1；目标值呈大片平台
+double step_ellipsoid(const Segment& z) {
+    const int n = static_cast<int>(z.size());
+    double sum = 0.0, first = 0.0;
+    for (int i = 0; i < n; ++i) {
+        const double rounded = std::abs(z[i]) > 0.5 ? std::floor(0.5 + z[i]) : std::floor(0.5 + 10.0 * z[i]) / 10.0;
+        if (i == 0) {
+            first = std::abs(rounded) / 1e4;
+        }
+        sum += std::pow(10.0, 2.0 * i / (n - 1)) * rounded * rounded;
+    }
+    return 0.1 * std::max(first, sum);
+}
+
+Function finish(std::string name, Category category, Objective evaluate, const Vector& optimum) {
+    const int dim = static_cast<int>(optimum.size());
+    const double optimum_value = evaluate(optimum);
+    return {std::move(name), category, std::move(evaluate), Vector::Constant(dim, -BOUND),
+            Vector::Constant(dim, BOUND), optimum, optimum_value};
+}
+
+/**
+ * @brief 单个基函数的平移旋转版本
+ */
+Function single(const std::string& name, Category category, double (*base)(const Segment&), double scale,
+                int dim, CounterRNG::CounterRng& rng) {
+    auto transform = std::make_shared<Transform>(random_transform(dim, scale, rng));
+    return finish(name, category, [transform, base](const Vector& x) { return base(transform->apply(x)); },
+                  transform->shift);
+}
+
+/**
+ * @brief 混合函数 (CEC2017 F11-F20 的做法)：变量随机置换后按 20% / 40% / 40% 分组，各组使用不同基函数
+ */
+Function hybrid(int dim, CounterRNG::CounterRng& rng) {
+    auto transform = std::make_shared<Transform>(random_transform(dim, 1.0, rng));
+    auto permutation = std::make_shared<std::vector<int>>(dim);
+    std::iota(permutation->begin(), permutation->end(), 0);
+    for (int i = dim - 1; i > 0; --i) {
+        std::swap((*permutation)[i], (*permutation)[rng.uniform_int(static_cast<uint32_t>(i + 1))]);
+    }
+    const int first = std::max(1, static_cast<int>(std::ceil(0.2 * dim)));
+    const int second = std::max(1, std::min(dim - first - 1, static_cast<int>(std::ceil(0.4 * dim))));
+    auto evaluate = [transform, permutation, first, second](const Vector& x) {
+        const Vector z = transform->apply(x);
+        Vector y(z.size());
+        for (int i = 0; i < z.size(); ++i) {
+            y[i] = z[(*permutation)[i]];
+        }
+        const int third = static_cast<int>(y.size()) - first - second;
+        return zakharov(y.head(first)) + rosenbrock(0.02048 * y.segment(first, second)) +
+               rastrigin(0.0512 * y.tail(third));
+    };
+    return finish("混合 (Zakharov+Rosenbrock+Rastrigin)", Category::HYBRID, std::move(evaluate), transform->shift);
+}
+
+/**
+ * @brief 组合函数 (CEC2017 F21 的做法)：三个基函数按到各自最优点的距离加权，第一个分量的最优点为全局最优
+ */
+Function composition(int dim, CounterRNG::CounterRng& rng) {
+    struct Component {
+        Transform transform;
+        double (*base)(const Segment&);
+        double sigma;
+        double lambda;
+        double bias;
+    };
+    auto components = std::make_shared<std::vector<Component>>();
+    components->push_back({random_transform(dim, 0.02048, rng), rosenbrock, 10.0, 1.0, 0.0});
+    components->push_back({random_transform(dim, 1.0, rng), elliptic, 20.0, 1e-6, 100.0});
+    components->push_back({random_transform(dim, 0.0512, rng), rastrigin, 30.0, 1.0, 200.0});
+
+    auto evaluate = [components, dim](const Vector& x) {
+        const size_t count = components->size();
+        std::vector<double> weights(count), values(count);
+        double total = 0.0;
+        for (size_t k = 0; k < count; ++k) {
+            const Component& c = (*components)[k];
+            values[k] = c.lambda * c.base(c.transform.apply(x)) + c.bias;
+            const double d2 = (x - c.transform.shift).squaredNorm();
+            if (d2 == 0.0) {
+                return values[k];
+            }
+            weights[k] = std::exp(-d2 / (2.0 * dim * c.sigma * c.sigma)) / std::sqrt(d2);
+            total += weights[k];
+        }
+        double sum = 0.0;
+        for (size_t k = 0; k < count; ++k) {
+            // 远离全部最优点时权重下溢为 0，退回等权
+            sum += (total > 0.0 ? weights[k] / total : 1.0 / count) * values[k];
+        }
+        return sum;
+    };
+    const Vector optimum = (*components)[0].transform.shift;
+    return finish("组合 (Rosenbrock+椭球+Rastrigin)", Category::COMPOSITION, std::move(evaluate), optimum);
+}
+
+/**
+ * @brief 量化覆盖函数：模拟按 0.1 s 量化的遮蔽时间
+ *
+ * 若干个旋转的各向异性"遮蔽窗口"，窗口外覆盖为 0 (大片平台，相当于没有形成遮蔽)，进入窗口后覆盖随距离平方线性增加，
+ * 归一化距离平方降到半径平方的 20% 以内饱和 (完全遮蔽)。目标为 最高覆盖 - 0.1 × floor(10 × 各窗口覆盖的最大值)。
+ * 全局最优窗口中心位于平移点，只覆盖约 2% 的搜索区间；其余窗口更大 (各约 6%) 但高度较低，形成诱骗的局部平台。
+ * 窗口半径取均匀随机点到窗口中心距离的分位数，覆盖比例与维度无关。
+ */
+Function quantised_coverage(int dim, CounterRNG::CounterRng& rng) {
+    struct Window {
+        Transform transform;
+        double height;
+        double radius2;
+    };
+    constexpr int NUM_WINDOWS = 6;
+    constexpr int CALIBRATION_SAMPLES = 2000;
+    constexpr double TOP_FRACTION = 0.02;       // 全局最优窗口覆盖的比例
+    constexpr double DECOY_FRACTION = 0.06;     // 其余窗口覆盖的比例
+    constexpr double SATURATION = 0.2;          // d² / r² 不超过该值时完全遮蔽
+    constexpr double TOP = 6.0;
+    auto axis = std::make_shared<Vector>(dim);
+    for (int i = 0; i < dim; ++i) {
+        (*axis)[i] = std::pow(10.0, static_cast<double>(i) / (dim - 1));
+    }
+    // 归一化距离 d² = mean_i(s_i z_i²)，s_i 从 1 到 10
+    auto distance2 = [axis](const Transform& transform, const Vector& x) {
+        const Vector z = transform.apply(x);
+        return z.cwiseAbs2().dot(*axis) / z.size();
+    };
+
+    auto windows = std::make_shared<std::vector<Window>>();
+    std::vector<double> samples(CALIBRATION_SAMPLES);
+    for (int k = 0; k < NUM_WINDOWS; ++k) {
+        Window window{random_transform(dim, 1.0, rng), k == 0 ? TOP : rng.uniform(3.0, 5.5), 0.0};
+        const double fraction = k == 0 ? TOP_FRACTION : DECOY_FRACTION;
+        for (double& d2 : samples) {
+            Vector x(dim);
+            for (int i = 0; i < dim; ++i) {
+                x[i] = rng.uniform(-BOUND, BOUND);
+            }
+            d2 = distance2(window.transform, x);
+        }
+        const auto quantile = samples.begin() + static_cast<int>(fraction * CALIBRATION_SAMPLES);
+        std::nth_element(samples.begin(), quantile, samples.end());
+        window.radius2 = *quantile;
+        windows->push_back(std::move(window));
+    }
+    auto evaluate = [windows, distance2](const Vector& x) {
+        double coverage = 0.0;
+        for (const Window& window : *windows) {
+            const double level = std::clamp((1.0 - distance2(window.transform, x) / window.radius2) / (1.0 - SATURATION),
+                                            0.0, 1.0);
+            coverage = std::max(coverage, window.height * level);
+        }
+        return TOP - 0.1 * std::floor(10.0 * coverage + 1e-9);
+    };
+    const Vector optimum = (*windows)[0].transform.shift;
+    return finish("量化覆盖 (遮蔽型)", Category::PLATEAU, std::move(evaluate), optimum);
+}
+
+/**
+ * @brief 预算内首次达到各误差目标的评估序号 (目标函数被并发调用时按评估计数的原子序号记)
+ */
+class Trace {
+public:
+    Trace(const Function& function, const std::vector<double>& targets, long long budget)
+        : function_(function), targets_(targets), budget_(budget),
+          hits_(new std::atomic<long long>[targets.size()]) {
+        for (size_t k = 0; k < targets_.size(); ++k) {
+            hits_[k].store(-1, std::memory_order_relaxed);
+        }
+    }
+
+    double evaluate(const Vector& x) {
+        const double value = function_.evaluate(x);
+        const long long n = count_.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (n > budget_) {
+            return value;   // 超出预算的评估不计入统计
+        }
+        const double error = value - function_.optimum_value;
+        double best = best_.load(std::memory_order_relaxed);
+        while (error < best && !best_.compare_exchange_weak(best, error, std::memory_order_relaxed)) {
+        }
+        for (size_t k = 0; k < targets_.size(); ++k) {
+            if (error > targets_[k]) {
+                continue;
+            }
+            long long seen = hits_[k].load(std::memory_order_relaxed);
+            while ((seen < 0 || n < seen) && !hits_[k].compare_exchange_weak(seen, n, std::memory_order_relaxed)) {
+            }
+        }
+        return value;
+    }
+
+    long long evaluations() const { return std::min(count_.load(), budget_); }
+    double best_error() const { return best_.load(); }
+    long long hit(size_t k) const { return hits_[k].load(); }
+
+private:
+    const Function& function_;
+    const std::vector<double>& targets_;
+    long long budget_;
+    std::atomic<long long> count_{0};
+    std::atomic<double> best_{std::numeric_limits<double>::infinity()};
+    std::unique_ptr<std::atomic<long long>[]> hits_;
+};
+
+std::string format_runtime(double value) {
+    if (!std::isfinite(value)) {
+        return "-";
+    }
+    std::ostringstream oss;
+    oss << std::setprecision(3) << value;
+    return oss.str();
+}
+
+} // namespace
+
+std::string category_name(Category category) {
+    switch (category) {
+        case Category::UNIMODAL:    return "单峰";
+        case Category::MULTIMODAL:  return "多峰";
+        case Category::HYBRID:      return "混合";
+        case Category::COMPOSITION: return "组合";
+        case Category::PLATEAU:     return "平台/量化";
+    }
+    return "未知";
+}
+
+std::vector<Function> make_suite(int dimension, uint64_t seed) {
+    if (dimension < 2) {
+        throw std::invalid_argument("基准函数集的维度至少为 2");
+    }
+    // 每个函数使用自己的随机数流，增删函数不影响其余函数的平移与旋转
+    uint64_t stream = 0;
+    auto next_rng = [&]() { return CounterRNG::CounterRng(seed, stream++); };
+
+    std::vector<Function> suite;
+    auto add = [&](const std::string& name, Category category, double (*base)(const Segment&), double scale) {
+        auto rng = next_rng();
+        suite.push_back(single(name, category, base, scale, dimension, rng));
+    };
+    add("Bent Cigar", Category::UNIMODAL, bent_cigar, 1.0);
+    add("Zakharov", Category::UNIMODAL, zakharov, 1.0);
+    add("Rosenbrock", Category::MULTIMODAL, rosenbrock, 0.02048);
+    add("Rastrigin", Category::MULTIMODAL, rastrigin, 0.0512);
+    add("扩展 Schaffer F6", Category::MULTIMODAL, expanded_schaffer_f6, 1.0);
+    add("Levy", Category::MULTIMODAL, levy, 0.1);
+    add("不连续 Rastrigin", Category::MULTIMODAL, noncontinuous_rastrigin, 0.0512);
+    add("修正 Schwefel", Category::MULTIMODAL, modified_schwefel, 10.0);
+    add("Ackley", Category::MULTIMODAL, ackley, 0.32);
+    auto hybrid_rng = next_rng();
+    suite.push_back(hybrid(dimension, hybrid_rng));
+    auto composition_rng = next_rng();
+    suite.push_back(composition(dimension, composition_rng));
+    add("台阶椭球", Category::PLATEAU, step_ellipsoid, 0.05);
+    auto coverage_rng = next_rng();
+    suite.push_back(quantised_coverage(dimension, coverage_rng));
+    return suite;
+}
+
+const RunRecord& BatchResult::run(int function, int solver, int seed) const {
+    return runs[(static_cast<size_t>(function) * solvers.size() + solver) * num_seeds + seed];
+}
+
+BatchResult run_batch(const std::vector<Function>& functions, const std::vector<SolverEntry>& solvers,
+                      const BatchSettings& settings) {
+    if (functions.empty() || solvers.empty()) {
+        throw std::invalid_argument("批量运行需要至少一个函数和一个求解器");
+    }
+    if (settings.num_seeds <= 0 || settings.budget_per_dimension <= 0 || settings.targets.empty()) {
+        throw std::invalid_argument("种子数、每维预算须为正，误差目标不能为空");
+    }
+    const int dim = static_cast<int>(functions[0].lower.size());
+    for (const auto& function : functions) {
+        if (function.lower.size() != dim) {
+            throw std::invalid_argument("批量运行的函数维度须相同");
+        }
+    }
+
+    BatchResult result;
+    result.dimension = dim;
+    result.budget = settings.budget_per_dimension * dim;
+    result.targets = settings.targets;
+    result.num_seeds = settings.num_seeds;
+    for (const auto& function : functions) {
+        result.functions.push_back(function.name);
+        result.categories.push_back(function.category);
+    }
+    for (const auto& solver : solvers) {
+        result.solvers.push_back(solver.name);
+    }
+
+    // 作业按 (函数, 求解器, 种子) 编号，每个作业只写自己的记录
+    const int num_solvers = static_cast<int>(solvers.size());
+    const int jobs = static_cast<int>(functions.size()) * num_solvers * settings.num_seeds;
+    result.runs.resize(jobs);
+    const auto start = std::chrono::steady_clock::now();
+    WorkPool::Pool::global().parallel_for(jobs, [&](int job) {
+        const int seed = job % settings.num_seeds;
+        const int solver = (job / settings.num_seeds) % num_solvers;
+        const int function = job / (settings.num_seeds * num_solvers);
+        const Function& f = functions[function];
+
+        Trace trace(f, result.targets, result.budget);
+        const Objective objective = [&trace](const Vector& x) { return trace.evaluate(x); };
+        const auto run_start = std::chrono::steady_clock::now();
+        solvers[solver].solve(objective, f.lower, f.upper, result.budget, settings.base_seed + seed);
+
+        RunRecord& record = result.runs[job];
+        record.function = function;
+        record.solver = solver;
+        record.seed = seed;
+        record.evaluations = trace.evaluations();
+        record.final_error = trace.best_error();
+        record.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - run_start).count();
+        record.hits.resize(result.targets.size());
+        for (size_t k = 0; k < result.targets.size(); ++k) {
+            record.hits[k] = trace.hit(k);
+        }
+    }, settings.num_threads, 1);
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+double expected_runtime(const BatchResult& result, int function, int solver, int target) {
+    double spent = 0.0;
+    int successes = 0;
+    for (int s = 0; s < result.num_seeds; ++s) {
+        const RunRecord& run = result.run(function, solver, s);
+        if (run.hits[target] > 0) {
+            spent += static_cast<double>(run.hits[target]);
+            ++successes;
+        } else {
+            spent += static_cast<double>(run.evaluations);
+        }
+    }
+    return successes > 0 ? spent / successes : std::numeric_limits<double>::infinity();
+}
+
+std::vector<EcdfPoint> ecdf(const BatchResult& result, const std::vector<int>& functions, int points_per_decade) {
+    std::vector<int> selected = functions;
+    if (selected.empty()) {
+        selected.resize(result.functions.size());
+        std::iota(selected.begin(), selected.end(), 0);
+    }
+    const double max_per_dim = static_cast<double>(result.budget) / result.dimension;
+    const int points = static_cast<int>(std::ceil(std::log10(max_per_dim) * points_per_decade)) + 1;
+    const double total = static_cast<double>(selected.size() * result.targets.size() * result.num_seeds);
+
+    std::vector<EcdfPoint> curve;
+    for (int p = 0; p < points; ++p) {
+        EcdfPoint point;
+        point.evaluations_per_dimension = std::min(max_per_dim, std::pow(10.0, static_cast<double>(p) / points_per_decade));
+        const double limit = point.evaluations_per_dimension * result.dimension;
+        for (size_t solver = 0; solver < result.solvers.size(); ++solver) {
+            int reached = 0;
+            for (int function : selected) {
+                for (int s = 0; s < result.num_seeds; ++s) {
+                    for (long long hit : result.run(function, static_cast<int>(solver), s).hits) {
+                        reached += (hit > 0 && hit <= limit) ? 1 : 0;
+                    }
+                }
+            }
+            point.fraction.push_back(reached / total);
+        }
+        curve.push_back(std::move(point));
+    }
+    return curve;
+}
+
+void print_report(const BatchResult& result, std::ostream& out, const std::vector<double>& report_targets) {
+    const auto saved_flags = out.flags();
+    const auto saved_precision = out.precision();
+    out << "维度 " << result.dimension << "，每次运行预算 " << result.budget << " 次评估，" << result.num_seeds
+        << " 个种子，" << result.runs.size() << " 次运行，墙钟 " << std::fixed << std::setprecision(1)
+        << result.seconds << " s" << std::endl;
+    out.flags(saved_flags);
+
+    // 各函数：中位最终误差与 ERT
+    std::vector<int> target_indices;
+    for (double target : report_targets) {
+        const auto it = std::find(result.targets.begin(), result.targets.end(), target);
+        if (it != result.targets.end()) {
+            target_indices.push_back(static_cast<int>(it - result.targets.begin()));
+        }
+    }
+    out << std::endl << "中位最终误差 / ERT (评估次数，- 表示没有运行达到)：" << std::endl;
+    out << std::left << std::setw(40) << "函数" << std::setw(14) << "求解器" << std::right << std::setw(12) << "中位误差";
+    for (int k : target_indices) {
+        std::ostringstream label;
+        label << "ERT(" << std::setprecision(0) << std::scientific << result.targets[k] << ")";
+        out << std::setw(14) << label.str();
+    }
+    out << std::endl;
+    for (size_t f = 0; f < result.functions.size(); ++f) {
+        for (size_t s = 0; s < result.solvers.size(); ++s) {
+            std::vector<double> errors;
+            for (int seed = 0; seed < result.num_seeds; ++seed) {
+                errors.push_back(result.run(static_cast<int>(f), static_cast<int>(s), seed).final_error);
+            }
+            std::nth_element(errors.begin(), errors.begin() + errors.size() / 2, errors.end());
+            out << std::left << std::setw(40) << (s == 0 ? result.functions[f] : "") << std::setw(14)
+                << result.solvers[s] << std::right << std::setw(12) << std::setprecision(3) << std::scientific
+                << errors[errors.size() / 2];
+            out.flags(saved_flags);
+            for (int k : target_indices) {
+                out << std::setw(14) << format_runtime(expected_runtime(result, static_cast<int>(f),
+                                                                        static_cast<int>(s), k));
+            }
+            out << std::endl;
+        }
+    }
+
+    // ECDF：全部函数与各类别
+    std::vector<std::pair<std::string, std::vector<int>>> groups = {{"全部函数", {}}};
+    for (Category category : {Category::UNIMODAL, Category::MULTIMODAL, Category::HYBRID, Category::COMPOSITION,
+                              Category::PLATEAU}) {
+        std::vector<int> members;
+        for (size_t f = 0; f < result.categories.size(); ++f) {
+            if (result.categories[f] == category) {
+                members.push_back(static_cast<int>(f));
+            }
+        }
+        if (!members.empty()) {
+            groups.push_back({category_name(category), members});
+        }
+    }
+    for (const auto& [name, members] : groups) {
+        out << std::endl << "ECDF (" << name << "，已达到的 (函数, 目标, 种子) 比例)：" << std::endl;
+        out << std::right << std::setw(12) << "评估次数/D";
+        for (const auto& solver : result.solvers) {
+            out << std::setw(14) << solver;
+        }
+        out << std::endl;
+        for (const auto& point : ecdf(result, members, 2)) {
+            out << std::setw(12) << std::setprecision(0) << std::fixed << point.evaluations_per_dimension;
+            for (double fraction : point.fraction) {
+                out << std::setw(14) << std::setprecision(3) << fraction;
+            }
+            out << std::endl;
+        }
+        out.flags(saved_flags);
+    }
+    out.precision(saved_precision);
+}
+
+void write_csv(const BatchResult& result, const std::string& prefix) {
+    std::ofstream runs(prefix + "_runs.csv");
+    if (!runs) {
+        throw std::runtime_error("无法写入 " + prefix + "_runs.csv");
+    }
+    runs << "function,category,solver,seed,evaluations,final_error,seconds";
+    for (double target : result.targets) {
+        runs << ",hit_" << target;
+    }
+    runs << "\n" << std::setprecision(17);
+    for (const auto& run : result.runs) {
+        runs << '"' << result.functions[run.function] << "\"," << category_name(result.categories[run.function])
+             << ',' << result.solvers[run.solver] << ',' << run.seed << ',' << run.evaluations << ','
+             << run.final_error << ',' << run.seconds;
+        for (long long hit : run.hits) {
+            runs << ',' << hit;
+        }
+        runs << "\n";
+    }
+
+    std::ofstream curve(prefix + "_ecdf.csv");
+    if (!curve) {
+        throw std::runtime_error("无法写入 " + prefix + "_ecdf.csv");
+    }
+    curve << "group,evaluations_per_dimension,solver,fraction\n";
+    auto write_group = [&](const std::string& name, const std::vector<int>& members) {
+        for (const auto& point : ecdf(result, members)) {
+            for (size_t s = 0; s < result.solvers.size(); ++s) {
+                curve << name << ',' << point.evaluations_per_dimension << ',' << result.solvers[s] << ','
+                      << point.fraction[s] << "\n";
+            }
+        }
+    };
+    write_group("全部函数", {});
+    for (Category category : {Category::UNIMODAL, Category::MULTIMODAL, Category::HYBRID, Category::COMPOSITION,
+                              Category::PLATEAU}) {
+        std::vector<int> members;
+        for (size_t f = 0; f < result.categories.size(); ++f) {
+            if (result.categories[f] == category) {
+                members.push_back(static_cast<int>(f));
+            }
+        }
+        if (!members.empty()) {
+            write_group(category_name(category), members);
+        }
+    }
+}
+
+} // namespace BenchmarkSuite
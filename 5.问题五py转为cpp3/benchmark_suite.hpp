@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include <Eigen/Dense>
+
+/**
+ * @brief 平移旋转基准函数集 (仿 CEC2017) 与批量多种子运行报告
+ *
+ * 每个函数在 [-100, 100]^D 上定义，自变量先平移 (最优点随机落在 [-80, 80]^D 内) 再乘随机正交矩阵，
+ * 变量之间相互耦合。除单峰、多峰、混合与组合函数外，另有台阶与量化函数模拟遮蔽目标的特点：
+ * 大片平坦区域 (没有遮蔽时目标恒为 0)、按 0.1 量化的目标值和不连续的跳变。
+ * 平移向量、旋转矩阵全部取自计数器型随机数，给定 (维度, 种子) 时函数在任何平台上都相同。
+ *
+ * 批量运行把 (函数, 求解器, 种子) 作业分派到进程级线程池并发执行，记录每次运行首次达到各误差目标时的
+ * 评估次数，汇总为 ECDF (各预算下已达到的 (函数, 目标, 种子) 比例，COCO 的做法) 和 ERT (期望运行时间)。
+ */
+namespace BenchmarkSuite {
+
+using Vector = Eigen::VectorXd;
+using Objective = std::function<double(const Vector&)>;
+
+enum class Category {
+    UNIMODAL,
+    MULTIMODAL,
+    HYBRID,         // 变量分组后各组使用不同的基函数
+    COMPOSITION,    // 多个基函数按到各自最优点的距离加权
+    PLATEAU         // 台阶、量化、大片平坦区域 (模拟 0.1 s 量化的遮蔽目标)
+};
+
+std::string category_name(Category category);
+
+struct Function {
+    std::string name;
+    Category category;
+    Objective evaluate;         // 可并行调用
+    Vector lower;
+    Vector upper;
+    Vector optimum;             // 全局最优点
+    double optimum_value;       // f(optimum)，误差 = f(x) - optimum_value
+};
+
+/**
+ * @brief 构造 D 维函数集 (dimension >= 2)
+ */
+std::vector<Function> make_suite(int dimension, uint64_t seed = 2017);
+
+/**
+ * @brief 求解器：在 [lower, upper] 上最小化 objective，评估次数不应超过 budget (超出部分不计入统计)
+ */
+using Solver = std::function<void(const Objective& objective, const Vector& lower, const Vector& upper,
+                                  long long budget, uint64_t seed)>;
+
+struct SolverEntry {
+    std::string name;
+    Solver solve;
+};
+
+struct BatchSettings {
+    long long budget_per_dimension = 10000;     // 每次运行的评估预算 = budget_per_dimension × D (CEC 惯例)
+    int num_seeds = 5;
+    uint64_t base_seed = 1;                     // 第 s 个种子为 base_seed + s，各函数、各求解器相同
+    std::vector<double> targets = {1e2, 1e1, 1e0, 1e-1, 1e-2, 1e-3, 1e-4, 1e-5, 1e-6, 1e-7, 1e-8};
+    int num_threads = -1;                       // 同时运行的作业数上限，-1 表示线程池的全部线程
+};
+
+/**
+ * @brief 一次运行的记录
+ */
+struct RunRecord {
+    int function;
+    int solver;
+    int seed;
+    long long evaluations;          // 预算内的评估次数
+    double final_error;
+    double seconds;
+    std::vector<long long> hits;    // 首次达到 targets[k] (误差不高于该值) 时的评估次数，未达到为 -1
+};
+
+struct BatchResult {
+    int dimension = 0;
+    long long budget = 0;
+    std::vector<std::string> functions;
+    std::vector<Category> categories;
+    std::vector<std::string> solvers;
+    std::vector<double> targets;
+    int num_seeds = 0;
+    std::vector<RunRecord> runs;    // 按 (函数, 求解器, 种子) 顺序排列
+    double seconds = 0.0;           // 整批的墙钟时间
+
+    const RunRecord& run(int function, int solver, int seed) const;
+};
+
+/**
+ * @brief 并发执行全部 (函数, 求解器, 种子) 作业；作业内的求解器可以再使用线程池 (嵌套并行)
+ */
+BatchResult run_batch(const std::vector<Function>& functions, const std::vector<SolverEntry>& solvers,
+                      const BatchSettings& settings = BatchSettings());
+
+/**
+ * @brief ERT：全部运行的评估次数 (达到目标的运行记到达到时为止) 之和 / 达到目标的运行数，没有运行达到时为 infinity
+ */
+double expected_runtime(const BatchResult& result, int function, int solver, int target);
+
+/**
+ * @brief ECDF 上的一点：预算为 evaluations_per_dimension × D 时各求解器已达到的 (函数, 目标, 种子) 比例
+ */
+struct EcdfPoint {
+    double evaluations_per_dimension;
+    std::vector<double> fraction;   // 每个求解器一项
+};
+
+/**
+ * @brief 按 evaluations / D 对数等距 (每十倍 points_per_decade 个点) 取 ECDF，functions 为空时统计全部函数
+ */
+std::vector<EcdfPoint> ecdf(const BatchResult& result, const std::vector<int>& functions = {},
+                            int points_per_decade = 4);
+
+/**
+ * @brief 打印各函数的中位最终误差、ERT (只列 report_targets 中出现在 targets 里的目标) 和按类别的 ECDF
+ */
+void print_report(const BatchResult& result, std::ostream& out,
+                  const std::vector<double>& report_targets = {1e1, 1e-1, 1e-8});
+
+/**
+ * @brief 写出 prefix_runs.csv (每次运行一行) 和 prefix_ecdf.csv (全部函数与各类别的 ECDF)
+ */
+void write_csv(const BatchResult& result, const std::string& prefix);
+
+} // namespace BenchmarkSuite
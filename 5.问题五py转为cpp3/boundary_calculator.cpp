@@ -1,5 +1,6 @@
 #include "boundary_calculator.hpp"
 #include "core_objects.hpp"
+#include "scenario.hpp"
 #include <iostream>
 #include <iomanip>
 #include <cmath>
@@ -37,7 +38,8 @@ double find_max_effective_deploy_time(
 {
     CoreObjects::UAV uav(uav_id);
     CoreObjects::Missile missile(missile_id);
-    CoreObjects::TargetCylinder target(Config::TRUE_TARGET_SPECS);
+    const auto& scenario = ScenarioLoader::active();
+    CoreObjects::TargetCylinder target(scenario.target);
 
     std::cout << "开始为 UAV(" << uav_id << ") vs Missile(" << missile_id 
               << ") 计算 t_deploy 的有效上边界..." << std::endl;
@@ -52,7 +54,7 @@ double find_max_effective_deploy_time(
         // 即无人机飞行速度最大，飞行方向使投放点的x坐标最小
         // 对于FY1和M1，它们y坐标初始几乎同线，最优方向就是沿着x轴负方向飞 (angle=pi)
         double optimal_angle = M_PI;
-        uav.set_flight_strategy(Config::UAV_SPEED_MAX, optimal_angle);
+        uav.set_flight_strategy(scenario.physics.uav_speed_max, optimal_angle);
 
         bool is_any_fuse_time_valid = false;
         
@@ -21,6 +21,7 @@ constexpr double UAV_SPEED_MAX = 140.0;
 constexpr double GRENADE_INTERVAL = 1.0;
 constexpr double GRENADE_MASS = 5.0;  // 烟幕弹质量 (kg)
 constexpr double GRENADE_DRAG_FACTOR = 0.005; // 阻力因子 k = 0.5 * C_d * ρ * A
+constexpr int MAX_GRENADES_PER_UAV = 3;        // 每架无人机最多携带的烟幕弹数
 
 // --- 目标信息 ---
 struct TargetSpecs {
@@ -1,4 +1,5 @@
 #include "core_objects.hpp"
+#include "scenario.hpp"
 #include <cmath>
 #include <stdexcept>
 #include <algorithm>
@@ -58,17 +59,23 @@ void TargetCylinder::generate_full_key_points(int num_circ_samples, int num_heig
 
 // Missile Implementation
 Missile::Missile(const std::string& missile_id) : id_(missile_id) {
-    auto it = Config::MISSILES_INITIAL.find(missile_id);
-    if (it == Config::MISSILES_INITIAL.end()) {
+    const auto& registry = Registry::EntityRegistry::default_registry();
+    Registry::EntityIndex index = registry.missile_index(missile_id);
+    if (index == Registry::INVALID_INDEX) {
         throw std::runtime_error("Unknown missile ID: " + missile_id);
     }
     
-    const auto& specs = it->second;
-    start_pos_ = specs.pos;
-    speed_ = specs.speed;
-    
-    Vector3d direction_vec = specs.target - start_pos_;
-    unit_vec_ = direction_vec.normalized();
+    const auto& entry = registry.missile(index);
+    start_pos_ = entry.start_pos;
+    speed_ = entry.speed;
+    unit_vec_ = entry.unit_vec;
+}
+
+std::optional<Missile> Missile::create(const std::string& missile_id) {
+    if (Registry::EntityRegistry::default_registry().missile_index(missile_id) == Registry::INVALID_INDEX) {
+        return std::nullopt;
+    }
+    return Missile(missile_id);
 }
 
 Vector3d Missile::get_position(double t) const {
@@ -79,7 +86,8 @@ Vector3d Missile::get_position(double t) const {
 SmokeCloud::SmokeCloud(const Vector3d& detonate_pos, double detonate_time)
     : detonate_pos_(detonate_pos)
     , start_time_(detonate_time)
-    , end_time_(detonate_time + Config::CLOUD_DURATION)
+    , end_time_(detonate_time + ScenarioLoader::active().physics.cloud_duration)
+    , sink_speed_(ScenarioLoader::active().physics.cloud_sink_speed)
 {
 }
 
@@ -89,7 +97,7 @@ std::optional<Vector3d> SmokeCloud::get_center(double t) const {
     }
     
     double t_since_detonate = t - start_time_;
-    Vector3d sink_offset(0.0, 0.0, -Config::CLOUD_SINK_SPEED * t_since_detonate);
+    Vector3d sink_offset(0.0, 0.0, -sink_speed_ * t_since_detonate);
     return detonate_pos_ + sink_offset;
 }
 
@@ -99,7 +107,8 @@ Vector3d TrajectoryIntegrator::solve_trajectory(
     const Vector3d& deploy_vel, 
     double fuse_time,
     double mass,
-    double drag_factor
+    double drag_factor,
+    double gravity
 ) {
     // 使用4阶Runge-Kutta方法求解ODE
     // 状态向量: [x, y, z, vx, vy, vz]
@@ -117,16 +126,16 @@ Vector3d TrajectoryIntegrator::solve_trajectory(
         Eigen::VectorXd k1(6), k2(6), k3(6), k4(6);
         Eigen::VectorXd y_temp(6);
         
-        grenade_motion_ode(t, y, k1, mass, drag_factor);
+        grenade_motion_ode(t, y, k1, mass, drag_factor, gravity);
         
         y_temp = y + 0.5 * h * k1;
-        grenade_motion_ode(t + 0.5*h, y_temp, k2, mass, drag_factor);
+        grenade_motion_ode(t + 0.5*h, y_temp, k2, mass, drag_factor, gravity);
         
         y_temp = y + 0.5 * h * k2;
-        grenade_motion_ode(t + 0.5*h, y_temp, k3, mass, drag_factor);
+        grenade_motion_ode(t + 0.5*h, y_temp, k3, mass, drag_factor, gravity);
         
         y_temp = y + h * k3;
-        grenade_motion_ode(t + h, y_temp, k4, mass, drag_factor);
+        grenade_motion_ode(t + h, y_temp, k4, mass, drag_factor, gravity);
         
         y += h/6.0 * (k1 + 2*k2 + 2*k3 + k4);
         t += h;
@@ -140,13 +149,14 @@ void TrajectoryIntegrator::grenade_motion_ode(
     const Eigen::VectorXd& y,
     Eigen::VectorXd& dydt,
     double mass,
-    double drag_factor
+    double drag_factor,
+    double gravity
 ) {
     // y[0:3] 是位置, y[3:6] 是速度
     Vector3d velocity(y[3], y[4], y[5]);
     
     // 计算加速度
-    Vector3d gravity_accel(0.0, 0.0, -Config::G);
+    Vector3d gravity_accel(0.0, 0.0, -gravity);
     
     double speed = velocity.norm();
     Vector3d drag_accel = Vector3d::Zero();
@@ -170,7 +180,10 @@ Grenade::Grenade(const Vector3d& deploy_pos,
     , fuse_time_(fuse_time)
     , detonate_time_(deploy_time + fuse_time)
 {
-    detonate_pos_ = TrajectoryIntegrator::solve_trajectory(deploy_pos, deploy_vel, fuse_time);
+    const auto& physics = ScenarioLoader::active().physics;
+    detonate_pos_ = TrajectoryIntegrator::solve_trajectory(deploy_pos, deploy_vel, fuse_time,
+                                                           physics.grenade_mass, physics.grenade_drag_factor,
+                                                           physics.g);
 }
 
 std::unique_ptr<SmokeCloud> Grenade::generate_smoke_cloud() const {
@@ -181,12 +194,20 @@ std::unique_ptr<SmokeCloud> Grenade::generate_smoke_cloud() const {
 UAV::UAV(const std::string& uav_id) 
     : id_(uav_id), strategy_set_(false) 
 {
-    auto it = Config::UAVS_INITIAL.find(uav_id);
-    if (it == Config::UAVS_INITIAL.end()) {
+    const auto& registry = Registry::EntityRegistry::default_registry();
+    Registry::EntityIndex index = registry.uav_index(uav_id);
+    if (index == Registry::INVALID_INDEX) {
         throw std::runtime_error("Unknown UAV ID: " + uav_id);
     }
     
-    start_pos_ = it->second.pos;
+    start_pos_ = registry.uav(index).start_pos;
+}
+
+std::optional<UAV> UAV::create(const std::string& uav_id) {
+    if (Registry::EntityRegistry::default_registry().uav_index(uav_id) == Registry::INVALID_INDEX) {
+        return std::nullopt;
+    }
+    return UAV(uav_id);
 }
 
 void UAV::set_flight_strategy(double speed, double angle) {
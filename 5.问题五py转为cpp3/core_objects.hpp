@@ -45,6 +45,11 @@ class Missile {
 public:
     explicit Missile(const std::string& missile_id);
     
+    /**
+     * @brief 不抛异常的构造：未知ID返回 std::nullopt
+     */
+    static std::optional<Missile> create(const std::string& missile_id);
+    
     Vector3d get_position(double t) const;
     
     const std::string& get_id() const { return id_; }
@@ -74,6 +79,7 @@ private:
     Vector3d detonate_pos_;
     double start_time_;
     double end_time_;
+    double sink_speed_;
 };
 
 /**
@@ -89,7 +95,8 @@ public:
         const Vector3d& deploy_vel, 
         double fuse_time,
         double mass = Config::GRENADE_MASS,
-        double drag_factor = Config::GRENADE_DRAG_FACTOR
+        double drag_factor = Config::GRENADE_DRAG_FACTOR,
+        double gravity = Config::G
     );
 
 private:
@@ -101,7 +108,8 @@ private:
         const Eigen::VectorXd& y,
         Eigen::VectorXd& dydt,
         double mass,
-        double drag_factor
+        double drag_factor,
+        double gravity
     );
 };
 
@@ -136,6 +144,11 @@ class UAV {
 public:
     explicit UAV(const std::string& uav_id);
     
+    /**
+     * @brief 不抛异常的构造：未知ID返回 std::nullopt
+     */
+    static std::optional<UAV> create(const std::string& uav_id);
+    
     void set_flight_strategy(double speed, double angle);
     Vector3d get_position(double t) const;
     std::unique_ptr<Grenade> deploy_grenade(double deploy_time, double fuse_time) const;
@@ -0,0 +1,97 @@
+#include "golden_corpus.hpp"
+#include "scenario.hpp"
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace {
+
+void print_usage() {
+    std::cout << "用法:\n"
+              << "  corpus_tool generate <目录> [每问题策略数] [种子] [场景文件]  生成黄金参考语料 (默认 200000 个)\n"
+              << "  corpus_tool check <目录> [场景文件]                          用全部评估后端检查语料并按门限判定\n"
+              << "  corpus_tool gate [每问题策略数] [种子]                       在内存中生成小语料并检查 (ctest 使用)"
+              << std::endl;
+}
+
+std::string corpus_path(const std::string& directory, const GoldenCorpus::ProblemShape& shape) {
+    return directory + "/" + shape.key + ".gold";
+}
+
+/**
+ * @brief 检查一份语料并打印报告，返回是否通过门限
+ */
+bool check_one(const GoldenCorpus::Corpus& corpus) {
+    const auto reports = GoldenCorpus::check(corpus, ScenarioLoader::active());
+    GoldenCorpus::print_report(corpus, reports, std::cout);
+    const bool ok = GoldenCorpus::passes(reports, GoldenCorpus::GateSettings(), &std::cout);
+    std::cout << (ok ? "通过" : "未通过") << std::endl << std::endl;
+    return ok;
+}
+
+} // namespace
+
+/**
+ * @brief 黄金参考语料工具：生成、检查与门限判定
+ *
+ * 生成的语料每个问题形状一个 .gold 文件，参考值只与场景、种子和参考精度有关；
+ * 修改快速评估内核 (SIMD、单精度、特化形状、时间分段等) 后运行 check，任何声明逐位一致的后端出现不一致、
+ * 或误差分布超出包络时返回非零。
+ */
+int main(int argc, char* argv[]) {
+    try {
+        if (argc < 2) {
+            print_usage();
+            return 1;
+        }
+        const std::string command = argv[1];
+
+        if (command == "generate" && argc >= 3) {
+            const size_t count = argc > 3 ? std::stoull(argv[3]) : 200000;
+            const uint64_t seed = argc > 4 ? std::stoull(argv[4]) : 20240907;
+            if (argc > 5) {
+                ScenarioLoader::set_active(ScenarioLoader::load_file(argv[5]));
+            }
+            for (const auto& shape : GoldenCorpus::standard_problems()) {
+                const auto start = std::chrono::steady_clock::now();
+                const auto corpus = GoldenCorpus::generate(shape, count, seed, ScenarioLoader::active());
+                const std::string path = corpus_path(argv[2], shape);
+                GoldenCorpus::save(corpus, path);
+                std::ifstream file(path, std::ios::binary | std::ios::ate);
+                std::cout << shape.name << ": " << count << " 个策略，参考值耗时 " << std::fixed
+                          << std::setprecision(1)
+                          << std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()
+                          << " s，文件 " << static_cast<double>(file.tellg()) / (1 << 20) << " MiB -> " << path
+                          << std::endl;
+                std::cout.unsetf(std::ios::fixed);
+            }
+            return 0;
+        }
+        if (command == "check" && argc >= 3) {
+            if (argc > 3) {
+                ScenarioLoader::set_active(ScenarioLoader::load_file(argv[3]));
+            }
+            bool ok = true;
+            for (const auto& shape : GoldenCorpus::standard_problems()) {
+                ok = check_one(GoldenCorpus::load(corpus_path(argv[2], shape))) && ok;
+            }
+            return ok ? 0 : 1;
+        }
+        if (command == "gate") {
+            const size_t count = argc > 2 ? std::stoull(argv[2]) : 2000;
+            const uint64_t seed = argc > 3 ? std::stoull(argv[3]) : 20240907;
+            bool ok = true;
+            for (const auto& shape : GoldenCorpus::standard_problems()) {
+                ok = check_one(GoldenCorpus::generate(shape, count, seed, ScenarioLoader::active())) && ok;
+            }
+            return ok ? 0 : 1;
+        }
+        print_usage();
+        return 1;
+    } catch (const std::exception& e) {
+        std::cerr << "语料工具出错: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cmath>
+
+namespace CounterRNG {
+
+/**
+ * @brief Philox4x32-10 计数器型随机数生成器 (Salmon et al., SC'11)
+ *
+ * 输出只由 (key, counter) 决定，没有内部状态需要在线程间共享或传递：
+ * 同一个 (种子, 流, 子流, 抽样序号) 在任何线程、任何调度下都得到相同的数。
+ */
+class Philox4x32 {
+public:
+    using Counter = std::array<uint32_t, 4>;
+    using Key = std::array<uint32_t, 2>;
+
+    static Counter generate(Counter ctr, Key key) {
+        for (int round = 0; round < 10; ++round) {
+            ctr = single_round(ctr, key);
+            key[0] += W0;
+            key[1] += W1;
+        }
+        return ctr;
+    }
+
+private:
+    static constexpr uint32_t M0 = 0xD2511F53u;
+    static constexpr uint32_t M1 = 0xCD9E8D57u;
+    static constexpr uint32_t W0 = 0x9E3779B9u;
+    static constexpr uint32_t W1 = 0xBB67AE85u;
+
+    static Counter single_round(const Counter& ctr, const Key& key) {
+        uint64_t p0 = static_cast<uint64_t>(M0) * ctr[0];
+        uint64_t p1 = static_cast<uint64_t>(M1) * ctr[2];
+        uint32_t hi0 = static_cast<uint32_t>(p0 >> 32), lo0 = static_cast<uint32_t>(p0);
+        uint32_t hi1 = static_cast<uint32_t>(p1 >> 32), lo1 = static_cast<uint32_t>(p1);
+        return {hi1 ^ ctr[1] ^ key[0], lo1, hi0 ^ ctr[3] ^ key[1], lo0};
+    }
+};
+
+/**
+ * @brief 由 (种子, 流, 子流) 确定的随机数流，按抽样序号递增计数器
+ *
+ * 典型用法：流 = 代数或样本编号，子流 = 个体编号，抽样序号在流内自增。
+ */
+class CounterRng {
+public:
+    CounterRng(uint64_t seed, uint64_t stream, uint32_t substream = 0)
+        : key_{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)},
+          ctr_{0u, substream, static_cast<uint32_t>(stream), static_cast<uint32_t>(stream >> 32)} {}
+
+    uint32_t next_u32() {
+        if (buffer_pos_ == 4) {
+            buffer_ = Philox4x32::generate(ctr_, key_);
+            ++ctr_[0];
+            buffer_pos_ = 0;
+        }
+        return buffer_[buffer_pos_++];
+    }
+
+    /**
+     * @brief (0, 1) 开区间上的均匀分布，使用52位精度
+     */
+    double uniform() {
+        const uint32_t hi = next_u32();
+        const uint32_t lo = next_u32();
+        return to_unit(hi, lo);
+    }
+
+    /**
+     * @brief 两个 32 位输出映射到 (0, 1)：取高 52 位再加半格，最大值 1 - 2^-53 可精确表示，不会舍入到 1
+     */
+    static double to_unit(uint32_t hi, uint32_t lo) {
+        const uint64_t bits = ((static_cast<uint64_t>(hi) << 32) | lo) >> 12;
+        return (static_cast<double>(bits) + 0.5) * 0x1p-52;
+    }
+
+    double uniform(double lower, double upper) {
+        return lower + (upper - lower) * uniform();
+    }
+
+    /**
+     * @brief [0, n) 上的均匀整数
+     */
+    uint32_t uniform_int(uint32_t n) {
+        return static_cast<uint32_t>(uniform() * n);
+    }
+
+    /**
+     * @brief 标准正态分布 (Box-Muller)，成对生成并缓存第二个值
+     */
+    double normal() {
+        if (has_spare_) {
+            has_spare_ = false;
+            return spare_;
+        }
+        double u1 = uniform();
+        double u2 = uniform();
+        double r = std::sqrt(-2.0 * std::log(u1));
+        double theta = 2.0 * M_PI * u2;
+        spare_ = r * std::sin(theta);
+        has_spare_ = true;
+        return r * std::cos(theta);
+    }
+
+    double normal(double mean, double stddev) {
+        return mean + stddev * normal();
+    }
+
+    /**
+     * @brief 柯西分布 (SHADE 系列采样 F 时使用)
+     */
+    double cauchy(double location, double scale) {
+        return location + scale * std::tan(M_PI * (uniform() - 0.5));
+    }
+
+private:
+    Philox4x32::Key key_;
+    Philox4x32::Counter ctr_;
+    Philox4x32::Counter buffer_{};
+    int buffer_pos_ = 4;
+    double spare_ = 0.0;
+    bool has_spare_ = false;
+};
+
+} // namespace CounterRNG
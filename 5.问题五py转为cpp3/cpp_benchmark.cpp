@@ -4,6 +4,10 @@
 #include <vector>
 #include <random>
 #include <cmath>
+#include <iomanip>
+#include <fstream>
+#include <numeric>
+#include <thread>
 
 using namespace OptimizerWrapper;
 using namespace HighPerformanceDE;
@@ -389,7 +393,7 @@ int main() {
         std::cout << "🔬 高性能C++自适应差分进化算法基准测试" << std::endl;
         std::cout << std::string(60, '=') << std::endl;
         
-        Utils::print_system_info();
+        OptimizerWrapper::Utils::print_system_info();
         
         // 基础函数测试
         test_difficult_functions();
@@ -1,4 +1,5 @@
 #include "cpp_optimizer_wrapper.hpp"
+#include "cpu_dispatch.hpp"
 #include <iostream>
 #include <fstream>
 #include <iomanip>
@@ -308,8 +309,8 @@ SimpleOptimizationResult Problem5CppOptimizer::optimize(const SimpleSettings& se
         auto internal_settings = settings.to_internal_settings();
         
         // 创建优化器
-        auto lower_bounds = Utils::bounds_to_lower(bounds_);
-        auto upper_bounds = Utils::bounds_to_upper(bounds_);
+        auto lower_bounds = HighPerformanceDE::Utils::bounds_to_lower(bounds_);
+        auto upper_bounds = HighPerformanceDE::Utils::bounds_to_upper(bounds_);
         
         HighPerformanceDE::HighPerformanceAdaptiveDE optimizer(
             [this](const HighPerformanceDE::Vector& x) { return (*objective_)(x); },
@@ -659,15 +660,9 @@ void print_system_info() {
     std::cout << "  CPU核心数: " << std::thread::hardware_concurrency() << std::endl;
     std::cout << "  OpenMP线程数: " << omp_get_max_threads() << std::endl;
     
-    #ifdef __AVX2__
-    std::cout << "  SIMD支持: AVX2" << std::endl;
-    #elif defined(__AVX__)
-    std::cout << "  SIMD支持: AVX" << std::endl;
-    #elif defined(__SSE2__)
-    std::cout << "  SIMD支持: SSE2" << std::endl;
-    #else
-    std::cout << "  SIMD支持: 无" << std::endl;
-    #endif
+    // SIMD 内核按运行时检测结果分派，与编译选项无关
+    std::cout << "  SIMD支持: " << CpuDispatch::isa_name(CpuDispatch::detected())
+              << " (使用 " << CpuDispatch::isa_name(CpuDispatch::active()) << ")" << std::endl;
     
     std::cout << "  Eigen版本: " << EIGEN_WORLD_VERSION << "." 
               << EIGEN_MAJOR_VERSION << "." << EIGEN_MINOR_VERSION << std::endl;
@@ -1,9 +1,40 @@
 #include "cpp_optimizer_wrapper.hpp"
+#include "cpu_dispatch.hpp"
+#include "simd_kernels.hpp"
+#include "work_pool.hpp"
+#include "job_scheduler.hpp"
+#include "eval_log.hpp"
+#include "optimizer.hpp"
+#include "portfolio.hpp"
+#include "benchmark_suite.hpp"
+#include "golden_corpus.hpp"
+#include "eval_service.hpp"
+#include "trajectory_exporter.hpp"
+#include "geometry.hpp"
+#include "solve_problem_5.hpp"
+#include "robust_objective.hpp"
+#include "scenario_generator.hpp"
+#include "batch_results.hpp"
 #include <iostream>
 #include <cassert>
 #include <cmath>
 #include <vector>
 #include <chrono>
+#include <cstdio>
+#include <set>
+#include <fstream>
+#include <iterator>
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <cstring>
+#include <omp.h>
+#include <unistd.h>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <filesystem>
 
 using namespace OptimizerWrapper;
 using namespace HighPerformanceDE;
@@ -89,25 +120,187 @@ double constrained_function(const Vector& x) {
     return result;
 }
 
+void test_counter_rng() {
+    test_framework.start_test("CounterRng计数器随机数");
+    
+    // 全 1 输出映射到小于 1 的最大值，全 0 输出大于 0
+    const double top = CounterRNG::CounterRng::to_unit(0xFFFFFFFFu, 0xFFFFFFFFu);
+    test_framework.assert_true(top < 1.0 && top == 1.0 - 0x1p-53, "全1输出不舍入到1");
+    test_framework.assert_true(CounterRNG::CounterRng::to_unit(0u, 0u) > 0.0, "全0输出大于0");
+    const uint32_t n = 0xFFFFFFFFu;
+    test_framework.assert_true(static_cast<uint32_t>(top * n) == n - 1, "uniform_int不会返回n");
+    
+    // 同一 (种子, 流, 子流) 的序列可复现，uniform_int 落在 [0, n)
+    CounterRNG::CounterRng a(11, 3, 2), b(11, 3, 2);
+    bool same = true, in_range = true;
+    for (int k = 0; k < 1000; ++k) {
+        const double u = a.uniform();
+        same = same && u == b.uniform();
+        in_range = in_range && u > 0.0 && u < 1.0 && a.uniform_int(7) < 7u;
+        b.uniform_int(7);
+    }
+    test_framework.assert_true(same, "序列可复现");
+    test_framework.assert_true(in_range, "取值范围");
+    
+    test_framework.pass();
+}
+
 void test_adaptive_parameter_manager() {
     test_framework.start_test("AdaptiveParameterManager基础功能");
     
-    AdaptiveParameterManager manager(10, 42);
+    AdaptiveParameterManager manager(6);
     
-    // 测试初始参数生成
-    auto [F1, CR1] = manager.generate_parameters();
-    test_framework.assert_true(F1 >= 0.0 && F1 <= 2.0, "F参数范围检查");
+    // 测试初始参数生成 (从只读快照抽样)
+    CounterRNG::CounterRng rng(42, 0);
+    auto [F1, CR1] = manager.snapshot().generate_parameters(rng);
+    test_framework.assert_true(F1 > 0.0 && F1 <= 1.0, "F参数范围检查");
     test_framework.assert_true(CR1 >= 0.0 && CR1 <= 1.0, "CR参数范围检查");
     
-    // 测试成功参数添加和更新
-    manager.add_success(0.8, 0.7, MutationStrategy::RAND_1);
-    manager.add_success(0.6, 0.5, MutationStrategy::BEST_1);
-    manager.update_parameters();
+    // 测试成功参数合并：加权 Lehmer 均值写入一个记忆槽
+    manager.merge({{1, 0.6, 0.5, MutationStrategy::BEST_1, 1.0, true},
+                   {0, 0.8, 0.7, MutationStrategy::RAND_1, 1.0, true},
+                   {2, 0.3, 0.2, MutationStrategy::RAND_2, 0.0, false}});
+    test_framework.assert_near(manager.snapshot().memory_F[0], (0.64 + 0.36) / 1.4, 1e-12, "记忆槽F为Lehmer均值");
+    test_framework.assert_near(manager.snapshot().memory_CR[0], 0.6, 1e-12, "记忆槽CR为加权均值");
     
     auto [F2, CR2] = manager.get_current_means();
     test_framework.assert_true(F2 > 0.0, "参数更新后F有效");
     test_framework.assert_true(CR2 > 0.0, "参数更新后CR有效");
     
+    // 各线程缓冲区的合并结果与线程划分无关
+    WorkPool::PoolOptions pool_options;
+    pool_options.num_threads = 4;
+    pool_options.pin_threads = false;
+    WorkPool::Pool pool(pool_options);
+    AdaptiveParameterManager serial(6), parallel(6);
+    WorkPool::WorkerLocal<AdaptiveParameterManager::OutcomeBuffer> buffers(pool);
+    std::vector<AdaptiveParameterManager::Outcome> outcomes;
+    for (int i = 0; i < 200; ++i) {
+        outcomes.push_back({i, 0.1 + 0.004 * i, 0.005 * i, static_cast<MutationStrategy>(i % 5), 0.01 * (i % 7), i % 3 == 0});
+    }
+    pool.parallel_for(200, [&](int i) { buffers.local().outcomes.push_back(outcomes[i]); }, -1, 1);
+    serial.merge(outcomes);
+    parallel.merge(buffers);
+    test_framework.assert_true(serial.snapshot().memory_F == parallel.snapshot().memory_F &&
+                               serial.snapshot().memory_CR == parallel.snapshot().memory_CR &&
+                               serial.get_strategy_rates() == parallel.get_strategy_rates(), "并行合并结果一致");
+    
+    test_framework.pass();
+}
+
+void test_de_variants() {
+    test_framework.start_test("JADE/L-SHADE/jSO 变体");
+    
+    using Outcome = AdaptiveParameterManager::Outcome;
+    const auto P = MutationStrategy::CURRENT_TO_PBEST_1;
+    
+    // JADE：单个记忆槽按 c = 0.1 向不加权的 Lehmer 均值 / 算术均值移动
+    AdaptiveParameterManager jade(6, 0.1, true, DEVariant::JADE);
+    test_framework.assert_true(jade.snapshot().memory_F.size() == 1, "JADE只有一个记忆槽");
+    jade.merge({Outcome{0, 0.6, 0.4, P, 5.0, true}, Outcome{1, 0.8, 0.8, P, 1.0, true}});
+    test_framework.assert_near(jade.snapshot().memory_F[0], 0.9 * 0.5 + 0.1 * (1.0 / 1.4), 1e-12, "JADE的μ_F");
+    test_framework.assert_near(jade.snapshot().memory_CR[0], 0.9 * 0.5 + 0.1 * 0.6, 1e-12, "JADE的μ_CR");
+    
+    // L-SHADE：成功的 CR 全为 0 时记忆槽变为终止值，此后从该槽抽样的 CR 恒为 0
+    AdaptiveParameterManager lshade(1, 0.1, true, DEVariant::LSHADE);
+    lshade.merge({Outcome{0, 0.5, 0.0, P, 1.0, true}, Outcome{1, 0.7, 0.9, P, 1.0, false}});
+    CounterRNG::CounterRng rng(7, 0);
+    bool all_zero = true;
+    for (int k = 0; k < 100; ++k) {
+        all_zero = all_zero && lshade.snapshot().generate_parameters(rng).second == 0.0;
+    }
+    test_framework.assert_true(all_zero, "L-SHADE终止CR");
+    
+    // jSO：5 个槽，最后一个固定为 0.9；新值与旧值取平均；前期 F 不超过 0.7、CR 不低于 0.7
+    AdaptiveParameterManager jso(6, 0.1, true, DEVariant::JSO);
+    test_framework.assert_true(jso.snapshot().memory_F.size() == 5, "jSO的记忆槽数");
+    for (int g = 0; g < 6; ++g) {
+        jso.merge({Outcome{0, 0.5, 0.5, P, 1.0, true}});
+    }
+    test_framework.assert_near(jso.snapshot().memory_F[4], 0.9, 1e-12, "jSO固定槽不更新");
+    test_framework.assert_near(jso.snapshot().memory_F[2], 0.5 * (0.5 + 0.3), 1e-12, "jSO新旧值平均");
+    jso.set_progress(0.1);
+    bool clamped = true;
+    for (int k = 0; k < 100; ++k) {
+        const auto [F, CR] = jso.snapshot().generate_parameters(rng);
+        clamped = clamped && F <= 0.7 && CR >= 0.7;
+    }
+    test_framework.assert_true(clamped, "jSO前期参数约束");
+    
+    // 各变体在评估预算内求解4维二次函数；L-SHADE 种群按评估次数缩减，结果与种子一一对应
+    Vector lower = Vector::Constant(4, -5.0), upper = Vector::Constant(4, 5.0);
+    for (DEVariant variant : {DEVariant::JADE, DEVariant::LSHADE, DEVariant::JSO}) {
+        AdaptiveDESettings settings;
+        settings.variant = variant;
+        settings.max_evaluations = 20000;
+        settings.max_iterations = 100000;
+        settings.max_stagnant_generations = 100000;
+        settings.tolerance = 0.0;
+        settings.verbose = false;
+        settings.random_seed = 11;
+        HighPerformanceAdaptiveDE optimizer(quadratic_function, lower, upper, settings);
+        auto result = optimizer.optimize();
+        const std::string name = variant_name(variant);
+        test_framework.assert_near(result.best_fitness, 0.0, 1e-8, name + " 找到最优");
+        test_framework.assert_true(result.performance_stats.total_evaluations <= 20000 + 100, name + " 评估预算");
+        if (variant == DEVariant::LSHADE) {
+            test_framework.assert_true(optimizer.get_population().size() < 72, "L-SHADE种群缩减");
+        }
+        HighPerformanceAdaptiveDE again(quadratic_function, lower, upper, settings);
+        test_framework.assert_true(again.optimize().best_fitness == result.best_fitness, name + " 可复现");
+    }
+    
+    test_framework.pass();
+}
+
+void test_thread_count_determinism() {
+    test_framework.start_test("线程数不影响优化结果");
+    
+    // 同一种子在 1 个线程与 4 个线程的私有线程池上运行，最优解与适应度逐位相同
+    WorkPool::Pool one(WorkPool::PoolOptions{1});
+    WorkPool::Pool four(WorkPool::PoolOptions{4});
+    auto same_bits = [](const Vector& a, double fa, const Vector& b, double fb) {
+        return a.size() == b.size() && std::memcmp(&fa, &fb, sizeof(double)) == 0 &&
+               std::memcmp(a.data(), b.data(), sizeof(double) * a.size()) == 0;
+    };
+    // 多峰函数，各代的选择结果对评估顺序敏感
+    auto rastrigin = [](const Vector& x) {
+        return 10.0 * x.size() + (x.array().square() - 10.0 * (2.0 * M_PI * x.array()).cos()).sum();
+    };
+    
+    Vector lower = Vector::Constant(6, -5.12), upper = Vector::Constant(6, 5.12);
+    for (DEVariant variant : {DEVariant::MULTI_STRATEGY, DEVariant::LSHADE}) {
+        AdaptiveDESettings settings;
+        settings.variant = variant;
+        settings.max_iterations = 80;
+        settings.max_stagnant_generations = 1000;
+        settings.tolerance = 0.0;
+        settings.verbose = false;
+        settings.random_seed = 9;
+        settings.pool = &one;
+        const auto serial = HighPerformanceAdaptiveDE(rastrigin, lower, upper, settings).optimize();
+        settings.pool = &four;
+        const auto parallel = HighPerformanceAdaptiveDE(rastrigin, lower, upper, settings).optimize();
+        test_framework.assert_true(same_bits(serial.best_solution, serial.best_fitness,
+                                             parallel.best_solution, parallel.best_fitness) &&
+                                   serial.iterations == parallel.iterations,
+                                   variant_name(variant) + " 1线程与4线程结果逐位相同");
+    }
+    
+    const std::vector<Optimizer::Bounds> bounds(6, Optimizer::Bounds(-5.12, 5.12));
+    Optimizer::DESettings settings;
+    settings.population_size = 40;
+    settings.max_iterations = 100;
+    settings.tolerance = 0.0;
+    settings.verbose = false;
+    settings.seed = 9;
+    settings.pool = &one;
+    const auto [serial_best, serial_fitness] = Optimizer::DifferentialEvolution::optimize(rastrigin, bounds, settings);
+    settings.pool = &four;
+    const auto [parallel_best, parallel_fitness] = Optimizer::DifferentialEvolution::optimize(rastrigin, bounds, settings);
+    test_framework.assert_true(same_bits(serial_best, serial_fitness, parallel_best, parallel_fitness),
+                               "经典DE 1线程与4线程结果逐位相同");
+    
     test_framework.pass();
 }
 
@@ -134,6 +327,1229 @@ void test_boundary_processor() {
     test_framework.pass();
 }
 
+void test_simd_dispatch() {
+    test_framework.start_test("SIMD内核各指令集档位");
+    
+    // 本机支持的每个档位都强制走一遍，结果须与 std::clamp 逐位相同 (覆盖各种尾部长度与非对齐起点)
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> dist(-3.0, 3.0);
+    const int levels = static_cast<int>(CpuDispatch::detected());
+    for (int level = 0; level <= levels; ++level) {
+        CpuDispatch::force(static_cast<CpuDispatch::IsaLevel>(level));
+        test_framework.assert_true(CpuDispatch::active() == static_cast<CpuDispatch::IsaLevel>(level), "强制档位生效");
+        for (int dim = 1; dim <= 37; ++dim) {
+            std::vector<double> x(dim + 1), lower(dim + 1), upper(dim + 1);
+            for (int i = 0; i <= dim; ++i) {
+                lower[i] = -1.0 - dist(rng) * dist(rng) / 9.0;
+                upper[i] = lower[i] + 2.0;
+                x[i] = dist(rng);
+            }
+            std::vector<double> expected(x);
+            for (int i = 1; i <= dim; ++i) {
+                expected[i] = std::clamp(x[i], lower[i], upper[i]);
+            }
+            SimdKernels::clamp(x.data() + 1, lower.data() + 1, upper.data() + 1, dim);
+            test_framework.assert_true(x == expected, std::string("截断结果 (") +
+                                       CpuDispatch::isa_name(CpuDispatch::active()) + ")");
+        }
+    }
+    CpuDispatch::force(CpuDispatch::IsaLevel::AVX512);
+    test_framework.assert_true(CpuDispatch::active() == CpuDispatch::detected(), "强制档位不超过检测结果");
+    CpuDispatch::reset();
+    
+    // BoundaryProcessor::process_simd 使用同一内核
+    Vector lower(5), upper(5), individual(5);
+    lower << -2.0, -1.0, 0.0, 1.0, -4.0;
+    upper << 2.0, 1.0, 5.0, 3.0, 4.0;
+    individual << -5.0, 0.5, 10.0, 2.0, -4.5;
+    BoundaryProcessor processor(lower, upper, BoundaryHandling::CLIP, 42);
+    processor.process_simd(individual);
+    test_framework.assert_near(individual[0], -2.0, 0.0, "下边界截断");
+    test_framework.assert_near(individual[1], 0.5, 0.0, "界内不变");
+    test_framework.assert_near(individual[2], 5.0, 0.0, "上边界截断");
+    test_framework.assert_near(individual[4], -4.0, 0.0, "下边界截断");
+    
+    test_framework.pass();
+}
+
+void test_work_pool() {
+    test_framework.start_test("WorkPool工作窃取线程池");
+    
+    WorkPool::PoolOptions options;
+    options.num_threads = 4;
+    WorkPool::Pool pool(options);
+    test_framework.assert_true(pool.num_threads() == 4, "线程总数含调用线程");
+    bool unpinned = true;
+    for (int w = 0; w < pool.num_threads() - 1; ++w) {
+        unpinned = unpinned && pool.worker_cpu(w) == -1;
+    }
+    test_framework.assert_true(unpinned, "默认不绑定 CPU");
+    
+    // 每个下标恰好执行一次 (各种粒度与并发上限)
+    for (int grain : {0, 1, 7}) {
+        for (int max_threads : {-1, 1, 2}) {
+            std::vector<std::atomic<int>> hits(1000);
+            pool.parallel_for(1000, [&](int i) { hits[i].fetch_add(1); }, max_threads, grain);
+            bool exactly_once = true;
+            for (auto& h : hits) {
+                exactly_once = exactly_once && h.load() == 1;
+            }
+            test_framework.assert_true(exactly_once, "每个下标恰好执行一次");
+        }
+    }
+    
+    // 工作线程内嵌套调用，每线程计数合并后等于总数
+    WorkPool::WorkerLocal<long> counts(pool, 0);
+    pool.parallel_for(40, [&](int) {
+        pool.parallel_for(25, [&](int) { ++counts.local(); });
+    });
+    long total = 0;
+    counts.for_each([&](long n) { total += n; });
+    test_framework.assert_true(total == 1000, "嵌套调用与每线程计数");
+    
+    // 异常在调用线程重新抛出，之后线程池仍可使用
+    bool thrown = false;
+    try {
+        pool.parallel_for(100, [](int i) {
+            if (i == 37) throw std::runtime_error("任务出错");
+        });
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    test_framework.assert_true(thrown, "任务异常传回调用线程");
+    std::atomic<int> after{0};
+    pool.parallel_for(10, [&](int) { after.fetch_add(1); });
+    test_framework.assert_true(after.load() == 10, "异常后线程池可继续使用");
+    
+    test_framework.pass();
+}
+
+void test_job_scheduler() {
+    test_framework.start_test("JobScheduler共享作业调度器");
+    
+    using JobScheduler::JobStatus;
+    
+    // 调度器在私有线程池上运行 (两个工作线程)，不另起线程
+    WorkPool::Pool pool(WorkPool::PoolOptions{3});
+    
+    // 单个工作线程先被一个阻塞任务占住，其余作业的任务全部排队后再放行，执行顺序即 pick 的选择顺序
+    struct Gate {
+        std::promise<void> entered;
+        std::promise<void> open;
+        std::shared_future<void> opened = open.get_future().share();
+        std::unique_ptr<JobScheduler::Job> job;
+        std::thread thread;
+        
+        explicit Gate(JobScheduler::Scheduler& scheduler) : job(scheduler.submit({"gate"})) {
+            std::future<void> running = entered.get_future();
+            thread = std::thread([this] {
+                job->parallel_for(1, [this](int) {
+                    entered.set_value();
+                    opened.wait();
+                }, 1);
+            });
+            running.wait();   // 工作线程已被占住
+        }
+        void release() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));   // 等各调用线程的批次入队
+            open.set_value();
+            thread.join();
+        }
+    };
+    
+    {
+        JobScheduler::Scheduler scheduler(pool, 1);
+        Gate gate(scheduler);
+        const auto now = JobScheduler::Clock::now();
+        std::vector<std::unique_ptr<JobScheduler::Job>> jobs;
+        jobs.push_back(scheduler.submit({"low", 0}));
+        jobs.push_back(scheduler.submit({"late", 1, now + std::chrono::seconds(20)}));
+        jobs.push_back(scheduler.submit({"high", 2}));
+        jobs.push_back(scheduler.submit({"early", 1, now + std::chrono::seconds(10)}));
+        std::mutex order_mutex;
+        std::string order;
+        std::vector<std::thread> callers;
+        for (auto& job : jobs) {
+            callers.emplace_back([&, j = job.get()] {
+                j->parallel_for(2, [&](int) {
+                    std::lock_guard<std::mutex> lock(order_mutex);
+                    order += j->options().name + " ";
+                }, 1);
+            });
+        }
+        gate.release();
+        for (auto& caller : callers) {
+            caller.join();
+        }
+        test_framework.assert_true(order == "high high early early late late low low ", "优先级与截止时间顺序");
+    }
+    
+    // 公平份额：同优先级时按占用时间 / 权重最少者优先，权重 3 的作业约占 3/4
+    {
+        JobScheduler::Scheduler scheduler(pool, 1);
+        Gate gate(scheduler);
+        JobScheduler::JobOptions heavy_options;
+        heavy_options.name = "heavy";
+        heavy_options.weight = 3.0;
+        auto heavy = scheduler.submit(heavy_options);
+        auto light = scheduler.submit({"light"});
+        std::mutex order_mutex;
+        std::string order;
+        auto run = [&](JobScheduler::Job& job, char tag) {
+            job.parallel_for(40, [&](int) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                std::lock_guard<std::mutex> lock(order_mutex);
+                order.push_back(tag);
+            }, 1);
+        };
+        std::thread heavy_caller(run, std::ref(*heavy), 'h');
+        std::thread light_caller(run, std::ref(*light), 'l');
+        gate.release();
+        heavy_caller.join();
+        light_caller.join();
+        const auto heavy_first = std::count(order.begin(), order.begin() + 20, 'h');
+        test_framework.assert_true(order.size() == 80 && heavy_first >= 12 && heavy_first <= 18, "按权重分配工作线程时间");
+        test_framework.assert_true(heavy->stats().tasks_completed == 40 && light->stats().tasks_completed == 40 &&
+                                   scheduler.busy_seconds() >= heavy->stats().busy_seconds + light->stats().busy_seconds,
+                                   "作业统计");
+    }
+    
+    JobScheduler::Scheduler scheduler(pool, 2);
+    test_framework.assert_true(scheduler.num_threads() == 2 && JobScheduler::Scheduler(pool).num_threads() == 2 &&
+                               &scheduler.pool() == &pool, "占用的工作线程数不超过线程池");
+    
+    // 取消：已在执行的任务完成，其余下标丢弃，此后的调用立即返回
+    {
+        JobScheduler::Scheduler single(pool, 1);
+        auto job = single.submit({"cancel"});
+        std::atomic<int> ran{0};
+        const JobStatus status = job->parallel_for(100, [&](int i) {
+            ++ran;
+            if (i == 10) {
+                job->cancel();
+            }
+        }, 1);
+        test_framework.assert_true(status == JobStatus::CANCELLED && ran == 11 && job->stats().tasks_completed == 11 &&
+                                   job->cancelled(), "取消后部分执行");
+        test_framework.assert_true(job->parallel_for(5, [&](int) { ++ran; }) == JobStatus::CANCELLED && ran == 11,
+                                   "取消后不再执行");
+    }
+    
+    // 截止时间：cancel_at_deadline 时到期自动取消，否则只影响排序
+    {
+        JobScheduler::JobOptions options;
+        options.name = "deadline";
+        options.deadline = JobScheduler::Clock::now() + std::chrono::milliseconds(50);
+        options.cancel_at_deadline = true;
+        auto job = scheduler.submit(options);
+        const JobStatus status = job->parallel_for(100000, [](int) {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }, 1);
+        const long long done = job->stats().tasks_completed;
+        test_framework.assert_true(status == JobStatus::DEADLINE_EXCEEDED && done > 0 && done < 100000, "到期自动取消");
+        
+        options.name = "overdue";
+        options.cancel_at_deadline = false;
+        auto overdue = scheduler.submit(options);
+        test_framework.assert_true(overdue->parallel_for(8, [](int) {}) == JobStatus::COMPLETED, "不自动取消时照常完成");
+    }
+    
+    // 暂停期间不分派新任务，恢复后完成
+    {
+        JobScheduler::Scheduler single(pool, 1);
+        auto job = single.submit({"pause"});
+        std::atomic<int> ran{0};
+        JobStatus status = JobStatus::CANCELLED;
+        std::thread caller([&] {
+            status = job->parallel_for(20, [&](int i) {
+                ++ran;
+                if (i == 4) {
+                    job->pause();
+                }
+            }, 1);
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        const int while_paused = ran.load();
+        job->resume();
+        caller.join();
+        test_framework.assert_true(while_paused == 5, "暂停后不再分派");
+        test_framework.assert_true(status == JobStatus::COMPLETED && ran == 20, "恢复后完成");
+    }
+    
+    // 任务异常：剩余任务结束后在调用线程重新抛出，作业仍可继续使用
+    {
+        auto job = scheduler.submit({"throws"});
+        bool thrown = false;
+        try {
+            job->parallel_for(10, [](int i) {
+                if (i == 3) {
+                    throw std::runtime_error("任务3失败");
+                }
+            }, 1);
+        } catch (const std::runtime_error& e) {
+            thrown = std::string(e.what()) == "任务3失败";
+        }
+        test_framework.assert_true(thrown, "异常传回调用线程");
+        std::atomic<int> ran{0};
+        test_framework.assert_true(job->parallel_for(5, [&](int) { ++ran; }) == JobStatus::COMPLETED && ran == 5,
+                                   "异常后作业可继续使用");
+    }
+    
+    // 自适应 DE 的各阶段提交到作业：结果与直接在线程池上运行时相同，作业取消后提前结束
+    {
+        Vector lower = Vector::Constant(4, -5.0), upper = Vector::Constant(4, 5.0);
+        AdaptiveDESettings settings;
+        settings.variant = DEVariant::LSHADE;
+        settings.max_iterations = 60;
+        settings.max_stagnant_generations = 1000;
+        settings.tolerance = 0.0;
+        settings.verbose = false;
+        settings.random_seed = 5;
+        const auto direct = HighPerformanceAdaptiveDE(quadratic_function, lower, upper, settings).optimize();
+        
+        auto job = scheduler.submit({"adaptive"});
+        settings.job = job.get();
+        const auto scheduled = HighPerformanceAdaptiveDE(quadratic_function, lower, upper, settings).optimize();
+        test_framework.assert_true(scheduled.best_solution == direct.best_solution &&
+                                   scheduled.best_fitness == direct.best_fitness &&
+                                   scheduled.iterations == 60 && job->stats().tasks_completed > 0,
+                                   "自适应DE经作业运行，结果不变");
+        
+        auto stopped_job = scheduler.submit({"adaptive-cancel"});
+        settings.job = stopped_job.get();
+        std::atomic<int> calls{0};
+        auto objective = [&](const Vector& x) {
+            if (++calls == 200) {
+                stopped_job->cancel();
+            }
+            return quadratic_function(x);
+        };
+        const auto stopped = HighPerformanceAdaptiveDE(objective, lower, upper, settings).optimize();
+        test_framework.assert_true(stopped.iterations < 60 && stopped.best_solution.size() == 4 &&
+                                   std::isfinite(stopped.best_fitness), "作业取消后自适应DE提前结束");
+    }
+    
+    // 参数检查
+    bool rejected_weight = false;
+    try {
+        JobScheduler::JobOptions options;
+        options.weight = 0.0;
+        scheduler.submit(options);
+    } catch (const std::invalid_argument&) {
+        rejected_weight = true;
+    }
+    bool rejected_threads = false;
+    try {
+        JobScheduler::Scheduler empty(0);
+    } catch (const std::invalid_argument&) {
+        rejected_threads = true;
+    }
+    test_framework.assert_true(rejected_weight && rejected_threads, "无效参数");
+    
+    // 线程池没有工作线程时由调用线程执行
+    {
+        WorkPool::Pool serial(WorkPool::PoolOptions{1});
+        JobScheduler::Scheduler inline_scheduler(serial);
+        auto job = inline_scheduler.submit({"inline"});
+        const std::thread::id caller = std::this_thread::get_id();
+        std::atomic<int> on_caller{0};
+        test_framework.assert_true(job->parallel_for(10, [&](int) {
+            on_caller += std::this_thread::get_id() == caller;
+        }) == JobStatus::COMPLETED && on_caller == 10, "无工作线程时调用线程执行");
+    }
+    
+    // 作业内的嵌套并行 (评估器按时间分段) 落在同一个线程池上：进程中不会多出池外的线程
+    {
+        auto live_threads = [] {
+            return static_cast<long long>(std::distance(std::filesystem::directory_iterator("/proc/self/task"),
+                                                        std::filesystem::directory_iterator()));
+        };
+        const auto& scenario = ScenarioLoader::active();
+        std::vector<Registry::EntityIndex> missiles(scenario.entities.num_missiles());
+        std::iota(missiles.begin(), missiles.end(), 0);
+        FastEvaluator::ObscurationEvaluator evaluator(missiles, scenario, 0.001);
+        Optimizer::FlatStrategy flat(1);
+        flat[0].uav = scenario.entities.uav_index("FY1");
+        flat[0].num_grenades = 3;
+        flat[0].speed = 139.6956;
+        flat[0].angle = 3.1338;
+        flat[0].grenades[0] = {0.2281, 3.7869};
+        flat[0].grenades[1] = {3.3818, 5.2772};
+        flat[0].grenades[2] = {4.8330, 5.9929};
+        std::vector<FastEvaluator::CloudState> clouds;
+        FastEvaluator::try_build_clouds(flat, clouds, scenario);
+        std::vector<double> expected(missiles.size());
+        evaluator.evaluate(clouds, expected.data());
+        evaluator.set_time_chunks(-1);
+        
+        WorkPool::Pool::global();
+        const long long before = live_threads();
+        const int pool_size = 4;
+        std::vector<std::vector<double>> results(12, std::vector<double>(missiles.size()));
+        std::atomic<int> running{0};
+        std::atomic<int> max_running{0};
+        std::atomic<long long> max_threads{0};
+        std::atomic<bool> nested_on_pool{true};
+        std::atomic<int> chunks{0};
+        JobStatus status = JobStatus::CANCELLED;
+        {
+            WorkPool::Pool shared(WorkPool::PoolOptions{pool_size});
+            JobScheduler::Scheduler on_shared(shared);
+            auto job = on_shared.submit({"chunks"});
+            status = job->parallel_for(static_cast<int>(results.size()), [&](int i) {
+                const int now = ++running;
+                for (int seen = max_running; now > seen && !max_running.compare_exchange_weak(seen, now);) {}
+                if (&WorkPool::Pool::current() != &shared) {
+                    nested_on_pool = false;
+                }
+                chunks = evaluator.plan_time_chunks(clouds, 60000);
+                evaluator.evaluate(clouds, results[i].data());
+                const long long threads = live_threads();
+                for (long long seen = max_threads; threads > seen && !max_threads.compare_exchange_weak(seen, threads);) {}
+                --running;
+            }, 1);
+        }
+        bool identical = true;
+        for (const auto& result : results) {
+            identical = identical && result == expected;
+        }
+        test_framework.assert_true(chunks == pool_size, "评估按线程池大小拆成多个时间段");
+        test_framework.assert_true(status == JobStatus::COMPLETED && identical && nested_on_pool, "分段评估在作业的线程池上完成");
+        test_framework.assert_true(max_running <= pool_size - 1, "作业并发数不超过工作线程数");
+        test_framework.assert_true(max_threads - before <= pool_size - 1, "线程总数不超过线程池大小");
+    }
+    
+    test_framework.pass();
+}
+
+void test_eval_log() {
+    test_framework.start_test("EvalLog异步列式评估日志");
+    
+    const std::string path = "test_eval_log.evlg";
+    std::vector<EvalLog::Compression> codecs = {EvalLog::Compression::NONE};
+    if (EvalLog::compression_available(EvalLog::Compression::ZLIB)) {
+        codecs.push_back(EvalLog::Compression::ZLIB);
+    }
+    
+    // 多线程全量记录 (小块，跨多次交块)，读回后每行的各列对应同一次评估
+    WorkPool::PoolOptions pool_options;
+    pool_options.num_threads = 4;
+    pool_options.pin_threads = false;
+    WorkPool::Pool pool(pool_options);
+    for (auto codec : codecs) {
+        EvalLog::LogOptions options;
+        options.dimension = 3;
+        options.num_outputs = 2;
+        options.block_rows = 64;
+        options.compression = codec;
+        {
+            EvalLog::Logger log(path, options);
+            pool.parallel_for(1000, [&](int i) {
+                if (log.should_record()) {
+                    const double x[3] = {double(i), 2.0 * i, 3.0 * i};
+                    const double y[2] = {i + 0.5, -double(i)};
+                    log.record(x, y, log.now_ns(), 0);
+                }
+            });
+            log.close();
+            test_framework.assert_true(log.offered() == 1000 && log.recorded() == 1000, "全量记录计数");
+        }
+        const auto data = EvalLog::read_log(path);
+        test_framework.assert_true(data.complete && data.offered == 1000 && data.rows() == 1000, "读回行数");
+        std::set<int> seen;
+        bool rows_consistent = true;
+        for (size_t r = 0; r < data.rows(); ++r) {
+            const double i = data.variables[0][r];
+            rows_consistent = rows_consistent && data.variables[1][r] == 2.0 * i && data.variables[2][r] == 3.0 * i &&
+                              data.outputs[0][r] == i + 0.5 && data.outputs[1][r] == -i;
+            seen.insert(static_cast<int>(i));
+        }
+        test_framework.assert_true(rows_consistent && seen.size() == 1000, "各列按行对齐且无重复遗漏");
+    }
+    
+    // 抽稀与抽样
+    EvalLog::LogOptions options;
+    options.dimension = 1;
+    options.decimation = 4;
+    {
+        EvalLog::Logger log(path, options);
+        for (int i = 0; i < 100; ++i) {
+            if (log.should_record()) {
+                const double x = i;
+                log.record(&x, &x, 0, 0);
+            }
+        }
+        log.close();
+        test_framework.assert_true(log.recorded() == 25, "每 4 次评估记录一次");
+    }
+    const auto decimated = EvalLog::read_log(path);
+    test_framework.assert_true(decimated.rows() == 25 && decimated.variables[0][1] == 4.0, "抽稀读回");
+    
+    options.decimation = 1;
+    options.sample_rate = 0.25;
+    {
+        EvalLog::Logger log(path, options);
+        for (int i = 0; i < 4000; ++i) {
+            if (log.should_record()) {
+                const double x = i;
+                log.record(&x, &x, 0, 0);
+            }
+        }
+        log.close();
+        test_framework.assert_true(log.recorded() > 800 && log.recorded() < 1200, "抽样比例");
+    }
+    std::remove(path.c_str());
+    
+    test_framework.pass();
+}
+
+void test_sensitivity_analysis() {
+    test_framework.start_test("Sensitivity敏感性分析");
+    
+    // x0 强非线性、x1 线性、x2 不影响目标：两种方法都应把 x2 判为低重要性
+    auto objective = [](const Eigen::VectorXd& x) { return 2.0 * x[0] * x[0] + x[1]; };
+    const Eigen::VectorXd lower = Eigen::VectorXd::Zero(3);
+    const Eigen::VectorXd upper = Eigen::VectorXd::Ones(3);
+    for (auto method : {Sensitivity::Method::MORRIS, Sensitivity::Method::SOBOL}) {
+        Sensitivity::AnalysisSettings settings;
+        settings.method = method;
+        settings.samples = method == Sensitivity::Method::MORRIS ? 20 : 256;
+        const auto analysis = Sensitivity::analyze(objective, lower, upper, settings);
+        const auto again = Sensitivity::analyze(objective, lower, upper, settings);
+        test_framework.assert_true(analysis.importance == again.importance, "同一种子结果可复现");
+        test_framework.assert_true(analysis.importance[0] > analysis.importance[1], "非线性变量最重要");
+        test_framework.assert_near(analysis.importance[2], 0.0, 1e-12, "无关变量重要性为零");
+        test_framework.assert_true(analysis.inert_variables(0.2) == std::vector<int>{2}, "低重要性变量");
+    }
+    
+    // 分阶段降维：冻结无关变量后仍找到最优
+    std::vector<Optimizer::Bounds> bounds = {{-5.0, 5.0}, {-5.0, 5.0}, {-5.0, 5.0}};
+    Optimizer::DESettings settings;
+    settings.population_size = 30;
+    settings.max_iterations = 100;
+    settings.tolerance = 0.0;
+    settings.verbose = false;
+    settings.seed = 7;
+    Sensitivity::ReductionSettings reduction;
+    reduction.analysis.samples = 10;
+    Sensitivity::Analysis analysis;
+    auto [best, fitness] = Optimizer::DifferentialEvolution::optimize_reduced(
+        [](const Eigen::VectorXd& x) { return x[0] * x[0] + x[1] * x[1]; }, bounds, settings, reduction, &analysis);
+    test_framework.assert_true(analysis.inert_variables(reduction.importance_threshold) == std::vector<int>{2},
+                               "试探解附近识别无关变量");
+    test_framework.assert_near(fitness, 0.0, 1e-6, "降维后找到最优");
+    
+    test_framework.pass();
+}
+
+void test_portfolio() {
+    test_framework.start_test("Portfolio算法组合竞速");
+    
+    // 最优解槽：多线程并发发布后保留最小值，改进链按目标值递减
+    Portfolio::IncumbentSlot slot;
+    WorkPool::Pool::global().parallel_for(1000, [&](int i) {
+        Vector x = Vector::Constant(2, i);
+        slot.offer(x, std::abs(i - 617.0));
+    });
+    test_framework.assert_true(slot.best() != nullptr && slot.best()->fitness == 0.0, "并发发布后为最小值");
+    bool decreasing = true;
+    for (auto entry = slot.best(); entry->previous != nullptr; entry = entry->previous) {
+        decreasing = decreasing && entry->fitness < entry->previous->fitness;
+    }
+    test_framework.assert_true(decreasing, "改进链单调");
+    
+    // 组合在 Rastrigin 上达到目标；份额只由评估次数决定，结果与线程数无关
+    auto rastrigin = [](const Vector& x) {
+        return 10.0 * x.size() + (x.array().square() - 10.0 * (2.0 * M_PI * x.array()).cos()).sum();
+    };
+    const Vector lower = Vector::Constant(5, -5.12), upper = Vector::Constant(5, 5.12);
+    Portfolio::Settings settings;
+    settings.max_evaluations = 40000;
+    settings.target = 1e-6;
+    settings.seed = 11;
+    auto result = Portfolio::optimize(rastrigin, lower, upper, settings);
+    test_framework.assert_true(result.reached_target && result.seconds_to_target >= 0.0, "达到目标");
+    test_framework.assert_true(result.members.size() == 4 && result.evaluations <= settings.max_evaluations + 1000,
+                               "成员与评估预算");
+    settings.num_threads = 1;
+    auto serial = Portfolio::optimize(rastrigin, lower, upper, settings);
+    test_framework.assert_true(serial.best_fitness == result.best_fitness && serial.rounds == result.rounds,
+                               "单线程结果一致");
+    
+    test_framework.pass();
+}
+
+void test_benchmark_suite() {
+    test_framework.start_test("BenchmarkSuite基准函数集");
+    
+    // 每个函数的最优点在区间内，随机点的误差非负；量化覆盖函数的取值是 0.1 的整数倍
+    const auto suite = BenchmarkSuite::make_suite(5);
+    test_framework.assert_true(suite.size() == 13, "函数个数");
+    CounterRNG::CounterRng rng(3, 0);
+    for (const auto& f : suite) {
+        test_framework.assert_true(((f.optimum - f.lower).array() >= 0.0).all() &&
+                                   ((f.upper - f.optimum).array() >= 0.0).all(), f.name + " 最优点在区间内");
+        for (int k = 0; k < 200; ++k) {
+            Vector x(5);
+            for (int i = 0; i < 5; ++i) x[i] = rng.uniform(-100.0, 100.0);
+            const double value = f.evaluate(x);
+            test_framework.assert_true(value - f.optimum_value >= -1e-9, f.name + " 误差非负");
+            if (f.category == BenchmarkSuite::Category::PLATEAU && f.name.find("覆盖") != std::string::npos) {
+                test_framework.assert_near(10.0 * value, std::round(10.0 * value), 1e-9, "量化到0.1");
+            }
+        }
+    }
+    
+    // 随机搜索的批量运行：可复现，目标越严达到越晚，ECDF 随预算单调不减
+    const std::vector<BenchmarkSuite::Function> functions(suite.begin(), suite.begin() + 4);
+    const BenchmarkSuite::SolverEntry random_search{"随机搜索",
+        [](const BenchmarkSuite::Objective& objective, const Vector& lower, const Vector& upper,
+           long long budget, uint64_t seed) {
+            CounterRNG::CounterRng search(seed, 1);
+            for (long long n = 0; n < budget; ++n) {
+                Vector x(lower.size());
+                for (int i = 0; i < x.size(); ++i) x[i] = search.uniform(lower[i], upper[i]);
+                objective(x);
+            }
+        }};
+    BenchmarkSuite::BatchSettings settings;
+    settings.budget_per_dimension = 100;
+    settings.num_seeds = 3;
+    settings.targets = {1e4, 1e3, 1e2};
+    const auto first = BenchmarkSuite::run_batch(functions, {random_search}, settings);
+    const auto second = BenchmarkSuite::run_batch(functions, {random_search}, settings);
+    test_framework.assert_true(first.runs.size() == 12, "作业数");
+    bool same = true, ordered = true;
+    for (size_t r = 0; r < first.runs.size(); ++r) {
+        same = same && first.runs[r].final_error == second.runs[r].final_error &&
+               first.runs[r].hits == second.runs[r].hits && first.runs[r].evaluations == 500;
+        for (size_t k = 1; k < first.runs[r].hits.size(); ++k) {
+            const long long looser = first.runs[r].hits[k - 1], stricter = first.runs[r].hits[k];
+            ordered = ordered && (stricter < 0 || (looser > 0 && looser <= stricter));
+        }
+    }
+    test_framework.assert_true(same, "批量运行可复现");
+    test_framework.assert_true(ordered, "更严的目标不会更早达到");
+    const auto curve = BenchmarkSuite::ecdf(first);
+    bool monotone = true;
+    for (size_t p = 1; p < curve.size(); ++p) {
+        monotone = monotone && curve[p].fraction[0] >= curve[p - 1].fraction[0];
+    }
+    test_framework.assert_true(monotone && curve.back().evaluations_per_dimension == 100.0, "ECDF单调");
+    test_framework.assert_true(std::isinf(BenchmarkSuite::expected_runtime(first, 0, 0, 2)) ||
+                               BenchmarkSuite::expected_runtime(first, 0, 0, 2) >= 1.0, "ERT");
+    
+    test_framework.pass();
+}
+
+void test_scenario_loader() {
+    test_framework.start_test("ScenarioLoader场景文件");
+    
+    const ScenarioLoader::Scenario scenario = ScenarioLoader::from_config();
+    auto rejects = [](const std::function<void()>& load, const std::string& reason) {
+        try {
+            load();
+        } catch (const std::runtime_error& e) {
+            return std::string(e.what()).find(reason) != std::string::npos;
+        }
+        return false;
+    };
+    
+    // JSON 与二进制往返后内容哈希与实体不变
+    const std::string json = ScenarioLoader::to_json(scenario);
+    const std::string binary = ScenarioLoader::to_binary(scenario);
+    const auto from_json = ScenarioLoader::parse_json(json);
+    const auto from_binary = ScenarioLoader::parse_binary(binary);
+    test_framework.assert_true(from_json.content_hash == scenario.content_hash &&
+                               from_binary.content_hash == scenario.content_hash, "往返后哈希不变");
+    test_framework.assert_true(ScenarioLoader::to_binary(from_json) == binary &&
+                               ScenarioLoader::to_json(from_binary) == json, "JSON与二进制互转一致");
+    test_framework.assert_true(from_binary.entities.num_missiles() == scenario.entities.num_missiles() &&
+                               from_binary.entities.missile(0).start_pos == scenario.entities.missile(0).start_pos &&
+                               from_binary.entities.uav(0).id == scenario.entities.uav(0).id, "实体逐项一致");
+    
+    // 二进制：改动内容后哈希校验失败，截断与多余数据被拒绝
+    const size_t first_field = 4 + 4 + 8 + 4 + scenario.name.size();   // 魔数、版本、哈希、名称之后的 g
+    std::string tampered = binary;
+    tampered[first_field] ^= 1;
+    test_framework.assert_true(rejects([&] { ScenarioLoader::parse_binary(tampered); }, "哈希校验失败"), "哈希校验");
+    test_framework.assert_true(rejects([&] { ScenarioLoader::parse_binary(binary.substr(0, binary.size() - 3)); },
+                                       "截断"), "截断文件");
+    test_framework.assert_true(rejects([&] { ScenarioLoader::parse_binary(binary + "x"); }, "多余数据"), "多余数据");
+    
+    // 重复的实体标识
+    const std::string first_missile = scenario.entities.missile(0).id;
+    const std::string second_missile = scenario.entities.missile(1).id;
+    std::string duplicated_json = json;
+    duplicated_json.replace(duplicated_json.find("\"" + second_missile + "\""), second_missile.size() + 2,
+                            "\"" + first_missile + "\"");
+    test_framework.assert_true(rejects([&] { ScenarioLoader::parse_json(duplicated_json); }, "导弹ID重复"), "JSON重复ID");
+    std::string duplicated_binary = binary;
+    const size_t id_at = duplicated_binary.find(second_missile);
+    test_framework.assert_true(first_missile.size() == second_missile.size() && id_at != std::string::npos, "定位导弹ID");
+    duplicated_binary.replace(id_at, first_missile.size(), first_missile);
+    test_framework.assert_true(rejects([&] { ScenarioLoader::parse_binary(duplicated_binary); }, "导弹ID重复"),
+                               "二进制重复ID");
+    
+    // 非有限值：JSON 中溢出的 1e999，二进制中的 NaN
+    auto with_value = [&](const std::string& key, const std::string& value) {
+        std::string text = json;
+        const size_t at = text.find(key) + key.size();
+        text.replace(at, text.find_first_of(",]}", at) - at, value);
+        return text;
+    };
+    test_framework.assert_true(rejects([&] { ScenarioLoader::parse_json(with_value("\"speed\": ", "1e999")); }, "非有限值"),
+                               "导弹速度溢出");
+    test_framework.assert_true(rejects([&] { ScenarioLoader::parse_json(with_value("\"height\": ", "-1e999")); }, "非有限值"),
+                               "目标高度溢出");
+    test_framework.assert_true(rejects([&] { ScenarioLoader::parse_json(with_value("\"target\": [", "1e999")); }, "非有限值"),
+                               "瞄准点溢出");
+    const std::string uav = scenario.entities.uav(0).id;
+    std::string nan_binary = binary;
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    nan_binary.replace(nan_binary.find(uav) + uav.size(), sizeof(nan), reinterpret_cast<const char*>(&nan), sizeof(nan));
+    test_framework.assert_true(rejects([&] { ScenarioLoader::parse_binary(nan_binary); }, "非有限值"), "无人机位置NaN");
+    
+    test_framework.pass();
+}
+
+void test_scenario_generator() {
+    test_framework.start_test("ScenarioGenerator合成场景");
+    
+    ScenarioGenerator::GeneratorSettings settings;
+    settings.num_missiles = 6;
+    settings.num_uavs = 12;
+    settings.num_aim_points = 3;
+    
+    // 同一种子逐字节相同，内容哈希与重新计算的一致
+    const auto first = ScenarioGenerator::generate(settings);
+    const auto second = ScenarioGenerator::generate(settings);
+    test_framework.assert_true(ScenarioLoader::to_binary(first) == ScenarioLoader::to_binary(second) &&
+                               ScenarioLoader::to_json(first) == ScenarioLoader::to_json(second), "同一种子逐字节相同");
+    test_framework.assert_true(first.content_hash != 0 && first.content_hash == second.content_hash &&
+                               first.content_hash == ScenarioLoader::compute_content_hash(first), "内容哈希一致");
+    settings.seed += 1;
+    test_framework.assert_true(ScenarioGenerator::generate(settings).content_hash != first.content_hash,
+                               "不同种子得到不同场景");
+    
+    // 各种规模与种子生成的场景都能通过校验，并经二进制编码往返
+    bool valid = true;
+    for (int missiles : {1, 3, 10}) {
+        for (int uavs : {1, 7, 40}) {
+            for (uint64_t seed : {1ull, 20240907ull, 987654321ull}) {
+                ScenarioGenerator::GeneratorSettings variant;
+                variant.num_missiles = missiles;
+                variant.num_uavs = uavs;
+                variant.num_aim_points = 1 + missiles % 3;
+                variant.seed = seed;
+                const auto scenario = ScenarioGenerator::generate(variant);
+                try {
+                    ScenarioLoader::validate(scenario);
+                    const auto parsed = ScenarioLoader::parse_binary(ScenarioLoader::to_binary(scenario));
+                    valid = valid && parsed.content_hash == scenario.content_hash &&
+                            parsed.entities.num_missiles() == missiles && parsed.entities.num_uavs() == uavs;
+                } catch (const std::exception&) {
+                    valid = false;
+                }
+                for (int j = 0; j < uavs; ++j) {
+                    const int budget = scenario.entities.uav(j).grenade_budget;
+                    valid = valid && budget >= 1 && budget <= ::Config::MAX_GRENADES_PER_UAV;
+                }
+            }
+        }
+    }
+    test_framework.assert_true(valid, "生成的场景通过校验");
+    
+    // 每个实体独立的随机流：增加无人机数量不改变已有无人机
+    ScenarioGenerator::GeneratorSettings small;
+    small.num_uavs = 5;
+    ScenarioGenerator::GeneratorSettings large = small;
+    large.num_uavs = 15;
+    const auto small_scenario = ScenarioGenerator::generate(small);
+    const auto large_scenario = ScenarioGenerator::generate(large);
+    bool stable = true;
+    for (int j = 0; j < small.num_uavs; ++j) {
+        stable = stable && small_scenario.entities.uav(j).start_pos == large_scenario.entities.uav(j).start_pos &&
+                 small_scenario.entities.uav(j).grenade_budget == large_scenario.entities.uav(j).grenade_budget;
+    }
+    test_framework.assert_true(stable, "增加实体不改变已有实体");
+    
+    small.num_uavs = 0;
+    bool rejected = false;
+    try {
+        ScenarioGenerator::generate(small);
+    } catch (const std::invalid_argument&) {
+        rejected = true;
+    }
+    test_framework.assert_true(rejected, "数量非正时拒绝");
+    
+    test_framework.pass();
+}
+
+void test_batch_results() {
+    test_framework.start_test("BatchResults断点续跑");
+    
+    BatchResults::Record done;
+    done.id = "job,\"a\"#1";           // 含逗号和引号，检查 CSV 转义
+    done.name = "job,\"a\"";
+    done.seed = 1;
+    done.scenario = "default";
+    done.problem = "intercept";
+    done.ok = true;
+    done.objective = 4.5;
+    done.strategy_json = "{\"M1\": {}}";
+    BatchResults::Record failed = done;
+    failed.id = "job#2";
+    failed.seed = 2;
+    failed.ok = false;
+    failed.error = "场景错误, 无法求解";
+    failed.strategy_json.clear();
+    BatchResults::Record retried = failed;
+    retried.id = "job#3";
+    retried.seed = 3;
+    BatchResults::Record retried_ok = retried;
+    retried_ok.ok = true;
+    retried_ok.error.clear();
+    retried_ok.strategy_json = done.strategy_json;
+    
+    for (const auto format : {BatchResults::OutputFormat::JSONL, BatchResults::OutputFormat::CSV}) {
+        const bool csv = format == BatchResults::OutputFormat::CSV;
+        const std::string name = csv ? "CSV" : "JSONL";
+        const std::string path = "/tmp/smoke_unit_test_" + std::to_string(::getpid()) + (csv ? ".csv" : ".jsonl");
+        std::string complete = csv ? std::string(BatchResults::CSV_HEADER) + "\n" : "";
+        for (const auto* record : {&done, &failed, &retried, &retried_ok}) {
+            complete += BatchResults::format_record(format, *record) + "\n";
+        }
+        {
+            // 模拟写到一半中断：末行只写了一部分
+            std::ofstream out(path, std::ios::binary);
+            out << complete << BatchResults::format_record(format, retried).substr(0, 20);
+        }
+        const std::set<std::string> completed = BatchResults::read_completed(path, format);
+        std::ifstream in(path, std::ios::binary);
+        const std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        in.close();
+        std::remove(path.c_str());
+        
+        test_framework.assert_true(text == complete, name + " 截掉不完整的末行");
+        test_framework.assert_true(completed.count(done.id) == 1, name + " 成功的运行视为已完成");
+        test_framework.assert_true(completed.count(failed.id) == 0, name + " 失败的运行需要重跑");
+        test_framework.assert_true(completed.count(retried.id) == 1, name + " 重跑成功后视为已完成");
+        test_framework.assert_true(completed.size() == 2, name + " 已完成的运行数");
+    }
+    
+    const std::vector<std::string> fields = BatchResults::csv_fields("\"a,\"\"b\"\"\",,c");
+    test_framework.assert_true(fields == std::vector<std::string>({"a,\"b\"", "", "c"}), "CSV 字段拆分");
+    test_framework.assert_true(BatchResults::read_completed("/tmp/smoke_unit_test_missing.jsonl",
+                                                            BatchResults::OutputFormat::JSONL).empty(),
+                               "结果文件不存在时没有已完成的运行");
+    
+    test_framework.pass();
+}
+
+void test_trajectory_exporter() {
+    test_framework.start_test("TrajectoryExporter轨迹导出");
+    
+    // 问题三的最优策略 (与 video.py 相同)，三个云团先后生效
+    TrajectoryExporter::ExportJob job;
+    job.output_path = "/tmp/smoke_unit_test_" + std::to_string(::getpid()) + ".traj";
+    job.strategy["FY1"] = {139.6956, 3.1338, {{0.2281, 3.7869}, {3.3818, 5.2772}, {4.8330, 5.9929}}};
+    job.missile_ids = {"M1"};
+    job.end_time = 30.0;
+    job.dt = 0.05;
+    TrajectoryExporter::ExportSettings settings;
+    settings.frames_per_chunk = 97;
+    settings.num_threads = 2;
+    settings.verbose = false;
+    const int max_threads = omp_get_max_threads();
+    const auto stats = TrajectoryExporter::export_trajectory(job, settings);
+    test_framework.assert_true(omp_get_max_threads() == max_threads, "不改变进程的OpenMP线程数");
+    test_framework.assert_true(stats.num_frames == 600 && stats.num_clouds == 3, "帧数与云团数");
+    
+    // 读回文件头 (魔数、头长度、字典字面量) 并按其中的偏移读取各列
+    std::ifstream file(job.output_path, std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    std::remove(job.output_path.c_str());
+    test_framework.assert_true(bytes.size() == static_cast<size_t>(stats.bytes_written) &&
+                               bytes.compare(0, 8, "\x93SMKTRJ\x01", 8) == 0, "魔数与文件大小");
+    uint32_t header_len = 0;
+    std::memcpy(&header_len, bytes.data() + 8, sizeof(header_len));
+    const std::string header = bytes.substr(12, header_len);
+    test_framework.assert_true((12 + header_len) % 64 == 0 && header.back() == '\n', "文件头按64字节对齐");
+    test_framework.assert_true(header.find("'num_frames': 600") != std::string::npos &&
+                               header.find("'missile_ids': ['M1']") != std::string::npos, "文件头字段");
+    auto column = [&](const std::string& name, const std::string& layout) {
+        const size_t entry = header.find("'" + name + "': {" + layout);
+        test_framework.assert_true(entry != std::string::npos, "列 " + name + " 的类型与形状");
+        const size_t offset = std::stoull(header.substr(header.find("'offset': ", entry) + 10));
+        test_framework.assert_true(offset % 64 == 0, "列 " + name + " 对齐");
+        return bytes.data() + offset;
+    };
+    const auto* time = reinterpret_cast<const double*>(column("time", "'dtype': '<f8', 'shape': (600,)"));
+    const auto* missile = reinterpret_cast<const double*>(column("missile_pos", "'dtype': '<f8', 'shape': (1, 600, 3,)"));
+    const auto* center = reinterpret_cast<const double*>(column("cloud_center", "'dtype': '<f8', 'shape': (3, 600, 3,)"));
+    const auto* active = reinterpret_cast<const uint8_t*>(column("cloud_active", "'dtype': '|u1', 'shape': (3, 600,)"));
+    const auto* obscured = reinterpret_cast<const uint8_t*>(column("obscured", "'dtype': '|u1', 'shape': (1, 600,)"));
+    
+    // obscured 列与由文件中位置重算的协同遮蔽一致，总帧数与统计一致
+    const Matrix3Xd key_points = CoreObjects::TargetCylinder(ScenarioLoader::active().target).get_key_points();
+    bool times_ok = true, criterion_ok = true;
+    int obscured_frames = 0;
+    for (int k = 0; k < 600; ++k) {
+        times_ok = times_ok && time[k] == job.start_time + k * job.dt;
+        std::vector<Vector3d> centers;
+        for (int c = 0; c < 3; ++c) {
+            if (active[c * 600 + k]) {
+                centers.emplace_back(center + (c * 600 + k) * 3);
+            }
+        }
+        const Vector3d m(missile + k * 3);
+        criterion_ok = criterion_ok &&
+                       obscured[k] == (Geometry::check_collective_obscuration(m, centers, key_points) ? 1 : 0);
+        obscured_frames += obscured[k];
+    }
+    test_framework.assert_true(times_ok, "时间列");
+    test_framework.assert_true(criterion_ok, "遮蔽列为协同遮蔽判据");
+    test_framework.assert_true(obscured_frames > 0, "存在遮蔽帧");
+    test_framework.assert_near(stats.obscured_time[0], obscured_frames * job.dt, 1e-12, "遮蔽时长与列一致");
+    
+    test_framework.pass();
+}
+
+/**
+ * @brief 公开问题5子优化器的解析与目标函数，直接检查状态码
+ */
+class StatusProbe : public Problem5::Problem5SubOptimizer {
+public:
+    using Problem5SubOptimizer::Problem5SubOptimizer;
+    using Problem5SubOptimizer::try_parse_decision_variables;
+    using Problem5SubOptimizer::try_parse_flat;
+    using Problem5SubOptimizer::objective_function;
+};
+
+void test_strategy_status() {
+    test_framework.start_test("StrategyStatus策略状态码");
+    
+    using Optimizer::StrategyStatus;
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double inf = std::numeric_limits<double>::infinity();
+    
+    // FY1 两枚 [速度, 角度, 投放1, 引信1, 间隔2, 引信2]，FY2 一枚 [速度, 角度, 投放1, 引信1]
+    StatusProbe probe("M1", {{"FY1", 2}, {"FY2", 1}});
+    Eigen::VectorXd valid(10);
+    valid << 120.0, 3.1, 1.0, 3.0, 2.0, 4.0, 100.0, 4.0, 5.0, 2.0;
+    auto with = [&](int i, double v) {
+        Eigen::VectorXd x = valid;
+        x[i] = v;
+        return x;
+    };
+    auto parse = [](StatusProbe& optimizer, const Eigen::VectorXd& x) {
+        Optimizer::StrategyMap map;
+        Optimizer::FlatStrategy flat;
+        const StrategyStatus status = optimizer.try_parse_decision_variables(x, map);
+        test_framework.assert_true(optimizer.try_parse_flat(x, flat) == status, "两条解析路径的状态一致");
+        return status;
+    };
+    
+    test_framework.assert_true(parse(probe, valid) == StrategyStatus::OK, "有效策略");
+    
+    // 直接填充的扁平策略与经字符串键策略转换的结果逐项相同
+    Optimizer::StrategyMap parsed;
+    Optimizer::FlatStrategy direct, converted;
+    probe.try_parse_decision_variables(valid, parsed);
+    Optimizer::to_flat_strategy(parsed, converted);
+    probe.try_parse_flat(valid, direct);
+    bool same_flat = direct.size() == converted.size();
+    for (size_t u = 0; same_flat && u < direct.size(); ++u) {
+        const auto& a = direct[u];
+        const auto& b = converted[u];
+        same_flat = a.uav == b.uav && a.num_grenades == b.num_grenades && a.speed == b.speed && a.angle == b.angle;
+        for (int g = 0; same_flat && g < a.num_grenades; ++g) {
+            same_flat = a.grenades[g].t_deploy == b.grenades[g].t_deploy && a.grenades[g].t_fuse == b.grenades[g].t_fuse;
+        }
+    }
+    test_framework.assert_true(same_flat, "直接解析与转换结果一致");
+    
+    test_framework.assert_true(parse(probe, valid.head(9)) == StrategyStatus::WRONG_DIMENSION, "维度不符");
+    test_framework.assert_true(parse(probe, with(3, nan)) == StrategyStatus::NON_FINITE, "NaN");
+    test_framework.assert_true(parse(probe, with(7, inf)) == StrategyStatus::NON_FINITE, "无穷大");
+    test_framework.assert_true(parse(probe, with(0, 150.0)) == StrategyStatus::SPEED_OUT_OF_RANGE, "速度超上限");
+    test_framework.assert_true(parse(probe, with(6, 60.0)) == StrategyStatus::SPEED_OUT_OF_RANGE, "速度低于下限");
+    test_framework.assert_true(parse(probe, with(4, -1.5)) == StrategyStatus::NEGATIVE_TIME, "负间隔使投放时间为负");
+    test_framework.assert_true(parse(probe, with(9, -0.1)) == StrategyStatus::NEGATIVE_TIME, "负引信时间");
+    StatusProbe stray("M1", {{"FY9", 1}});
+    test_framework.assert_true(parse(stray, valid.head(4)) == StrategyStatus::UNKNOWN_UAV, "未知无人机");
+    StatusProbe greedy("M1", {{"FY1", ::Config::MAX_GRENADES_PER_UAV + 1}});
+    test_framework.assert_true(parse(greedy, Eigen::VectorXd::Constant(4 + 2 * ::Config::MAX_GRENADES_PER_UAV, 80.0)) ==
+                               StrategyStatus::TOO_MANY_GRENADES, "弹药数超过上限");
+    
+    // 字符串键与扁平策略的校验：场景中的弹药预算、未知索引
+    const auto defaults = ScenarioLoader::from_config();
+    std::string json = ScenarioLoader::to_json(defaults);
+    json.replace(json.find("\"grenades\": ") + 12, 1, "1");
+    const auto scarce = ScenarioLoader::parse_json(json);
+    Optimizer::StrategyMap two_grenades = {{scarce.entities.uav(0).id, {100.0, 0.0, {{1.0, 2.0}, {3.0, 2.0}}}}};
+    test_framework.assert_true(Optimizer::validate_strategy(two_grenades, defaults) == StrategyStatus::OK &&
+                               Optimizer::validate_strategy(two_grenades, scarce) == StrategyStatus::TOO_MANY_GRENADES,
+                               "场景弹药预算");
+    Optimizer::FlatStrategy flat;
+    test_framework.assert_true(Optimizer::to_flat_strategy(two_grenades, flat, scarce) ==
+                               StrategyStatus::TOO_MANY_GRENADES, "扁平转换检查弹药预算");
+    Optimizer::FlatUAVStrategy stranger;
+    stranger.speed = 100.0;
+    std::vector<FastEvaluator::CloudState> clouds;
+    test_framework.assert_true(Optimizer::validate_strategy(Optimizer::FlatStrategy{stranger}, defaults) ==
+                               StrategyStatus::UNKNOWN_UAV &&
+                               FastEvaluator::try_build_clouds(Optimizer::FlatStrategy{stranger}, clouds, defaults) ==
+                               StrategyStatus::UNKNOWN_UAV, "扁平策略未知索引");
+    std::set<std::string> messages;
+    for (int s = 0; s <= static_cast<int>(StrategyStatus::TOO_MANY_GRENADES); ++s) {
+        messages.insert(Optimizer::status_message(static_cast<StrategyStatus>(s)));
+    }
+    test_framework.assert_true(messages.size() == 7, "每个状态码有不同的说明");
+    
+    // 实体的不抛异常构造
+    test_framework.assert_true(CoreObjects::UAV::create("FY1").has_value() &&
+                               !CoreObjects::UAV::create("FY9").has_value(), "UAV::create");
+    test_framework.assert_true(CoreObjects::Missile::create("M1").has_value() &&
+                               !CoreObjects::Missile::create("M9").has_value(), "Missile::create");
+    
+    // 目标函数把无效试验解计为 0 分并累加计数，有效解不计数
+    const long long before = probe.invalid_trial_count();
+    probe.objective_function(valid);
+    test_framework.assert_true(probe.invalid_trial_count() == before, "有效解不计入");
+    bool zero = true;
+    for (const auto& x : {with(0, 150.0), Eigen::VectorXd(valid.head(9)), with(3, nan), with(4, -1.5)}) {
+        zero = zero && probe.objective_function(x) == 0.0;
+    }
+    test_framework.assert_true(zero && probe.invalid_trial_count() == before + 4, "无效试验解计数");
+    
+    test_framework.pass();
+}
+
+void test_robust_objective() {
+    test_framework.start_test("RobustObscurationObjective鲁棒目标");
+    
+    const auto& scenario = ScenarioLoader::active();
+    const Registry::EntityIndex fy1 = scenario.entities.uav_index("FY1");
+    // FY1 单弹：[速度, 角度, 投放, 引信]，维度不对时无效
+    auto decoder = [&](const Eigen::VectorXd& x, Optimizer::FlatStrategy& flat) {
+        if (x.size() != 4) {
+            return Optimizer::StrategyStatus::WRONG_DIMENSION;
+        }
+        flat.assign(1, Optimizer::FlatUAVStrategy());
+        flat[0].uav = fy1;
+        flat[0].num_grenades = 1;
+        flat[0].speed = x[0];
+        flat[0].angle = x[1];
+        flat[0].grenades[0] = {x[2], x[3]};
+        return Optimizer::validate_strategy(flat, scenario);
+    };
+    RobustOptimization::RobustSettings settings;
+    settings.initial_samples = 8;
+    settings.sample_increment = 8;
+    settings.max_samples = 64;
+    auto run = [&](const std::vector<Eigen::VectorXd>& trials, const std::vector<Eigen::VectorXd>& parents,
+                   std::vector<double>& trial_fitness, std::vector<double>& parent_fitness, int generation = 0) {
+        RobustOptimization::RobustObscurationObjective objective(decoder, {"M1"}, RobustnessAnalyzer::NoiseModel(),
+                                                                 settings);
+        objective.begin_generation(generation);
+        objective.evaluate_pairs(trials, parents, trial_fitness, parent_fitness);
+        return objective.stats();
+    };
+    
+    Eigen::VectorXd good(4);
+    good << 120.0, M_PI, 1.5, 3.6;
+    Eigen::VectorXd away = good;        // 背离假目标飞行，始终零遮蔽
+    away[1] = 0.0;
+    Eigen::VectorXd near = good;        // 与 good 只差 10 ms 引信，配对差在初始样本上不显著
+    near[3] += 0.01;
+    Eigen::VectorXd later = good;
+    later[2] += 0.3;
+    std::vector<double> trial_fitness, parent_fitness;
+    
+    // 公共随机数：试验行与父代行相同时每个样本的扰动相同，估计值逐位相等且无需追加样本
+    auto stats = run({good, later}, {good, later}, trial_fitness, parent_fitness);
+    test_framework.assert_true(trial_fitness == parent_fitness && trial_fitness[0] < 0.0, "配对行使用相同扰动");
+    test_framework.assert_true(stats.refined_pairs == 0 && stats.realisations == 4 * settings.initial_samples,
+                               "相同候选解不追加样本");
+    std::vector<double> next_fitness;
+    run({good, later}, {good, later}, next_fitness, parent_fitness, 1);
+    test_framework.assert_true(next_fitness != trial_fitness, "不同代抽取不同样本");
+    
+    // 自适应追加：差异显著的对只用初始样本，不显著的对追加样本；混合评估时追加量与单独评估不显著的对相同
+    const auto significant = run({good}, {away}, trial_fitness, parent_fitness);
+    test_framework.assert_true(significant.refined_pairs == 0 &&
+                               significant.realisations == 2 * settings.initial_samples, "显著的对不追加样本");
+    const auto borderline = run({good}, {near}, trial_fitness, parent_fitness);
+    test_framework.assert_true(borderline.refined_pairs == 1 &&
+                               borderline.realisations > 2 * settings.initial_samples, "不显著的对追加样本");
+    const auto mixed = run({good, good}, {away, near}, trial_fitness, parent_fitness);
+    test_framework.assert_true(mixed.pairs == 2 && mixed.refined_pairs == 1, "只有不显著的对被追加");
+    test_framework.assert_true(mixed.realisations == significant.realisations + borderline.realisations,
+                               "追加的样本只落在不显著的对上");
+    
+    // 无效策略计入 invalid_trials，所有样本按零遮蔽计
+    stats = run({good, Eigen::VectorXd::Zero(3), away}, {}, trial_fitness, parent_fitness);
+    test_framework.assert_true(stats.invalid_trials == 1, "无效策略计数");
+    test_framework.assert_true(trial_fitness[1] == 0.0 && trial_fitness[0] < 0.0, "无效策略零遮蔽");
+    stats = run({good}, {Eigen::VectorXd::Zero(5)}, trial_fitness, parent_fitness);
+    test_framework.assert_true(stats.invalid_trials == 1 && parent_fitness[0] == 0.0, "无效父代计数");
+    
+    test_framework.pass();
+}
+
+void test_golden_corpus() {
+    test_framework.start_test("GoldenCorpus黄金参考语料");
+    
+    const auto& scenario = ScenarioLoader::active();
+    const auto shape = GoldenCorpus::standard_problems()[1];    // 问题3
+    const auto corpus = GoldenCorpus::generate(shape, 300, 7, scenario);
+    test_framework.assert_true(corpus.size() == 300 && corpus.dimension() == shape.dimension(), "语料规模");
+    
+    // 定点编码下整数边界值精确可表示：边界策略中应出现恰好等于速度上下限的速度
+    bool exact_edge = false;
+    size_t obscuring = 0;
+    for (size_t i = 0; i < corpus.size(); ++i) {
+        const double speed = corpus.decode(i)[0];
+        exact_edge = exact_edge || speed == scenario.physics.uav_speed_min || speed == scenario.physics.uav_speed_max;
+        obscuring += corpus.reference_total(i) > 0.0;
+    }
+    test_framework.assert_true(exact_edge, "边界值精确编码");
+    test_framework.assert_true(obscuring > 20, "对抗性策略产生足够多的遮蔽");
+    
+    // 文件往返逐位相同，截断的文件被拒绝
+    const std::string path = "test_golden_corpus.gold";
+    GoldenCorpus::save(corpus, path);
+    const auto loaded = GoldenCorpus::load(path);
+    test_framework.assert_true(loaded.codes == corpus.codes && loaded.kinds == corpus.kinds &&
+                               loaded.reference_times == corpus.reference_times &&
+                               loaded.scenario_hash == corpus.scenario_hash, "文件往返");
+    {
+        std::ifstream in(path, std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), bytes.size() - 5);
+    }
+    bool rejected = false;
+    try {
+        GoldenCorpus::load(path);
+    } catch (const std::runtime_error&) {
+        rejected = true;
+    }
+    test_framework.assert_true(rejected, "截断文件");
+    std::remove(path.c_str());
+    
+    // 各后端与双精度路径一致，误差在包络内；参考值偏差很小 (0.1 s 计数相对连续测度)
+    const auto reports = GoldenCorpus::check(loaded, scenario);
+    test_framework.assert_true(reports.size() >= 4 && reports[0].backend == "双精度", "后端列表");
+    test_framework.assert_true(GoldenCorpus::passes(reports), "通过门限");
+    test_framework.assert_true(std::abs(reports[0].mean_error) < 0.02, "参考值偏差");
+    
+    // 门限能拦下不一致的后端
+    auto broken = reports;
+    broken[1].mismatches = 1;
+    test_framework.assert_true(!GoldenCorpus::passes(broken), "不一致被拦下");
+    
+    test_framework.pass();
+}
+
+void test_eval_service() {
+    test_framework.start_test("EvalService常驻评估服务");
+    
+    const auto& scenario = ScenarioLoader::active();
+    EvalService::ServerSettings settings;
+    settings.socket_path = "test_eval_service.sock";
+    settings.parallel_threshold = 8;
+    EvalService::Server server(scenario, settings);
+    server.start();
+    
+    EvalService::Client client(settings.socket_path);
+    client.ping();
+    const auto& description = client.describe();
+    test_framework.assert_true(description.scenario_hash == scenario.content_hash &&
+                               static_cast<int>(description.missiles.size()) == scenario.entities.num_missiles(),
+                               "场景描述");
+    
+    // 问题3 形状：批量 (线程池并行) 与逐个评估都与进程内评估器逐位相同
+    const auto shape3 = GoldenCorpus::standard_problems()[1];
+    const auto corpus = GoldenCorpus::generate(shape3, 40, 11, scenario);
+    const auto shape = client.shape(shape3.uavs, shape3.grenades_per_uav, shape3.missiles);
+    std::vector<double> variables;
+    for (size_t i = 0; i < corpus.size(); ++i) {
+        const auto x = corpus.decode(i);
+        variables.insert(variables.end(), x.data(), x.data() + x.size());
+    }
+    const auto batch = client.evaluate(shape, variables.data(), static_cast<uint32_t>(corpus.size()));
+    
+    FastEvaluator::ObscurationEvaluator evaluator({scenario.entities.missile_index("M1")}, scenario);
+    const Registry::EntityIndex fy1 = scenario.entities.uav_index("FY1");
+    bool identical = batch.times.size() == corpus.size();
+    for (size_t i = 0; i < corpus.size() && identical; ++i) {
+        const double* v = variables.data() + i * shape.dimension();
+        Optimizer::FlatStrategy flat(1);
+        flat[0].uav = fy1;
+        flat[0].num_grenades = 3;
+        flat[0].speed = v[0];
+        flat[0].angle = v[1];
+        flat[0].grenades[0] = {v[2], v[3]};
+        flat[0].grenades[1] = {v[2] + v[4], v[5]};
+        flat[0].grenades[2] = {v[2] + v[4] + v[6], v[7]};
+        std::vector<FastEvaluator::CloudState> clouds;
+        double expected = 0.0;
+        const auto status = FastEvaluator::try_build_clouds(flat, clouds, scenario);
+        if (status == Optimizer::StrategyStatus::OK) {
+            evaluator.evaluate(clouds, &expected);
+        }
+        identical = batch.strategy_status[i] == static_cast<uint8_t>(status) && batch.times[i] == expected;
+    }
+    test_framework.assert_true(identical, "批量评估与进程内评估器一致");
+    
+    // 流水线：连续发出多个请求后按顺序读回；无效形状只使该请求失败
+    std::vector<uint32_t> ids;
+    for (int r = 0; r < 5; ++r) {
+        ids.push_back(client.send_evaluate(shape, variables.data() + r * shape.dimension(), 1));
+    }
+    EvalService::Shape bad = shape;
+    bad.missiles = {200};
+    const uint32_t bad_id = client.send_evaluate(bad, variables.data(), 1);
+    bool in_order = true;
+    EvalService::Response response;
+    for (int r = 0; r < 5; ++r) {
+        client.receive(response);
+        in_order = in_order && response.id == ids[r] && response.status == EvalService::Status::OK &&
+                   response.times.size() == 1 && response.times[0] == batch.times[r];
+    }
+    test_framework.assert_true(in_order, "流水线请求按序应答");
+    client.receive(response);
+    test_framework.assert_true(response.id == bad_id && response.status == EvalService::Status::BAD_REQUEST,
+                               "无效形状被拒绝");
+    client.ping();
+    
+    // 无效策略返回状态码和零遮蔽
+    std::vector<double> slow(variables.begin(), variables.begin() + shape.dimension());
+    slow[0] = scenario.physics.uav_speed_min - 1.0;
+    const auto rejected = client.evaluate(shape, slow.data(), 1);
+    test_framework.assert_true(rejected.strategy_status[0] ==
+                                   static_cast<uint8_t>(Optimizer::StrategyStatus::SPEED_OUT_OF_RANGE) &&
+                               rejected.times[0] == 0.0, "无效策略状态码");
+    
+    const auto stats = client.stats();
+    test_framework.assert_true(stats.strategies == corpus.size() + 6 && stats.errors == 1, "服务端计数");
+    
+    // 停止后套接字文件被删除，新连接失败
+    server.stop();
+    bool refused = false;
+    try {
+        EvalService::Client late(settings.socket_path);
+    } catch (const std::runtime_error&) {
+        refused = true;
+    }
+    test_framework.assert_true(refused, "停止后拒绝连接");
+    
+    test_framework.pass();
+}
+
 void test_solution_cache() {
     test_framework.start_test("SolutionCache解缓存");
     
@@ -184,6 +1600,41 @@ void test_simple_optimization() {
     test_framework.pass();
 }
 
+void test_surrogate_screening() {
+    test_framework.start_test("代理模型预筛选");
+    
+    // 代理模型在二次函数样本上训练后，应能区分好坏点
+    Vector lower = Vector::Constant(4, -5.0), upper = Vector::Constant(4, 5.0);
+    SurrogateModel model(lower, upper, 100, 7);
+    std::vector<Individual> samples;
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> dist(-5.0, 5.0);
+    for (int i = 0; i < 300; ++i) {
+        Vector x(4);
+        for (int j = 0; j < 4; ++j) x[j] = dist(rng);
+        samples.emplace_back(x, x.squaredNorm());
+    }
+    model.update(samples);
+    test_framework.assert_true(model.num_samples() == 300, "样本计数");
+    test_framework.assert_true(model.predict(Vector::Zero(4)) < model.predict(Vector::Constant(4, 4.0)), "预测排序");
+    
+    // 预筛选减少评估次数，仍能找到最优附近
+    std::vector<std::pair<double, double>> bounds = {{-5.0, 5.0}, {-5.0, 5.0}};
+    AdaptiveDESettings settings;
+    settings.population_size = 40;
+    settings.max_iterations = 200;
+    settings.tolerance = 1e-6;
+    settings.verbose = false;
+    settings.random_seed = 42;
+    settings.use_surrogate = true;
+    
+    auto result = adaptive_differential_evolution(quadratic_function, bounds, settings);
+    test_framework.assert_true(result.performance_stats.surrogate_skipped > 0, "部分试验个体被筛掉");
+    test_framework.assert_near(result.best_fitness, 0.0, 1e-3, "预筛选下找到最优附近");
+    
+    test_framework.pass();
+}
+
 void test_constrained_optimization() {
     test_framework.start_test("约束优化问题");
     
@@ -258,20 +1709,20 @@ void test_settings_validation() {
     valid_settings.tolerance = 1e-6;
     valid_settings.boundary_handling = "reflect";
     
-    test_framework.assert_true(Utils::validate_settings(valid_settings), "有效设置应该通过验证");
+    test_framework.assert_true(OptimizerWrapper::Utils::validate_settings(valid_settings), "有效设置应该通过验证");
     
     // 测试无效设置
     SimpleSettings invalid_settings = valid_settings;
     invalid_settings.max_iterations = -1;
     
-    test_framework.assert_true(!Utils::validate_settings(invalid_settings), "无效设置应该被拒绝");
+    test_framework.assert_true(!OptimizerWrapper::Utils::validate_settings(invalid_settings), "无效设置应该被拒绝");
     
     // 测试边界验证
     std::vector<std::pair<double, double>> valid_bounds = {{-1.0, 1.0}, {0.0, 5.0}};
-    test_framework.assert_true(Utils::validate_bounds(valid_bounds), "有效边界");
+    test_framework.assert_true(OptimizerWrapper::Utils::validate_bounds(valid_bounds), "有效边界");
     
     std::vector<std::pair<double, double>> invalid_bounds = {{1.0, -1.0}};  // 下界大于上界
-    test_framework.assert_true(!Utils::validate_bounds(invalid_bounds), "无效边界应该被拒绝");
+    test_framework.assert_true(!OptimizerWrapper::Utils::validate_bounds(invalid_bounds), "无效边界应该被拒绝");
     
     test_framework.pass();
 }
@@ -337,10 +1788,29 @@ int main() {
         std::cout << std::string(60, '=') << std::endl;
         
         // 执行所有测试
+        test_counter_rng();
         test_adaptive_parameter_manager();
+        test_de_variants();
+        test_thread_count_determinism();
         test_boundary_processor();
+        test_simd_dispatch();
+        test_work_pool();
+        test_job_scheduler();
+        test_eval_log();
+        test_sensitivity_analysis();
+        test_portfolio();
+        test_benchmark_suite();
+        test_scenario_loader();
+        test_scenario_generator();
+        test_batch_results();
+        test_trajectory_exporter();
+        test_strategy_status();
+        test_robust_objective();
+        test_golden_corpus();
+        test_eval_service();
         test_solution_cache();
         test_simple_optimization();
+        test_surrogate_screening();
         test_constrained_optimization();
         test_problem5_optimizer();
         test_settings_validation();
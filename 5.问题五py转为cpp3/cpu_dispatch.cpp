@@ -0,0 +1,96 @@
+#include "cpu_dispatch.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdlib>
+#include <iostream>
+
+namespace CpuDispatch {
+
+namespace {
+
+constexpr int NOT_FORCED = -1;
+
+IsaLevel detect() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl") &&
+        __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512bw")) {
+        return IsaLevel::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return IsaLevel::AVX2;
+    }
+    if (__builtin_cpu_supports("sse4.2")) {
+        return IsaLevel::SSE42;
+    }
+#endif
+    return IsaLevel::SCALAR;
+}
+
+int forced_from_environment() {
+    const char* value = std::getenv("SMOKE_SIMD");
+    if (value == nullptr || std::string(value).empty() || std::string(value) == "auto") {
+        return NOT_FORCED;
+    }
+    IsaLevel level;
+    if (!parse_isa(value, level)) {
+        std::cerr << "忽略无法识别的 SMOKE_SIMD: " << value << std::endl;
+        return NOT_FORCED;
+    }
+    return static_cast<int>(level);
+}
+
+std::atomic<int>& forced_level() {
+    static std::atomic<int> forced{forced_from_environment()};
+    return forced;
+}
+
+} // namespace
+
+IsaLevel detected() {
+    static const IsaLevel level = detect();
+    return level;
+}
+
+IsaLevel active() {
+    const int forced = forced_level().load(std::memory_order_relaxed);
+    const IsaLevel best = detected();
+    if (forced == NOT_FORCED) {
+        return best;
+    }
+    return static_cast<IsaLevel>(std::min(forced, static_cast<int>(best)));
+}
+
+void force(IsaLevel level) {
+    forced_level().store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+void reset() {
+    forced_level().store(NOT_FORCED, std::memory_order_relaxed);
+}
+
+const char* isa_name(IsaLevel level) {
+    switch (level) {
+        case IsaLevel::SCALAR: return "scalar";
+        case IsaLevel::SSE42:  return "sse4.2";
+        case IsaLevel::AVX2:   return "avx2";
+        case IsaLevel::AVX512: return "avx512";
+    }
+    return "unknown";
+}
+
+bool parse_isa(const std::string& name, IsaLevel& level) {
+    std::string lower(name);
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    for (IsaLevel candidate : {IsaLevel::SCALAR, IsaLevel::SSE42, IsaLevel::AVX2, IsaLevel::AVX512}) {
+        if (lower == isa_name(candidate)) {
+            level = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace CpuDispatch
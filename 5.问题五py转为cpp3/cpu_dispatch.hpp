@@ -0,0 +1,53 @@
+#pragma once
+
+#include <string>
+
+namespace CpuDispatch {
+
+/**
+ * @brief SIMD 内核的指令集档位，数值越大要求越高
+ *
+ * SCALAR 为编译基线 (x86-64 上即 SSE2)，其余档位只在运行时确认 CPU 支持后才会选用。
+ */
+enum class IsaLevel {
+    SCALAR = 0,
+    SSE42 = 1,
+    AVX2 = 2,     // AVX2 + FMA
+    AVX512 = 3    // AVX-512 F/VL/DQ/BW
+};
+
+/**
+ * @brief 按 CPUID 检测到的最高档位 (首次调用时检测，之后缓存)
+ */
+IsaLevel detected();
+
+/**
+ * @brief 内核实际使用的档位：强制档位与检测结果中较低者
+ *
+ * 首次调用时读取环境变量 SMOKE_SIMD (scalar / sse4.2 / avx2 / avx512 / auto)，
+ * 可在不改代码的情况下让整个进程走指定路径。
+ */
+IsaLevel active();
+
+/**
+ * @brief 强制使用不高于 level 的档位 (用于测试与对比)，高于检测结果时按检测结果
+ *
+ * 可以随时调用，对之后发起的内核调用生效；正在执行的内核不受影响。
+ */
+void force(IsaLevel level);
+
+/**
+ * @brief 取消强制，恢复按检测结果选择
+ */
+void reset();
+
+const char* isa_name(IsaLevel level);
+
+/**
+ * @brief 解析档位名 (scalar / sse4.2 / avx2 / avx512，大小写不敏感)
+ *
+ * @return 是否解析成功
+ */
+bool parse_isa(const std::string& name, IsaLevel& level);
+
+} // namespace CpuDispatch
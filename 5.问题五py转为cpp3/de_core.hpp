@@ -0,0 +1,416 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+#include <Eigen/Dense>
+#include "counter_rng.hpp"
+
+/**
+ * @brief 差分进化公共内核 (仅头文件)
+ *
+ * 目标函数类型、维度 (编译期固定或 Eigen::Dynamic)、变异策略、交叉方式和边界处理都是模板参数，
+ * 编译器可以内联目标函数并展开定长维度的循环。Optimizer::DifferentialEvolution (经典与带噪声版本)
+ * 和 HighPerformanceDE::HighPerformanceAdaptiveDE 都是它的实例化；后者的目标函数以 std::function 保存，不内联。
+ * 随机数取自计数器型发生器，第 g 代第 i 个个体的抽样只由 (种子, g, i, 抽样序号) 决定，
+ * 给定种子时任何线程数、任何调度下结果都相同，热路径上没有共享的随机数状态。
+ */
+namespace DECore {
+
+template <int Dim>
+using Vector = Eigen::Matrix<double, Dim, 1>;
+
+/**
+ * @brief 搜索区间
+ */
+template <int Dim>
+struct Box {
+    Vector<Dim> lower;
+    Vector<Dim> upper;
+
+    int dimension() const { return static_cast<int>(lower.size()); }
+};
+
+// =============================================================================
+// 随机数：rng 需提供 uniform()、uniform(lower, upper) 和 uniform_int(n) (见 CounterRNG::CounterRng)
+// =============================================================================
+
+using Rng = CounterRNG::CounterRng;
+
+/**
+ * @brief 第 generation 代第 individual 个个体的随机数流 (初始种群为第 0 代)
+ */
+inline Rng individual_rng(uint64_t seed, int generation, int individual) {
+    return Rng(seed, static_cast<uint64_t>(generation), static_cast<uint32_t>(individual));
+}
+
+/**
+ * @brief 种子为 0 时改用 std::random_device (结果不可复现)
+ */
+inline uint64_t resolve_seed(uint64_t seed) {
+    if (seed != 0) {
+        return seed;
+    }
+    std::random_device device;
+    return (static_cast<uint64_t>(device()) << 32) | device();
+}
+
+// =============================================================================
+// 边界处理策略：apply(x, box, rng)
+// =============================================================================
+
+struct ClipBoundary {
+    template <int Dim, class Rng>
+    static void apply(Vector<Dim>& x, const Box<Dim>& box, Rng&) {
+        for (int i = 0; i < box.dimension(); ++i) {
+            x[i] = std::clamp(x[i], box.lower[i], box.upper[i]);
+        }
+    }
+};
+
+struct ReflectBoundary {
+    template <int Dim, class Rng>
+    static void apply(Vector<Dim>& x, const Box<Dim>& box, Rng&) {
+        for (int i = 0; i < box.dimension(); ++i) {
+            if (x[i] < box.lower[i]) {
+                x[i] = std::min(box.lower[i] + (box.lower[i] - x[i]), box.upper[i]);
+            } else if (x[i] > box.upper[i]) {
+                x[i] = std::max(box.upper[i] - (x[i] - box.upper[i]), box.lower[i]);
+            }
+        }
+    }
+};
+
+struct ReinitializeBoundary {
+    template <int Dim, class Rng>
+    static void apply(Vector<Dim>& x, const Box<Dim>& box, Rng& rng) {
+        for (int i = 0; i < box.dimension(); ++i) {
+            if (x[i] < box.lower[i] || x[i] > box.upper[i]) {
+                x[i] = rng.uniform(box.lower[i], box.upper[i]);
+            }
+        }
+    }
+};
+
+struct MidpointBoundary {
+    template <int Dim, class Rng>
+    static void apply(Vector<Dim>& x, const Box<Dim>& box, Rng&) {
+        for (int i = 0; i < box.dimension(); ++i) {
+            if (x[i] < box.lower[i] || x[i] > box.upper[i]) {
+                x[i] = (box.lower[i] + box.upper[i]) * 0.5;
+            }
+        }
+    }
+};
+
+// =============================================================================
+// 变异策略：NUM_DONORS 个互不相同且不等于目标个体的供体，mutate(population, target, best, donors, F)
+// population 只需提供 size() 和返回 Vector<Dim> 的 operator[]
+// =============================================================================
+
+/** DE/rand/1: x_r1 + F (x_r2 - x_r3) */
+struct RandOne {
+    static constexpr int NUM_DONORS = 3;
+
+    template <int Dim, class Population>
+    static Vector<Dim> mutate(const Population& pop, int, const Vector<Dim>&, const int* r, double F) {
+        return pop[r[0]] + F * (pop[r[1]] - pop[r[2]]);
+    }
+};
+
+/** DE/best/1: x_best + F (x_r1 - x_r2) */
+struct BestOne {
+    static constexpr int NUM_DONORS = 2;
+
+    template <int Dim, class Population>
+    static Vector<Dim> mutate(const Population& pop, int, const Vector<Dim>& best, const int* r, double F) {
+        return best + F * (pop[r[0]] - pop[r[1]]);
+    }
+};
+
+/** DE/current-to-best/1: x_i + F (x_best - x_i) + F (x_r1 - x_r2) */
+struct CurrentToBestOne {
+    static constexpr int NUM_DONORS = 2;
+
+    template <int Dim, class Population>
+    static Vector<Dim> mutate(const Population& pop, int target, const Vector<Dim>& best, const int* r, double F) {
+        const Vector<Dim>& current = pop[target];
+        return current + F * (best - current) + F * (pop[r[0]] - pop[r[1]]);
+    }
+};
+
+/** DE/rand/2: x_r1 + F (x_r2 - x_r3) + F (x_r4 - x_r5) */
+struct RandTwo {
+    static constexpr int NUM_DONORS = 5;
+
+    template <int Dim, class Population>
+    static Vector<Dim> mutate(const Population& pop, int, const Vector<Dim>&, const int* r, double F) {
+        return pop[r[0]] + F * (pop[r[1]] - pop[r[2]]) + F * (pop[r[3]] - pop[r[4]]);
+    }
+};
+
+// =============================================================================
+// 交叉方式：apply(trial, mutant, CR, rng)，trial 传入时为目标个体
+// =============================================================================
+
+/** 二项交叉，先抽取一个必然取自变异向量的维度 */
+struct BinomialCrossover {
+    template <int Dim, class Rng>
+    static void apply(Vector<Dim>& trial, const Vector<Dim>& mutant, double CR, Rng& rng) {
+        const int dim = static_cast<int>(trial.size());
+        const int forced_dim = static_cast<int>(rng.uniform_int(dim));
+        for (int i = 0; i < dim; ++i) {
+            if (rng.uniform() < CR || i == forced_dim) {
+                trial[i] = mutant[i];
+            }
+        }
+    }
+};
+
+// =============================================================================
+// 基本操作
+// =============================================================================
+
+/**
+ * @brief 在区间内均匀抽样一个个体
+ */
+template <int Dim, class Rng>
+Vector<Dim> random_individual(const Box<Dim>& box, Rng& rng) {
+    Vector<Dim> x(box.dimension());
+    for (int i = 0; i < box.dimension(); ++i) {
+        x[i] = rng.uniform(box.lower[i], box.upper[i]);
+    }
+    return x;
+}
+
+/**
+ * @brief 均匀抽取 count 个互不相同且不等于 target 的下标 (拒绝抽样)
+ *
+ * 期望代价 O(count)，与种群规模无关；对全部候选洗牌再取前几个是 O(种群)，种群较大时每代开销为 O(种群^2)。
+ */
+template <class Rng>
+void select_donors(int pop_size, int target, int count, Rng& rng, int* donors) {
+    for (int k = 0; k < count; ++k) {
+        int candidate;
+        bool duplicate;
+        do {
+            candidate = static_cast<int>(rng.uniform_int(pop_size));
+            duplicate = candidate == target;
+            for (int j = 0; j < k && !duplicate; ++j) {
+                duplicate = donors[j] == candidate;
+            }
+        } while (duplicate);
+        donors[k] = candidate;
+    }
+}
+
+/**
+ * @brief 生成一个试验个体：选取供体 → 变异 → 边界处理 → 交叉 → 边界处理
+ *
+ * @param pop 种群 (size() 须大于 Mutation::NUM_DONORS)
+ * @param target 目标个体下标
+ * @param best 当前最优个体 (不使用最优个体的策略忽略此参数)
+ * @param trial 输出
+ */
+template <class Mutation, class Boundary, class Crossover = BinomialCrossover,
+          int Dim, class Population, class Rng>
+void make_trial(const Population& pop, int target, const Vector<Dim>& best,
+                double F, double CR, const Box<Dim>& box, Rng& rng, Vector<Dim>& trial) {
+    int donors[Mutation::NUM_DONORS];
+    select_donors(static_cast<int>(pop.size()), target, Mutation::NUM_DONORS, rng, donors);
+
+    Vector<Dim> mutant = Mutation::template mutate<Dim>(pop, target, best, donors, F);
+    Boundary::apply(mutant, box, rng);
+
+    trial = pop[target];
+    Crossover::apply(trial, mutant, CR, rng);
+    Boundary::apply(trial, box, rng);
+}
+
+/**
+ * @brief 生成一个 current-to-pbest/1 试验个体 (JADE)：x_i + Fw (x_pbest - x_i) + F (x_r1 - x~_r2)
+ *
+ * x_pbest 从 elite (目标值排在前 p·NP 的个体下标) 中均匀抽取；r1 取自种群且不等于 target；
+ * x~_r2 取自种群与外部档案 (被替换的父代) 的并集，且不等于 target 和 r1。
+ * jSO 的加权形式取 Fw ≠ F，其余算法 Fw = F。
+ *
+ * @param pop 种群 (size() 不小于 3)
+ * @param archive 外部档案，接口与 pop 相同，可以为空
+ * @param elite 前 p·NP 个体的下标 (非空)
+ */
+template <class Boundary, class Crossover = BinomialCrossover,
+          int Dim, class Population, class Archive, class Rng>
+void make_pbest_trial(const Population& pop, const Archive& archive, const std::vector<int>& elite, int target,
+                      double F, double Fw, double CR, const Box<Dim>& box, Rng& rng, Vector<Dim>& trial) {
+    const int pop_size = static_cast<int>(pop.size());
+    const int pbest = elite[rng.uniform_int(static_cast<uint32_t>(elite.size()))];
+    int r1, r2;
+    do {
+        r1 = static_cast<int>(rng.uniform_int(pop_size));
+    } while (r1 == target);
+    do {
+        r2 = static_cast<int>(rng.uniform_int(pop_size + static_cast<int>(archive.size())));
+    } while (r2 == target || r2 == r1);
+
+    const Vector<Dim>& current = pop[target];
+    const Vector<Dim>& far = r2 < pop_size ? pop[r2] : archive[r2 - pop_size];
+    Vector<Dim> mutant = current + Fw * (pop[pbest] - current) + F * (pop[r1] - far);
+    Boundary::apply(mutant, box, rng);
+
+    trial = current;
+    Crossover::apply(trial, mutant, CR, rng);
+    Boundary::apply(trial, box, rng);
+}
+
+/**
+ * @brief 为第 generation 代的每个个体生成试验个体，第 i 个个体使用 individual_rng(seed, generation, i)
+ *
+ * 结果与线程数和执行顺序无关。parallel_for(count, body) 负责执行 body(0) ... body(count - 1)。
+ */
+template <class Mutation, class Boundary, class Crossover = BinomialCrossover,
+          int Dim, class ParallelFor>
+void generate_trials(const std::vector<Vector<Dim>>& population, const Vector<Dim>& best,
+                     double F, double CR, const Box<Dim>& box, uint64_t seed, int generation,
+                     ParallelFor&& parallel_for, std::vector<Vector<Dim>>& trials) {
+    trials.resize(population.size());
+    parallel_for(static_cast<int>(population.size()), [&](int i) {
+        Rng rng = individual_rng(seed, generation, i);
+        make_trial<Mutation, Boundary, Crossover>(population, i, best, F, CR, box, rng, trials[i]);
+    });
+}
+
+// =============================================================================
+// 经典差分进化主循环
+// =============================================================================
+
+struct Settings {
+    int population_size = 150;
+    int max_iterations = 1000;
+    double tolerance = 1e-6;          // 最优值绝对值低于该值且本代有改进时停止
+    double differential_weight = 0.8; // F
+    double crossover_rate = 0.7;      // CR
+    unsigned int seed = 0;            // 0 表示使用随机种子
+};
+
+template <int Dim>
+struct Result {
+    Vector<Dim> best;
+    double best_fitness = std::numeric_limits<double>::max();
+    int iterations = 0;     // 完成的代数
+    bool converged = false;
+    bool cancelled = false; // parallel_for 报告未完成 (作业被取消) 时提前结束
+    std::vector<Vector<Dim>> population;    // 结束时的种群与适应度 (用于分阶段运行时接续)
+    std::vector<double> fitness;
+};
+
+/**
+ * @brief 差分进化 (最小化)
+ *
+ * 每代先生成全部试验个体并评估，再逐个与父代比较。
+ *
+ * @param objective 目标函数 double(const Vector<Dim>&)，以模板参数传入可被内联；并行评估时须线程安全
+ * @param parallel_for bool(int count, body)：执行 body(0) ... body(count - 1)，未全部执行 (被取消) 时返回 false；
+ *                     未执行的个体保持最差适应度
+ * @param observer void(int iteration, double best_fitness, bool improved)：初始种群评估后以 iteration = -1
+ *                 调用一次，之后每代结束时调用 (用于输出进度)
+ * @param initial 初始种群的前若干个个体 (其余随机抽样)，多余的个体被忽略
+ */
+template <class Mutation = RandOne, class Boundary = ClipBoundary, class Crossover = BinomialCrossover,
+          int Dim, class Objective, class ParallelFor, class Observer>
+Result<Dim> optimize(Objective&& objective, const Box<Dim>& box, const Settings& settings,
+                     ParallelFor&& parallel_for, Observer&& observer,
+                     const std::vector<Vector<Dim>>& initial = {}) {
+    constexpr double WORST = std::numeric_limits<double>::max();
+    const int pop_size = settings.population_size;
+    const uint64_t seed = resolve_seed(settings.seed);
+
+    std::vector<Vector<Dim>> population;
+    population.reserve(pop_size);
+    for (int i = 0; i < pop_size; ++i) {
+        if (i < static_cast<int>(initial.size())) {
+            population.push_back(initial[i]);
+            continue;
+        }
+        Rng rng = individual_rng(seed, 0, i);
+        population.push_back(random_individual(box, rng));
+    }
+
+    Result<Dim> result;
+    std::vector<double> fitness(pop_size, WORST);
+    result.cancelled = !parallel_for(pop_size, [&](int i) { fitness[i] = objective(population[i]); });
+
+    const int best_index = static_cast<int>(std::min_element(fitness.begin(), fitness.end()) - fitness.begin());
+    result.best = population[best_index];
+    result.best_fitness = fitness[best_index];
+    observer(-1, result.best_fitness, false);
+
+    // 试验个体缓冲区跨代复用
+    std::vector<Vector<Dim>> trials(pop_size, Vector<Dim>(box.dimension()));
+    std::vector<double> trial_fitness(pop_size);
+
+    for (int iteration = 0; iteration < settings.max_iterations && !result.cancelled; ++iteration) {
+        std::fill(trial_fitness.begin(), trial_fitness.end(), WORST);
+
+        result.cancelled = !parallel_for(pop_size, [&](int i) {
+            Rng rng = individual_rng(seed, iteration + 1, i);
+            make_trial<Mutation, Boundary, Crossover>(population, i, result.best,
+                                                      settings.differential_weight, settings.crossover_rate,
+                                                      box, rng, trials[i]);
+            trial_fitness[i] = objective(trials[i]);
+        });
+
+        bool improved = false;
+        for (int i = 0; i < pop_size; ++i) {
+            if (trial_fitness[i] < fitness[i]) {
+                std::swap(population[i], trials[i]);
+                fitness[i] = trial_fitness[i];
+                if (fitness[i] < result.best_fitness) {
+                    result.best = population[i];
+                    result.best_fitness = fitness[i];
+                    improved = true;
+                }
+            }
+        }
+
+        result.iterations = iteration + 1;
+        observer(iteration, result.best_fitness, improved);
+
+        if (improved && std::abs(result.best_fitness) < settings.tolerance) {
+            result.converged = true;
+            break;
+        }
+    }
+    result.population = std::move(population);
+    result.fitness = std::move(fitness);
+    return result;
+}
+
+/**
+ * @brief 由上下界向量构造区间 (定长维度时长度须等于 Dim)
+ */
+template <int Dim = Eigen::Dynamic, class Bounds>
+Box<Dim> make_box(const std::vector<Bounds>& bounds) {
+    Box<Dim> box{Vector<Dim>(static_cast<int>(bounds.size())), Vector<Dim>(static_cast<int>(bounds.size()))};
+    for (size_t i = 0; i < bounds.size(); ++i) {
+        box.lower[i] = bounds[i].lower;
+        box.upper[i] = bounds[i].upper;
+    }
+    return box;
+}
+
+/**
+ * @brief 串行执行的 parallel_for
+ */
+struct SerialFor {
+    template <class Body>
+    bool operator()(int count, Body&& body) const {
+        for (int i = 0; i < count; ++i) {
+            body(i);
+        }
+        return true;
+    }
+};
+
+} // namespace DECore
@@ -0,0 +1,69 @@
+#include "entity_registry.hpp"
+#include "scenario.hpp"
+#include <algorithm>
+
+namespace Registry {
+
+EntityRegistry EntityRegistry::from_config() {
+    EntityRegistry registry;
+
+    std::vector<std::string> missile_ids;
+    for (const auto& [id, _] : Config::MISSILES_INITIAL) {
+        missile_ids.push_back(id);
+    }
+    std::sort(missile_ids.begin(), missile_ids.end());
+    for (const auto& id : missile_ids) {
+        const auto& specs = Config::MISSILES_INITIAL.at(id);
+        registry.add_missile(id, specs.pos, specs.speed, specs.target);
+    }
+
+    std::vector<std::string> uav_ids;
+    for (const auto& [id, _] : Config::UAVS_INITIAL) {
+        uav_ids.push_back(id);
+    }
+    std::sort(uav_ids.begin(), uav_ids.end());
+    for (const auto& id : uav_ids) {
+        registry.add_uav(id, Config::UAVS_INITIAL.at(id).pos);
+    }
+
+    return registry;
+}
+
+const EntityRegistry& EntityRegistry::default_registry() {
+    return ScenarioLoader::active().entities;
+}
+
+EntityIndex EntityRegistry::add_uav(const std::string& id, const Vector3d& start_pos, int grenade_budget) {
+    auto it = uav_lookup_.find(id);
+    if (it != uav_lookup_.end()) {
+        return it->second;
+    }
+    EntityIndex index = uavs_.size();
+    uavs_.push_back({id, start_pos, grenade_budget});
+    uav_lookup_.emplace(id, index);
+    return index;
+}
+
+EntityIndex EntityRegistry::add_missile(const std::string& id, const Vector3d& start_pos,
+                                        double speed, const Vector3d& target) {
+    auto it = missile_lookup_.find(id);
+    if (it != missile_lookup_.end()) {
+        return it->second;
+    }
+    EntityIndex index = missiles_.size();
+    missiles_.push_back({id, start_pos, (target - start_pos).normalized(), speed, target});
+    missile_lookup_.emplace(id, index);
+    return index;
+}
+
+EntityIndex EntityRegistry::uav_index(const std::string& id) const {
+    auto it = uav_lookup_.find(id);
+    return it == uav_lookup_.end() ? INVALID_INDEX : it->second;
+}
+
+EntityIndex EntityRegistry::missile_index(const std::string& id) const {
+    auto it = missile_lookup_.find(id);
+    return it == missile_lookup_.end() ? INVALID_INDEX : it->second;
+}
+
+} // namespace Registry
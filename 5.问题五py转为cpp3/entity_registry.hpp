@@ -0,0 +1,89 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <Eigen/Dense>
+#include "config.hpp"
+
+using Vector3d = Eigen::Vector3d;
+
+namespace Registry {
+
+/**
+ * @brief 场景内实体的稠密整数索引
+ */
+using EntityIndex = int;
+constexpr EntityIndex INVALID_INDEX = -1;
+
+/**
+ * @brief 无人机条目
+ */
+struct UAVEntry {
+    std::string id;
+    Vector3d start_pos;
+    int grenade_budget = Config::MAX_GRENADES_PER_UAV;   // 可携带的弹药数
+};
+
+/**
+ * @brief 导弹条目 (方向与速度预先算好，热路径上不再查表)
+ */
+struct MissileEntry {
+    std::string id;
+    Vector3d start_pos;
+    Vector3d unit_vec;
+    double speed;
+    Vector3d target;
+};
+
+/**
+ * @brief 场景级实体注册表
+ *
+ * 把字符串ID一次性映射为稠密整数索引，热路径上的结构体只保存索引；
+ * 字符串只在输入输出边界 (解析配置、打印结果) 出现。
+ */
+class EntityRegistry {
+public:
+    EntityRegistry() = default;
+
+    /**
+     * @brief 由 Config 中的导弹和无人机构建，按ID排序，保证索引稳定
+     */
+    static EntityRegistry from_config();
+
+    /**
+     * @brief 当前生效场景 (ScenarioLoader::active) 的注册表
+     */
+    static const EntityRegistry& default_registry();
+
+    /**
+     * @brief 注册实体，ID已存在时返回原索引
+     */
+    EntityIndex add_uav(const std::string& id, const Vector3d& start_pos,
+                        int grenade_budget = Config::MAX_GRENADES_PER_UAV);
+    EntityIndex add_missile(const std::string& id, const Vector3d& start_pos,
+                            double speed, const Vector3d& target);
+
+    /**
+     * @brief 查找索引，未知ID返回 INVALID_INDEX
+     */
+    EntityIndex uav_index(const std::string& id) const;
+    EntityIndex missile_index(const std::string& id) const;
+
+    const UAVEntry& uav(EntityIndex index) const { return uavs_[index]; }
+    const MissileEntry& missile(EntityIndex index) const { return missiles_[index]; }
+
+    int num_uavs() const { return static_cast<int>(uavs_.size()); }
+    int num_missiles() const { return static_cast<int>(missiles_.size()); }
+
+    bool valid_uav(EntityIndex index) const { return index >= 0 && index < num_uavs(); }
+    bool valid_missile(EntityIndex index) const { return index >= 0 && index < num_missiles(); }
+
+private:
+    std::vector<UAVEntry> uavs_;
+    std::vector<MissileEntry> missiles_;
+    std::unordered_map<std::string, EntityIndex> uav_lookup_;
+    std::unordered_map<std::string, EntityIndex> missile_lookup_;
+};
+
+} // namespace Registry
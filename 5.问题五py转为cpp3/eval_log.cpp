@@ -0,0 +1,494 @@
+#include "eval_log.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+
+#ifdef SMOKE_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace EvalLog {
+
+namespace {
+
+constexpr char FILE_MAGIC[4] = {'E', 'V', 'L', 'G'};
+constexpr char BLOCK_MAGIC[4] = {'E', 'V', 'B', 'K'};
+constexpr char END_MAGIC[4] = {'E', 'V', 'E', 'N'};
+constexpr uint32_t FILE_VERSION = 1;
+
+std::atomic<uint64_t> next_logger_id{1};
+
+// 每线程最近使用的几个日志对象的缓冲区 (日志编号不复用，过期的项不会被误命中)
+struct CacheEntry {
+    uint64_t id = 0;
+    void* buffer = nullptr;
+};
+constexpr int CACHE_SIZE = 4;
+thread_local CacheEntry buffer_cache[CACHE_SIZE];
+thread_local int buffer_cache_next = 0;
+
+uint64_t mix64(uint64_t z) {
+    z += 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// 负载各列的元素宽度：thread、start_ns、cost_ns、各决策变量与输出
+std::vector<size_t> column_widths(int dimension, int num_outputs) {
+    std::vector<size_t> widths = {sizeof(uint32_t), sizeof(uint64_t), sizeof(uint64_t)};
+    widths.insert(widths.end(), static_cast<size_t>(dimension + num_outputs), sizeof(double));
+    return widths;
+}
+
+// 各列按字节平面重排 (同一列各元素的第 b 个字节相邻)，浮点列经此处理后 deflate 压缩率明显提高
+void shuffle_columns(const char* in, char* out, size_t rows, const std::vector<size_t>& widths, bool inverse) {
+    size_t offset = 0;
+    for (size_t width : widths) {
+        for (size_t i = 0; i < rows; ++i) {
+            for (size_t b = 0; b < width; ++b) {
+                const size_t plain = offset + i * width + b;
+                const size_t planar = offset + b * rows + i;
+                if (inverse) {
+                    out[plain] = in[planar];
+                } else {
+                    out[planar] = in[plain];
+                }
+            }
+        }
+        offset += rows * width;
+    }
+}
+
+template <class T>
+void put(std::ofstream& out, T value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+class ByteReader {
+public:
+    ByteReader(const std::string& bytes, size_t pos) : bytes_(bytes), pos_(pos) {}
+
+    bool has(size_t n) const { return pos_ + n <= bytes_.size(); }
+
+    template <class T>
+    T get() {
+        if (!has(sizeof(T))) {
+            throw std::runtime_error("评估日志文件头不完整");
+        }
+        T value;
+        std::memcpy(&value, bytes_.data() + pos_, sizeof(T));
+        pos_ += sizeof(T);
+        return value;
+    }
+
+    const char* take(size_t n) {
+        const char* p = bytes_.data() + pos_;
+        pos_ += n;
+        return p;
+    }
+
+private:
+    const std::string& bytes_;
+    size_t pos_;
+};
+
+} // namespace
+
+bool compression_available(Compression compression) {
+    switch (compression) {
+    case Compression::NONE:
+        return true;
+    case Compression::ZLIB:
+#ifdef SMOKE_HAVE_ZLIB
+        return true;
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+/**
+ * @brief 一个列块的缓冲区 (各列预留 block_rows 行)
+ */
+struct Logger::Block {
+    int rows = 0;
+    std::vector<uint32_t> thread;
+    std::vector<uint64_t> start_ns;
+    std::vector<uint64_t> cost_ns;
+    std::vector<double> values;     // 第 c 列 (决策变量在前、输出在后) 从 c * block_rows 开始
+};
+
+/**
+ * @brief 一个记录线程的状态，只由该线程访问 (关闭时由调用者收尾)
+ */
+struct Logger::ThreadBuffer {
+    uint32_t thread = 0;
+    uint64_t offered = 0;
+    uint64_t recorded = 0;
+    uint64_t sampled = 0;       // 抽稀命中的次数，作为抽样随机数的计数器
+    int countdown = 0;          // 距下一次抽稀命中还需跳过的评估数
+    std::unique_ptr<Block> block;
+};
+
+Logger::Logger(const std::string& path, const LogOptions& options)
+    : path_(path)
+    , options_(options)
+    , id_(next_logger_id.fetch_add(1))
+    , epoch_(std::chrono::steady_clock::now())
+{
+    if (options.dimension <= 0 || options.num_outputs < 0 || options.block_rows <= 0 ||
+        options.decimation <= 0 || options.max_pending_blocks <= 0) {
+        throw std::invalid_argument("评估日志参数无效: 维度、块行数、抽稀间隔和积压上限须为正数");
+    }
+    if (!(options.sample_rate >= 0.0 && options.sample_rate <= 1.0)) {
+        throw std::invalid_argument("评估日志抽样比例须在 [0, 1] 之间");
+    }
+    if (!compression_available(options.compression)) {
+        throw std::invalid_argument("当前构建不支持所选的评估日志压缩方式 (未找到 zlib)");
+    }
+    sample_threshold_ = options.sample_rate >= 1.0
+        ? ~0ull : static_cast<uint64_t>(options.sample_rate * 18446744073709551616.0);
+
+    file_.open(path, std::ios::binary | std::ios::trunc);
+    if (!file_) {
+        throw std::runtime_error("无法创建评估日志文件: " + path);
+    }
+    file_.write(FILE_MAGIC, sizeof(FILE_MAGIC));
+    put<uint32_t>(file_, FILE_VERSION);
+    put<uint32_t>(file_, static_cast<uint32_t>(options.dimension));
+    put<uint32_t>(file_, static_cast<uint32_t>(options.num_outputs));
+    put<uint32_t>(file_, static_cast<uint32_t>(options.block_rows));
+    put<uint32_t>(file_, static_cast<uint32_t>(options.decimation));
+    put<double>(file_, options.sample_rate);
+
+    writer_ = std::thread(&Logger::writer_loop, this);
+}
+
+Logger::~Logger() {
+    try {
+        close();
+    } catch (const std::exception& e) {
+        std::cerr << "评估日志关闭出错: " << e.what() << std::endl;
+    }
+}
+
+Logger::ThreadBuffer& Logger::buffer() {
+    for (const auto& entry : buffer_cache) {
+        if (entry.id == id_) {
+            return *static_cast<ThreadBuffer*>(entry.buffer);
+        }
+    }
+    return register_thread();
+}
+
+Logger::ThreadBuffer& Logger::register_thread() {
+    ThreadBuffer* buffer;
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        auto& slot = buffers_[std::this_thread::get_id()];
+        if (!slot) {
+            slot = std::make_unique<ThreadBuffer>();
+            slot->thread = static_cast<uint32_t>(buffers_.size() - 1);
+            slot->block = acquire_block();
+        }
+        buffer = slot.get();
+    }
+    buffer_cache[buffer_cache_next] = {id_, buffer};
+    buffer_cache_next = (buffer_cache_next + 1) % CACHE_SIZE;
+    return *buffer;
+}
+
+bool Logger::should_record() {
+    ThreadBuffer& b = buffer();
+    ++b.offered;
+    if (b.countdown > 0) {
+        --b.countdown;
+        return false;
+    }
+    b.countdown = options_.decimation - 1;
+    if (sample_threshold_ != ~0ull &&
+        mix64(options_.seed ^ mix64((static_cast<uint64_t>(b.thread) << 40) ^ b.sampled++)) >= sample_threshold_) {
+        return false;
+    }
+    return true;
+}
+
+void Logger::record(const double* variables, const double* outputs, uint64_t start_ns, uint64_t cost_ns) {
+    ThreadBuffer& b = buffer();
+    Block& block = *b.block;
+    const size_t row = static_cast<size_t>(block.rows);
+    const size_t capacity = static_cast<size_t>(options_.block_rows);
+    block.thread[row] = b.thread;
+    block.start_ns[row] = start_ns;
+    block.cost_ns[row] = cost_ns;
+    double* column = block.values.data() + row;
+    for (int j = 0; j < options_.dimension; ++j, column += capacity) {
+        *column = variables[j];
+    }
+    for (int k = 0; k < options_.num_outputs; ++k, column += capacity) {
+        *column = outputs[k];
+    }
+    ++b.recorded;
+    if (++block.rows == options_.block_rows) {
+        b.block = submit(std::move(b.block));
+    }
+}
+
+std::unique_ptr<Logger::Block> Logger::acquire_block() {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    if (!free_.empty()) {
+        auto block = std::move(free_.back());
+        free_.pop_back();
+        return block;
+    }
+    const size_t rows = static_cast<size_t>(options_.block_rows);
+    auto block = std::make_unique<Block>();
+    block->thread.resize(rows);
+    block->start_ns.resize(rows);
+    block->cost_ns.resize(rows);
+    block->values.resize(rows * static_cast<size_t>(options_.dimension + options_.num_outputs));
+    return block;
+}
+
+// 交出写满的块并换回一个空块；待写队列已满时等待后台线程
+std::unique_ptr<Logger::Block> Logger::submit(std::unique_ptr<Block> block) {
+    {
+        std::unique_lock<std::mutex> lock(queue_mutex_);
+        space_cv_.wait(lock, [&] { return static_cast<int>(queue_.size()) < options_.max_pending_blocks; });
+        queue_.push_back(std::move(block));
+    }
+    queue_cv_.notify_one();
+    return acquire_block();
+}
+
+void Logger::writer_loop() {
+    for (;;) {
+        std::unique_ptr<Block> block;
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+            queue_cv_.wait(lock, [&] { return !queue_.empty() || closing_; });
+            if (queue_.empty()) {
+                return;
+            }
+            block = std::move(queue_.front());
+            queue_.pop_front();
+        }
+        space_cv_.notify_one();
+
+        // 出错后继续取块 (丢弃)，避免记录线程在交块处一直等待
+        if (!error_) {
+            try {
+                write_block(*block);
+            } catch (...) {
+                error_ = std::current_exception();
+            }
+        }
+
+        block->rows = 0;
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        free_.push_back(std::move(block));
+    }
+}
+
+void Logger::write_block(const Block& block) {
+    const size_t rows = static_cast<size_t>(block.rows);
+    const size_t capacity = static_cast<size_t>(options_.block_rows);
+    const int num_values = options_.dimension + options_.num_outputs;
+
+    const size_t raw_size = rows * (sizeof(uint32_t) + 2 * sizeof(uint64_t) + num_values * sizeof(double));
+    auto write_header = [&](size_t stored_size) {
+        file_.write(BLOCK_MAGIC, sizeof(BLOCK_MAGIC));
+        put<uint32_t>(file_, static_cast<uint32_t>(rows));
+        put<uint32_t>(file_, static_cast<uint32_t>(options_.compression));
+        put<uint64_t>(file_, raw_size);
+        put<uint64_t>(file_, stored_size);
+    };
+
+    if (options_.compression == Compression::NONE) {
+        // 不压缩时各列直接从块缓冲区写出
+        write_header(raw_size);
+        file_.write(reinterpret_cast<const char*>(block.thread.data()), rows * sizeof(uint32_t));
+        file_.write(reinterpret_cast<const char*>(block.start_ns.data()), rows * sizeof(uint64_t));
+        file_.write(reinterpret_cast<const char*>(block.cost_ns.data()), rows * sizeof(uint64_t));
+        for (int c = 0; c < num_values; ++c) {
+            file_.write(reinterpret_cast<const char*>(block.values.data() + c * capacity), rows * sizeof(double));
+        }
+    }
+#ifdef SMOKE_HAVE_ZLIB
+    if (options_.compression == Compression::ZLIB) {
+        payload_.clear();
+        auto append = [&](const void* data, size_t bytes) {
+            const char* p = static_cast<const char*>(data);
+            payload_.insert(payload_.end(), p, p + bytes);
+        };
+        append(block.thread.data(), rows * sizeof(uint32_t));
+        append(block.start_ns.data(), rows * sizeof(uint64_t));
+        append(block.cost_ns.data(), rows * sizeof(uint64_t));
+        for (int c = 0; c < num_values; ++c) {
+            append(block.values.data() + c * capacity, rows * sizeof(double));
+        }
+
+        shuffled_.resize(payload_.size());
+        shuffle_columns(payload_.data(), shuffled_.data(), rows,
+                        column_widths(options_.dimension, options_.num_outputs), false);
+        uLongf size = compressBound(static_cast<uLong>(shuffled_.size()));
+        compressed_.resize(size);
+        if (compress2(reinterpret_cast<Bytef*>(compressed_.data()), &size,
+                      reinterpret_cast<const Bytef*>(shuffled_.data()), static_cast<uLong>(shuffled_.size()),
+                      options_.compression_level) != Z_OK) {
+            throw std::runtime_error("评估日志压缩失败");
+        }
+        write_header(size);
+        file_.write(compressed_.data(), static_cast<std::streamsize>(size));
+    }
+#endif
+    if (!file_) {
+        throw std::runtime_error("写入评估日志失败: " + path_);
+    }
+    ++blocks_written_;
+}
+
+void Logger::close() {
+    if (closed_) {
+        return;
+    }
+    closed_ = true;
+
+    // 各线程未满的块交给后台线程，汇总计数
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        for (auto& entry : buffers_) {
+            ThreadBuffer& b = *entry.second;
+            offered_ += b.offered;
+            recorded_ += b.recorded;
+            if (b.block->rows > 0) {
+                b.block = submit(std::move(b.block));
+            }
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        closing_ = true;
+    }
+    queue_cv_.notify_one();
+    writer_.join();
+
+    if (!error_) {
+        file_.write(END_MAGIC, sizeof(END_MAGIC));
+        put<uint64_t>(file_, offered_);
+        put<uint64_t>(file_, recorded_);
+        put<uint64_t>(file_, blocks_written_);
+        file_.close();
+        if (!file_) {
+            error_ = std::make_exception_ptr(std::runtime_error("写入评估日志失败: " + path_));
+        }
+    }
+    if (error_) {
+        std::rethrow_exception(error_);
+    }
+}
+
+LogData read_log(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("无法打开评估日志文件: " + path);
+    }
+    const std::string bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (bytes.size() < sizeof(FILE_MAGIC) || std::memcmp(bytes.data(), FILE_MAGIC, sizeof(FILE_MAGIC)) != 0) {
+        throw std::runtime_error("不是评估日志文件: " + path);
+    }
+
+    ByteReader r(bytes, sizeof(FILE_MAGIC));
+    const uint32_t version = r.get<uint32_t>();
+    if (version != FILE_VERSION) {
+        throw std::runtime_error("不支持的评估日志版本: " + std::to_string(version));
+    }
+    LogData data;
+    data.dimension = static_cast<int>(r.get<uint32_t>());
+    data.num_outputs = static_cast<int>(r.get<uint32_t>());
+    r.get<uint32_t>();      // 块行数
+    r.get<uint32_t>();      // 抽稀
+    r.get<double>();        // 抽样比例
+    data.variables.resize(data.dimension);
+    data.outputs.resize(data.num_outputs);
+    const auto widths = column_widths(data.dimension, data.num_outputs);
+
+    std::vector<char> payload;
+    for (;;) {
+        if (!r.has(sizeof(BLOCK_MAGIC))) {
+            break;
+        }
+        const char* tag = r.take(sizeof(BLOCK_MAGIC));
+        if (std::memcmp(tag, END_MAGIC, sizeof(END_MAGIC)) == 0) {
+            if (r.has(3 * sizeof(uint64_t))) {
+                data.offered = r.get<uint64_t>();
+                data.complete = true;
+            }
+            break;
+        }
+        if (std::memcmp(tag, BLOCK_MAGIC, sizeof(BLOCK_MAGIC)) != 0 || !r.has(24)) {
+            break;
+        }
+        const size_t rows = r.get<uint32_t>();
+        const auto compression = static_cast<Compression>(r.get<uint32_t>());
+        const size_t raw_size = r.get<uint64_t>();
+        const size_t stored_size = r.get<uint64_t>();
+        size_t expected = 0;
+        for (size_t width : widths) {
+            expected += rows * width;
+        }
+        if (raw_size != expected) {
+            throw std::runtime_error("评估日志列块大小与文件头不符");
+        }
+        if (!r.has(stored_size)) {
+            break;      // 写到一半的块
+        }
+        const char* stored = r.take(stored_size);
+
+        if (compression == Compression::NONE) {
+            payload.assign(stored, stored + stored_size);
+        } else if (compression == Compression::ZLIB) {
+#ifdef SMOKE_HAVE_ZLIB
+            std::vector<char> shuffled(raw_size);
+            uLongf size = static_cast<uLongf>(raw_size);
+            if (uncompress(reinterpret_cast<Bytef*>(shuffled.data()), &size,
+                           reinterpret_cast<const Bytef*>(stored), static_cast<uLong>(stored_size)) != Z_OK ||
+                size != raw_size) {
+                throw std::runtime_error("评估日志列块解压失败");
+            }
+            payload.resize(raw_size);
+            shuffle_columns(shuffled.data(), payload.data(), rows, widths, true);
+#else
+            throw std::runtime_error("当前构建不支持读取压缩的评估日志 (未找到 zlib)");
+#endif
+        } else {
+            throw std::runtime_error("未知的评估日志压缩方式");
+        }
+
+        const char* p = payload.data();
+        auto read_column = [&](auto& column) {
+            using T = typename std::decay_t<decltype(column)>::value_type;
+            const size_t old = column.size();
+            column.resize(old + rows);
+            std::memcpy(column.data() + old, p, rows * sizeof(T));
+            p += rows * sizeof(T);
+        };
+        read_column(data.thread);
+        read_column(data.start_ns);
+        read_column(data.cost_ns);
+        for (auto& column : data.variables) {
+            read_column(column);
+        }
+        for (auto& column : data.outputs) {
+            read_column(column);
+        }
+    }
+    return data;
+}
+
+} // namespace EvalLog
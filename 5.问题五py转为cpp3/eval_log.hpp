@@ -0,0 +1,185 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace EvalLog {
+
+/**
+ * @brief 列块的压缩方式
+ */
+enum class Compression : uint32_t {
+    NONE = 0,
+    ZLIB = 1    // 按字节平面重排各列后 deflate (构建时找到 zlib 才可用)
+};
+
+/**
+ * @brief 当前构建是否支持该压缩方式
+ */
+bool compression_available(Compression compression);
+
+/**
+ * @brief 评估日志参数
+ */
+struct LogOptions {
+    int dimension = 0;              // 决策变量维度
+    int num_outputs = 1;            // 每次评估记录的输出个数 (如各导弹的遮蔽时间)
+    int block_rows = 4096;          // 每个列块的行数，线程缓冲区写满一块即交给后台线程
+    int decimation = 1;             // 抽稀：每个线程每 N 次评估取一次
+    double sample_rate = 1.0;       // 抽样：抽稀后再按此比例随机保留
+    uint64_t seed = 0;              // 抽样随机数种子
+    bool record_cost = true;        // 记录评估开始时刻与耗时 (关闭时两列为 0，省去计时)
+    Compression compression = Compression::NONE;
+    int compression_level = 1;
+    int max_pending_blocks = 64;    // 等待写入的块数上限，后台写入跟不上时记录线程在交块处等待
+};
+
+/**
+ * @brief 异步列式评估日志
+ *
+ * 每个记录线程写自己的列缓冲区 (热路径无锁、无共享计数器)，写满一块后交给后台线程编码为定长二进制列块
+ * 并写入文件，交块时才加一次锁。抽稀和抽样在各线程内独立判断，被跳过的评估只增加一个线程局部计数。
+ *
+ * 文件格式 (小端)：文件头 "EVLG"、版本、维度、输出数、块行数、抽稀、抽样比例；之后是若干列块，
+ * 每块为 "EVBK"、行数、压缩方式、原始字节数、存储字节数和负载，负载依次为 thread (u32)、start_ns (u64)、
+ * cost_ns (u64)、各决策变量 (f64) 和各输出 (f64) 的整列；close 时写入 "EVEN"、评估总数、记录总数与块数。
+ * 没有结尾标记的文件 (进程中断) 仍可读出已写入的完整块。
+ */
+class Logger {
+public:
+    Logger(const std::string& path, const LogOptions& options);
+    ~Logger();
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    /**
+     * @brief 本次评估是否记录 (按抽稀和抽样判断)；返回 true 后须在同一线程调用 record
+     */
+    bool should_record();
+
+    /**
+     * @brief 记录一次评估
+     *
+     * @param variables 决策变量 (dimension 个)
+     * @param outputs 输出 (num_outputs 个)
+     * @param start_ns 评估开始时刻 (now_ns)
+     * @param cost_ns 评估耗时
+     */
+    void record(const double* variables, const double* outputs, uint64_t start_ns, uint64_t cost_ns);
+
+    /**
+     * @brief 日志创建以来的纳秒数 (record_cost 关闭时为 0)
+     */
+    uint64_t now_ns() const {
+        if (!options_.record_cost) {
+            return 0;
+        }
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - epoch_).count());
+    }
+
+    /**
+     * @brief 写出各线程未满的块和结尾标记并关闭文件；须在没有线程记录时调用
+     *
+     * 后台写入出错时在此抛出；析构时若尚未关闭则自动关闭 (出错只打印)。
+     */
+    void close();
+
+    const LogOptions& options() const { return options_; }
+
+    /**
+     * @brief 经过 should_record 的评估总数与实际记录数 (close 之后有效)
+     */
+    uint64_t offered() const { return offered_; }
+    uint64_t recorded() const { return recorded_; }
+
+private:
+    struct Block;
+    struct ThreadBuffer;
+
+    std::string path_;
+    LogOptions options_;
+    uint64_t id_;
+    uint64_t sample_threshold_;
+    std::chrono::steady_clock::time_point epoch_;
+
+    std::mutex registry_mutex_;
+    std::unordered_map<std::thread::id, std::unique_ptr<ThreadBuffer>> buffers_;
+
+    std::mutex queue_mutex_;
+    std::condition_variable queue_cv_;      // 有块待写或正在关闭
+    std::condition_variable space_cv_;      // 待写队列有空位
+    std::deque<std::unique_ptr<Block>> queue_;
+    std::vector<std::unique_ptr<Block>> free_;
+    bool closing_ = false;
+    bool closed_ = false;
+
+    std::ofstream file_;
+    std::thread writer_;
+    std::exception_ptr error_;
+    std::vector<char> payload_;             // 以下仅后台线程使用
+    std::vector<char> shuffled_;
+    std::vector<char> compressed_;
+    uint64_t blocks_written_ = 0;
+    uint64_t offered_ = 0;
+    uint64_t recorded_ = 0;
+
+    ThreadBuffer& buffer();
+    ThreadBuffer& register_thread();
+    std::unique_ptr<Block> acquire_block();
+    std::unique_ptr<Block> submit(std::unique_ptr<Block> block);
+    void writer_loop();
+    void write_block(const Block& block);
+};
+
+/**
+ * @brief 包装目标函数：按日志的抽样设置记录决策变量、目标值 (num_outputs 须为 1) 与评估耗时
+ *
+ * 适用于以 Eigen 向量为参数的目标函数 (经典 DE、自适应 DE 等)。
+ */
+template <class Objective>
+auto logged(Objective objective, Logger& logger) {
+    return [objective = std::move(objective), &logger](const auto& x) {
+        if (!logger.should_record()) {
+            return objective(x);
+        }
+        const uint64_t start = logger.now_ns();
+        const double value = objective(x);
+        logger.record(x.data(), &value, start, logger.now_ns() - start);
+        return value;
+    };
+}
+
+/**
+ * @brief 读出的评估日志，各列按行对齐
+ */
+struct LogData {
+    int dimension = 0;
+    int num_outputs = 0;
+    std::vector<uint32_t> thread;                   // 记录缓冲区编号 (每个记录线程一个)
+    std::vector<uint64_t> start_ns;
+    std::vector<uint64_t> cost_ns;
+    std::vector<std::vector<double>> variables;     // variables[j][行]
+    std::vector<std::vector<double>> outputs;       // outputs[k][行]
+    bool complete = false;                          // 是否读到结尾标记
+    uint64_t offered = 0;                           // 评估总数 (仅 complete 时有效)
+
+    size_t rows() const { return thread.size(); }
+};
+
+/**
+ * @brief 读取评估日志文件；文件末尾不完整的块被忽略
+ */
+LogData read_log(const std::string& path);
+
+} // namespace EvalLog
@@ -0,0 +1,53 @@
+#include "eval_service.hpp"
+#include "scenario.hpp"
+#include <csignal>
+#include <iostream>
+#include <string>
+#include <pthread.h>
+
+/**
+ * @brief 常驻策略评估服务
+ *
+ * 在 Unix 域套接字上接受评估请求 (协议见 eval_service.hpp)，收到 SIGINT/SIGTERM 时关闭连接、删除套接字文件并打印计数。
+ *
+ * 用法: eval_server <套接字路径> [场景文件] [时间步长=0.1]
+ */
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cout << "用法: eval_server <套接字路径> [场景文件] [时间步长=0.1]" << std::endl;
+        return 1;
+    }
+    try {
+        if (argc > 2 && std::string(argv[2]) != "-") {
+            ScenarioLoader::set_active(ScenarioLoader::load_file(argv[2]));
+        }
+        EvalService::ServerSettings settings;
+        settings.socket_path = argv[1];
+        settings.time_step = argc > 3 ? std::stod(argv[3]) : 0.1;
+
+        // 信号在创建任何线程之前屏蔽，由主线程同步等待
+        sigset_t signals;
+        sigemptyset(&signals);
+        sigaddset(&signals, SIGINT);
+        sigaddset(&signals, SIGTERM);
+        pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+        const auto& scenario = ScenarioLoader::active();
+        EvalService::Server server(scenario, settings);
+        server.start();
+        std::cout << "评估服务已就绪: " << settings.socket_path << " (场景 " << scenario.name << "，无人机 "
+                  << scenario.entities.num_uavs() << "，导弹 " << scenario.entities.num_missiles() << "，时间步长 "
+                  << settings.time_step << " s)" << std::endl;
+
+        int received = 0;
+        sigwait(&signals, &received);
+        server.stop();
+        const auto stats = server.stats();
+        std::cout << "评估服务已停止：连接 " << stats.connections << "，请求 " << stats.requests << "，策略 "
+                  << stats.strategies << "，出错请求 " << stats.errors << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "评估服务出错: " << e.what() << std::endl;
+        return 1;
+    }
+}
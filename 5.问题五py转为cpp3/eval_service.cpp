@@ -0,0 +1,741 @@
+#include "eval_service.hpp"
+#include "optimizer.hpp"
+#include "work_pool.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace EvalService {
+
+namespace {
+
+constexpr size_t READ_CHUNK = 1 << 16;
+
+// ------------------------------------------------------------------
+// 帧编码 (小端，直接追加到发送缓冲区)
+// ------------------------------------------------------------------
+
+void put_raw(std::string& out, const void* data, size_t size) {
+    out.append(static_cast<const char*>(data), size);
+}
+void put_u8(std::string& out, uint8_t v) { out.push_back(static_cast<char>(v)); }
+void put_u32(std::string& out, uint32_t v) { put_raw(out, &v, sizeof(v)); }
+void put_u64(std::string& out, uint64_t v) { put_raw(out, &v, sizeof(v)); }
+void put_f64(std::string& out, double v) { put_raw(out, &v, sizeof(v)); }
+void put_str(std::string& out, const std::string& s) {
+    put_u32(out, static_cast<uint32_t>(s.size()));
+    put_raw(out, s.data(), s.size());
+}
+
+/**
+ * @brief 写入帧头 (长度待 end_frame 回填)，返回帧起点
+ */
+size_t begin_frame(std::string& out, uint32_t id, uint8_t op, uint8_t b1, uint8_t b2, uint8_t b3, uint32_t count) {
+    const size_t start = out.size();
+    put_u32(out, 0);
+    put_u32(out, id);
+    put_u8(out, op);
+    put_u8(out, b1);
+    put_u8(out, b2);
+    put_u8(out, b3);
+    put_u32(out, count);
+    return start;
+}
+
+void end_frame(std::string& out, size_t start) {
+    const uint32_t length = static_cast<uint32_t>(out.size() - start - sizeof(uint32_t));
+    std::memcpy(&out[start], &length, sizeof(length));
+}
+
+size_t begin_response(std::string& out, uint32_t id, Op op, Status status, uint32_t count) {
+    // 状态之后的两个字节为保留的 u16
+    return begin_frame(out, id, static_cast<uint8_t>(op), static_cast<uint8_t>(status), 0, 0, count);
+}
+
+void error_response(std::string& out, uint32_t id, Op op, Status status, const std::string& message) {
+    const size_t start = begin_response(out, id, op, status, 0);
+    put_str(out, message);
+    end_frame(out, start);
+}
+
+/**
+ * @brief 有界读取，越界时抛出 std::runtime_error
+ */
+class FrameReader {
+public:
+    FrameReader(const char* data, size_t size) : data_(data), size_(size) {}
+    void raw(void* out, size_t size) {
+        if (size > size_ - pos_) {
+            throw std::runtime_error("协议帧被截断");
+        }
+        std::memcpy(out, data_ + pos_, size);
+        pos_ += size;
+    }
+    uint8_t u8() { uint8_t v; raw(&v, sizeof(v)); return v; }
+    uint16_t u16() { uint16_t v; raw(&v, sizeof(v)); return v; }
+    uint32_t u32() { uint32_t v; raw(&v, sizeof(v)); return v; }
+    uint64_t u64() { uint64_t v; raw(&v, sizeof(v)); return v; }
+    double f64() { double v; raw(&v, sizeof(v)); return v; }
+    std::string str() {
+        const uint32_t size = u32();
+        if (size > size_ - pos_) {
+            throw std::runtime_error("协议帧被截断");
+        }
+        std::string s(data_ + pos_, size);
+        pos_ += size;
+        return s;
+    }
+    const char* here() const { return data_ + pos_; }
+    size_t remaining() const { return size_ - pos_; }
+
+private:
+    const char* data_;
+    size_t size_;
+    size_t pos_ = 0;
+};
+
+/**
+ * @brief 写出全部字节 (对端关闭时不产生 SIGPIPE)，失败返回 false
+ */
+bool write_all(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        const ssize_t n = ::send(fd, data, size, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+/**
+ * @brief 决策变量转为扁平策略 (按无人机索引升序)
+ */
+void to_flat(const Shape& shape, const double* v, Optimizer::FlatStrategy& flat) {
+    const int grenades = shape.grenades_per_uav;
+    flat.resize(shape.uavs.size());
+    for (size_t u = 0; u < shape.uavs.size(); ++u, v += 2 + 2 * grenades) {
+        auto& record = flat[u];
+        record.uav = shape.uavs[u];
+        record.num_grenades = grenades;
+        record.speed = v[0];
+        record.angle = v[1];
+        double t_deploy = v[2];
+        for (int g = 0; g < grenades; ++g) {
+            if (g > 0) {
+                t_deploy += v[2 + 2 * g];
+            }
+            record.grenades[g] = {t_deploy, v[3 + 2 * g]};
+        }
+    }
+    std::sort(flat.begin(), flat.end(), [](const Optimizer::FlatUAVStrategy& a, const Optimizer::FlatUAVStrategy& b) {
+        return a.uav < b.uav;
+    });
+}
+
+std::string system_error(const std::string& what) {
+    return what + ": " + std::strerror(errno);
+}
+
+} // namespace
+
+std::string status_name(Status status) {
+    switch (status) {
+        case Status::OK: return "OK";
+        case Status::BAD_REQUEST: return "请求无效";
+        case Status::UNKNOWN_OP: return "未知操作";
+        case Status::TOO_LARGE: return "请求过大";
+        case Status::INTERNAL: return "服务端内部错误";
+    }
+    return "未知状态";
+}
+
+// ------------------------------------------------------------------
+// 服务端
+// ------------------------------------------------------------------
+
+Server::Server(const ScenarioLoader::Scenario& scenario, const ServerSettings& settings)
+    : scenario_(scenario), settings_(settings) {
+    if (settings_.socket_path.empty() || settings_.socket_path.size() >= sizeof(sockaddr_un::sun_path)) {
+        throw std::invalid_argument("评估服务的套接字路径为空或过长: " + settings_.socket_path);
+    }
+    if (!(settings_.time_step > 0.0)) {
+        throw std::invalid_argument("评估服务的时间步长须为正");
+    }
+    if (settings_.parallel_threshold < 1 || settings_.max_connections < 1 ||
+        settings_.max_request_bytes < HEADER_BYTES) {
+        throw std::invalid_argument("评估服务的并行阈值、连接数上限或请求长度上限无效");
+    }
+    if (scenario_.entities.num_uavs() > 255 || scenario_.entities.num_missiles() > 255) {
+        throw std::invalid_argument("评估服务协议用 u8 实体索引，场景中的无人机和导弹都不能超过 255 个");
+    }
+
+    // 每枚导弹单独和全部导弹的评估器预先建好
+    std::vector<uint8_t> all;
+    for (int m = 0; m < scenario_.entities.num_missiles(); ++m) {
+        model({static_cast<uint8_t>(m)});
+        all.push_back(static_cast<uint8_t>(m));
+    }
+    if (!all.empty()) {
+        model(all);
+    }
+}
+
+Server::~Server() {
+    stop();
+}
+
+void Server::start() {
+    if (listen_fd_ >= 0) {
+        throw std::runtime_error("评估服务已经启动");
+    }
+    stopping_ = false;
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, settings_.socket_path.c_str(), sizeof(address.sun_path) - 1);
+
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        throw std::runtime_error(system_error("无法创建评估服务套接字"));
+    }
+    ::unlink(settings_.socket_path.c_str());
+    if (::bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 || ::listen(fd, 128) != 0) {
+        const std::string message = system_error("无法监听评估服务套接字 " + settings_.socket_path);
+        ::close(fd);
+        throw std::runtime_error(message);
+    }
+    if (::pipe2(wake_pipe_, O_CLOEXEC) != 0) {
+        const std::string message = system_error("无法创建评估服务的唤醒管道");
+        ::close(fd);
+        ::unlink(settings_.socket_path.c_str());
+        throw std::runtime_error(message);
+    }
+    listen_fd_ = fd;
+    accept_thread_ = std::thread([this] { accept_loop(); });
+}
+
+void Server::stop() {
+    if (listen_fd_ < 0) {
+        return;
+    }
+    stopping_ = true;
+    const char wake = 1;
+    if (::write(wake_pipe_[1], &wake, 1) < 0) {
+        // 管道写满也说明接受线程已被唤醒
+    }
+    accept_thread_.join();
+
+    // 关闭读写两端使连接线程的 recv 返回，再等待它们写完当前应答退出
+    {
+        std::lock_guard<std::mutex> lock(connections_mutex_);
+        for (auto& connection : connections_) {
+            if (connection.fd >= 0) {
+                ::shutdown(connection.fd, SHUT_RDWR);
+            }
+        }
+    }
+    for (auto& connection : connections_) {
+        connection.thread.join();
+    }
+    connections_.clear();
+
+    ::close(listen_fd_);
+    ::close(wake_pipe_[0]);
+    ::close(wake_pipe_[1]);
+    listen_fd_ = -1;
+    wake_pipe_[0] = wake_pipe_[1] = -1;
+    ::unlink(settings_.socket_path.c_str());
+}
+
+Stats Server::stats() const {
+    Stats stats;
+    stats.connections = num_connections_.load(std::memory_order_relaxed);
+    stats.requests = num_requests_.load(std::memory_order_relaxed);
+    stats.strategies = num_strategies_.load(std::memory_order_relaxed);
+    stats.errors = num_errors_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void Server::accept_loop() {
+    pollfd fds[2] = {{listen_fd_, POLLIN, 0}, {wake_pipe_[0], POLLIN, 0}};
+    while (!stopping_) {
+        if (::poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        if (fds[1].revents != 0) {
+            return;
+        }
+        if ((fds[0].revents & POLLIN) == 0) {
+            continue;
+        }
+        const int fd = ::accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0) {
+            continue;
+        }
+
+        // 回收已结束的连接
+        std::lock_guard<std::mutex> lock(connections_mutex_);
+        for (auto it = connections_.begin(); it != connections_.end();) {
+            if (it->done) {
+                it->thread.join();
+                it = connections_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        if (static_cast<int>(connections_.size()) >= settings_.max_connections) {
+            ::close(fd);
+            continue;
+        }
+        connections_.emplace_back();
+        Connection& connection = connections_.back();
+        connection.fd = fd;
+        connection.thread = std::thread([this, &connection] { serve(connection); });
+        num_connections_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void Server::serve(Connection& connection) {
+    const int fd = connection.fd;
+    std::vector<char> buffer(READ_CHUNK);
+    size_t begin = 0;
+    size_t end = 0;
+    std::string out;
+
+    for (bool open = true; open;) {
+        // 缓冲区尾部不足一次读取时先把未处理的字节移到开头，仍不足再扩大
+        if (buffer.size() - end < READ_CHUNK / 4) {
+            if (begin > 0) {
+                std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+                end -= begin;
+                begin = 0;
+            }
+            if (buffer.size() - end < READ_CHUNK / 4) {
+                buffer.resize(buffer.size() * 2);
+            }
+        }
+        const ssize_t n = ::recv(fd, buffer.data() + end, buffer.size() - end, 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+        end += static_cast<size_t>(n);
+
+        // 处理缓冲区里全部完整的请求，应答合并写出
+        while (end - begin >= sizeof(uint32_t)) {
+            uint32_t length;
+            std::memcpy(&length, buffer.data() + begin, sizeof(length));
+            const size_t frame_bytes = sizeof(uint32_t) + static_cast<size_t>(length);
+            if (frame_bytes < HEADER_BYTES || frame_bytes > settings_.max_request_bytes) {
+                num_errors_.fetch_add(1, std::memory_order_relaxed);
+                error_response(out, 0, Op::PING, Status::TOO_LARGE,
+                               "请求帧长度 " + std::to_string(frame_bytes) + " 字节不在 [16, " +
+                               std::to_string(settings_.max_request_bytes) + "] 内");
+                open = false;
+                break;
+            }
+            if (end - begin < frame_bytes) {
+                if (buffer.size() - begin < frame_bytes) {
+                    std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+                    end -= begin;
+                    begin = 0;
+                    buffer.resize(std::max(buffer.size(), frame_bytes + READ_CHUNK / 4));
+                }
+                break;
+            }
+            handle(buffer.data() + begin, frame_bytes, out);
+            begin += frame_bytes;
+        }
+        if (begin == end) {
+            begin = end = 0;
+        }
+        if (!out.empty()) {
+            if (!write_all(fd, out.data(), out.size())) {
+                break;
+            }
+            out.clear();
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(connections_mutex_);
+    ::close(connection.fd);
+    connection.fd = -1;
+    connection.done = true;
+}
+
+void Server::handle(const char* frame, size_t size, std::string& out) {
+    FrameReader reader(frame, size);
+    reader.u32();
+    const uint32_t id = reader.u32();
+    const Op op = static_cast<Op>(reader.u8());
+    Shape shape;
+    const int num_uavs = reader.u8();
+    shape.grenades_per_uav = reader.u8();
+    const int num_missiles = reader.u8();
+    const uint32_t count = reader.u32();
+    num_requests_.fetch_add(1, std::memory_order_relaxed);
+
+    const size_t rollback = out.size();
+    try {
+        switch (op) {
+            case Op::PING: {
+                end_frame(out, begin_response(out, id, op, Status::OK, 0));
+                return;
+            }
+            case Op::DESCRIBE: {
+                const auto& entities = scenario_.entities;
+                const size_t start = begin_response(out, id, op, Status::OK, 0);
+                put_u64(out, scenario_.content_hash);
+                put_f64(out, settings_.time_step);
+                put_u32(out, static_cast<uint32_t>(entities.num_uavs()));
+                for (int u = 0; u < entities.num_uavs(); ++u) {
+                    put_str(out, entities.uav(u).id);
+                    put_u32(out, static_cast<uint32_t>(entities.uav(u).grenade_budget));
+                }
+                put_u32(out, static_cast<uint32_t>(entities.num_missiles()));
+                for (int m = 0; m < entities.num_missiles(); ++m) {
+                    put_str(out, entities.missile(m).id);
+                }
+                end_frame(out, start);
+                return;
+            }
+            case Op::STATS: {
+                const Stats current = stats();
+                const size_t start = begin_response(out, id, op, Status::OK, 0);
+                for (uint64_t v : {current.connections, current.requests, current.strategies, current.errors}) {
+                    put_u64(out, v);
+                }
+                end_frame(out, start);
+                return;
+            }
+            case Op::EVALUATE:
+                break;
+            default:
+                num_errors_.fetch_add(1, std::memory_order_relaxed);
+                error_response(out, id, op, Status::UNKNOWN_OP,
+                               "未知操作 " + std::to_string(static_cast<int>(op)));
+                return;
+        }
+
+        // 形状与负载长度
+        std::string problem;
+        const uint64_t dimension = static_cast<uint64_t>(num_uavs) * (2 + 2 * shape.grenades_per_uav);
+        if (num_uavs < 1 || num_missiles < 1) {
+            problem = "无人机数和导弹数须为正";
+        } else if (shape.grenades_per_uav < 1 || shape.grenades_per_uav > Config::MAX_GRENADES_PER_UAV) {
+            problem = "每机弹药数须在 [1, " + std::to_string(Config::MAX_GRENADES_PER_UAV) + "] 内";
+        } else if (reader.remaining() != num_uavs + num_missiles + dimension * count * sizeof(double)) {
+            problem = "负载长度与形状和策略数不符";
+        } else {
+            shape.uavs.resize(num_uavs);
+            shape.missiles.resize(num_missiles);
+            reader.raw(shape.uavs.data(), num_uavs);
+            reader.raw(shape.missiles.data(), num_missiles);
+            std::vector<uint8_t> sorted = shape.uavs;
+            std::sort(sorted.begin(), sorted.end());
+            if (std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end() ||
+                sorted.back() >= scenario_.entities.num_uavs()) {
+                problem = "无人机索引重复或不在场景中";
+            } else if (*std::max_element(shape.missiles.begin(), shape.missiles.end()) >=
+                       scenario_.entities.num_missiles()) {
+                problem = "导弹索引不在场景中";
+            }
+        }
+        if (!problem.empty()) {
+            num_errors_.fetch_add(1, std::memory_order_relaxed);
+            error_response(out, id, op, Status::BAD_REQUEST, problem);
+            return;
+        }
+
+        const size_t start = begin_response(out, id, op, Status::OK, count);
+        evaluate(shape, reader.here(), count, out);
+        end_frame(out, start);
+        num_strategies_.fetch_add(count, std::memory_order_relaxed);
+    } catch (const std::exception& e) {
+        out.resize(rollback);
+        num_errors_.fetch_add(1, std::memory_order_relaxed);
+        error_response(out, id, op, Status::INTERNAL, e.what());
+    }
+}
+
+void Server::evaluate(const Shape& shape, const char* variables, uint32_t count, std::string& out) {
+    const FastEvaluator::ObscurationEvaluator& evaluator = model(shape.missiles);
+    const int dimension = shape.dimension();
+    const int num_missiles = static_cast<int>(shape.missiles.size());
+
+    // 应答负载先占好位置，各策略写入互不重叠的区间
+    const size_t status_offset = out.size();
+    const size_t times_offset = status_offset + count;
+    out.resize(times_offset + static_cast<size_t>(count) * num_missiles * sizeof(double));
+    char* status_out = &out[status_offset];
+    char* times_out = &out[times_offset];
+
+    auto body = [&](int i) {
+        thread_local std::vector<double> x;
+        thread_local std::vector<double> times;
+        thread_local Optimizer::FlatStrategy flat;
+        thread_local std::vector<FastEvaluator::CloudState> clouds;
+
+        x.resize(dimension);
+        std::memcpy(x.data(), variables + static_cast<size_t>(i) * dimension * sizeof(double),
+                    dimension * sizeof(double));
+        to_flat(shape, x.data(), flat);
+        const Optimizer::StrategyStatus status = FastEvaluator::try_build_clouds(flat, clouds, scenario_);
+        times.assign(num_missiles, 0.0);
+        if (status == Optimizer::StrategyStatus::OK) {
+            evaluator.evaluate(clouds, times.data());
+        }
+        status_out[i] = static_cast<char>(status);
+        std::memcpy(times_out + static_cast<size_t>(i) * num_missiles * sizeof(double), times.data(),
+                    num_missiles * sizeof(double));
+    };
+
+    if (static_cast<int>(count) >= settings_.parallel_threshold) {
+        WorkPool::Pool::global().parallel_for(static_cast<int>(count), body, settings_.num_threads);
+    } else {
+        for (uint32_t i = 0; i < count; ++i) {
+            body(static_cast<int>(i));
+        }
+    }
+}
+
+const FastEvaluator::ObscurationEvaluator& Server::model(const std::vector<uint8_t>& missiles) {
+    {
+        std::shared_lock<std::shared_mutex> lock(models_mutex_);
+        auto it = models_.find(missiles);
+        if (it != models_.end()) {
+            return *it->second;
+        }
+    }
+    std::unique_lock<std::shared_mutex> lock(models_mutex_);
+    auto& slot = models_[missiles];
+    if (!slot) {
+        const std::vector<Registry::EntityIndex> indices(missiles.begin(), missiles.end());
+        slot = std::make_unique<FastEvaluator::ObscurationEvaluator>(indices, scenario_, settings_.time_step);
+        slot->set_time_chunks(settings_.time_chunks);
+    }
+    return *slot;
+}
+
+// ------------------------------------------------------------------
+// 客户端
+// ------------------------------------------------------------------
+
+Client::Client(const std::string& socket_path) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socket_path.empty() || socket_path.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("评估服务的套接字路径为空或过长: " + socket_path);
+    }
+    std::strncpy(address.sun_path, socket_path.c_str(), sizeof(address.sun_path) - 1);
+    fd_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd_ < 0) {
+        throw std::runtime_error(system_error("无法创建套接字"));
+    }
+    if (::connect(fd_, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        const std::string message = system_error("无法连接评估服务 " + socket_path);
+        ::close(fd_);
+        throw std::runtime_error(message);
+    }
+}
+
+Client::~Client() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+const Description& Client::describe() {
+    if (!described_) {
+        description_ = call(Op::DESCRIBE).description;
+        described_ = true;
+    }
+    return description_;
+}
+
+Shape Client::shape(const std::vector<std::string>& uavs, int grenades_per_uav,
+                    const std::vector<std::string>& missiles) {
+    const Description& description = describe();
+    auto lookup = [](const std::vector<std::string>& names, const std::string& id) {
+        const auto it = std::find(names.begin(), names.end(), id);
+        if (it == names.end()) {
+            throw std::runtime_error("评估服务的场景中没有实体 " + id);
+        }
+        return static_cast<uint8_t>(it - names.begin());
+    };
+    Shape shape;
+    shape.grenades_per_uav = grenades_per_uav;
+    for (const auto& id : uavs) {
+        shape.uavs.push_back(lookup(description.uavs, id));
+    }
+    for (const auto& id : missiles) {
+        shape.missiles.push_back(lookup(description.missiles, id));
+    }
+    return shape;
+}
+
+Response Client::evaluate(const Shape& shape, const double* variables, uint32_t count) {
+    send_evaluate(shape, variables, count);
+    Response response;
+    receive(response);
+    if (response.status != Status::OK) {
+        throw std::runtime_error("评估服务返回 " + status_name(response.status) + ": " + response.error);
+    }
+    return response;
+}
+
+void Client::ping() {
+    call(Op::PING);
+}
+
+Stats Client::stats() {
+    return call(Op::STATS).stats;
+}
+
+uint32_t Client::send_evaluate(const Shape& shape, const double* variables, uint32_t count) {
+    const uint32_t id = next_id_++;
+    const size_t start = begin_frame(out_, id, static_cast<uint8_t>(Op::EVALUATE),
+                                     static_cast<uint8_t>(shape.uavs.size()),
+                                     static_cast<uint8_t>(shape.grenades_per_uav),
+                                     static_cast<uint8_t>(shape.missiles.size()), count);
+    put_raw(out_, shape.uavs.data(), shape.uavs.size());
+    put_raw(out_, shape.missiles.data(), shape.missiles.size());
+    put_raw(out_, variables, static_cast<size_t>(count) * shape.dimension() * sizeof(double));
+    end_frame(out_, start);
+    return id;
+}
+
+uint32_t Client::send(Op op) {
+    const uint32_t id = next_id_++;
+    end_frame(out_, begin_frame(out_, id, static_cast<uint8_t>(op), 0, 0, 0, 0));
+    return id;
+}
+
+void Client::flush() {
+    if (!out_.empty()) {
+        if (!write_all(fd_, out_.data(), out_.size())) {
+            throw std::runtime_error(system_error("向评估服务发送请求失败"));
+        }
+        out_.clear();
+    }
+}
+
+void Client::receive(Response& response) {
+    flush();
+
+    // 读到一个完整的应答帧为止
+    auto available = [this] { return in_.size() - in_pos_; };
+    auto fill = [this] {
+        if (in_pos_ > 0) {
+            in_.erase(0, in_pos_);
+            in_pos_ = 0;
+        }
+        char chunk[READ_CHUNK];
+        ssize_t n;
+        do {
+            n = ::recv(fd_, chunk, sizeof(chunk), 0);
+        } while (n < 0 && errno == EINTR);
+        if (n <= 0) {
+            throw std::runtime_error("评估服务断开了连接");
+        }
+        in_.append(chunk, static_cast<size_t>(n));
+    };
+    while (available() < sizeof(uint32_t)) {
+        fill();
+    }
+    uint32_t length;
+    std::memcpy(&length, in_.data() + in_pos_, sizeof(length));
+    const size_t frame_bytes = sizeof(uint32_t) + static_cast<size_t>(length);
+    if (frame_bytes < HEADER_BYTES) {
+        throw std::runtime_error("评估服务的应答帧无效");
+    }
+    while (available() < frame_bytes) {
+        fill();
+    }
+
+    FrameReader reader(in_.data() + in_pos_, frame_bytes);
+    in_pos_ += frame_bytes;
+    reader.u32();
+    response.id = reader.u32();
+    response.op = static_cast<Op>(reader.u8());
+    response.status = static_cast<Status>(reader.u8());
+    reader.u16();
+    response.count = reader.u32();
+    response.error.clear();
+
+    if (response.status != Status::OK) {
+        response.error = reader.str();
+        return;
+    }
+    switch (response.op) {
+        case Op::EVALUATE: {
+            response.strategy_status.resize(response.count);
+            reader.raw(response.strategy_status.data(), response.count);
+            if (response.count == 0 || reader.remaining() % (response.count * sizeof(double)) != 0) {
+                response.times.clear();
+                break;
+            }
+            response.times.resize(reader.remaining() / sizeof(double));
+            reader.raw(response.times.data(), response.times.size() * sizeof(double));
+            break;
+        }
+        case Op::DESCRIBE: {
+            Description& d = response.description;
+            d = Description();
+            d.scenario_hash = reader.u64();
+            d.time_step = reader.f64();
+            const uint32_t num_uavs = reader.u32();
+            for (uint32_t u = 0; u < num_uavs; ++u) {
+                d.uavs.push_back(reader.str());
+                d.grenade_budgets.push_back(static_cast<int>(reader.u32()));
+            }
+            const uint32_t num_missiles = reader.u32();
+            for (uint32_t m = 0; m < num_missiles; ++m) {
+                d.missiles.push_back(reader.str());
+            }
+            break;
+        }
+        case Op::STATS: {
+            response.stats.connections = reader.u64();
+            response.stats.requests = reader.u64();
+            response.stats.strategies = reader.u64();
+            response.stats.errors = reader.u64();
+            break;
+        }
+        default:
+            break;
+    }
+
+    if (in_pos_ == in_.size()) {
+        in_.clear();
+        in_pos_ = 0;
+    }
+}
+
+Response Client::call(Op op) {
+    send(op);
+    Response response;
+    receive(response);
+    if (response.status != Status::OK) {
+        throw std::runtime_error("评估服务返回 " + status_name(response.status) + ": " + response.error);
+    }
+    return response;
+}
+
+} // namespace EvalService
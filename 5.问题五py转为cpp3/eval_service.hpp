@@ -0,0 +1,246 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "fast_evaluator.hpp"
+#include "scenario.hpp"
+
+/**
+ * @brief 常驻的策略评估服务 (Unix 域套接字)
+ *
+ * 规划与可视化工具交互式地给候选策略打分时，不必每次启动求解器或经 Python 计算：服务进程常驻，
+ * 场景表、按导弹组合建好的评估器、每线程的扁平策略与云团缓冲区和线程池都保持就绪。
+ *
+ * 协议为紧凑的小端二进制帧，客户端可以不等应答连续发送多个请求 (流水线)，同一连接上按发送顺序应答。
+ * 服务端一次读入尽量多的字节，处理缓冲区里全部完整的请求后合并写出应答。
+ *
+ * 请求帧 (16 字节帧头 + 负载)：
+ *   u32 长度 (帧头之后的字节数) | u32 请求号 | u8 操作 | u8 无人机数 U | u8 每机弹药数 G | u8 导弹数 M | u32 策略数 N
+ *   EVALUATE 的负载：U 个 u8 无人机索引 | M 个 u8 导弹索引 | N × U × (2 + 2G) 个 f64 决策变量
+ *   其余操作没有负载 (U、G、M、N 为 0)。
+ * 决策变量布局与 ShapedObjective 相同：无人机按请求中的顺序，每机 [速度, 角度, 投放1, 引信1, 间隔k, 引信k...]。
+ *
+ * 应答帧 (16 字节帧头 + 负载)：
+ *   u32 长度 | u32 请求号 | u8 操作 | u8 状态 | u16 保留 | u32 条目数
+ *   EVALUATE：N 个 u8 策略状态 (Optimizer::StrategyStatus) | N × M 个 f64 各导弹遮蔽时间 (无效策略为 0)
+ *   DESCRIBE：u64 场景内容哈希 | f64 时间步长 | u32 无人机数 | 各无人机 (str 标识, u32 弹药预算) | u32 导弹数 | 各导弹 str 标识
+ *   STATS：u64 连接数 | u64 请求数 | u64 策略数 | u64 出错请求数
+ *   状态非 OK 时负载为 str 原因。str 为 u32 长度 + 字节。
+ */
+namespace EvalService {
+
+constexpr size_t HEADER_BYTES = 16;
+
+/**
+ * @brief 请求的操作
+ */
+enum class Op : uint8_t {
+    PING = 0,
+    DESCRIBE = 1,   // 场景哈希、时间步长与实体标识 (客户端据此把标识换成索引)
+    EVALUATE = 2,   // 一批同形状策略的各导弹遮蔽时间
+    STATS = 3
+};
+
+/**
+ * @brief 应答状态
+ */
+enum class Status : uint8_t {
+    OK = 0,
+    BAD_REQUEST = 1,    // 形状或负载长度无效 (连接保持可用)
+    UNKNOWN_OP = 2,
+    TOO_LARGE = 3,      // 帧长度超过上限 (应答后关闭连接)
+    INTERNAL = 4
+};
+
+std::string status_name(Status status);
+
+/**
+ * @brief 评估请求的问题形状 (场景注册表中的实体索引)
+ */
+struct Shape {
+    std::vector<uint8_t> uavs;          // 决策变量中的无人机顺序
+    int grenades_per_uav = 1;
+    std::vector<uint8_t> missiles;      // 统计遮蔽时间的导弹
+
+    int dimension() const { return static_cast<int>(uavs.size()) * (2 + 2 * grenades_per_uav); }
+};
+
+/**
+ * @brief DESCRIBE 的结果
+ */
+struct Description {
+    uint64_t scenario_hash = 0;
+    double time_step = 0.0;
+    std::vector<std::string> uavs;
+    std::vector<int> grenade_budgets;
+    std::vector<std::string> missiles;
+};
+
+/**
+ * @brief 服务端累计计数
+ */
+struct Stats {
+    uint64_t connections = 0;
+    uint64_t requests = 0;
+    uint64_t strategies = 0;
+    uint64_t errors = 0;
+};
+
+/**
+ * @brief 一个应答 (按操作填写对应字段)
+ */
+struct Response {
+    uint32_t id = 0;
+    Op op = Op::PING;
+    Status status = Status::OK;
+    uint32_t count = 0;
+    std::vector<uint8_t> strategy_status;   // EVALUATE: [策略]
+    std::vector<double> times;              // EVALUATE: [策略][导弹]
+    Description description;                // DESCRIBE
+    Stats stats;                            // STATS
+    std::string error;                      // 状态非 OK 时的原因
+};
+
+/**
+ * @brief 服务参数
+ */
+struct ServerSettings {
+    std::string socket_path;                // 套接字文件 (已存在时先删除)
+    double time_step = 0.1;                 // 遮蔽时间的扫描步长
+    int parallel_threshold = 16;            // 策略数不少于此值的请求在线程池上并行，更小的请求在连接线程上直接评估
+    int num_threads = -1;                   // 单个批量请求的并发上限，-1表示不限
+    int time_chunks = -1;                   // 单次评估的时间分段上限 (见 ObscurationEvaluator::set_time_chunks)
+    size_t max_request_bytes = 64u << 20;   // 单个请求帧的长度上限
+    int max_connections = 64;               // 超过时新连接被立即关闭
+};
+
+/**
+ * @brief 评估服务
+ *
+ * 每个连接一个线程：读到的完整请求依次处理，小请求直接在连接线程上评估 (不经过任务分派，延迟最低)，
+ * 大批量请求在 WorkPool::Pool::global() 上并行。评估器按导弹组合缓存，启动时为每枚导弹和全部导弹预先建好。
+ * 结果与 FastEvaluator::ObscurationEvaluator 逐位相同。
+ */
+class Server {
+public:
+    /**
+     * @brief 参数无效时抛出 std::invalid_argument
+     */
+    Server(const ScenarioLoader::Scenario& scenario, const ServerSettings& settings);
+    ~Server();
+    Server(const Server&) = delete;
+    Server& operator=(const Server&) = delete;
+
+    /**
+     * @brief 绑定套接字并开始接受连接，失败时抛出 std::runtime_error
+     */
+    void start();
+
+    /**
+     * @brief 停止接受连接、关闭现有连接并等待连接线程退出，删除套接字文件 (可重复调用)
+     */
+    void stop();
+
+    Stats stats() const;
+    const ServerSettings& settings() const { return settings_; }
+
+private:
+    struct Connection {
+        int fd = -1;
+        std::thread thread;
+        std::atomic<bool> done{false};
+    };
+
+    ScenarioLoader::Scenario scenario_;
+    ServerSettings settings_;
+
+    mutable std::shared_mutex models_mutex_;
+    std::map<std::vector<uint8_t>, std::unique_ptr<FastEvaluator::ObscurationEvaluator>> models_;
+
+    int listen_fd_ = -1;
+    int wake_pipe_[2] = {-1, -1};
+    std::thread accept_thread_;
+    std::mutex connections_mutex_;
+    std::list<Connection> connections_;
+    std::atomic<bool> stopping_{false};
+
+    std::atomic<uint64_t> num_connections_{0};
+    std::atomic<uint64_t> num_requests_{0};
+    std::atomic<uint64_t> num_strategies_{0};
+    std::atomic<uint64_t> num_errors_{0};
+
+    void accept_loop();
+    void serve(Connection& connection);
+
+    /**
+     * @brief 处理一个完整的请求帧，把应答追加到 out
+     */
+    void handle(const char* frame, size_t size, std::string& out);
+    void evaluate(const Shape& shape, const char* variables, uint32_t count, std::string& out);
+    const FastEvaluator::ObscurationEvaluator& model(const std::vector<uint8_t>& missiles);
+};
+
+/**
+ * @brief 评估服务的客户端 (同步调用与流水线)
+ *
+ * send_* 只把请求追加到发送缓冲区并返回请求号，flush 一次写出；receive 按发送顺序读回应答
+ * (发送缓冲区非空时先写出)。一个客户端对象只应由一个线程使用。
+ */
+class Client {
+public:
+    /**
+     * @brief 连接失败时抛出 std::runtime_error
+     */
+    explicit Client(const std::string& socket_path);
+    ~Client();
+    Client(const Client&) = delete;
+    Client& operator=(const Client&) = delete;
+
+    /**
+     * @brief 场景描述 (首次调用时向服务端查询，之后使用缓存)
+     */
+    const Description& describe();
+
+    /**
+     * @brief 按实体标识构造形状，未知标识时抛出 std::runtime_error
+     */
+    Shape shape(const std::vector<std::string>& uavs, int grenades_per_uav, const std::vector<std::string>& missiles);
+
+    /**
+     * @brief 同步评估 count 个策略 (按 shape.dimension() 连续存放)，应答状态非 OK 时抛出 std::runtime_error
+     */
+    Response evaluate(const Shape& shape, const double* variables, uint32_t count);
+
+    void ping();
+    Stats stats();
+
+    uint32_t send_evaluate(const Shape& shape, const double* variables, uint32_t count);
+    uint32_t send(Op op);
+    void flush();
+
+    /**
+     * @brief 读回下一个应答，连接断开时抛出 std::runtime_error
+     */
+    void receive(Response& response);
+
+private:
+    int fd_ = -1;
+    uint32_t next_id_ = 1;
+    std::string out_;
+    std::string in_;
+    size_t in_pos_ = 0;
+    bool described_ = false;
+    Description description_;
+
+    Response call(Op op);
+};
+
+} // namespace EvalService
@@ -0,0 +1,40 @@
+#include "trajectory_exporter.hpp"
+#include <iostream>
+#include <string>
+
+/**
+ * @brief 导出视频渲染用的轨迹数据
+ *
+ * 用法: export_trajectory [输出文件] [结束时间] [帧率]
+ * 生成的文件可在 video.py 中通过 load_trajectory_data() 直接内存映射读取。
+ */
+int main(int argc, char* argv[]) {
+    try {
+        std::string output_path = argc > 1 ? argv[1] : "problem3_trajectory.traj";
+        double end_time = argc > 2 ? std::stod(argv[2]) : 65.0;
+        double framerate = argc > 3 ? std::stod(argv[3]) : 30.0;
+
+        // 问题三求解器得到的最优策略 (与 video.py 中的 OPTIMAL_STRATEGY_P3 一致)
+        Optimizer::UAVStrategy fy1;
+        fy1.speed = 139.6956;
+        fy1.angle = 3.1338;
+        fy1.grenades = {
+            {0.2281, 3.7869},
+            {3.3818, 5.2772},
+            {4.8330, 5.9929}
+        };
+
+        TrajectoryExporter::ExportJob job;
+        job.output_path = output_path;
+        job.strategy["FY1"] = fy1;
+        job.missile_ids = {"M1"};
+        job.end_time = end_time;
+        job.dt = 1.0 / framerate;
+
+        TrajectoryExporter::export_trajectory(job);
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "轨迹导出失败: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,585 @@
+#include "fast_evaluator.hpp"
+#include "core_objects.hpp"
+#include "simd_kernels.hpp"
+#include "work_pool.hpp"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace FastEvaluator {
+
+namespace {
+
+inline Vector3d grenade_accel(const Vector3d& velocity, double mass, double drag_factor, double gravity) {
+    Vector3d accel(0.0, 0.0, -gravity);
+    double speed = velocity.norm();
+    if (speed > 1e-6) {
+        accel += -(drag_factor / mass) * speed * velocity;
+    }
+    return accel;
+}
+
+} // namespace
+
+Vector3d integrate_detonation_point(
+    const Vector3d& deploy_pos,
+    const Vector3d& deploy_vel,
+    double fuse_time,
+    double mass,
+    double drag_factor,
+    double gravity)
+{
+    Vector3d pos = deploy_pos;
+    Vector3d vel = deploy_vel;
+
+    double t = 0.0;
+    const double dt = 0.01; // 与 TrajectoryIntegrator 相同的时间步长
+
+    while (t < fuse_time) {
+        double h = std::min(dt, fuse_time - t);
+
+        Vector3d k1p = vel;
+        Vector3d k1v = grenade_accel(vel, mass, drag_factor, gravity);
+
+        Vector3d k2p = vel + 0.5 * h * k1v;
+        Vector3d k2v = grenade_accel(k2p, mass, drag_factor, gravity);
+
+        Vector3d k3p = vel + 0.5 * h * k2v;
+        Vector3d k3v = grenade_accel(k3p, mass, drag_factor, gravity);
+
+        Vector3d k4p = vel + h * k3v;
+        Vector3d k4v = grenade_accel(k4p, mass, drag_factor, gravity);
+
+        pos += h/6.0 * (k1p + 2*k2p + 2*k3p + k4p);
+        vel += h/6.0 * (k1v + 2*k2v + 2*k3v + k4v);
+        t += h;
+    }
+
+    return pos;
+}
+
+CloudState deploy_cloud(const Vector3d& uav_start_pos,
+                        double speed,
+                        double angle,
+                        double t_deploy,
+                        double t_fuse,
+                        double sink_speed)
+{
+    Vector3d velocity = speed * Vector3d(std::cos(angle), std::sin(angle), 0.0);
+    Vector3d deploy_pos = uav_start_pos + velocity * t_deploy;
+    Vector3d detonate_pos = integrate_detonation_point(deploy_pos, velocity, t_fuse);
+    return CloudState(detonate_pos, t_deploy + t_fuse, sink_speed);
+}
+
+CloudState deploy_cloud(const Vector3d& uav_start_pos,
+                        double speed,
+                        double angle,
+                        double t_deploy,
+                        double t_fuse,
+                        double sink_speed,
+                        const ScenarioLoader::PhysicalConstants& physics)
+{
+    Vector3d velocity = speed * Vector3d(std::cos(angle), std::sin(angle), 0.0);
+    Vector3d deploy_pos = uav_start_pos + velocity * t_deploy;
+    Vector3d detonate_pos = integrate_detonation_point(deploy_pos, velocity, t_fuse, physics.grenade_mass,
+                                                       physics.grenade_drag_factor, physics.g);
+    return CloudState(detonate_pos, t_deploy + t_fuse, sink_speed, physics.cloud_duration);
+}
+
+Optimizer::StrategyStatus try_build_clouds(const Optimizer::FlatStrategy& strategy,
+                                           std::vector<CloudState>& clouds,
+                                           const ScenarioLoader::Scenario& scenario)
+{
+    Optimizer::StrategyStatus status = Optimizer::validate_strategy(strategy, scenario);
+    if (status != Optimizer::StrategyStatus::OK) {
+        clouds.clear();
+        return status;
+    }
+    build_validated_clouds(strategy, clouds, scenario);
+    return Optimizer::StrategyStatus::OK;
+}
+
+void build_validated_clouds(const Optimizer::FlatStrategy& strategy,
+                            std::vector<CloudState>& clouds,
+                            const ScenarioLoader::Scenario& scenario)
+{
+    clouds.clear();
+
+    // 扁平策略按无人机索引排列，云团顺序与策略解析顺序无关
+    for (const auto& record : strategy) {
+        const Vector3d& uav_start = scenario.entities.uav(record.uav).start_pos;
+        for (int i = 0; i < record.num_grenades; ++i) {
+            clouds.push_back(deploy_cloud(uav_start, record.speed, record.angle,
+                                          record.grenades[i].t_deploy, record.grenades[i].t_fuse,
+                                          scenario.physics.cloud_sink_speed, scenario.physics));
+        }
+    }
+}
+
+Optimizer::StrategyStatus try_build_clouds(const Optimizer::StrategyMap& strategy,
+                                           std::vector<CloudState>& clouds)
+{
+    Optimizer::FlatStrategy flat;
+    Optimizer::StrategyStatus status = Optimizer::to_flat_strategy(strategy, flat);
+    if (status != Optimizer::StrategyStatus::OK) {
+        clouds.clear();
+        return status;
+    }
+    return try_build_clouds(flat, clouds);
+}
+
+void build_clouds(const Optimizer::StrategyMap& strategy, std::vector<CloudState>& clouds) {
+    Optimizer::StrategyStatus status = try_build_clouds(strategy, clouds);
+    if (status != Optimizer::StrategyStatus::OK) {
+        throw std::runtime_error(std::string("Invalid strategy: ") + Optimizer::status_message(status));
+    }
+}
+
+ObscurationEvaluator::ObscurationEvaluator(const std::vector<std::string>& missile_ids,
+                                           double time_step)
+    : time_step_(time_step)
+{
+    const auto& scenario = ScenarioLoader::active();
+    std::vector<Registry::EntityIndex> missiles;
+    for (const auto& missile_id : missile_ids) {
+        Registry::EntityIndex index = scenario.entities.missile_index(missile_id);
+        if (index == Registry::INVALID_INDEX) {
+            throw std::runtime_error("Unknown missile ID: " + missile_id);
+        }
+        missiles.push_back(index);
+    }
+    init(missiles, scenario);
+}
+
+ObscurationEvaluator::ObscurationEvaluator(const std::vector<Registry::EntityIndex>& missiles,
+                                           const ScenarioLoader::Scenario& scenario,
+                                           double time_step)
+    : time_step_(time_step)
+{
+    init(missiles, scenario);
+}
+
+void ObscurationEvaluator::init(const std::vector<Registry::EntityIndex>& missiles,
+                                const ScenarioLoader::Scenario& scenario)
+{
+    for (Registry::EntityIndex index : missiles) {
+        if (!scenario.entities.valid_missile(index)) {
+            throw std::runtime_error("Invalid missile index: " + std::to_string(index));
+        }
+        const auto& missile = scenario.entities.missile(index);
+        missile_ids_.push_back(missile.id);
+        missile_start_.push_back(missile.start_pos);
+        missile_unit_.push_back(missile.unit_vec);
+        missile_speed_.push_back(missile.speed);
+    }
+
+    key_points_ = CoreObjects::TargetCylinder(scenario.target).get_key_points();
+    cloud_radius_ = scenario.physics.cloud_radius;
+
+    const int num_points = key_points_.cols();
+    key_origin_ = num_points > 0 ? Vector3d(key_points_.col(0)) : Vector3d::Zero();
+    key_dx_.assign(num_points, 0.0f);
+    key_dy_.assign(num_points, 0.0f);
+    key_dz_.assign(num_points, 0.0f);
+    for (int i = 0; i < num_points; ++i) {
+        Vector3d offset = key_points_.col(i) - key_origin_;
+        key_dx_[i] = static_cast<float>(offset.x());
+        key_dy_[i] = static_cast<float>(offset.y());
+        key_dz_[i] = static_cast<float>(offset.z());
+    }
+}
+
+bool ObscurationEvaluator::check_obscuration(const Vector3d& missile_pos,
+                                             const Vector3d* centers,
+                                             int num_active) const
+{
+    if (num_active == 0) {
+        return false;
+    }
+
+    // 锥轴与半角余弦，云团数量很少，放在栈上
+    constexpr int MAX_STACK_CONES = 32;
+    Vector3d axis_stack[MAX_STACK_CONES];
+    double cos_half_stack[MAX_STACK_CONES];
+    std::vector<Vector3d> axis_heap;
+    std::vector<double> cos_half_heap;
+
+    Vector3d* axes = axis_stack;
+    double* cos_half = cos_half_stack;
+    if (num_active > MAX_STACK_CONES) {
+        axis_heap.resize(num_active);
+        cos_half_heap.resize(num_active);
+        axes = axis_heap.data();
+        cos_half = cos_half_heap.data();
+    }
+
+    const double r = cloud_radius_;
+    for (int c = 0; c < num_active; ++c) {
+        Vector3d vec_vc = centers[c] - missile_pos;
+        double dist = vec_vc.norm();
+
+        // 导弹在云团内，视为完全遮蔽
+        if (dist <= r) {
+            return true;
+        }
+
+        axes[c] = vec_vc / dist;
+        double sin_half = r / dist;
+        cos_half[c] = std::sqrt(1.0 - sin_half * sin_half);
+    }
+
+    // acos(cos_beta) <= asin(r/d) 等价于 cos_beta >= sqrt(1 - (r/d)^2)
+    const int num_points = key_points_.cols();
+    for (int i = 0; i < num_points; ++i) {
+        Vector3d vec_vp = key_points_.col(i) - missile_pos;
+        double norm = vec_vp.norm();
+        if (norm < 1e-9) {
+            continue;
+        }
+
+        bool covered = false;
+        for (int c = 0; c < num_active; ++c) {
+            if (vec_vp.dot(axes[c]) >= cos_half[c] * norm) {
+                covered = true;
+                break;
+            }
+        }
+        if (!covered) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool ObscurationEvaluator::check_obscuration_f32(const Vector3d& missile_pos,
+                                                 const Vector3d* centers,
+                                                 int num_active,
+                                                 long long* guard_rechecks) const
+{
+    static_assert(FLOAT_LANES == SimdKernels::CONE_LANES, "单精度通道数须与内核一致");
+    constexpr int MAX_CONES = 8 * FLOAT_LANES;
+    if (num_active == 0 || num_active > MAX_CONES) {
+        return check_obscuration(missile_pos, centers, num_active);
+    }
+    const int num_chunks = (num_active + FLOAT_LANES - 1) / FLOAT_LANES;
+
+    // 云团相对导弹的位置：减法用双精度，之后转单精度；补位通道由 valid 屏蔽
+    alignas(64) float vc_x[MAX_CONES], vc_y[MAX_CONES], vc_z[MAX_CONES], dist[MAX_CONES];
+    alignas(64) int valid[MAX_CONES];
+    for (int c = 0; c < num_active; ++c) {
+        vc_x[c] = static_cast<float>(centers[c].x() - missile_pos.x());
+        vc_y[c] = static_cast<float>(centers[c].y() - missile_pos.y());
+        vc_z[c] = static_cast<float>(centers[c].z() - missile_pos.z());
+        valid[c] = 1;
+    }
+    for (int c = num_active; c < num_chunks * FLOAT_LANES; ++c) {
+        vc_x[c] = 1.0f;
+        vc_y[c] = 0.0f;
+        vc_z[c] = 0.0f;
+        valid[c] = 0;
+    }
+
+    // 千米级距离上半角只有 1e-4 rad 量级，cos 形式在单精度下会与 1 相消。改用不需要归一化的等价判据：
+    // 点在锥顶前方且 |vp × vc| <= r * |vp|，叉积没有相消问题。
+    // 各量的舍入误差不超过约 11 * 2^-24 倍的尺度 (|vp| * |vc| 或 |vc|)，保护带取其数倍，
+    // 保护带内的判断交给双精度，保证与 check_obscuration 结果一致。
+    constexpr float GUARD = 64.0f * FLT_EPSILON;
+    const float r = static_cast<float>(cloud_radius_);
+
+    // 导弹在云团内，视为完全遮蔽
+    int inside = 0;
+    int inside_ambiguous = 0;
+    for (int chunk = 0; chunk < num_chunks; ++chunk) {
+        const int k = chunk * FLOAT_LANES;
+        for (int c = k; c < k + FLOAT_LANES; ++c) {
+            dist[c] = std::sqrt(vc_x[c] * vc_x[c] + vc_y[c] * vc_y[c] + vc_z[c] * vc_z[c]);
+            float margin = dist[c] - r;
+            float tol = GUARD * dist[c];
+            inside |= valid[c] & (margin < -tol);
+            inside_ambiguous |= valid[c] & (std::abs(margin) <= tol);
+        }
+    }
+    if (inside) {
+        return true;
+    }
+
+    // 双精度锥参数只在需要复核时计算，计算方式与 check_obscuration 相同
+    Vector3d axes[MAX_CONES];
+    double cos_half[MAX_CONES];
+    bool have_double = false;
+    auto prepare_double = [&]() {
+        if (have_double) {
+            return false;
+        }
+        have_double = true;
+        const double r_d = cloud_radius_;
+        for (int c = 0; c < num_active; ++c) {
+            Vector3d vec_vc = centers[c] - missile_pos;
+            double dist_d = vec_vc.norm();
+            if (dist_d <= r_d) {
+                return true;
+            }
+            axes[c] = vec_vc / dist_d;
+            double sin_half = r_d / dist_d;
+            cos_half[c] = std::sqrt(1.0 - sin_half * sin_half);
+        }
+        return false;
+    };
+    if (inside_ambiguous) {
+        if (guard_rechecks != nullptr) {
+            ++*guard_rechecks;
+        }
+        if (prepare_double()) {
+            return true;
+        }
+    }
+
+    const Vector3d base = key_origin_ - missile_pos;
+    const SimdKernels::ConeSet cones{vc_x, vc_y, vc_z, dist, valid, num_chunks, r, GUARD};
+    const SimdKernels::KeyPointSet points{
+        key_dx_.data(), key_dy_.data(), key_dz_.data(), static_cast<int>(key_points_.cols()),
+        static_cast<float>(base.x()), static_cast<float>(base.y()), static_cast<float>(base.z())};
+
+    // 逐个关键点判断，一个关键点对所有云团的锥体测试在 SIMD 通道上并行 (按 CPU 选择指令集)，
+    // 与双精度路径一样在第一个未被遮挡的关键点处提前返回
+    for (int i = 0;; ++i) {
+        const SimdKernels::ScanResult scan = SimdKernels::scan_key_points(cones, points, i);
+        i = scan.index;
+        if (i == points.count) {
+            break;
+        }
+        if (!scan.ambiguous) {
+            return false;
+        }
+
+        // 保护带内：按双精度路径复核这个关键点
+        if (guard_rechecks != nullptr) {
+            ++*guard_rechecks;
+        }
+        if (prepare_double()) {
+            return true;
+        }
+        Vector3d vec_vp = key_points_.col(i) - missile_pos;
+        double norm_d = vec_vp.norm();
+        if (norm_d < 1e-9) {
+            continue;
+        }
+        bool covered_d = false;
+        for (int c = 0; c < num_active; ++c) {
+            if (vec_vp.dot(axes[c]) >= cos_half[c] * norm_d) {
+                covered_d = true;
+                break;
+            }
+        }
+        if (!covered_d) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool ObscurationEvaluator::is_obscured(int missile_index, double t,
+                                       const std::vector<CloudState>& clouds) const
+{
+    std::vector<Vector3d> centers;
+    centers.reserve(clouds.size());
+    for (const auto& cloud : clouds) {
+        if (t >= cloud.start_time && t < cloud.end_time) {
+            centers.push_back(cloud.detonate_pos + Vector3d(0.0, 0.0, -cloud.sink_speed * (t - cloud.start_time)));
+        }
+    }
+    Vector3d missile_pos = missile_start_[missile_index] + missile_unit_[missile_index] * missile_speed_[missile_index] * t;
+    if (precision_ == Precision::FLOAT32) {
+        return check_obscuration_f32(missile_pos, centers.data(), static_cast<int>(centers.size()), nullptr);
+    }
+    return check_obscuration(missile_pos, centers.data(), static_cast<int>(centers.size()));
+}
+
+/**
+ * @brief 一段时间扫描的结果 (扫描前一次性分配，扫描过程中不再分配)
+ */
+struct ObscurationEvaluator::SweepCounts {
+    static constexpr long long NONE = std::numeric_limits<long long>::min();
+
+    std::vector<Vector3d> centers;
+    std::vector<long long> obscured;        // 计入的遮蔽时间步数
+    std::vector<long long> first_index;     // 第一个计入的时间索引
+    std::vector<long long> last_index;      // 最后一个计入的时间索引
+    long long guard_rechecks = 0;
+
+    SweepCounts(int num_clouds, int num_missiles)
+        : centers(num_clouds), obscured(num_missiles, 0),
+          first_index(num_missiles, NONE), last_index(num_missiles, NONE) {}
+};
+
+void ObscurationEvaluator::sweep(const std::vector<CloudState>& clouds, double t, long long max_steps,
+                                 double t_end, SweepCounts& counts) const {
+    const int num_missiles = missile_ids_.size();
+    long long* guard_rechecks = &counts.guard_rechecks;
+
+    for (long long step = 0; step < max_steps && t < t_end; ++step, t += time_step_) {
+        int num_active = 0;
+        for (const auto& cloud : clouds) {
+            if (t >= cloud.start_time && t < cloud.end_time) {
+                counts.centers[num_active++] = cloud.detonate_pos +
+                    Vector3d(0.0, 0.0, -cloud.sink_speed * (t - cloud.start_time));
+            }
+        }
+        if (num_active == 0) {
+            continue;
+        }
+
+        // 与原实现的 std::set<int> 去重等价：时间索引单调不减，只需与上一个比较
+        const long long time_index = std::llround(t / time_step_);
+        for (int m = 0; m < num_missiles; ++m) {
+            if (time_index == counts.last_index[m]) {
+                continue;
+            }
+            Vector3d missile_pos = missile_start_[m] + missile_unit_[m] * missile_speed_[m] * t;
+            const bool obscured = precision_ == Precision::FLOAT32
+                ? check_obscuration_f32(missile_pos, counts.centers.data(), num_active, guard_rechecks)
+                : check_obscuration(missile_pos, counts.centers.data(), num_active);
+            if (obscured) {
+                ++counts.obscured[m];
+                if (counts.first_index[m] == SweepCounts::NONE) {
+                    counts.first_index[m] = time_index;
+                }
+                counts.last_index[m] = time_index;
+            }
+        }
+    }
+}
+
+int ObscurationEvaluator::plan_time_chunks(const std::vector<CloudState>& clouds, long long num_steps) const {
+    if (max_time_chunks_ == 1 || num_steps < 2) {
+        return 1;
+    }
+    const int limit = max_time_chunks_ > 0 ? max_time_chunks_ : WorkPool::Pool::current().num_threads();
+
+    // 每个时间步对每枚导弹要为每个有效云团建锥，关键点测试通常在前几个点就能判定
+    double cloud_steps = 0.0;
+    for (const auto& cloud : clouds) {
+        cloud_steps += (cloud.end_time - cloud.start_time) / time_step_;
+    }
+    const double work = cloud_steps * num_missiles();
+    const double chunks = std::min({static_cast<double>(limit), work / MIN_CHUNK_WORK,
+                                    static_cast<double>(num_steps)});
+    return std::max(1, static_cast<int>(chunks));
+}
+
+void ObscurationEvaluator::evaluate(const std::vector<CloudState>& clouds, double* obscured_time,
+                                    long long* guard_rechecks) const {
+    const int num_missiles = missile_ids_.size();
+    std::fill(obscured_time, obscured_time + num_missiles, 0.0);
+
+    if (clouds.empty()) {
+        return;
+    }
+
+    double sim_start_time = std::numeric_limits<double>::max();
+    double sim_end_time = std::numeric_limits<double>::lowest();
+    for (const auto& cloud : clouds) {
+        sim_start_time = std::min(sim_start_time, cloud.start_time);
+        sim_end_time = std::max(sim_end_time, cloud.end_time);
+    }
+
+    int num_chunks = 1;
+    std::vector<double> chunk_start;
+    std::vector<long long> chunk_end;
+    if (max_time_chunks_ != 1) {
+        // 时刻按串行扫描的方式逐步累加，各段起点与串行扫描到该步时的时刻逐位相同
+        long long num_steps = 0;
+        for (double t = sim_start_time; t < sim_end_time; t += time_step_) {
+            ++num_steps;
+        }
+        num_chunks = plan_time_chunks(clouds, num_steps);
+        if (num_chunks > 1) {
+            chunk_start.resize(num_chunks);
+            chunk_end.resize(num_chunks);
+            for (int c = 0; c < num_chunks; ++c) {
+                chunk_end[c] = num_steps * (c + 1) / num_chunks;
+            }
+            long long step = 0;
+            int c = 0;
+            for (double t = sim_start_time; c < num_chunks; t += time_step_, ++step) {
+                if (step == (c == 0 ? 0 : chunk_end[c - 1])) {
+                    chunk_start[c++] = t;
+                }
+            }
+        }
+    }
+
+    if (num_chunks <= 1) {
+        SweepCounts counts(clouds.size(), num_missiles);
+        sweep(clouds, sim_start_time, std::numeric_limits<long long>::max(), sim_end_time, counts);
+        for (int m = 0; m < num_missiles; ++m) {
+            obscured_time[m] = counts.obscured[m] * time_step_;
+        }
+        if (guard_rechecks != nullptr) {
+            *guard_rechecks += counts.guard_rechecks;
+        }
+        return;
+    }
+
+    std::vector<SweepCounts> parts(num_chunks, SweepCounts(clouds.size(), num_missiles));
+    WorkPool::Pool::current().parallel_for(num_chunks, [&](int c) {
+        const long long steps = chunk_end[c] - (c == 0 ? 0 : chunk_end[c - 1]);
+        sweep(clouds, chunk_start[c], steps, sim_end_time, parts[c]);
+    }, num_chunks, 1);
+
+    // 按段的顺序合并：串行扫描会跳过与上一个计入时间索引相同的时间步，
+    // 某段第一个计入的索引等于之前各段最后计入的索引时，该步在串行扫描中不会被计入
+    for (int m = 0; m < num_missiles; ++m) {
+        long long total = 0;
+        long long last_index = SweepCounts::NONE;
+        for (const auto& part : parts) {
+            total += part.obscured[m];
+            if (part.first_index[m] != SweepCounts::NONE && part.first_index[m] == last_index) {
+                --total;
+            }
+            if (part.last_index[m] != SweepCounts::NONE) {
+                last_index = part.last_index[m];
+            }
+        }
+        obscured_time[m] = total * time_step_;
+    }
+    if (guard_rechecks != nullptr) {
+        for (const auto& part : parts) {
+            *guard_rechecks += part.guard_rechecks;
+        }
+    }
+}
+
+std::vector<double> ObscurationEvaluator::evaluate(const Optimizer::StrategyMap& strategy) const {
+    std::vector<CloudState> clouds;
+    build_clouds(strategy, clouds);
+    std::vector<double> result(missile_ids_.size());
+    evaluate(clouds, result.data());
+    return result;
+}
+
+std::vector<double> ObscurationEvaluator::evaluate_batch(
+    const std::vector<Optimizer::StrategyMap>& strategies,
+    int num_threads) const
+{
+    const int num_strategies = strategies.size();
+    const int num_missiles = missile_ids_.size();
+    std::vector<double> results(static_cast<size_t>(num_strategies) * num_missiles, 0.0);
+
+    auto& pool = WorkPool::Pool::global();
+    WorkPool::WorkerLocal<std::vector<CloudState>> clouds(pool);
+    pool.parallel_for(num_strategies, [&](int i) {
+        // 无效策略得到空云团列表，evaluate 输出零遮蔽
+        auto& local = clouds.local();
+        try_build_clouds(strategies[i], local);
+        evaluate(local, results.data() + static_cast<size_t>(i) * num_missiles);
+    }, num_threads, 16);
+
+    return results;
+}
+
+} // namespace FastEvaluator
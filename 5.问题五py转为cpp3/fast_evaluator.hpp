@@ -0,0 +1,215 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <Eigen/Dense>
+#include "config.hpp"
+#include "optimizer.hpp"
+
+using Vector3d = Eigen::Vector3d;
+using Matrix3Xd = Eigen::Matrix3Xd;
+
+namespace FastEvaluator {
+
+/**
+ * @brief 起爆后的烟雾云状态 (紧凑、可拷贝，无堆分配)
+ */
+struct CloudState {
+    Vector3d detonate_pos;
+    double start_time;
+    double end_time;
+    double sink_speed;
+
+    CloudState() : detonate_pos(Vector3d::Zero()), start_time(0.0), end_time(0.0),
+                   sink_speed(Config::CLOUD_SINK_SPEED) {}
+    CloudState(const Vector3d& pos, double detonate_time, double sink = Config::CLOUD_SINK_SPEED,
+               double duration = Config::CLOUD_DURATION)
+        : detonate_pos(pos), start_time(detonate_time),
+          end_time(detonate_time + duration), sink_speed(sink) {}
+};
+
+/**
+ * @brief 栈上固定尺寸的RK4弹道积分，与 TrajectoryIntegrator::solve_trajectory 数值一致
+ */
+Vector3d integrate_detonation_point(
+    const Vector3d& deploy_pos,
+    const Vector3d& deploy_vel,
+    double fuse_time,
+    double mass = Config::GRENADE_MASS,
+    double drag_factor = Config::GRENADE_DRAG_FACTOR,
+    double gravity = Config::G
+);
+
+/**
+ * @brief 由无人机初始位置和一枚弹药的投放参数计算云团
+ */
+CloudState deploy_cloud(const Vector3d& uav_start_pos,
+                        double speed,
+                        double angle,
+                        double t_deploy,
+                        double t_fuse,
+                        double sink_speed = Config::CLOUD_SINK_SPEED);
+
+/**
+ * @brief 同上，弹道与云团参数取自场景物理常量
+ */
+CloudState deploy_cloud(const Vector3d& uav_start_pos,
+                        double speed,
+                        double angle,
+                        double t_deploy,
+                        double t_fuse,
+                        double sink_speed,
+                        const ScenarioLoader::PhysicalConstants& physics);
+
+/**
+ * @brief 根据策略生成全部云团 (按无人机ID排序、弹药顺序排列)，不抛异常
+ *
+ * @param strategy 策略
+ * @param clouds 输出云团列表 (会被清空后重填；策略无效时为空)
+ * @return Optimizer::StrategyStatus 策略校验结果
+ */
+Optimizer::StrategyStatus try_build_clouds(const Optimizer::StrategyMap& strategy,
+                                           std::vector<CloudState>& clouds);
+
+/**
+ * @brief 扁平策略版本，按注册表索引取无人机初始位置 (热路径使用)
+ */
+Optimizer::StrategyStatus try_build_clouds(const Optimizer::FlatStrategy& strategy,
+                                           std::vector<CloudState>& clouds,
+                                           const ScenarioLoader::Scenario& scenario =
+                                               ScenarioLoader::active());
+
+/**
+ * @brief 由已通过 validate_strategy 的扁平策略生成云团 (不再校验，目标函数热路径使用)
+ */
+void build_validated_clouds(const Optimizer::FlatStrategy& strategy,
+                            std::vector<CloudState>& clouds,
+                            const ScenarioLoader::Scenario& scenario = ScenarioLoader::active());
+
+/**
+ * @brief 同 try_build_clouds，策略无效时抛出 std::runtime_error
+ */
+void build_clouds(const Optimizer::StrategyMap& strategy, std::vector<CloudState>& clouds);
+
+/**
+ * @brief 锥体判断的数值精度
+ */
+enum class Precision {
+    DOUBLE,     // 全部双精度 (默认)
+    FLOAT32     // 单精度成块判断 (SIMD 宽度加倍)，落在边界保护带内的判断用双精度复核，结果与 DOUBLE 一致
+};
+
+/**
+ * @brief 批量快速遮蔽评估器
+ *
+ * 与 ObscurationOptimizer::objective_function 采用相同的时间离散 (从最早起爆到最晚消散，
+ * 步长 time_step) 和协同遮蔽判据，但锥体判断使用余弦比较代替 asin/acos，
+ * 且整个时间扫描过程不做堆分配，适合在并行循环中大量调用。
+ */
+class ObscurationEvaluator {
+public:
+    /**
+     * @param missile_ids 需要统计遮蔽时间的导弹 (在当前场景中查找)
+     * @param time_step 时间扫描步长
+     */
+    explicit ObscurationEvaluator(const std::vector<std::string>& missile_ids,
+                                  double time_step = 0.1);
+
+    /**
+     * @param missiles 场景注册表中的导弹索引
+     * @param scenario 场景 (只在构造时读取)
+     * @param time_step 时间扫描步长
+     */
+    ObscurationEvaluator(const std::vector<Registry::EntityIndex>& missiles,
+                         const ScenarioLoader::Scenario& scenario,
+                         double time_step = 0.1);
+
+    /**
+     * @brief 计算每枚导弹的有效遮蔽时间
+     *
+     * 启用时间分段 (set_time_chunks) 且代价模型判断值得拆分时，时间扫描按连续的时间段在
+     * 当前线程所在的线程池 (WorkPool::Pool::current()) 上并行执行，按段的顺序合并计数，结果与不拆分时逐位相同。
+     * 可以在线程池的任务内调用 (种群级并行内嵌套)，工作线程都在忙时由调用线程依次完成各段。
+     *
+     * @param clouds 云团列表
+     * @param obscured_time 输出，长度为导弹数
+     * @param guard_rechecks 可选输出，FLOAT32 模式下累加双精度复核的关键点次数
+     */
+    void evaluate(const std::vector<CloudState>& clouds, double* obscured_time,
+                  long long* guard_rechecks = nullptr) const;
+
+    /**
+     * @brief 便捷接口：直接评估一个策略
+     */
+    std::vector<double> evaluate(const Optimizer::StrategyMap& strategy) const;
+
+    /**
+     * @brief 并行批量评估，结果按 [策略][导弹] 行优先存放 (无效策略记为零遮蔽)
+     *
+     * 在 WorkPool::Pool::global() 上执行，num_threads 为并发上限 (-1表示不限)。
+     */
+    std::vector<double> evaluate_batch(const std::vector<Optimizer::StrategyMap>& strategies,
+                                       int num_threads = -1) const;
+
+    /**
+     * @brief 单个时刻下某枚导弹是否被协同遮蔽
+     */
+    bool is_obscured(int missile_index, double t, const std::vector<CloudState>& clouds) const;
+
+    /**
+     * @brief 切换锥体判断精度 (不能与 evaluate 并发调用)
+     */
+    void set_precision(Precision precision) { precision_ = precision; }
+    Precision precision() const { return precision_; }
+
+    /**
+     * @brief 单次评估的时间扫描最多拆成几段并行 (不能与 evaluate 并发调用)
+     *
+     * @param max_chunks 1 表示不拆分 (默认)，-1 表示最多为线程池的线程数；实际段数由 plan_time_chunks 决定
+     */
+    void set_time_chunks(int max_chunks) { max_time_chunks_ = max_chunks; }
+    int time_chunks() const { return max_time_chunks_; }
+
+    /**
+     * @brief 代价模型：按云团的有效时间步数与导弹数估计扫描工作量，每段至少 MIN_CHUNK_WORK
+     *
+     * @param clouds 云团列表
+     * @param num_steps 时间步数
+     * @return 时间段数 (1 表示不拆分)
+     */
+    int plan_time_chunks(const std::vector<CloudState>& clouds, long long num_steps) const;
+
+    // 每段的最小工作量 (导弹 × 有效云团 × 时间步)，约相当于 0.25 毫秒的扫描，任务分派开销可忽略
+    static constexpr double MIN_CHUNK_WORK = 20000.0;
+
+    int num_missiles() const { return static_cast<int>(missile_ids_.size()); }
+    const std::vector<std::string>& missile_ids() const { return missile_ids_; }
+    double time_step() const { return time_step_; }
+
+private:
+    std::vector<std::string> missile_ids_;
+    std::vector<Vector3d> missile_start_;
+    std::vector<Vector3d> missile_unit_;
+    std::vector<double> missile_speed_;
+    Matrix3Xd key_points_;
+    double cloud_radius_;
+    double time_step_;
+    Precision precision_ = Precision::DOUBLE;
+    int max_time_chunks_ = 1;
+
+    // 单精度关键点：相对 key_origin_ 的偏移 (数值小，舍入误差可忽略)
+    static constexpr int FLOAT_LANES = 16;  // 一个关键点同时测试的云团数 (AVX-512 单精度宽度)
+    Vector3d key_origin_;
+    std::vector<float> key_dx_, key_dy_, key_dz_;
+
+    void init(const std::vector<Registry::EntityIndex>& missiles, const ScenarioLoader::Scenario& scenario);
+    bool check_obscuration(const Vector3d& missile_pos, const Vector3d* centers, int num_active) const;
+    bool check_obscuration_f32(const Vector3d& missile_pos, const Vector3d* centers, int num_active,
+                               long long* guard_rechecks) const;
+
+    struct SweepCounts;
+    void sweep(const std::vector<CloudState>& clouds, double t, long long max_steps, double t_end,
+               SweepCounts& counts) const;
+};
+
+} // namespace FastEvaluator
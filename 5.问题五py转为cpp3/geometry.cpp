@@ -1,4 +1,5 @@
 #include "geometry.hpp"
+#include "scenario.hpp"
 #include <cmath>
 #include <algorithm>
 #include <vector>
@@ -15,6 +16,7 @@ bool check_collective_obscuration(
     }
 
     // 1. 为每一个云团构建其对应的阴影锥
+    const double cloud_radius = ScenarioLoader::active().physics.cloud_radius;
     std::vector<ShadowCone> cones;
     cones.reserve(active_cloud_centers.size());
     
@@ -23,12 +25,12 @@ bool check_collective_obscuration(
         double dist = vec_vc.norm();
         
         // 如果导弹在任何一个云团内，视为完全遮蔽
-        if (dist <= Config::CLOUD_RADIUS) {
+        if (dist <= cloud_radius) {
             return true;
         }
         
         Vector3d axis = vec_vc / dist;
-        double angle = std::asin(Config::CLOUD_RADIUS / dist);
+        double angle = std::asin(cloud_radius / dist);
         cones.emplace_back(axis, angle);
     }
 
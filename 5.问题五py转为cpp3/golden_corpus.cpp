@@ -0,0 +1,846 @@
+#include "golden_corpus.hpp"
+#include "core_objects.hpp"
+#include "counter_rng.hpp"
+#include "cpu_dispatch.hpp"
+#include "geometry.hpp"
+#include "optimizer.hpp"
+#include "shaped_objective.hpp"
+#include "work_pool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+
+namespace GoldenCorpus {
+
+namespace {
+
+constexpr char FILE_MAGIC[4] = {'G', 'L', 'D', 'C'};
+constexpr uint32_t FILE_VERSION = 1;
+
+// 定点编码：速度 [0, 256) m/s、角度 [-1, 7) rad、时间量 [-2, 62) s，步长分别约 6e-8、2e-9、1.5e-8
+constexpr double SPEED_OFFSET = 0.0;
+constexpr double SPEED_SCALE = 1.0 / (1 << 24);
+constexpr double ANGLE_OFFSET = -1.0;
+constexpr double ANGLE_SCALE = 1.0 / (1 << 29);
+constexpr double TIME_OFFSET = -2.0;
+constexpr double TIME_SCALE = 1.0 / (1 << 26);
+
+// 与双精度路径的差超过该值才算不一致：各后端结果都是时间步的整数倍，真正的分歧至少差一个时间步，
+// 而 -ffast-math 下各导弹遮蔽时间求和的结合顺序不同会带来末位舍入差
+constexpr double MISMATCH_TOLERANCE = 1e-9;
+
+// 生成方式按序号轮换：每 20 个策略中随机 4 个、瞄准 6 个、擦边 7 个、边界 3 个
+constexpr Kind KIND_CYCLE[20] = {
+    Kind::RANDOM, Kind::AIMED, Kind::GRAZING, Kind::AIMED, Kind::GRAZING,
+    Kind::BOUNDARY, Kind::GRAZING, Kind::AIMED, Kind::RANDOM, Kind::GRAZING,
+    Kind::AIMED, Kind::BOUNDARY, Kind::GRAZING, Kind::RANDOM, Kind::AIMED,
+    Kind::GRAZING, Kind::AIMED, Kind::BOUNDARY, Kind::GRAZING, Kind::RANDOM};
+
+uint32_t encode(double value, double offset, double scale) {
+    const double code = std::round((value - offset) / scale);
+    return static_cast<uint32_t>(std::clamp(code, 0.0, 4294967295.0));
+}
+
+/**
+ * @brief 问题形状在场景中的实体索引
+ */
+struct Resolved {
+    std::vector<Registry::EntityIndex> uavs;
+    std::vector<Registry::EntityIndex> missiles;
+};
+
+Resolved resolve(const ProblemShape& shape, const ScenarioLoader::Scenario& scenario) {
+    if (shape.uavs.empty() || shape.missiles.empty() || shape.grenades_per_uav < 1 ||
+        shape.grenades_per_uav > Config::MAX_GRENADES_PER_UAV) {
+        throw std::invalid_argument("语料问题形状 " + shape.key + " 的无人机、导弹或弹药数无效");
+    }
+    Resolved resolved;
+    for (const auto& id : shape.uavs) {
+        const Registry::EntityIndex index = scenario.entities.uav_index(id);
+        if (index == Registry::INVALID_INDEX) {
+            throw std::runtime_error("语料问题形状中的无人机 " + id + " 不在当前场景中");
+        }
+        resolved.uavs.push_back(index);
+    }
+    for (const auto& id : shape.missiles) {
+        const Registry::EntityIndex index = scenario.entities.missile_index(id);
+        if (index == Registry::INVALID_INDEX) {
+            throw std::runtime_error("语料问题形状中的导弹 " + id + " 不在当前场景中");
+        }
+        resolved.missiles.push_back(index);
+    }
+    return resolved;
+}
+
+/**
+ * @brief 决策变量转为扁平策略 (按无人机索引升序)
+ */
+void to_flat(const Resolved& resolved, int grenades, const Vector& x, Optimizer::FlatStrategy& flat) {
+    flat.resize(resolved.uavs.size());
+    for (size_t u = 0; u < resolved.uavs.size(); ++u) {
+        const double* v = x.data() + u * (2 + 2 * grenades);
+        auto& record = flat[u];
+        record.uav = resolved.uavs[u];
+        record.num_grenades = grenades;
+        record.speed = v[0];
+        record.angle = v[1];
+        double t_deploy = v[2];
+        for (int g = 0; g < grenades; ++g) {
+            if (g > 0) {
+                t_deploy += v[2 + 2 * g];
+            }
+            record.grenades[g] = {t_deploy, v[3 + 2 * g]};
+        }
+    }
+    std::sort(flat.begin(), flat.end(), [](const Optimizer::FlatUAVStrategy& a, const Optimizer::FlatUAVStrategy& b) {
+        return a.uav < b.uav;
+    });
+}
+
+/**
+ * @brief 使第一枚弹药在导弹飞行到 tm 时起爆于导弹到目标视线上的航向、投放与引信时间 (忽略阻力的自由落体)
+ *
+ * @return 是否找到可行解 (最多尝试 8 个 tm)
+ */
+bool aim(const ScenarioLoader::Scenario& scenario, const Resolved& resolved, Registry::EntityIndex uav_index,
+         double speed, CounterRNG::CounterRng& rng, double& angle, double& t_deploy, double& t_fuse) {
+    const auto& physics = scenario.physics;
+    const auto& uav = scenario.entities.uav(uav_index);
+    const auto& missile = scenario.entities.missile(
+        resolved.missiles[rng.uniform_int(static_cast<uint32_t>(resolved.missiles.size()))]);
+    const Vector3d target = scenario.target.center_bottom + Vector3d(0.0, 0.0, 0.5 * scenario.target.height);
+
+    for (int attempt = 0; attempt < 8; ++attempt) {
+        const double tm = rng.uniform(3.0, 50.0);
+        const double fuse = rng.uniform(0.3, 6.0);
+        const double z = uav.start_pos.z() - 0.5 * physics.g * fuse * fuse;
+        const Vector3d p = missile.start_pos + missile.unit_vec * missile.speed * tm;
+        if (p.z() - target.z() < 1e-6 || z < target.z() || z > p.z()) {
+            continue;
+        }
+        const Vector3d q = p + (target - p) * ((p.z() - z) / (p.z() - target.z()));
+        const Vector3d offset = q - uav.start_pos;
+        const double deploy = std::hypot(offset.x(), offset.y()) / speed - fuse;
+        const double detonate = deploy + fuse;
+        if (deploy < 0.1 || detonate > tm || tm - detonate > physics.cloud_duration) {
+            continue;
+        }
+        angle = std::atan2(offset.y(), offset.x());
+        if (angle < 0.0) {
+            angle += 2.0 * M_PI;
+        }
+        t_deploy = deploy;
+        t_fuse = fuse;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief 生成第 index 个策略的决策变量 (未量化)
+ */
+Vector generate_strategy(const ProblemShape& shape, const Resolved& resolved, const ScenarioLoader::Scenario& scenario,
+                         uint64_t seed, uint64_t index, Kind kind, double time_step) {
+    const auto& physics = scenario.physics;
+    const int grenades = shape.grenades_per_uav;
+    CounterRNG::CounterRng rng(seed, index);
+    Vector x(shape.dimension());
+
+    for (size_t u = 0; u < resolved.uavs.size(); ++u) {
+        double* v = x.data() + u * (2 + 2 * grenades);
+        const double speed = rng.uniform(physics.uav_speed_min, physics.uav_speed_max);
+        double angle = rng.uniform(0.0, 2.0 * M_PI);
+        double t_deploy = rng.uniform(0.1, 20.0);
+        double t_fuse = rng.uniform(0.1, 8.0);
+        const bool aimed = kind != Kind::RANDOM && aim(scenario, resolved, resolved.uavs[u], speed, rng,
+                                                       angle, t_deploy, t_fuse);
+        if (aimed && kind == Kind::GRAZING) {
+            // 对数均匀的小扰动：从几乎不动到明显偏离，覆盖锥体边界两侧
+            angle += (rng.uniform() < 0.5 ? -1.0 : 1.0) * std::pow(10.0, rng.uniform(-6.0, -1.5));
+            t_fuse *= 1.0 + (rng.uniform() < 0.5 ? -1.0 : 1.0) * std::pow(10.0, rng.uniform(-6.0, -2.0));
+        } else if (aimed) {
+            angle += rng.uniform(-0.01, 0.01);
+            t_deploy *= rng.uniform(0.97, 1.03);
+            t_fuse *= rng.uniform(0.9, 1.1);
+        }
+        v[0] = speed;
+        v[1] = angle;
+        v[2] = t_deploy;
+        v[3] = t_fuse;
+        for (int g = 1; g < grenades; ++g) {
+            // 瞄准的策略让后续云团沿同一航线排开，遮蔽区间首尾相接
+            v[2 + 2 * g] = aimed ? physics.grenade_interval + rng.uniform(0.0, 1.5)
+                                 : rng.uniform(physics.grenade_interval, 10.0);
+            v[3 + 2 * g] = aimed ? t_fuse * rng.uniform(0.8, 1.2) : rng.uniform(0.1, 8.0);
+        }
+
+        if (kind == Kind::BOUNDARY) {
+            // 逐个变量以 0.3 的概率取端点或刚好越界一个编码步长
+            const double speed_edges[4] = {physics.uav_speed_min, physics.uav_speed_max,
+                                           physics.uav_speed_min - SPEED_SCALE, physics.uav_speed_max + SPEED_SCALE};
+            if (rng.uniform() < 0.3) {
+                v[0] = speed_edges[rng.uniform_int(4)];
+            }
+            if (rng.uniform() < 0.3) {
+                v[2] = rng.uniform() < 0.5 ? 0.0 : -TIME_SCALE;
+            }
+            for (int g = 0; g < grenades; ++g) {
+                if (rng.uniform() < 0.3) {
+                    v[3 + 2 * g] = rng.uniform() < 0.7 ? 0.0 : -TIME_SCALE;
+                }
+                if (g > 0 && rng.uniform() < 0.3) {
+                    v[2 + 2 * g] = rng.uniform() < 0.7 ? physics.grenade_interval
+                                                       : physics.grenade_interval - TIME_SCALE;
+                }
+            }
+            // 第一枚弹药的起爆时刻对齐时间步的整数倍或半整数倍 (扫描起点处 llround 去重最敏感)
+            if (rng.uniform() < 0.5) {
+                const double half = rng.uniform() < 0.5 ? 0.0 : 0.5;
+                const double detonate = (std::floor((v[2] + v[3]) / time_step) + half) * time_step;
+                if (detonate - v[2] >= 0.0) {
+                    v[3] = detonate - v[2];
+                }
+            }
+        }
+    }
+    return x;
+}
+
+// ------------------------------------------------------------------
+// 二进制读写
+// ------------------------------------------------------------------
+
+class FileWriter {
+public:
+    explicit FileWriter(const std::string& path) : path_(path), file_(path, std::ios::binary) {
+        if (!file_) {
+            throw std::runtime_error("无法写入语料文件: " + path);
+        }
+    }
+    void raw(const void* data, size_t size) { file_.write(static_cast<const char*>(data), size); }
+    void u32(uint32_t v) { raw(&v, sizeof(v)); }
+    void u64(uint64_t v) { raw(&v, sizeof(v)); }
+    void f64(double v) { raw(&v, sizeof(v)); }
+    void str(const std::string& s) {
+        u32(static_cast<uint32_t>(s.size()));
+        raw(s.data(), s.size());
+    }
+    void finish() {
+        file_.flush();
+        if (!file_) {
+            throw std::runtime_error("写入语料文件失败: " + path_);
+        }
+    }
+
+private:
+    std::string path_;
+    std::ofstream file_;
+};
+
+class ByteReader {
+public:
+    explicit ByteReader(const std::string& bytes) : bytes_(bytes) {}
+    void raw(void* data, size_t size) {
+        if (size > bytes_.size() - pos_) {
+            throw std::runtime_error("语料文件被截断");
+        }
+        std::memcpy(data, bytes_.data() + pos_, size);
+        pos_ += size;
+    }
+    uint32_t u32() { uint32_t v; raw(&v, sizeof(v)); return v; }
+    uint64_t u64() { uint64_t v; raw(&v, sizeof(v)); return v; }
+    double f64() { double v; raw(&v, sizeof(v)); return v; }
+    std::string str() {
+        const uint32_t size = u32();
+        std::string s(size, '\0');
+        raw(s.data(), size);
+        return s;
+    }
+    size_t position() const { return pos_; }
+
+private:
+    const std::string& bytes_;
+    size_t pos_ = 0;
+};
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief 后端的线程私有缓冲
+ */
+struct Scratch {
+    Optimizer::FlatStrategy flat;
+    std::vector<FastEvaluator::CloudState> clouds;
+    std::vector<double> times;
+};
+
+} // namespace
+
+std::string kind_name(Kind kind) {
+    switch (kind) {
+        case Kind::RANDOM:   return "随机";
+        case Kind::AIMED:    return "瞄准";
+        case Kind::GRAZING:  return "擦边";
+        case Kind::BOUNDARY: return "边界";
+    }
+    return "未知";
+}
+
+std::vector<ProblemShape> standard_problems() {
+    return {
+        {"problem2", "问题2 (1x1, M1)", {"FY1"}, 1, {"M1"}},
+        {"problem3", "问题3 (1x3, M1)", {"FY1"}, 3, {"M1"}},
+        {"problem4", "问题4 (3x1, M1)", {"FY1", "FY2", "FY3"}, 1, {"M1"}},
+        {"problem5", "问题5 (5x3, M1-M3)", {"FY1", "FY2", "FY3", "FY4", "FY5"}, 3, {"M1", "M2", "M3"}},
+    };
+}
+
+// ------------------------------------------------------------------
+// 参考评估器
+// ------------------------------------------------------------------
+
+ReferenceEvaluator::ReferenceEvaluator(const std::vector<Registry::EntityIndex>& missiles,
+                                       const ScenarioLoader::Scenario& scenario, const ReferenceSettings& settings)
+    : settings_(settings), cloud_radius_(scenario.physics.cloud_radius) {
+    if (!(settings.time_step > 0.0) || !(settings.tolerance > 0.0) || settings.circ_samples < 4 ||
+        settings.height_samples < 1) {
+        throw std::invalid_argument("参考评估器的步长、二分精度须为正，圆周采样至少 4 个，高度分段至少 1 段");
+    }
+    for (Registry::EntityIndex index : missiles) {
+        const auto& missile = scenario.entities.missile(index);
+        const Vector3d velocity = missile.unit_vec * missile.speed;
+        missile_start_.push_back({missile.start_pos.x(), missile.start_pos.y(), missile.start_pos.z()});
+        missile_velocity_.push_back({velocity.x(), velocity.y(), velocity.z()});
+    }
+
+    const auto& target = scenario.target;
+    const long double bx = target.center_bottom.x(), by = target.center_bottom.y(), bz = target.center_bottom.z();
+    const long double radius = target.radius, height = target.height;
+    const long double pi = 3.141592653589793238462643383279502884L;
+    key_points_.push_back({bx, by, bz});
+    key_points_.push_back({bx, by, bz + height});
+    for (int i = 0; i < settings.circ_samples; ++i) {
+        const long double angle = 2.0L * pi * i / settings.circ_samples;
+        const long double cx = std::cos(angle), cy = std::sin(angle);
+        for (long double fraction : {1.0L, 0.5L}) {
+            key_points_.push_back({bx + fraction * radius * cx, by + fraction * radius * cy, bz});
+            key_points_.push_back({bx + fraction * radius * cx, by + fraction * radius * cy, bz + height});
+        }
+        for (int j = 1; j < settings.height_samples; ++j) {
+            key_points_.push_back({bx + radius * cx, by + radius * cy, bz + height * j / settings.height_samples});
+        }
+    }
+}
+
+bool ReferenceEvaluator::covered(size_t key, const Point& m, Scan& scan) const {
+    // 点在锥内：vp·vc >= 0 且 |vp × vc|² <= r² |vp|² (与 vp·vc >= cos(半角) |vp| |vc| 等价)
+    const Point& p = key_points_[key];
+    const Point vp{p.x - m.x, p.y - m.y, p.z - m.z};
+    const long double norm2 = vp.x * vp.x + vp.y * vp.y + vp.z * vp.z;
+    if (norm2 < 1e-18L) {
+        return true;
+    }
+    const long double r2 = cloud_radius_ * cloud_radius_;
+    const size_t num_clouds = scan.centers.size();
+    const size_t first = scan.cover[key] < num_clouds ? scan.cover[key] : 0;
+    for (size_t n = 0; n < num_clouds; ++n) {
+        const size_t c = (first + n) % num_clouds;
+        const Point& vc = scan.centers[c];
+        const long double dot = vp.x * vc.x + vp.y * vc.y + vp.z * vc.z;
+        if (dot < 0.0L) {
+            continue;
+        }
+        const long double cx = vp.y * vc.z - vp.z * vc.y;
+        const long double cy = vp.z * vc.x - vp.x * vc.z;
+        const long double cz = vp.x * vc.y - vp.y * vc.x;
+        if (cx * cx + cy * cy + cz * cz <= r2 * norm2) {
+            scan.cover[key] = static_cast<uint16_t>(c);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ReferenceEvaluator::obscured(int missile, long double t,
+                                  const std::vector<const FastEvaluator::CloudState*>& active, Scan& scan) const {
+    const Point& start = missile_start_[missile];
+    const Point& velocity = missile_velocity_[missile];
+    const Point m{start.x + velocity.x * t, start.y + velocity.y * t, start.z + velocity.z * t};
+    const long double r2 = cloud_radius_ * cloud_radius_;
+
+    // 云团中心相对导弹的位置
+    scan.centers.clear();
+    for (const auto* cloud : active) {
+        const long double sink = static_cast<long double>(cloud->sink_speed) * (t - cloud->start_time);
+        const Point vc{cloud->detonate_pos.x() - m.x, cloud->detonate_pos.y() - m.y,
+                       cloud->detonate_pos.z() - sink - m.z};
+        if (vc.x * vc.x + vc.y * vc.y + vc.z * vc.z <= r2) {
+            return true;
+        }
+        scan.centers.push_back(vc);
+    }
+
+    // 相邻时刻通常由同一个未被遮挡的采样点决定，先测上一次的点
+    if (!covered(scan.open, m, scan)) {
+        return false;
+    }
+    for (size_t k = 0; k < key_points_.size(); ++k) {
+        if (k != scan.open && !covered(k, m, scan)) {
+            scan.open = k;
+            return false;
+        }
+    }
+    return true;
+}
+
+long double ReferenceEvaluator::measure(int missile, const std::vector<FastEvaluator::CloudState>& clouds) const {
+    // 云团生效、消散时刻把时间轴分成若干段，每段内的有效云团集合不变
+    std::vector<double> breaks;
+    for (const auto& cloud : clouds) {
+        breaks.push_back(cloud.start_time);
+        breaks.push_back(cloud.end_time);
+    }
+    std::sort(breaks.begin(), breaks.end());
+    breaks.erase(std::unique(breaks.begin(), breaks.end()), breaks.end());
+
+    std::vector<const FastEvaluator::CloudState*> active;
+    Scan scan;
+    scan.cover.assign(key_points_.size(), 0);
+    long double total = 0.0L;
+    for (size_t s = 0; s + 1 < breaks.size(); ++s) {
+        const long double a = breaks[s], b = breaks[s + 1];
+        const double middle = 0.5 * (breaks[s] + breaks[s + 1]);
+        active.clear();
+        for (const auto& cloud : clouds) {
+            if (middle >= cloud.start_time && middle < cloud.end_time) {
+                active.push_back(&cloud);
+            }
+        }
+        if (active.empty()) {
+            continue;
+        }
+
+        const long long steps = std::max(1LL, static_cast<long long>(std::ceil((b - a) / settings_.time_step)));
+        long double previous_t = a;
+        bool previous = obscured(missile, a, active, scan);
+        for (long long j = 1; j <= steps; ++j) {
+            const long double t = j == steps ? b : a + (b - a) * j / steps;
+            const bool current = obscured(missile, t, active, scan);
+            if (previous && current) {
+                total += t - previous_t;
+            } else if (previous != current) {
+                long double lo = previous_t, hi = t;
+                while (hi - lo > settings_.tolerance) {
+                    const long double mid = 0.5L * (lo + hi);
+                    if (obscured(missile, mid, active, scan) == previous) {
+                        lo = mid;
+                    } else {
+                        hi = mid;
+                    }
+                }
+                const long double crossing = 0.5L * (lo + hi);
+                total += previous ? crossing - previous_t : t - crossing;
+            }
+            previous_t = t;
+            previous = current;
+        }
+    }
+    return total;
+}
+
+void ReferenceEvaluator::evaluate(const std::vector<FastEvaluator::CloudState>& clouds, double* obscured_time) const {
+    for (size_t m = 0; m < missile_start_.size(); ++m) {
+        obscured_time[m] = clouds.empty() ? 0.0 : static_cast<double>(measure(static_cast<int>(m), clouds));
+    }
+}
+
+// ------------------------------------------------------------------
+// 语料
+// ------------------------------------------------------------------
+
+Vector Corpus::decode(size_t i) const {
+    const int dim = dimension();
+    Vector x(dim);
+    const uint32_t* code = codes.data() + i * dim;
+    for (int k = 0; k < dim; ++k) {
+        x[k] = offset[k] + static_cast<double>(code[k]) * scale[k];
+    }
+    return x;
+}
+
+double Corpus::reference_total(size_t i) const {
+    double total = 0.0;
+    for (int m = 0; m < num_missiles(); ++m) {
+        total += reference_times[i * num_missiles() + m];
+    }
+    return total;
+}
+
+Corpus generate(const ProblemShape& shape, size_t count, uint64_t seed, const ScenarioLoader::Scenario& scenario,
+                const ReferenceSettings& reference, double time_step, int num_threads) {
+    const Resolved resolved = resolve(shape, scenario);
+    if (!(time_step > 0.0)) {
+        throw std::invalid_argument("语料的时间步长须为正");
+    }
+
+    Corpus corpus;
+    corpus.shape = shape;
+    corpus.scenario_hash = scenario.content_hash;
+    corpus.seed = seed;
+    corpus.time_step = time_step;
+    corpus.reference = reference;
+    for (size_t u = 0; u < shape.uavs.size(); ++u) {
+        corpus.offset.insert(corpus.offset.end(), {SPEED_OFFSET, ANGLE_OFFSET});
+        corpus.scale.insert(corpus.scale.end(), {SPEED_SCALE, ANGLE_SCALE});
+        for (int g = 0; g < shape.grenades_per_uav; ++g) {
+            corpus.offset.insert(corpus.offset.end(), {TIME_OFFSET, TIME_OFFSET});
+            corpus.scale.insert(corpus.scale.end(), {TIME_SCALE, TIME_SCALE});
+        }
+    }
+    const int dim = corpus.dimension();
+    const int num_missiles = corpus.num_missiles();
+    corpus.kinds.resize(count);
+    corpus.codes.resize(count * dim);
+    corpus.reference_times.resize(count * num_missiles);
+
+    const ReferenceEvaluator evaluator(resolved.missiles, scenario, reference);
+    auto& pool = WorkPool::Pool::global();
+    WorkPool::WorkerLocal<Scratch> scratch(pool);
+    pool.parallel_for(static_cast<int>(count), [&](int i) {
+        const Kind kind = KIND_CYCLE[i % 20];
+        const Vector raw = generate_strategy(shape, resolved, scenario, seed, i, kind, time_step);
+        corpus.kinds[i] = static_cast<uint8_t>(kind);
+        for (int k = 0; k < dim; ++k) {
+            corpus.codes[static_cast<size_t>(i) * dim + k] = encode(raw[k], corpus.offset[k], corpus.scale[k]);
+        }
+
+        // 参考值由量化后的决策变量计算，与文件中存放的策略完全对应
+        auto& local = scratch.local();
+        local.times.assign(num_missiles, 0.0);
+        to_flat(resolved, shape.grenades_per_uav, corpus.decode(i), local.flat);
+        if (FastEvaluator::try_build_clouds(local.flat, local.clouds, scenario) == Optimizer::StrategyStatus::OK) {
+            evaluator.evaluate(local.clouds, local.times.data());
+        }
+        for (int m = 0; m < num_missiles; ++m) {
+            corpus.reference_times[static_cast<size_t>(i) * num_missiles + m] = static_cast<float>(local.times[m]);
+        }
+    }, num_threads);
+    return corpus;
+}
+
+void save(const Corpus& corpus, const std::string& path) {
+    FileWriter w(path);
+    w.raw(FILE_MAGIC, sizeof(FILE_MAGIC));
+    w.u32(FILE_VERSION);
+    w.u64(corpus.scenario_hash);
+    w.str(corpus.shape.key);
+    w.str(corpus.shape.name);
+    w.u32(static_cast<uint32_t>(corpus.shape.grenades_per_uav));
+    w.u32(static_cast<uint32_t>(corpus.shape.uavs.size()));
+    for (const auto& id : corpus.shape.uavs) {
+        w.str(id);
+    }
+    w.u32(static_cast<uint32_t>(corpus.shape.missiles.size()));
+    for (const auto& id : corpus.shape.missiles) {
+        w.str(id);
+    }
+    w.u64(corpus.seed);
+    w.f64(corpus.time_step);
+    w.f64(corpus.reference.time_step);
+    w.f64(corpus.reference.tolerance);
+    w.u32(static_cast<uint32_t>(corpus.reference.circ_samples));
+    w.u32(static_cast<uint32_t>(corpus.reference.height_samples));
+    w.u32(static_cast<uint32_t>(corpus.dimension()));
+    for (int k = 0; k < corpus.dimension(); ++k) {
+        w.f64(corpus.offset[k]);
+        w.f64(corpus.scale[k]);
+    }
+    w.u64(corpus.size());
+    w.raw(corpus.kinds.data(), corpus.kinds.size());
+    w.raw(corpus.codes.data(), corpus.codes.size() * sizeof(uint32_t));
+    w.raw(corpus.reference_times.data(), corpus.reference_times.size() * sizeof(float));
+    w.finish();
+}
+
+Corpus load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("无法打开语料文件: " + path);
+    }
+    const std::string bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (bytes.size() < sizeof(FILE_MAGIC) || std::memcmp(bytes.data(), FILE_MAGIC, sizeof(FILE_MAGIC)) != 0) {
+        throw std::runtime_error("不是黄金参考语料文件: " + path);
+    }
+
+    ByteReader r(bytes);
+    char magic[sizeof(FILE_MAGIC)];
+    r.raw(magic, sizeof(magic));
+    const uint32_t version = r.u32();
+    if (version != FILE_VERSION) {
+        throw std::runtime_error("不支持的语料文件版本: " + std::to_string(version));
+    }
+    Corpus corpus;
+    corpus.scenario_hash = r.u64();
+    corpus.shape.key = r.str();
+    corpus.shape.name = r.str();
+    corpus.shape.grenades_per_uav = static_cast<int>(r.u32());
+    const uint32_t num_uavs = r.u32();
+    for (uint32_t u = 0; u < num_uavs; ++u) {
+        corpus.shape.uavs.push_back(r.str());
+    }
+    const uint32_t num_missiles = r.u32();
+    for (uint32_t m = 0; m < num_missiles; ++m) {
+        corpus.shape.missiles.push_back(r.str());
+    }
+    corpus.seed = r.u64();
+    corpus.time_step = r.f64();
+    corpus.reference.time_step = r.f64();
+    corpus.reference.tolerance = r.f64();
+    corpus.reference.circ_samples = static_cast<int>(r.u32());
+    corpus.reference.height_samples = static_cast<int>(r.u32());
+    const uint32_t dim = r.u32();
+    if (static_cast<int>(dim) != corpus.shape.dimension()) {
+        throw std::runtime_error("语料文件的决策变量维度与问题形状不符");
+    }
+    corpus.offset.resize(dim);
+    corpus.scale.resize(dim);
+    for (uint32_t k = 0; k < dim; ++k) {
+        corpus.offset[k] = r.f64();
+        corpus.scale[k] = r.f64();
+    }
+    const uint64_t count = r.u64();
+    if (count > bytes.size()) {
+        throw std::runtime_error("语料文件被截断");
+    }
+    corpus.kinds.resize(count);
+    corpus.codes.resize(count * dim);
+    corpus.reference_times.resize(count * num_missiles);
+    r.raw(corpus.kinds.data(), corpus.kinds.size());
+    r.raw(corpus.codes.data(), corpus.codes.size() * sizeof(uint32_t));
+    r.raw(corpus.reference_times.data(), corpus.reference_times.size() * sizeof(float));
+    if (r.position() != bytes.size()) {
+        throw std::runtime_error("语料文件结尾有多余数据");
+    }
+    for (uint8_t kind : corpus.kinds) {
+        if (kind >= NUM_KINDS) {
+            throw std::runtime_error("语料文件中的生成方式无效");
+        }
+    }
+    return corpus;
+}
+
+// ------------------------------------------------------------------
+// 检查器
+// ------------------------------------------------------------------
+
+std::vector<BackendReport> check(const Corpus& corpus, const ScenarioLoader::Scenario& scenario, int num_threads) {
+    if (corpus.scenario_hash != scenario.content_hash) {
+        throw std::runtime_error("语料 " + corpus.shape.key + " 由另一个场景生成 (内容哈希不同)");
+    }
+    const Resolved resolved = resolve(corpus.shape, scenario);
+    const int grenades = corpus.shape.grenades_per_uav;
+    const int num_missiles = corpus.num_missiles();
+    const size_t count = corpus.size();
+    auto& pool = WorkPool::Pool::global();
+
+    using Backend = std::function<double(const Vector& x, Scratch& scratch)>;
+    std::vector<BackendReport> reports;
+    std::vector<double> baseline;
+
+    auto run = [&](const std::string& name, bool exact, bool gated, const Backend& backend) {
+        std::vector<double> totals(count);
+        WorkPool::WorkerLocal<Scratch> scratch(pool);
+        const auto start = std::chrono::steady_clock::now();
+        pool.parallel_for(static_cast<int>(count), [&](int i) {
+            totals[i] = backend(corpus.decode(i), scratch.local());
+        }, num_threads);
+
+        BackendReport report;
+        report.backend = name;
+        report.exact = exact;
+        report.gated = gated;
+        report.count = count;
+        report.seconds = seconds_since(start);
+        if (baseline.empty()) {
+            baseline = totals;
+        }
+        std::vector<double> abs_errors(count);
+        size_t kind_count[NUM_KINDS] = {};
+        for (size_t i = 0; i < count; ++i) {
+            const double error = totals[i] - corpus.reference_total(i);
+            abs_errors[i] = std::abs(error);
+            report.mean_error += error;
+            report.mean_abs_error += abs_errors[i];
+            if (abs_errors[i] > report.max_abs_error) {
+                report.max_abs_error = abs_errors[i];
+                report.worst = i;
+            }
+            report.mismatches += std::abs(totals[i] - baseline[i]) > MISMATCH_TOLERANCE;
+            report.kind_mean_abs_error[corpus.kinds[i]] += abs_errors[i];
+            ++kind_count[corpus.kinds[i]];
+        }
+        if (count > 0) {
+            report.mean_error /= count;
+            report.mean_abs_error /= count;
+            std::sort(abs_errors.begin(), abs_errors.end());
+            report.p50_abs_error = abs_errors[(count - 1) / 2];
+            report.p99_abs_error = abs_errors[std::min(count - 1, static_cast<size_t>(0.99 * count))];
+        }
+        for (int k = 0; k < NUM_KINDS; ++k) {
+            report.kind_mean_abs_error[k] /= std::max<size_t>(1, kind_count[k]);
+        }
+        reports.push_back(report);
+    };
+
+    auto evaluator_backend = [&](const FastEvaluator::ObscurationEvaluator& evaluator) -> Backend {
+        return [&, num_missiles](const Vector& x, Scratch& s) {
+            to_flat(resolved, grenades, x, s.flat);
+            if (FastEvaluator::try_build_clouds(s.flat, s.clouds, scenario) != Optimizer::StrategyStatus::OK) {
+                return 0.0;
+            }
+            s.times.resize(num_missiles);
+            evaluator.evaluate(s.clouds, s.times.data());
+            double total = 0.0;
+            for (double time : s.times) {
+                total += time;
+            }
+            return total;
+        };
+    };
+
+    // 基准路径：双精度快速评估器
+    FastEvaluator::ObscurationEvaluator evaluator(resolved.missiles, scenario, corpus.time_step);
+    run("双精度", false, true, evaluator_backend(evaluator));
+
+    // 单精度锥体判断 (保护带内双精度复核) 的各 SIMD 档位
+    FastEvaluator::ObscurationEvaluator single(resolved.missiles, scenario, corpus.time_step);
+    single.set_precision(FastEvaluator::Precision::FLOAT32);
+    for (CpuDispatch::IsaLevel level : {CpuDispatch::IsaLevel::SCALAR, CpuDispatch::IsaLevel::SSE42,
+                                        CpuDispatch::IsaLevel::AVX2, CpuDispatch::IsaLevel::AVX512}) {
+        if (level > CpuDispatch::detected()) {
+            continue;
+        }
+        CpuDispatch::force(level);
+        run(std::string("单精度 ") + CpuDispatch::isa_name(level), true, true, evaluator_backend(single));
+    }
+    CpuDispatch::reset();
+
+    // 单次评估的时间扫描拆段并行 (代价模型认为不值得拆分时与不拆分相同)
+    FastEvaluator::ObscurationEvaluator chunked(resolved.missiles, scenario, corpus.time_step);
+    chunked.set_time_chunks(8);
+    run("时间分段", true, true, evaluator_backend(chunked));
+
+    // 编译期特化形状
+    auto shaped = ShapedObjective::make_objective(resolved.uavs, grenades, resolved.missiles, scenario,
+                                                  corpus.time_step);
+    if (shaped) {
+        run("特化形状", true, true, [&](const Vector& x, Scratch&) { return -shaped(x); });
+    }
+
+    // 几何库 (asin/acos 判据，轨迹导出使用)：半径取自当前场景，只在语料场景为当前场景时检查
+    if (ScenarioLoader::active().content_hash == scenario.content_hash) {
+        const Eigen::Matrix3Xd key_points = CoreObjects::TargetCylinder(scenario.target).get_key_points();
+        run("几何库", false, false, [&, num_missiles](const Vector& x, Scratch& s) {
+            to_flat(resolved, grenades, x, s.flat);
+            if (FastEvaluator::try_build_clouds(s.flat, s.clouds, scenario) != Optimizer::StrategyStatus::OK) {
+                return 0.0;
+            }
+            double sim_start = std::numeric_limits<double>::max();
+            double sim_end = std::numeric_limits<double>::lowest();
+            for (const auto& cloud : s.clouds) {
+                sim_start = std::min(sim_start, cloud.start_time);
+                sim_end = std::max(sim_end, cloud.end_time);
+            }
+            long long obscured = 0;
+            std::vector<Vector3d> centers;
+            for (int m = 0; m < num_missiles; ++m) {
+                const auto& missile = scenario.entities.missile(resolved.missiles[m]);
+                long long last_index = std::numeric_limits<long long>::min();
+                for (double t = sim_start; t < sim_end; t += corpus.time_step) {
+                    centers.clear();
+                    for (const auto& cloud : s.clouds) {
+                        if (t >= cloud.start_time && t < cloud.end_time) {
+                            centers.push_back(cloud.detonate_pos +
+                                              Vector3d(0.0, 0.0, -cloud.sink_speed * (t - cloud.start_time)));
+                        }
+                    }
+                    const long long time_index = std::llround(t / corpus.time_step);
+                    if (centers.empty() || time_index == last_index) {
+                        continue;
+                    }
+                    const Vector3d position = missile.start_pos + missile.unit_vec * missile.speed * t;
+                    if (Geometry::check_collective_obscuration(position, centers, key_points)) {
+                        ++obscured;
+                        last_index = time_index;
+                    }
+                }
+            }
+            return obscured * corpus.time_step;
+        });
+    }
+    return reports;
+}
+
+bool passes(const std::vector<BackendReport>& reports, const GateSettings& gate, std::ostream* log) {
+    bool ok = true;
+    for (const auto& report : reports) {
+        if (report.exact && report.mismatches > 0) {
+            ok = false;
+            if (log != nullptr) {
+                *log << report.backend << ": " << report.mismatches << " 个策略与双精度路径不一致" << std::endl;
+            }
+        }
+        if (report.gated && (report.mean_abs_error > gate.max_mean_abs_error ||
+                             report.p99_abs_error > gate.max_p99_abs_error)) {
+            ok = false;
+            if (log != nullptr) {
+                *log << report.backend << ": 平均绝对误差 " << report.mean_abs_error << " s、p99 "
+                     << report.p99_abs_error << " s 超出包络 (" << gate.max_mean_abs_error << " s、"
+                     << gate.max_p99_abs_error << " s)" << std::endl;
+            }
+        }
+    }
+    return ok;
+}
+
+void print_report(const Corpus& corpus, const std::vector<BackendReport>& reports, std::ostream& out) {
+    size_t obscuring = 0;
+    for (size_t i = 0; i < corpus.size(); ++i) {
+        obscuring += corpus.reference_total(i) > 0.0;
+    }
+    out << "=== " << corpus.shape.name << "：" << corpus.size() << " 个策略 (参考值有遮蔽 " << obscuring
+        << ")，参考步长 " << corpus.reference.time_step << " s，二分精度 " << corpus.reference.tolerance
+        << " s，目标采样 " << corpus.reference.circ_samples << "x" << corpus.reference.height_samples << " ===" << std::endl;
+    out << "误差 = 后端总遮蔽时间 - 参考值 (秒)；各生成方式列为平均绝对误差" << std::endl;
+    out << std::left << std::setw(16) << "后端" << std::right << std::setw(10) << "偏差" << std::setw(10) << "平均|e|"
+        << std::setw(9) << "p50" << std::setw(9) << "p99" << std::setw(9) << "最大" << std::setw(10) << "最大处"
+        << std::setw(10) << "不一致";
+    for (int k = 0; k < NUM_KINDS; ++k) {
+        out << std::setw(9) << kind_name(static_cast<Kind>(k));
+    }
+    out << std::setw(12) << "us/策略" << std::endl;
+    for (const auto& report : reports) {
+        out << std::left << std::setw(16) << report.backend << std::right << std::fixed << std::setprecision(4)
+            << std::setw(10) << report.mean_error << std::setw(10) << report.mean_abs_error << std::setprecision(3)
+            << std::setw(9) << report.p50_abs_error << std::setw(9) << report.p99_abs_error << std::setw(9)
+            << report.max_abs_error << std::setw(10) << report.worst << std::setw(10) << report.mismatches;
+        for (int k = 0; k < NUM_KINDS; ++k) {
+            out << std::setw(9) << report.kind_mean_abs_error[k];
+        }
+        out << std::setprecision(1) << std::setw(12)
+            << report.seconds * 1e6 / std::max<size_t>(1, report.count);
+        out << (report.gated ? "" : "  (仅报告)") << std::endl;
+        out.unsetf(std::ios::fixed);
+    }
+}
+
+} // namespace GoldenCorpus
@@ -0,0 +1,204 @@
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include <Eigen/Dense>
+#include "entity_registry.hpp"
+#include "fast_evaluator.hpp"
+#include "scenario.hpp"
+
+/**
+ * @brief 快速评估内核的黄金参考回归语料
+ *
+ * 每个问题形状生成大量随机与对抗性策略 (瞄准视线、贴近锥体边界、参数落在边界上或刚好越界、
+ * 起爆时刻对齐时间步)，用慢速的高精度参考评估器 (细时间步 + 二分定位遮蔽起止时刻、稠密的目标表面采样、
+ * long double 锥体判断) 计算每枚导弹的遮蔽时间，紧凑地存成二进制文件。
+ * 检查器在线程池上并行地用每个评估后端重算全部策略，报告相对参考值的误差分布和与双精度路径不一致的策略数，
+ * 并按门限判定快速内核是否可以合入。
+ *
+ * 决策变量按定点编码存储：value = offset + code × scale，scale 为 2 的负整数次幂，
+ * 整数等边界值可以精确表示，解码与平台无关。参考值由解码后的决策变量计算。
+ */
+namespace GoldenCorpus {
+
+using Vector = Eigen::VectorXd;
+
+/**
+ * @brief 策略的生成方式
+ */
+enum class Kind : uint8_t {
+    RANDOM = 0,     // 在常用区间内均匀抽样 (大部分没有遮蔽)
+    AIMED = 1,      // 起爆点落在某时刻导弹到目标的视线上
+    GRAZING = 2,    // 瞄准后按对数均匀的小量扰动航向和引信，云团贴近锥体边界
+    BOUNDARY = 3    // 参数取区间端点、刚好越界 (一个编码步长) 或使起爆时刻对齐时间步
+};
+
+constexpr int NUM_KINDS = 4;
+
+std::string kind_name(Kind kind);
+
+/**
+ * @brief 问题形状：决策变量布局与 ShapedObjective 相同 (无人机按给定顺序，每机 [速度, 角度, 投放1, 引信1, 间隔k, 引信k...])
+ */
+struct ProblemShape {
+    std::string key;                    // 文件名 (不含扩展名)
+    std::string name;
+    std::vector<std::string> uavs;
+    int grenades_per_uav = 1;
+    std::vector<std::string> missiles;
+
+    int dimension() const { return static_cast<int>(uavs.size()) * (2 + 2 * grenades_per_uav); }
+};
+
+/**
+ * @brief 问题2 (1×1)、问题3 (1×3)、问题4 (3×1，均针对 M1) 与问题5 (5×3，三枚导弹)
+ */
+std::vector<ProblemShape> standard_problems();
+
+/**
+ * @brief 参考评估器的精度设置
+ */
+struct ReferenceSettings {
+    double time_step = 0.005;       // 遮蔽状态的采样步长 (云团生效、消散时刻另作断点)
+    double tolerance = 1e-7;        // 遮蔽起止时刻的二分精度
+    int circ_samples = 64;          // 目标圆周方向的采样数
+    int height_samples = 16;        // 目标高度方向的分段数
+};
+
+/**
+ * @brief 慢速高精度参考评估器
+ *
+ * 遮蔽判据与快速评估器相同 (导弹在云团内，或全部采样点都落在某个云团的阴影锥内)，
+ * 但求的是遮蔽时间的测度而不是按 0.1 s 步长计数：在云团生效、消散时刻之间按 time_step 采样遮蔽状态，
+ * 相邻采样状态不同时二分定位切换时刻。目标表面按上下底面的圆周与半径一半处的圆、侧面网格稠密采样。
+ * 短于 time_step 且两端状态相同的遮蔽片段会被漏掉。
+ */
+class ReferenceEvaluator {
+public:
+    ReferenceEvaluator(const std::vector<Registry::EntityIndex>& missiles, const ScenarioLoader::Scenario& scenario,
+                       const ReferenceSettings& settings = ReferenceSettings());
+
+    /**
+     * @brief 每枚导弹的遮蔽时间 (秒)
+     */
+    void evaluate(const std::vector<FastEvaluator::CloudState>& clouds, double* obscured_time) const;
+
+    int num_key_points() const { return static_cast<int>(key_points_.size()); }
+
+private:
+    struct Point {
+        long double x, y, z;
+    };
+
+    ReferenceSettings settings_;
+    long double cloud_radius_;
+    std::vector<Point> missile_start_;
+    std::vector<Point> missile_velocity_;
+    std::vector<Point> key_points_;
+
+    /**
+     * @brief 测量过程中的缓冲与提示 (只影响测试顺序，不影响结论)
+     */
+    struct Scan {
+        std::vector<Point> centers;         // 有效云团中心相对导弹的位置
+        std::vector<uint16_t> cover;        // 每个采样点上一次被哪个云团遮挡
+        size_t open = 0;                    // 上一次未被遮挡的采样点
+    };
+
+    bool covered(size_t key, const Point& missile, Scan& scan) const;
+    bool obscured(int missile, long double t, const std::vector<const FastEvaluator::CloudState*>& active,
+                  Scan& scan) const;
+    long double measure(int missile, const std::vector<FastEvaluator::CloudState>& clouds) const;
+};
+
+/**
+ * @brief 一个问题形状的语料 (列式存放)
+ */
+struct Corpus {
+    ProblemShape shape;
+    uint64_t scenario_hash = 0;
+    uint64_t seed = 0;
+    double time_step = 0.1;             // 被检查的快速评估器使用的时间步长
+    ReferenceSettings reference;
+    std::vector<double> offset;         // 每个决策变量的编码原点
+    std::vector<double> scale;          // 每个决策变量的编码步长 (2 的负整数次幂)
+    std::vector<uint8_t> kinds;         // [策略]
+    std::vector<uint32_t> codes;        // [策略][变量]
+    std::vector<float> reference_times; // [策略][导弹]，无效策略为 0
+
+    size_t size() const { return kinds.size(); }
+    int dimension() const { return static_cast<int>(offset.size()); }
+    int num_missiles() const { return static_cast<int>(shape.missiles.size()); }
+
+    /**
+     * @brief 第 i 个策略的决策变量
+     */
+    Vector decode(size_t i) const;
+
+    /**
+     * @brief 第 i 个策略的参考总遮蔽时间 (各导弹之和)
+     */
+    double reference_total(size_t i) const;
+};
+
+/**
+ * @brief 按 (seed, 序号) 生成 count 个策略并在线程池上并行计算参考值；生成方式按序号轮换
+ */
+Corpus generate(const ProblemShape& shape, size_t count, uint64_t seed, const ScenarioLoader::Scenario& scenario,
+                const ReferenceSettings& reference = ReferenceSettings(), double time_step = 0.1,
+                int num_threads = -1);
+
+/**
+ * @brief 二进制语料文件 (小端，列式：生成方式、决策变量编码、参考值)
+ */
+void save(const Corpus& corpus, const std::string& path);
+Corpus load(const std::string& path);
+
+/**
+ * @brief 一个评估后端在一份语料上的误差统计 (误差 = 后端总遮蔽时间 - 参考总遮蔽时间)
+ */
+struct BackendReport {
+    std::string backend;
+    bool exact = false;                 // 按设计应与双精度路径逐位一致
+    bool gated = false;                 // 参与门限判定
+    size_t count = 0;
+    double mean_error = 0.0;            // 平均误差 (正值表示高估)
+    double mean_abs_error = 0.0;
+    double p50_abs_error = 0.0;
+    double p99_abs_error = 0.0;
+    double max_abs_error = 0.0;
+    size_t worst = 0;                   // 误差最大的策略序号
+    size_t mismatches = 0;              // 与双精度路径相差超过 1e-9 s 的策略数
+    double kind_mean_abs_error[NUM_KINDS] = {};
+    double seconds = 0.0;
+};
+
+/**
+ * @brief 依次用每个后端重算语料 (各后端内部按策略并行)
+ *
+ * 后端：双精度快速评估器 (基准路径)、单精度锥体判断的各 SIMD 档位 (本机支持的)、时间分段并行、
+ * 编译期特化形状、几何库的 asin/acos 判据 (仅报告，不参与门限)。
+ * 语料与当前场景不符 (内容哈希不同) 时抛出 std::runtime_error。
+ */
+std::vector<BackendReport> check(const Corpus& corpus, const ScenarioLoader::Scenario& scenario,
+                                 int num_threads = -1);
+
+/**
+ * @brief 门限：声明逐位一致的后端不能有不一致，参与门限的后端误差不能超过包络
+ */
+struct GateSettings {
+    double max_mean_abs_error = 0.02;   // 0.1 s 步长计数相对连续测度的平均误差约 0.007 s
+    double max_p99_abs_error = 0.15;    // 约 0.095 s：一个遮蔽区间首尾各不超过一个时间步
+};
+
+/**
+ * @brief 判定是否通过，失败原因写入 log (可为 nullptr)
+ */
+bool passes(const std::vector<BackendReport>& reports, const GateSettings& gate = GateSettings(),
+            std::ostream* log = nullptr);
+
+void print_report(const Corpus& corpus, const std::vector<BackendReport>& reports, std::ostream& out);
+
+} // namespace GoldenCorpus
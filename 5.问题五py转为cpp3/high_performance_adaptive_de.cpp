@@ -1,4 +1,7 @@
 #include "high_performance_adaptive_de.hpp"
+#include "de_core.hpp"
+#include "simd_kernels.hpp"
+#include "job_scheduler.hpp"
 #include <iostream>
 #include <iomanip>
 #include <sstream>
@@ -8,120 +11,285 @@
 
 namespace HighPerformanceDE {
 
+namespace {
+
+/**
+ * @brief 把种群视为解向量序列，供 DECore 的变异策略按下标访问
+ */
+struct SolutionView {
+    const std::vector<Individual>& individuals;
+
+    size_t size() const { return individuals.size(); }
+    const Vector& operator[](int i) const { return individuals[i].solution; }
+};
+
+/**
+ * @brief 截断边界的 SIMD 版本 (运行时按 CPU 选择指令集)，结果与 DECore::ClipBoundary 相同
+ */
+struct SimdClipBoundary {
+    template <int Dim, class Rng>
+    static void apply(DECore::Vector<Dim>& x, const DECore::Box<Dim>& box, Rng&) {
+        SimdKernels::clamp(x.data(), box.lower.data(), box.upper.data(), box.dimension());
+    }
+};
+
+/**
+ * @brief 运行时选择的边界处理方式转为静态策略类型，调用 body(Boundary{})
+ */
+template <class Body>
+void with_boundary(BoundaryHandling handling, bool use_simd, Body&& body) {
+    switch (handling) {
+        case BoundaryHandling::CLIP:
+            if (use_simd) {
+                body(SimdClipBoundary{});
+            } else {
+                body(DECore::ClipBoundary{});
+            }
+            break;
+        case BoundaryHandling::REFLECT:      body(DECore::ReflectBoundary{}); break;
+        case BoundaryHandling::REINITIALIZE: body(DECore::ReinitializeBoundary{}); break;
+        case BoundaryHandling::MIDPOINT:     body(DECore::MidpointBoundary{}); break;
+    }
+}
+
+/**
+ * @brief 运行时选择的变异策略转为静态策略类型，调用 body(Mutation{})
+ *
+ * BEST_2 没有单独实现，与原实现一样退回 DE/rand/1。
+ */
+template <class Body>
+void with_mutation(MutationStrategy strategy, Body&& body) {
+    switch (strategy) {
+        case MutationStrategy::BEST_1:            body(DECore::BestOne{}); break;
+        case MutationStrategy::CURRENT_TO_BEST_1: body(DECore::CurrentToBestOne{}); break;
+        case MutationStrategy::RAND_2:            body(DECore::RandTwo{}); break;
+        default:                                  body(DECore::RandOne{}); break;
+    }
+}
+
+/**
+ * @brief 负数种子表示使用 std::random_device (结果不可复现)
+ */
+uint64_t resolve_seed(int seed) {
+    return seed >= 0 ? static_cast<uint64_t>(seed) : DECore::resolve_seed(0);
+}
+
+// JADE 的均值学习率 c
+constexpr double JADE_LEARNING_RATE = 0.1;
+// L-SHADE 记忆槽中 CR 的终止值 (⊥)
+constexpr double TERMINAL_CR = -1.0;
+// L-SHADE/jSO 线性缩减的最终种群规模
+constexpr int MIN_VARIANT_POPULATION = 4;
+
+int memory_slots(DEVariant variant, int memory_size) {
+    switch (variant) {
+        case DEVariant::JADE: return 1;
+        case DEVariant::JSO:  return 5;
+        default:              return std::max(1, memory_size);
+    }
+}
+
+/**
+ * @brief current-to-pbest/1 的 p 与档案容量倍数 (相对当前种群规模)
+ */
+double pbest_rate(DEVariant variant, double progress) {
+    switch (variant) {
+        case DEVariant::JADE:   return 0.05;
+        case DEVariant::LSHADE: return 0.11;
+        default:                return 0.125 + 0.125 * progress;   // jSO：p 从 0.125 线性增大到 0.25
+    }
+}
+
+double archive_rate(DEVariant variant) {
+    return variant == DEVariant::LSHADE ? 2.6 : 1.0;
+}
+
+/**
+ * @brief jSO 加权变异中 x_pbest - x_i 一项的系数 Fw
+ */
+double pbest_weight(DEVariant variant, double F, double progress) {
+    if (variant != DEVariant::JSO) {
+        return F;
+    }
+    return progress < 0.2 ? 0.7 * F : (progress < 0.4 ? 0.8 * F : 1.2 * F);
+}
+
+} // namespace
+
+std::string variant_name(DEVariant variant) {
+    switch (variant) {
+        case DEVariant::MULTI_STRATEGY: return "多策略SHADE";
+        case DEVariant::JADE:           return "JADE";
+        case DEVariant::LSHADE:         return "L-SHADE";
+        case DEVariant::JSO:            return "jSO";
+    }
+    return "未知";
+}
+
 // =============================================================================
 // AdaptiveParameterManager Implementation
 // =============================================================================
 
-AdaptiveParameterManager::AdaptiveParameterManager(int memory_size, int seed) 
-    : memory_size_(memory_size), mean_F_(0.5), mean_CR_(0.5), std_F_(0.1), std_CR_(0.1) {
-    
-    successful_F_.clear();
-    successful_CR_.clear();
-    
-    // 初始化策略成功率
-    strategy_success_rates_.resize(5, 0.2); // 5种策略，初始均等概率
-    
-    // 设置随机数生成器
-    if (seed >= 0) {
-        rng_.seed(seed);
-    } else {
-        rng_.seed(std::random_device{}());
+AdaptiveParameterManager::AdaptiveParameterManager(int memory_size, double learning_rate, bool strategy_adaptation,
+                                                   DEVariant variant)
+    : memory_F_(memory_slots(variant, memory_size), variant == DEVariant::JSO ? 0.3 : 0.5),
+      memory_CR_(memory_slots(variant, memory_size), variant == DEVariant::JSO ? 0.8 : 0.5),
+      strategy_success_rates_(NUM_STRATEGIES, 1.0 / NUM_STRATEGIES),   // 初始均等概率
+      learning_rate_(learning_rate), strategy_adaptation_(strategy_adaptation), variant_(variant) {
+    if (variant_ == DEVariant::JSO) {
+        memory_F_.back() = 0.9;
+        memory_CR_.back() = 0.9;
     }
+    snapshot_.variant = variant_;
+    refresh_snapshot();
 }
 
-void AdaptiveParameterManager::add_success(double F, double CR, MutationStrategy strategy) {
-    successful_F_.push_back(F);
-    successful_CR_.push_back(CR);
-    
-    // 限制内存使用
-    if (successful_F_.size() > memory_size_) {
-        successful_F_.pop_front();
-        successful_CR_.pop_front();
-    }
+void AdaptiveParameterManager::merge(WorkPool::WorkerLocal<OutcomeBuffer>& buffers) {
+    merged_.clear();
+    buffers.for_each([&](OutcomeBuffer& buffer) {
+        merged_.insert(merged_.end(), buffer.outcomes.begin(), buffer.outcomes.end());
+        buffer.outcomes.clear();
+    });
+    merge(std::move(merged_));
 }
 
-void AdaptiveParameterManager::update_parameters() {
-    if (successful_F_.empty()) return;
-    
-    // 使用Lehmer均值计算F
-    double numerator = 0.0, denominator = 0.0;
-    for (double f : successful_F_) {
-        numerator += f * f;
-        denominator += f;
+void AdaptiveParameterManager::merge(std::vector<Outcome> outcomes) {
+    std::sort(outcomes.begin(), outcomes.end(),
+              [](const Outcome& a, const Outcome& b) { return a.individual < b.individual; });
+    
+    // 成功参数按改进量加权 (JADE 不加权)；改进量不是有限正数时退回等权
+    bool finite_weights = variant_ != DEVariant::JADE;
+    int successes = 0;
+    double max_CR = 0.0;
+    for (const auto& outcome : outcomes) {
+        if (outcome.success) {
+            ++successes;
+            finite_weights = finite_weights && std::isfinite(outcome.improvement) && outcome.improvement > 0.0;
+            max_CR = std::max(max_CR, outcome.CR);
+        }
     }
-    
-    if (denominator > 1e-10) {
-        mean_F_ = numerator / denominator;
+    if (successes > 0) {
+        double weight_sum = 0.0, sum_F = 0.0, sum_F2 = 0.0, sum_CR = 0.0, sum_CR2 = 0.0;
+        for (const auto& outcome : outcomes) {
+            if (!outcome.success) {
+                continue;
+            }
+            const double w = finite_weights ? outcome.improvement : 1.0;
+            weight_sum += w;
+            sum_F += w * outcome.F;
+            sum_F2 += w * outcome.F * outcome.F;
+            sum_CR += w * outcome.CR;
+            sum_CR2 += w * outcome.CR * outcome.CR;
+        }
+        double& slot_F = memory_F_[next_slot_];
+        double& slot_CR = memory_CR_[next_slot_];
+        const double lehmer_F = sum_F > 0.0 ? sum_F2 / sum_F : slot_F;     // 加权 Lehmer 均值
+        switch (variant_) {
+            case DEVariant::MULTI_STRATEGY:
+                slot_F = lehmer_F;
+                slot_CR = sum_CR / weight_sum;
+                break;
+            case DEVariant::JADE:
+                slot_F = (1.0 - JADE_LEARNING_RATE) * slot_F + JADE_LEARNING_RATE * lehmer_F;
+                slot_CR = (1.0 - JADE_LEARNING_RATE) * slot_CR + JADE_LEARNING_RATE * sum_CR / weight_sum;
+                break;
+            case DEVariant::LSHADE:
+            case DEVariant::JSO: {
+                const bool jso = variant_ == DEVariant::JSO;
+                slot_F = jso ? 0.5 * (lehmer_F + slot_F) : lehmer_F;
+                if (slot_CR == TERMINAL_CR || max_CR == 0.0) {
+                    slot_CR = TERMINAL_CR;
+                } else {
+                    const double lehmer_CR = sum_CR2 / sum_CR;
+                    slot_CR = jso ? 0.5 * (lehmer_CR + slot_CR) : lehmer_CR;
+                }
+                break;
+            }
+        }
+        // jSO 的最后一个槽固定不更新
+        const int adaptive_slots = static_cast<int>(memory_F_.size()) - (variant_ == DEVariant::JSO ? 1 : 0);
+        next_slot_ = (next_slot_ + 1) % std::max(1, adaptive_slots);
     }
     
-    // 使用算术均值计算CR
-    double sum_cr = std::accumulate(successful_CR_.begin(), successful_CR_.end(), 0.0);
-    mean_CR_ = sum_cr / successful_CR_.size();
-    
-    // 限制参数范围
-    mean_F_ = std::clamp(mean_F_, 0.1, 2.0);
-    mean_CR_ = std::clamp(mean_CR_, 0.0, 1.0);
+    // 策略成功率：本代各策略的成功比例按学习率做指数平滑，保留最低概率维持探索
+    if (strategy_adaptation_ && variant_ == DEVariant::MULTI_STRATEGY) {
+        std::array<int, NUM_STRATEGIES> trials{};
+        std::array<int, NUM_STRATEGIES> wins{};
+        for (const auto& outcome : outcomes) {
+            const int idx = static_cast<int>(outcome.strategy);
+            if (idx >= NUM_STRATEGIES) {
+                continue;
+            }
+            ++trials[idx];
+            wins[idx] += outcome.success ? 1 : 0;
+        }
+        for (int k = 0; k < NUM_STRATEGIES; ++k) {
+            if (trials[k] > 0) {
+                const double ratio = static_cast<double>(wins[k]) / trials[k];
+                strategy_success_rates_[k] = std::max(0.05,
+                    (1.0 - learning_rate_) * strategy_success_rates_[k] + learning_rate_ * ratio);
+            }
+        }
+    }
     
-    // 清空成功记录
-    successful_F_.clear();
-    successful_CR_.clear();
+    merged_ = std::move(outcomes);
+    merged_.clear();
+    refresh_snapshot();
 }
 
-std::pair<double, double> AdaptiveParameterManager::generate_parameters() {
-    std::normal_distribution<double> f_dist(mean_F_, std_F_);
-    std::normal_distribution<double> cr_dist(mean_CR_, std_CR_);
-    
-    double F = std::clamp(f_dist(rng_), 0.0, 2.0);
-    double CR = std::clamp(cr_dist(rng_), 0.0, 1.0);
-    
-    // 特殊处理F为0的情况
-    if (F <= 0.01) {
-        F = 0.1 + 0.4 * std::uniform_real_distribution<double>(0.0, 1.0)(rng_);
+void AdaptiveParameterManager::refresh_snapshot() {
+    snapshot_.memory_F = memory_F_;
+    snapshot_.memory_CR = memory_CR_;
+    const double total = std::accumulate(strategy_success_rates_.begin(), strategy_success_rates_.end(), 0.0);
+    double cumulative = 0.0;
+    for (int k = 0; k < NUM_STRATEGIES; ++k) {
+        cumulative += strategy_success_rates_[k] / total;
+        snapshot_.strategy_cdf[k] = cumulative;
     }
-    
-    return {F, CR};
 }
 
-MutationStrategy AdaptiveParameterManager::select_strategy() {
-    // 计算累积概率
-    std::vector<double> cumulative_probs(strategy_success_rates_.size());
-    std::partial_sum(strategy_success_rates_.begin(), strategy_success_rates_.end(), 
-                     cumulative_probs.begin());
-    
-    // 归一化
-    double total = cumulative_probs.back();
-    if (total <= 0.0) {
-        return MutationStrategy::RAND_1;  // 默认策略
+std::pair<double, double> AdaptiveParameterManager::get_current_means() const {
+    // 终止槽按 CR = 0 计
+    const double n = static_cast<double>(memory_F_.size());
+    double sum_CR = 0.0;
+    for (double m : memory_CR_) {
+        sum_CR += std::max(m, 0.0);
     }
-    
-    std::for_each(cumulative_probs.begin(), cumulative_probs.end(), 
-                  [total](double& p) { p /= total; });
-    
-    // 轮盘赌选择
-    double rand_val = std::uniform_real_distribution<double>(0.0, 1.0)(rng_);
-    
-    for (size_t i = 0; i < cumulative_probs.size(); ++i) {
-        if (rand_val <= cumulative_probs[i]) {
-            return static_cast<MutationStrategy>(i);
+    return {std::accumulate(memory_F_.begin(), memory_F_.end(), 0.0) / n, sum_CR / n};
+}
+
+std::pair<double, double> AdaptiveParameterManager::Snapshot::generate_parameters(CounterRNG::CounterRng& rng) const {
+    const int r = static_cast<int>(rng.uniform_int(static_cast<uint32_t>(memory_F.size())));
+    double CR = memory_CR[r] == TERMINAL_CR ? 0.0 : std::clamp(rng.normal(memory_CR[r], 0.1), 0.0, 1.0);
+    double F;
+    do {
+        F = rng.cauchy(memory_F[r], 0.1);
+    } while (F <= 0.0);
+    F = std::min(F, 1.0);
+    
+    // jSO：前期保证较大的 CR，前 60% 的评估限制 F 不超过 0.7
+    if (variant == DEVariant::JSO) {
+        if (progress < 0.25) {
+            CR = std::max(CR, 0.7);
+        } else if (progress < 0.5) {
+            CR = std::max(CR, 0.6);
+        }
+        if (progress < 0.6) {
+            F = std::min(F, 0.7);
         }
     }
-    
-    return MutationStrategy::RAND_1;
+    return {F, CR};
 }
 
-void AdaptiveParameterManager::update_strategy_performance(MutationStrategy strategy, bool success) {
-    int idx = static_cast<int>(strategy);
-    if (idx >= 0 && idx < strategy_success_rates_.size()) {
-        const double learning_rate = 0.1;
-        const double decay_rate = 0.95;
-        
-        // 使用指数移动平均更新成功率
-        strategy_success_rates_[idx] = decay_rate * strategy_success_rates_[idx] + 
-                                      learning_rate * (success ? 1.0 : 0.0);
-        
-        // 确保最小概率，维持探索
-        strategy_success_rates_[idx] = std::max(strategy_success_rates_[idx], 0.05);
+MutationStrategy AdaptiveParameterManager::Snapshot::select_strategy(CounterRNG::CounterRng& rng) const {
+    // 轮盘赌选择
+    const double rand_val = rng.uniform();
+    for (int k = 0; k < NUM_STRATEGIES; ++k) {
+        if (rand_val <= strategy_cdf[k]) {
+            return static_cast<MutationStrategy>(k);
+        }
     }
+    return MutationStrategy::RAND_1;
 }
 
 // =============================================================================
@@ -130,92 +298,32 @@ void AdaptiveParameterManager::update_strategy_performance(MutationStrategy stra
 
 BoundaryProcessor::BoundaryProcessor(const Vector& lower, const Vector& upper, 
                                    BoundaryHandling strategy, int seed)
-    : strategy_(strategy), lower_bounds_(lower), upper_bounds_(upper) {
-    
-    if (seed >= 0) {
-        rng_.seed(seed);
-    } else {
-        rng_.seed(std::random_device{}());
-    }
-}
+    : strategy_(strategy), lower_bounds_(lower), upper_bounds_(upper),
+      seed_(resolve_seed(seed)), rng_(seed_, 0) {}
 
 void BoundaryProcessor::process(Vector& individual) const {
-    const int dim = individual.size();
-    
-    switch (strategy_) {
-        case BoundaryHandling::CLIP:
-            for (int i = 0; i < dim; ++i) {
-                individual[i] = std::clamp(individual[i], lower_bounds_[i], upper_bounds_[i]);
-            }
-            break;
-            
-        case BoundaryHandling::REFLECT:
-            for (int i = 0; i < dim; ++i) {
-                if (individual[i] < lower_bounds_[i]) {
-                    individual[i] = lower_bounds_[i] + (lower_bounds_[i] - individual[i]);
-                    individual[i] = std::min(individual[i], upper_bounds_[i]);
-                } else if (individual[i] > upper_bounds_[i]) {
-                    individual[i] = upper_bounds_[i] - (individual[i] - upper_bounds_[i]);
-                    individual[i] = std::max(individual[i], lower_bounds_[i]);
-                }
-            }
-            break;
-            
-        case BoundaryHandling::REINITIALIZE:
-            for (int i = 0; i < dim; ++i) {
-                if (individual[i] < lower_bounds_[i] || individual[i] > upper_bounds_[i]) {
-                    std::uniform_real_distribution<double> dist(lower_bounds_[i], upper_bounds_[i]);
-                    individual[i] = dist(rng_);
-                }
-            }
-            break;
-            
-        case BoundaryHandling::MIDPOINT:
-            for (int i = 0; i < dim; ++i) {
-                if (individual[i] < lower_bounds_[i] || individual[i] > upper_bounds_[i]) {
-                    individual[i] = (lower_bounds_[i] + upper_bounds_[i]) * 0.5;
-                }
-            }
-            break;
-    }
+    const DECore::Box<Eigen::Dynamic> box{lower_bounds_, upper_bounds_};
+    with_boundary(strategy_, false, [&](auto boundary) {
+        decltype(boundary)::apply(individual, box, rng_);
+    });
 }
 
 void BoundaryProcessor::process_population(std::vector<Individual>& population) const {
-    #pragma omp parallel for
-    for (size_t i = 0; i < population.size(); ++i) {
-        process(population[i].solution);
-    }
+    // 每次调用取一个新的流编号，个体 i 使用其中第 i 个子流，并行时不共享随机数状态
+    const DECore::Box<Eigen::Dynamic> box{lower_bounds_, upper_bounds_};
+    const uint64_t stream = (static_cast<uint64_t>(rng_.next_u32()) << 32) | rng_.next_u32();
+    WorkPool::Pool::global().parallel_for(static_cast<int>(population.size()), [&](int i) {
+        CounterRNG::CounterRng rng(seed_, stream, static_cast<uint32_t>(i));
+        with_boundary(strategy_, false, [&](auto boundary) {
+            decltype(boundary)::apply(population[i].solution, box, rng);
+        });
+    });
 }
 
 void BoundaryProcessor::process_simd(Vector& individual) const {
-    // SIMD优化的边界处理（AVX2）
-    const int dim = individual.size();
-    double* data = individual.data();
-    const double* lower_data = lower_bounds_.data();
-    const double* upper_data = upper_bounds_.data();
-    
-    #ifdef __AVX2__
-    const int simd_width = 4;  // AVX2处理4个double
-    int simd_end = (dim / simd_width) * simd_width;
-    
-    for (int i = 0; i < simd_end; i += simd_width) {
-        __m256d values = _mm256_load_pd(&data[i]);
-        __m256d lower = _mm256_load_pd(&lower_data[i]);
-        __m256d upper = _mm256_load_pd(&upper_data[i]);
-        
-        // SIMD clamp操作
-        __m256d clamped = _mm256_max_pd(lower, _mm256_min_pd(values, upper));
-        _mm256_store_pd(&data[i], clamped);
-    }
-    
-    // 处理剩余元素
-    for (int i = simd_end; i < dim; ++i) {
-        data[i] = std::clamp(data[i], lower_data[i], upper_data[i]);
-    }
-    #else
-    // 回退到标准处理
-    process(individual);
-    #endif
+    // SIMD 截断 (运行时按 CPU 选择指令集；Eigen 向量不保证 32 字节对齐，内核使用非对齐访问)
+    SimdKernels::clamp(individual.data(), lower_bounds_.data(), upper_bounds_.data(),
+                       static_cast<int>(individual.size()));
 }
 
 // =============================================================================
@@ -299,10 +407,119 @@ double SolutionCache::get_hit_rate() const {
     return total > 0 ? static_cast<double>(total_hits) / total : 0.0;
 }
 
+// =============================================================================
+// SurrogateModel Implementation
+// =============================================================================
+
+namespace {
+
+// 代理模型特征使用的随机数流 (与按代编号的个体流不重叠)
+constexpr uint64_t SURROGATE_STREAM = ~0ull;
+// 预筛选探索名额使用的子流 (个体子流编号小于种群大小)
+constexpr uint32_t SCREENING_SUBSTREAM = ~0u;
+// 档案超出容量时随机删除使用的子流
+constexpr uint32_t ARCHIVE_SUBSTREAM = ~0u - 1;
+// 格拉姆矩阵按列分块并行更新的块宽
+constexpr int GRAM_BLOCK = 16;
+
+} // namespace
+
+SurrogateModel::SurrogateModel(const Vector& lower, const Vector& upper, int num_features, uint64_t seed,
+                               int num_threads, double length_scale, double forgetting, WorkPool::Pool* pool)
+    : forgetting_(forgetting), num_threads_(num_threads), pool_(pool != nullptr ? *pool : WorkPool::Pool::global()) {
+    const int dimension = lower.size();
+    const int features = std::max(1, num_features);
+    const double sigma = 1.0 / (length_scale * std::sqrt(static_cast<double>(dimension)));
+    
+    // 归一化坐标 u = (x - lower) / (upper - lower) 上的频率 w，换算为原始坐标：w·u = (w / range)·x - (w / range)·lower
+    CounterRNG::CounterRng rng(seed, SURROGATE_STREAM);
+    frequencies_.resize(dimension, features);
+    phases_.resize(features);
+    for (int k = 0; k < features; ++k) {
+        double shift = 0.0;
+        for (int j = 0; j < dimension; ++j) {
+            const double w = rng.normal(0.0, sigma) / (upper[j] - lower[j]);
+            frequencies_(j, k) = w;
+            shift += w * lower[j];
+        }
+        phases_[k] = rng.uniform(0.0, 2.0 * M_PI) - shift;
+    }
+    
+    gram_ = Matrix::Zero(features + 1, features + 1);
+    rhs_ = Vector::Zero(features + 1);
+    weights_ = Vector::Zero(features + 1);
+}
+
+void SurrogateModel::update(const std::vector<Individual>& samples) {
+    std::vector<int> rows;
+    for (size_t i = 0; i < samples.size(); ++i) {
+        if (std::isfinite(samples[i].fitness)) {
+            rows.push_back(static_cast<int>(i));
+        }
+    }
+    if (rows.empty()) {
+        return;
+    }
+    
+    // 特征矩阵按样本分列：第 r 列为第 r 个样本的特征，最后一行为常数特征
+    const int features = phases_.size();
+    const int n = rows.size();
+    const double scale = std::sqrt(2.0 / features);
+    Matrix phi(features + 1, n);
+    Vector y(n);
+    pool_.parallel_for(n, [&](int r) {
+        const Vector& x = samples[rows[r]].solution;
+        for (int k = 0; k < features; ++k) {
+            phi(k, r) = scale * std::cos(frequencies_.col(k).dot(x) + phases_[k]);
+        }
+        phi(features, r) = 1.0;
+        y[r] = samples[rows[r]].fitness;
+    }, num_threads_);
+    
+    // 格拉姆矩阵按列块并行更新，每个元素只由一个任务按固定顺序累加
+    const int blocks = (features + GRAM_BLOCK) / GRAM_BLOCK;
+    pool_.parallel_for(blocks, [&](int b) {
+        const int begin = b * GRAM_BLOCK;
+        const int width = std::min(GRAM_BLOCK, features + 1 - begin);
+        gram_.middleCols(begin, width) *= forgetting_;
+        gram_.middleCols(begin, width) += phi.lazyProduct(phi.middleRows(begin, width).transpose());
+    }, num_threads_, 1);
+    rhs_ = forgetting_ * rhs_ + phi * y;
+    num_samples_ += n;
+    
+    // 岭系数与格拉姆矩阵对角线的量级成比例
+    Matrix system = gram_;
+    const double ridge = 1e-3 * gram_.diagonal().mean() + 1e-12;
+    system.diagonal().array() += ridge;
+    weights_ = system.llt().solve(rhs_);
+}
+
+double SurrogateModel::predict(const Vector& x) const {
+    const int features = phases_.size();
+    const double scale = std::sqrt(2.0 / features);
+    double value = weights_[features];
+    for (int k = 0; k < features; ++k) {
+        value += weights_[k] * scale * std::cos(frequencies_.col(k).dot(x) + phases_[k]);
+    }
+    return value;
+}
+
 // =============================================================================
 // HighPerformanceAdaptiveDE Implementation
 // =============================================================================
 
+namespace {
+
+// 设置了作业时各阶段运行在作业的线程池上，WorkerLocal 的槽位须与之对应
+WorkPool::Pool& settings_pool(const AdaptiveDESettings& settings) {
+    if (settings.job != nullptr) {
+        return settings.job->pool();
+    }
+    return settings.pool != nullptr ? *settings.pool : WorkPool::Pool::global();
+}
+
+} // namespace
+
 HighPerformanceAdaptiveDE::HighPerformanceAdaptiveDE(
     ObjectiveFunction objective,
     const Vector& lower_bounds,
@@ -314,7 +531,10 @@ HighPerformanceAdaptiveDE::HighPerformanceAdaptiveDE(
       settings_(settings),
       current_generation_(0),
       stagnant_generations_(0),
-      total_evaluations_(0) {
+      total_evaluations_(0),
+      outcome_buffers_(settings_pool(settings)),
+      worker_evaluations_(settings_pool(settings), 0),
+      surrogate_skipped_(0) {
     
     // 验证边界
     if (lower_bounds_.size() != upper_bounds_.size()) {
@@ -333,45 +553,49 @@ HighPerformanceAdaptiveDE::HighPerformanceAdaptiveDE(
 void HighPerformanceAdaptiveDE::initialize_components() {
     int dimension = lower_bounds_.size();
     
-    // 自动计算种群大小
+    // 自动计算种群大小 (L-SHADE 取 18 D，jSO 取 25 ln(D) sqrt(D)，随后线性缩减)
     if (settings_.population_size <= 0) {
-        settings_.population_size = std::max(30, 4 * dimension);
-        settings_.population_size = std::min(settings_.population_size, 200); // 限制上限
-    }
-    
-    // 初始化随机数生成器
-    if (settings_.random_seed >= 0) {
-        master_rng_.seed(settings_.random_seed);
-    } else {
-        master_rng_.seed(std::random_device{}());
-    }
-    
-    // 为每个线程创建独立的随机数生成器
-    int num_threads = settings_.num_threads;
-    if (num_threads <= 0) {
-        num_threads = omp_get_max_threads();
+        switch (settings_.variant) {
+            case DEVariant::LSHADE:
+                settings_.population_size = 18 * dimension;
+                break;
+            case DEVariant::JSO:
+                settings_.population_size = static_cast<int>(
+                    std::lround(25.0 * std::log(dimension) * std::sqrt(dimension)));
+                break;
+            default:
+                settings_.population_size = std::max(30, 4 * dimension);
+                settings_.population_size = std::min(settings_.population_size, 200); // 限制上限
+                break;
+        }
+        settings_.population_size = std::max(settings_.population_size, 2 * MIN_VARIANT_POPULATION);
     }
     
-    thread_rngs_.resize(num_threads);
-    for (int i = 0; i < num_threads; ++i) {
-        thread_rngs_[i].seed(master_rng_());
-    }
+    // 计数器型随机数的种子；线程数只影响速度
+    seed_ = resolve_seed(settings_.random_seed);
+    const int available = pool().num_threads();
+    num_threads_ = settings_.num_threads > 0 ? std::min(settings_.num_threads, available) : available;
     
     // 初始化自适应组件
     param_manager_ = std::make_unique<AdaptiveParameterManager>(
-        settings_.memory_size, master_rng_());
+        settings_.memory_size, settings_.learning_rate, settings_.strategy_adaptation, settings_.variant);
     
     boundary_processor_ = std::make_unique<BoundaryProcessor>(
-        lower_bounds_, upper_bounds_, settings_.boundary_handling, master_rng_());
+        lower_bounds_, upper_bounds_, settings_.boundary_handling, settings_.random_seed);
     
     if (settings_.enable_caching) {
         solution_cache_ = std::make_unique<SolutionCache>(10000, 1e-12);
     }
     
+    if (settings_.use_surrogate) {
+        surrogate_ = std::make_unique<SurrogateModel>(
+            lower_bounds_, upper_bounds_, settings_.surrogate_features, seed_, num_threads_, 0.3, 0.8, &pool());
+    }
+    
     // 预分配内存
     population_.reserve(settings_.population_size);
     if (settings_.use_archive) {
-        archive_.reserve(settings_.archive_size);
+        archive_.reserve(archive_capacity() + settings_.population_size);
     }
     convergence_history_.reserve(settings_.max_iterations);
 }
@@ -381,21 +605,46 @@ void HighPerformanceAdaptiveDE::initialize_population() {
     population_.resize(settings_.population_size);
     
     const int dimension = lower_bounds_.size();
+    const DECore::Box<Eigen::Dynamic> box{lower_bounds_, upper_bounds_};
     
-    // 并行初始化种群
-    #pragma omp parallel for
-    for (int i = 0; i < settings_.population_size; ++i) {
-        int thread_id = omp_get_thread_num();
-        auto& rng = thread_rngs_[thread_id];
+    // 并行初始化种群 (初始种群为第0代)；目标函数不可并行调用时只并行生成，随后串行评估
+    const bool evaluate_in_parallel = !noisy_objective_ && settings_.parallel_evaluation;
+    parallel_for(settings_.population_size, [&](int i) {
+        DECore::Rng rng = DECore::individual_rng(seed_, 0, i);
+        Vector solution = DECore::random_individual(box, rng);
         
-        Vector solution(dimension);
-        for (int j = 0; j < dimension; ++j) {
-            std::uniform_real_distribution<double> dist(lower_bounds_[j], upper_bounds_[j]);
-            solution[j] = dist(rng);
-        }
-        
-        double fitness = evaluate_with_cache(solution);
+        double fitness = evaluate_in_parallel ? evaluate_with_cache(solution)
+                                              : std::numeric_limits<double>::infinity();
         population_[i] = Individual(solution, fitness);
+    }, 1);
+    if (cancelled()) {
+        // 作业在初始化中途被取消：未生成的个体补上随机解 (不评估)，保证种群完整
+        for (int i = 0; i < settings_.population_size; ++i) {
+            if (population_[i].solution.size() == 0) {
+                DECore::Rng rng = DECore::individual_rng(seed_, 0, i);
+                population_[i] = Individual(DECore::random_individual(box, rng), std::numeric_limits<double>::infinity());
+            }
+        }
+    }
+    if (!noisy_objective_ && !evaluate_in_parallel) {
+        parallel_evaluation(population_);
+    }
+    
+    // 鲁棒优化模式：初始种群在第0代公共随机数上评估
+    if (noisy_objective_) {
+        std::vector<Vector> solutions(population_.size());
+        for (size_t i = 0; i < population_.size(); ++i) {
+            solutions[i] = population_[i].solution;
+        }
+        std::vector<double> fitness, unused;
+        noisy_objective_->begin_generation(0);
+        noisy_objective_->evaluate_pairs(solutions, {}, fitness, unused);
+        for (size_t i = 0; i < population_.size(); ++i) {
+            population_[i].fitness = fitness[i];
+        }
+        total_evaluations_ += population_.size();
+    } else if (surrogate_) {
+        surrogate_->update(population_);
     }
     
     // 找到初始最佳个体
@@ -415,95 +664,6 @@ void HighPerformanceAdaptiveDE::initialize_population() {
     }
 }
 
-Vector HighPerformanceAdaptiveDE::mutate(int target_idx, MutationStrategy strategy, double F) {
-    const int pop_size = population_.size();
-    const int dimension = lower_bounds_.size();
-    Vector mutant(dimension);
-    
-    // 获取随机个体索引（避免与目标个体相同）
-    std::vector<int> candidates;
-    candidates.reserve(pop_size - 1);
-    for (int i = 0; i < pop_size; ++i) {
-        if (i != target_idx) {
-            candidates.push_back(i);
-        }
-    }
-    
-    int thread_id = omp_get_thread_num();
-    auto& rng = thread_rngs_[thread_id % thread_rngs_.size()];
-    std::shuffle(candidates.begin(), candidates.end(), rng);
-    
-    switch (strategy) {
-        case MutationStrategy::RAND_1: {
-            if (candidates.size() >= 3) {
-                int r1 = candidates[0], r2 = candidates[1], r3 = candidates[2];
-                mutant = population_[r1].solution + F * (population_[r2].solution - population_[r3].solution);
-            }
-            break;
-        }
-        
-        case MutationStrategy::BEST_1: {
-            if (candidates.size() >= 2) {
-                int r1 = candidates[0], r2 = candidates[1];
-                mutant = best_individual_.solution + F * (population_[r1].solution - population_[r2].solution);
-            }
-            break;
-        }
-        
-        case MutationStrategy::CURRENT_TO_BEST_1: {
-            if (candidates.size() >= 2) {
-                int r1 = candidates[0], r2 = candidates[1];
-                mutant = population_[target_idx].solution + 
-                        F * (best_individual_.solution - population_[target_idx].solution) +
-                        F * (population_[r1].solution - population_[r2].solution);
-            }
-            break;
-        }
-        
-        case MutationStrategy::RAND_2: {
-            if (candidates.size() >= 5) {
-                int r1 = candidates[0], r2 = candidates[1], r3 = candidates[2];
-                int r4 = candidates[3], r5 = candidates[4];
-                mutant = population_[r1].solution + 
-                        F * (population_[r2].solution - population_[r3].solution) +
-                        F * (population_[r4].solution - population_[r5].solution);
-            }
-            break;
-        }
-        
-        default:
-            // 默认使用RAND_1
-            if (candidates.size() >= 3) {
-                int r1 = candidates[0], r2 = candidates[1], r3 = candidates[2];
-                mutant = population_[r1].solution + F * (population_[r2].solution - population_[r3].solution);
-            }
-            break;
-    }
-    
-    return mutant;
-}
-
-Vector HighPerformanceAdaptiveDE::crossover(const Vector& target, const Vector& mutant, double CR) {
-    const int dimension = target.size();
-    Vector trial = target;
-    
-    int thread_id = omp_get_thread_num();
-    auto& rng = thread_rngs_[thread_id % thread_rngs_.size()];
-    
-    std::uniform_real_distribution<double> uniform(0.0, 1.0);
-    std::uniform_int_distribution<int> rand_dim(0, dimension - 1);
-    
-    int forced_dim = rand_dim(rng); // 确保至少一个维度被交叉
-    
-    for (int i = 0; i < dimension; ++i) {
-        if (uniform(rng) < CR || i == forced_dim) {
-            trial[i] = mutant[i];
-        }
-    }
-    
-    return trial;
-}
-
 double HighPerformanceAdaptiveDE::evaluate_with_cache(const Vector& solution) {
     double fitness;
     
@@ -515,7 +675,7 @@ double HighPerformanceAdaptiveDE::evaluate_with_cache(const Vector& solution) {
     
     // 评估目标函数
     fitness = objective_function_(solution);
-    total_evaluations_++;
+    ++worker_evaluations_.local();
     
     // 存储到缓存
     if (settings_.enable_caching && solution_cache_) {
@@ -525,66 +685,173 @@ double HighPerformanceAdaptiveDE::evaluate_with_cache(const Vector& solution) {
     return fitness;
 }
 
+size_t HighPerformanceAdaptiveDE::evaluation_count() const {
+    size_t count = total_evaluations_;
+    worker_evaluations_.for_each([&](size_t n) { count += n; });
+    return count;
+}
+
+double HighPerformanceAdaptiveDE::search_progress() const {
+    const double budget = settings_.max_evaluations > 0
+        ? static_cast<double>(settings_.max_evaluations)
+        : static_cast<double>(settings_.population_size) * settings_.max_iterations;
+    return std::min(1.0, static_cast<double>(evaluation_count()) / budget);
+}
+
+bool HighPerformanceAdaptiveDE::evaluation_budget_exhausted() const {
+    return settings_.max_evaluations > 0 &&
+           evaluation_count() >= static_cast<size_t>(settings_.max_evaluations);
+}
+
+bool HighPerformanceAdaptiveDE::cancelled() const {
+    return settings_.job != nullptr && settings_.job->cancelled();
+}
+
+WorkPool::Pool& HighPerformanceAdaptiveDE::pool() const {
+    return settings_pool(settings_);
+}
+
+void HighPerformanceAdaptiveDE::parallel_for(int count, const std::function<void(int)>& body, int grain) const {
+    if (settings_.job != nullptr) {
+        settings_.job->parallel_for(count, body, grain);
+    } else {
+        pool().parallel_for(count, body, num_threads_, grain);
+    }
+}
+
+size_t HighPerformanceAdaptiveDE::archive_capacity() const {
+    if (!settings_.use_archive) {
+        return 0;
+    }
+    if (settings_.variant == DEVariant::MULTI_STRATEGY) {
+        return static_cast<size_t>(std::max(0, settings_.archive_size));
+    }
+    // 容量随种群缩减而缩小
+    const size_t pop_size = population_.empty() ? settings_.population_size : population_.size();
+    return static_cast<size_t>(std::lround(archive_rate(settings_.variant) * pop_size));
+}
+
 void HighPerformanceAdaptiveDE::parallel_mutation_crossover() {
     const int pop_size = population_.size();
     std::vector<Individual> trial_population(pop_size);
     std::vector<std::pair<double, double>> parameters(pop_size);
     std::vector<MutationStrategy> strategies(pop_size);
     
-    // 第一阶段：生成参数和策略
-    #pragma omp parallel for
-    for (int i = 0; i < pop_size; ++i) {
-        parameters[i] = param_manager_->generate_parameters();
-        strategies[i] = param_manager_->select_strategy();
+    // 第一阶段：每个个体抽取参数和策略，并行变异和交叉 (按个体的策略分派到 DECore 的静态实例)
+    // 全部抽样取自本代该个体的随机数流和参数管理器的本代快照。
+    // 目标函数可并行调用时，试验个体生成后在同一任务内直接评估，变异与评估之间不设同步点
+    const DECore::Box<Eigen::Dynamic> box{lower_bounds_, upper_bounds_};
+    const SolutionView view{population_};
+    const SolutionView archive_view{archive_};
+    
+    // current-to-pbest/1 的变体：本代进度写入快照，划分出前 p·NP 个个体 (期望 O(NP)，不整体排序)
+    const bool use_pbest = settings_.variant != DEVariant::MULTI_STRATEGY;
+    double progress = 0.0;
+    if (use_pbest) {
+        progress = search_progress();
+        param_manager_->set_progress(progress);
+        const int num_best = std::clamp(
+            static_cast<int>(std::lround(pbest_rate(settings_.variant, progress) * pop_size)), 2, pop_size);
+        elite_.resize(pop_size);
+        std::iota(elite_.begin(), elite_.end(), 0);
+        std::nth_element(elite_.begin(), elite_.begin() + (num_best - 1), elite_.end(), [&](int a, int b) {
+            return population_[a].fitness < population_[b].fitness ||
+                   (population_[a].fitness == population_[b].fitness && a < b);
+        });
+        elite_.resize(num_best);
     }
-    
-    // 第二阶段：并行变异和交叉
-    #pragma omp parallel for schedule(dynamic)
-    for (int i = 0; i < pop_size; ++i) {
+    const AdaptiveParameterManager::Snapshot& parameter_snapshot = param_manager_->snapshot();
+    // 代理模型预筛选时先生成全部试验个体，排序后只评估其中一部分
+    const bool screening = surrogate_ && !noisy_objective_ && current_generation_ > settings_.surrogate_warmup;
+    const bool fused = !noisy_objective_ && settings_.parallel_evaluation && !screening;
+    parallel_for(pop_size, [&](int i) {
+        DECore::Rng rng = DECore::individual_rng(seed_, current_generation_, i);
+        parameters[i] = parameter_snapshot.generate_parameters(rng);
         double F = parameters[i].first;
         double CR = parameters[i].second;
-        MutationStrategy strategy = strategies[i];
-        
-        // 变异
-        Vector mutant = mutate(i, strategy, F);
-        boundary_processor_->process(mutant);
         
-        // 交叉
-        Vector trial = crossover(population_[i].solution, mutant, CR);
-        boundary_processor_->process(trial);
-        
-        // 创建试验个体
-        trial_population[i].solution = std::move(trial);
-        trial_population[i].fitness = std::numeric_limits<double>::infinity(); // 稍后评估
+        if (use_pbest) {
+            strategies[i] = MutationStrategy::CURRENT_TO_PBEST_1;
+            const double Fw = pbest_weight(settings_.variant, F, progress);
+            with_boundary(settings_.boundary_handling, settings_.use_simd, [&](auto boundary) {
+                DECore::make_pbest_trial<decltype(boundary)>(
+                    view, archive_view, elite_, i, F, Fw, CR, box, rng, trial_population[i].solution);
+            });
+        } else {
+            strategies[i] = parameter_snapshot.select_strategy(rng);
+            with_boundary(settings_.boundary_handling, settings_.use_simd, [&](auto boundary) {
+                with_mutation(strategies[i], [&](auto mutation) {
+                    DECore::make_trial<decltype(mutation), decltype(boundary)>(
+                        view, i, best_individual_.solution, F, CR, box, rng, trial_population[i].solution);
+                });
+            });
+        }
+        trial_population[i].fitness = fused ? evaluate_with_cache(trial_population[i].solution)
+                                            : std::numeric_limits<double>::infinity(); // 稍后评估
+    }, 1);
+    if (cancelled()) {
+        return;     // 作业已取消：部分试验个体未生成，放弃本代
     }
     
-    // 第三阶段：并行评估
-    parallel_evaluation(trial_population);
+    // 第二阶段：未在第一阶段评估的试验个体成对评估 (鲁棒模式)、经预筛选后评估或串行评估
+    std::vector<char> evaluated(pop_size, 1);
+    if (noisy_objective_) {
+        noisy_evaluation(trial_population);
+    } else if (screening) {
+        evaluated = screen_trials(trial_population);
+        auto evaluate_selected = [&](int i) {
+            if (evaluated[i]) {
+                trial_population[i].fitness = evaluate_with_cache(trial_population[i].solution);
+            }
+        };
+        if (settings_.parallel_evaluation) {
+            parallel_for(pop_size, evaluate_selected, 1);
+        } else {
+            for (int i = 0; i < pop_size; ++i) {
+                evaluate_selected(i);
+            }
+        }
+        surrogate_skipped_ += std::count(evaluated.begin(), evaluated.end(), 0);
+    } else if (!fused) {
+        parallel_evaluation(trial_population);
+    }
+    if (surrogate_ && !noisy_objective_) {
+        surrogate_->update(trial_population);
+    }
     
-    // 第四阶段：选择和参数更新
-    bool improved = false;
-    for (int i = 0; i < pop_size; ++i) {
-        if (trial_population[i].fitness < population_[i].fitness) {
-            // 记录成功参数
-            param_manager_->add_success(parameters[i].first, parameters[i].second, strategies[i]);
-            param_manager_->update_strategy_performance(strategies[i], true);
-            
-            // 添加到档案
-            if (settings_.use_archive && archive_.size() < settings_.archive_size) {
-                archive_.push_back(population_[i]);
+    // 第三阶段：并行选择，试验结果记入各线程的缓冲区；档案和全局最优随后按个体顺序串行更新
+    std::vector<char> replaced(pop_size, 0);
+    std::vector<Individual> displaced(settings_.use_archive ? pop_size : 0);
+    parallel_for(pop_size, [&](int i) {
+        if (!evaluated[i]) {
+            return;     // 被预筛选跳过的试验个体不参与选择，也不计入参数统计
+        }
+        const bool success = trial_population[i].fitness < population_[i].fitness;
+        outcome_buffers_.local().outcomes.push_back({i, parameters[i].first, parameters[i].second, strategies[i],
+                                                     population_[i].fitness - trial_population[i].fitness, success});
+        if (success) {
+            if (settings_.use_archive) {
+                displaced[i] = std::move(population_[i]);
             }
-            
-            // 替换个体
             population_[i] = std::move(trial_population[i]);
-            
-            // 更新全局最优
-            if (population_[i].fitness < best_individual_.fitness) {
-                best_individual_ = population_[i];
-                improved = true;
-                stagnant_generations_ = 0;
-            }
-        } else {
-            param_manager_->update_strategy_performance(strategies[i], false);
+            replaced[i] = 1;
+        }
+    });
+    
+    bool improved = false;
+    for (int i = 0; i < pop_size; ++i) {
+        if (!replaced[i]) {
+            continue;
+        }
+        // 被替换的父代进入档案，超出容量的部分在本代种群缩减后随机删除
+        if (settings_.use_archive) {
+            archive_.push_back(std::move(displaced[i]));
+        }
+        // 更新全局最优
+        if (population_[i].fitness < best_individual_.fitness) {
+            best_individual_ = population_[i];
+            improved = true;
+            stagnant_generations_ = 0;
         }
     }
     
@@ -592,20 +859,48 @@ void HighPerformanceAdaptiveDE::parallel_mutation_crossover() {
         stagnant_generations_++;
     }
     
-    // 更新参数
-    param_manager_->update_parameters();
+    // 一次合并各线程的成功记录，更新记忆槽和本代之后的快照
+    param_manager_->merge(outcome_buffers_);
+}
+
+std::vector<char> HighPerformanceAdaptiveDE::screen_trials(const std::vector<Individual>& trials) const {
+    const int n = trials.size();
+    
+    // 按预测改进量 (试验个体与父代的预测值之差，抵消代理模型的整体偏差) 从好到差排序
+    std::vector<double> gain(n);
+    parallel_for(n, [&](int i) {
+        gain[i] = surrogate_->predict(trials[i].solution) - surrogate_->predict(population_[i].solution);
+    });
+    std::vector<int> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return gain[a] < gain[b]; });
+    
+    const int promising = std::min(n, static_cast<int>(std::ceil(settings_.surrogate_eval_fraction * n)));
+    const int exploration = std::min(n - promising, static_cast<int>(std::ceil(settings_.surrogate_exploration * n)));
+    std::vector<char> selected(n, 0);
+    for (int k = 0; k < promising; ++k) {
+        selected[order[k]] = 1;
+    }
+    
+    // 探索名额：从其余个体中无放回随机抽取，防止代理模型的系统性误判一直得不到纠正
+    CounterRNG::CounterRng rng(seed_, static_cast<uint64_t>(current_generation_), SCREENING_SUBSTREAM);
+    for (int k = 0; k < exploration; ++k) {
+        const int pick = promising + k + static_cast<int>(rng.uniform_int(n - promising - k));
+        std::swap(order[promising + k], order[pick]);
+        selected[order[promising + k]] = 1;
+    }
+    return selected;
 }
 
 void HighPerformanceAdaptiveDE::parallel_evaluation(std::vector<Individual>& candidates) {
     const int num_candidates = candidates.size();
     
     if (settings_.parallel_evaluation) {
-        #pragma omp parallel for schedule(dynamic, 1)
-        for (int i = 0; i < num_candidates; ++i) {
+        parallel_for(num_candidates, [&](int i) {
             if (candidates[i].fitness == std::numeric_limits<double>::infinity()) {
                 candidates[i].fitness = evaluate_with_cache(candidates[i].solution);
             }
-        }
+        }, 1);
     } else {
         // 串行评估
         for (int i = 0; i < num_candidates; ++i) {
@@ -616,26 +911,53 @@ void HighPerformanceAdaptiveDE::parallel_evaluation(std::vector<Individual>& can
     }
 }
 
-void HighPerformanceAdaptiveDE::adapt_population_size() {
-    if (!settings_.adaptive_population) return;
+void HighPerformanceAdaptiveDE::noisy_evaluation(std::vector<Individual>& trials) {
+    const int num_trials = trials.size();
+    std::vector<Vector> trial_solutions(num_trials);
+    std::vector<Vector> parent_solutions(num_trials);
+    for (int i = 0; i < num_trials; ++i) {
+        trial_solutions[i] = trials[i].solution;
+        parent_solutions[i] = population_[i].solution;
+    }
     
-    // 线性种群缩减
-    int min_pop_size = std::max(10, static_cast<int>(lower_bounds_.size()));
-    int max_pop_size = settings_.population_size;
+    std::vector<double> trial_fitness, parent_fitness;
+    noisy_objective_->begin_generation(current_generation_);
+    noisy_objective_->evaluate_pairs(trial_solutions, parent_solutions, trial_fitness, parent_fitness);
+    total_evaluations_ += 2 * num_trials;
     
-    double progress = static_cast<double>(current_generation_) / settings_.max_iterations;
-    int target_size = static_cast<int>(max_pop_size - progress * (max_pop_size - min_pop_size));
+    for (int i = 0; i < num_trials; ++i) {
+        trials[i].fitness = trial_fitness[i];
+        population_[i].fitness = parent_fitness[i];
+    }
+    
+    // 父代已按本代样本重新估计，最优个体随之刷新，避免保留历史上最幸运的一次估计
+    auto best_it = std::min_element(population_.begin(), population_.end(),
+        [](const Individual& a, const Individual& b) {
+            return a.fitness < b.fitness;
+        });
+    best_individual_ = *best_it;
+}
+
+void HighPerformanceAdaptiveDE::adapt_population_size() {
+    if (!settings_.adaptive_population || settings_.variant == DEVariant::JADE) return;
+    
+    // 线性种群缩减：L-SHADE/jSO 按已用评估次数从初始规模降到 4 (LPSR)，多策略版本按代数降到 max(10, D)；
+    // JADE 种群规模固定
+    const int max_pop_size = settings_.population_size;
+    int min_pop_size;
+    double progress;
+    if (settings_.variant == DEVariant::LSHADE || settings_.variant == DEVariant::JSO) {
+        min_pop_size = MIN_VARIANT_POPULATION;
+        progress = search_progress();
+    } else {
+        min_pop_size = std::max(10, static_cast<int>(lower_bounds_.size()));
+        progress = static_cast<double>(current_generation_) / settings_.max_iterations;
+    }
+    int target_size = static_cast<int>(std::lround(max_pop_size - progress * (max_pop_size - min_pop_size)));
     target_size = std::max(target_size, min_pop_size);
     
-    if (target_size < population_.size()) {
-        // 保留最优个体
-        std::partial_sort(population_.begin(), population_.begin() + target_size, 
-                         population_.end(),
-                         [](const Individual& a, const Individual& b) {
-                             return a.fitness < b.fitness;
-                         });
-        
-        population_.resize(target_size);
+    if (target_size < static_cast<int>(population_.size())) {
+        shrink_population(target_size);
         
         if (settings_.verbose && current_generation_ % 100 == 0) {
             std::cout << "种群大小调整为: " << target_size << std::endl;
@@ -643,6 +965,29 @@ void HighPerformanceAdaptiveDE::adapt_population_size() {
     }
 }
 
+void HighPerformanceAdaptiveDE::shrink_population(int target_size) {
+    // 保留最优的 target_size 个个体：只需划分，不必排序 (期望 O(NP))
+    std::nth_element(population_.begin(), population_.begin() + target_size, population_.end(),
+                     [](const Individual& a, const Individual& b) {
+                         return a.fitness < b.fitness;
+                     });
+    population_.resize(target_size);
+}
+
+void HighPerformanceAdaptiveDE::update_archive() {
+    // 超出容量时随机删除 (JADE 的做法)，随机数取自本代的档案子流
+    const size_t capacity = archive_capacity();
+    if (archive_.size() <= capacity) {
+        return;
+    }
+    CounterRNG::CounterRng rng(seed_, static_cast<uint64_t>(current_generation_), ARCHIVE_SUBSTREAM);
+    while (archive_.size() > capacity) {
+        const size_t victim = rng.uniform_int(static_cast<uint32_t>(archive_.size()));
+        std::swap(archive_[victim], archive_.back());
+        archive_.pop_back();
+    }
+}
+
 bool HighPerformanceAdaptiveDE::check_convergence() {
     // 适应度容忍度检查
     if (std::abs(best_individual_.fitness) < settings_.tolerance) {
@@ -687,38 +1032,77 @@ void HighPerformanceAdaptiveDE::print_generation_info() {
     }
 }
 
-OptimizationResult HighPerformanceAdaptiveDE::optimize() {
+void HighPerformanceAdaptiveDE::start() {
     start_time_ = std::chrono::steady_clock::now();
+    current_generation_ = 0;
+    stagnant_generations_ = 0;
+    convergence_history_.clear();
+    archive_.clear();
+    initialize_population();
+}
+
+bool HighPerformanceAdaptiveDE::step() {
+    ++current_generation_;
+    
+    // 并行变异、交叉和选择
+    parallel_mutation_crossover();
+    if (cancelled()) {
+        return true;
+    }
+    
+    // 自适应种群大小，档案容量随之调整
+    adapt_population_size();
+    update_archive();
     
+    // 记录收敛历史
+    convergence_history_.push_back(best_individual_.fitness);
+    
+    // 打印进度
+    print_generation_info();
+    
+    return check_convergence();
+}
+
+void HighPerformanceAdaptiveDE::inject(const Vector& solution, double fitness) {
+    auto worst = std::max_element(population_.begin(), population_.end(),
+        [](const Individual& a, const Individual& b) {
+            return a.fitness < b.fitness;
+        });
+    if (worst == population_.end()) {
+        return;
+    }
+    *worst = Individual(solution, fitness);
+    if (fitness < best_individual_.fitness) {
+        best_individual_ = *worst;
+        stagnant_generations_ = 0;
+    }
+}
+
+void HighPerformanceAdaptiveDE::set_num_threads(int num_threads) {
+    const int available = pool().num_threads();
+    num_threads_ = num_threads > 0 ? std::min(num_threads, available) : available;
+}
+
+OptimizationResult HighPerformanceAdaptiveDE::optimize() {
     // 初始化
-    initialize_population();
+    start();
     
     if (settings_.verbose) {
         std::cout << "开始自适应差分进化优化..." << std::endl;
-        std::cout << "设置: 种群=" << population_.size() 
+        std::cout << "设置: 算法=" << variant_name(settings_.variant)
+                  << ", 种群=" << population_.size() 
                   << ", 最大代数=" << settings_.max_iterations
                   << ", 维度=" << lower_bounds_.size() 
-                  << ", 并行线程=" << (settings_.num_threads > 0 ? settings_.num_threads : omp_get_max_threads())
+                  << ", 并行线程=" << num_threads_
                   << std::endl;
     }
     
     // 主进化循环
-    for (current_generation_ = 1; current_generation_ <= settings_.max_iterations; ++current_generation_) {
-        // 并行变异、交叉和选择
-        parallel_mutation_crossover();
-        
-        // 自适应种群大小
-        adapt_population_size();
-        
-        // 记录收敛历史
-        convergence_history_.push_back(best_individual_.fitness);
-        
-        // 打印进度
-        print_generation_info();
-        
-        // 收敛检查
-        if (check_convergence()) {
-            if (settings_.verbose) {
+    while (current_generation_ < settings_.max_iterations && !evaluation_budget_exhausted()) {
+        if (step()) {
+            if (settings_.verbose && cancelled()) {
+                std::cout << "作业已取消，返回当前最佳个体" << std::endl;
+            } else if (settings_.verbose) {
                 std::cout << "在第 " << current_generation_ << " 代收敛" << std::endl;
             }
             break;
@@ -738,8 +1122,9 @@ OptimizationResult HighPerformanceAdaptiveDE::optimize() {
     result.convergence_history = convergence_history_;
     
     // 性能统计
-    result.performance_stats.total_evaluations = total_evaluations_;
-    result.performance_stats.avg_evaluation_time = result.execution_time / total_evaluations_;
+    result.performance_stats.total_evaluations = evaluation_count();
+    result.performance_stats.surrogate_skipped = surrogate_skipped_;
+    result.performance_stats.avg_evaluation_time = result.execution_time / result.performance_stats.total_evaluations;
     
     if (settings_.enable_caching && solution_cache_) {
         auto [hits, misses] = solution_cache_->get_statistics();
@@ -768,7 +1153,10 @@ void HighPerformanceAdaptiveDE::print_performance_report() const {
     
     std::cout << "最优值: " << std::scientific << best_individual_.fitness << std::endl;
     std::cout << "迭代次数: " << current_generation_ << std::endl;
-    std::cout << "函数评估次数: " << total_evaluations_ << std::endl;
+    std::cout << "函数评估次数: " << evaluation_count() << std::endl;
+    if (surrogate_) {
+        std::cout << "代理模型筛掉的试验个体: " << surrogate_skipped_ << std::endl;
+    }
     
     if (settings_.enable_caching && solution_cache_) {
         std::cout << "缓存命中率: " << std::fixed << std::setprecision(1) 
@@ -779,6 +1167,10 @@ void HighPerformanceAdaptiveDE::print_performance_report() const {
     std::cout << "最终参数: F=" << std::setprecision(3) << mean_F 
               << ", CR=" << mean_CR << std::endl;
     
+    if (settings_.variant != DEVariant::MULTI_STRATEGY) {
+        std::cout << "算法变体: " << variant_name(settings_.variant) << ", 档案大小: " << archive_.size() << std::endl;
+        return;
+    }
     const auto& strategy_rates = param_manager_->get_strategy_rates();
     std::cout << "策略成功率: ";
     const std::vector<std::string> strategy_names = {
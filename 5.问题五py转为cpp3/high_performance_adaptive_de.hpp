@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <vector>
 #include <functional>
 #include <random>
@@ -10,9 +11,16 @@
 #include <unordered_map>
 #include <algorithm>
 #include <chrono>
-#include <immintrin.h>  // AVX2 SIMD support
+#include <mutex>
+#include <limits>
+#include <string>
 #include <omp.h>
 #include <Eigen/Dense>
+#include "counter_rng.hpp"
+#include "noisy_objective.hpp"
+#include "work_pool.hpp"
+
+namespace JobScheduler { class Job; }
 
 namespace HighPerformanceDE {
 
@@ -26,9 +34,20 @@ enum class MutationStrategy {
     BEST_1,             // DE/best/1  
     CURRENT_TO_BEST_1,  // DE/current-to-best/1
     RAND_2,             // DE/rand/2
-    BEST_2              // DE/best/2
+    BEST_2,             // DE/best/2
+    CURRENT_TO_PBEST_1  // DE/current-to-pbest/1 + 外部档案 (JADE 系列变体使用，不参与策略轮盘赌)
+};
+
+// 算法变体，共用同一套并行的变异、评估与选择流程
+enum class DEVariant {
+    MULTI_STRATEGY,     // SHADE 参数记忆 + 五种变异策略按成功率轮盘赌 (原有实现)
+    JADE,               // current-to-pbest/1 (p = 0.05) + 档案；μ_F、μ_CR 以 c = 0.1 向本代成功参数的均值移动
+    LSHADE,             // SHADE 记忆 + current-to-pbest/1 (p = 0.11) + 档案 (2.6 NP) + 按评估次数线性缩减种群
+    JSO                 // L-SHADE 基础上：加权 current-to-pbest/1、p 随评估次数增大、F/CR 按进度约束 (Brest et al., 2017)
 };
 
+std::string variant_name(DEVariant variant);
+
 // 边界处理策略
 enum class BoundaryHandling {
     CLIP,           // 截断
@@ -53,6 +72,7 @@ struct OptimizationResult {
         double parallel_efficiency;
         int cache_hits;
         int cache_misses;
+        size_t surrogate_skipped;   // 被代理模型筛掉、未完整评估的试验个体数
     } performance_stats;
 };
 
@@ -62,21 +82,33 @@ struct AdaptiveDESettings {
     int max_iterations = 1000;
     double tolerance = 1e-6;
     int max_stagnant_generations = 50;
-    bool adaptive_population = true;   // 动态种群大小
+    bool adaptive_population = true;   // 动态种群大小 (JADE 不缩减)
     bool use_archive = true;          // 使用历史档案
     int archive_size = 100;
     BoundaryHandling boundary_handling = BoundaryHandling::REFLECT;
     int random_seed = -1;             // -1表示随机种子
+    DEVariant variant = DEVariant::MULTI_STRATEGY;
+    long long max_evaluations = 0;    // 评估次数上限 (不含缓存命中)，0 表示只受代数限制；
+                                      // 同时是 L-SHADE/jSO 进度的分母，0 时取 初始种群 × 最大代数
     bool parallel_evaluation = true;  // 并行评估
     int num_threads = -1;             // -1表示使用所有可用线程
-    bool use_simd = true;             // 使用SIMD优化
+    JobScheduler::Job* job = nullptr; // 非空时各并行阶段提交到共享调度器 (忽略 num_threads)，作业取消时提前结束
+    WorkPool::Pool* pool = nullptr;   // 各并行阶段所用的线程池，空表示 WorkPool::Pool::global() (设置了 job 时不使用)
+    bool use_simd = true;             // 截断边界使用运行时分派的SIMD内核
     bool enable_caching = true;       // 启用解缓存
     bool verbose = true;
     
     // 自适应参数
-    int memory_size = 100;            // 成功参数记忆大小
-    double learning_rate = 0.1;       // 参数学习率
-    bool strategy_adaptation = true;   // 策略自适应
+    int memory_size = 6;              // 成功历史记忆槽数 H (L-SHADE 取 6；JADE 固定为 1，jSO 固定为 5)
+    double learning_rate = 0.1;       // 策略成功率每代的学习率
+    bool strategy_adaptation = true;   // 策略自适应 (关闭时各策略等概率)
+    
+    // 代理模型预筛选 (目标函数昂贵时使用，鲁棒优化模式下不生效)
+    bool use_surrogate = false;
+    double surrogate_eval_fraction = 0.3;   // 每代按预测改进量完整评估的试验个体比例
+    double surrogate_exploration = 0.05;    // 其余个体中随机抽取完整评估的比例
+    int surrogate_features = 200;           // 随机傅里叶特征数
+    int surrogate_warmup = 5;               // 前几代全部评估，只训练模型
 };
 
 // 内存对齐的个体结构，优化缓存访问
@@ -90,31 +122,78 @@ struct alignas(64) Individual {
     Individual(const Vector& sol, double fit) : solution(sol), fitness(fit), constraint_violation(0.0), age(0) {}
 };
 
-// 高性能参数自适应管理器
+// 参数自适应管理器：SHADE 式成功历史记忆 (Tanabe & Fukunaga, CEC 2013)
+//
+// H 个记忆槽保存 (M_F, M_CR)，另有各变异策略的成功率。每代开始时形成只读快照，各线程从快照
+// 用自己的随机数流独立抽样 (F, CR, 策略)；试验结果写入各线程自己的缓冲区，选择结束后 merge()
+// 一次合并：按改进量加权的 Lehmer 均值 (F) 和加权算术均值 (CR) 写入下一个记忆槽，并更新策略成功率。
+// 并行阶段没有共享的可写状态，也没有锁。
+//
+// 记忆更新规则随算法变体而定：JADE 只有一个槽，按 c = 0.1 平滑，均值不加权；L-SHADE 的 CR 也取
+// 加权 Lehmer 均值，本代成功的 CR 全为 0 后该槽记为终止值 (此后从该槽抽样的 CR 恒为 0)；jSO 在
+// L-SHADE 基础上新值与旧值取平均，最后一个槽固定为 (0.9, 0.9)，抽样时按搜索进度约束 F 与 CR。
 class AdaptiveParameterManager {
-private:
-    std::deque<double> successful_F_;
-    std::deque<double> successful_CR_;
-    std::vector<double> strategy_success_rates_;
-    double mean_F_;
-    double mean_CR_;
-    double std_F_;
-    double std_CR_;
-    int memory_size_;
-    std::mt19937 rng_;
-    
 public:
-    explicit AdaptiveParameterManager(int memory_size = 100, int seed = -1);
+    static constexpr int NUM_STRATEGIES = 5;
+    
+    // 一代内只读的抽样参数，可在并行循环中调用
+    struct Snapshot {
+        std::vector<double> memory_F;
+        std::vector<double> memory_CR;
+        std::array<double, NUM_STRATEGIES> strategy_cdf;    // 策略选择的累积概率
+        DEVariant variant = DEVariant::MULTI_STRATEGY;
+        double progress = 0.0;      // 搜索进度 (已用评估次数 / 预算)，jSO 的参数约束使用
+        
+        // 随机取一个记忆槽 r：CR ~ N(M_CR[r], 0.1) 截断到 [0, 1] (终止槽为 0)，F ~ Cauchy(M_F[r], 0.1) 直到为正，超过 1 取 1
+        std::pair<double, double> generate_parameters(CounterRNG::CounterRng& rng) const;
+        MutationStrategy select_strategy(CounterRNG::CounterRng& rng) const;
+    };
+    
+    // 一次试验的结果；合并时按个体下标排序，浮点求和的顺序与线程划分无关
+    struct Outcome {
+        int individual;
+        double F;
+        double CR;
+        MutationStrategy strategy;
+        double improvement;     // 父代与试验个体的目标值之差 (成功时为正)
+        bool success;
+    };
+    
+    // 一个线程的结果缓冲区 (跨代复用容量)
+    struct OutcomeBuffer {
+        std::vector<Outcome> outcomes;
+    };
+    
+    // 记忆槽数：JADE 为 1，jSO 为 5 (含固定槽)，其余取 memory_size
+    explicit AdaptiveParameterManager(int memory_size = 6, double learning_rate = 0.1,
+                                      bool strategy_adaptation = true,
+                                      DEVariant variant = DEVariant::MULTI_STRATEGY);
+    
+    const Snapshot& snapshot() const { return snapshot_; }
     
-    void add_success(double F, double CR, MutationStrategy strategy);
-    void update_parameters();
-    std::pair<double, double> generate_parameters();
-    MutationStrategy select_strategy();
-    void update_strategy_performance(MutationStrategy strategy, bool success);
+    // 设置下一代快照的搜索进度，须在并行阶段之外调用
+    void set_progress(double progress) { snapshot_.progress = progress; }
     
-    // 获取当前参数统计
-    std::pair<double, double> get_current_means() const { return {mean_F_, mean_CR_}; }
+    // 合并各线程缓冲区中本代的全部结果并清空缓冲区，须在并行阶段之外调用
+    void merge(WorkPool::WorkerLocal<OutcomeBuffer>& buffers);
+    void merge(std::vector<Outcome> outcomes);
+    
+    // 获取当前参数统计 (各记忆槽的平均值)
+    std::pair<double, double> get_current_means() const;
     const std::vector<double>& get_strategy_rates() const { return strategy_success_rates_; }
+    
+private:
+    std::vector<double> memory_F_;
+    std::vector<double> memory_CR_;
+    int next_slot_ = 0;
+    std::vector<double> strategy_success_rates_;
+    double learning_rate_;
+    bool strategy_adaptation_;
+    DEVariant variant_;
+    std::vector<Outcome> merged_;   // 合并用的缓冲区 (跨代复用容量)
+    Snapshot snapshot_;
+    
+    void refresh_snapshot();
 };
 
 // 高性能边界处理器
@@ -123,7 +202,8 @@ private:
     BoundaryHandling strategy_;
     Vector lower_bounds_;
     Vector upper_bounds_;
-    std::mt19937 rng_;
+    uint64_t seed_;
+    mutable CounterRNG::CounterRng rng_;
     
 public:
     BoundaryProcessor(const Vector& lower, const Vector& upper, 
@@ -132,7 +212,7 @@ public:
     void process(Vector& individual) const;
     void process_population(std::vector<Individual>& population) const;
     
-    // SIMD优化的边界处理
+    // SIMD截断 (不论边界处理方式，运行时按 CPU 选择指令集)
     void process_simd(Vector& individual) const;
 };
 
@@ -149,8 +229,8 @@ private:
     mutable std::mutex cache_mutex_;
     size_t max_size_;
     double tolerance_;
-    std::atomic<int> hits_{0};
-    std::atomic<int> misses_{0};
+    mutable std::atomic<int> hits_{0};
+    mutable std::atomic<int> misses_{0};
     
     size_t hash_solution(const Vector& solution) const;
     bool is_similar(const Vector& a, const Vector& b, double tol) const;
@@ -166,6 +246,34 @@ public:
     double get_hit_rate() const;
 };
 
+// 在线代理模型：随机傅里叶特征上的岭回归 (近似高斯核回归)，用于预筛选试验个体
+class SurrogateModel {
+private:
+    Matrix frequencies_;    // 维度 × 特征数，已换算到原始坐标 (每列一个特征)
+    Vector phases_;
+    Matrix gram_;           // 特征格拉姆矩阵 (带遗忘)，最后一维为常数特征
+    Vector rhs_;
+    Vector weights_;
+    double forgetting_;
+    int num_threads_;
+    WorkPool::Pool& pool_;
+    size_t num_samples_ = 0;
+    
+public:
+    /**
+     * @param length_scale 核长度尺度，相对归一化到 [0, 1] 的坐标，按 sqrt(维度) 缩放
+     * @param forgetting 每批新样本加入前旧统计量的衰减系数，使模型跟随种群移动
+     */
+    SurrogateModel(const Vector& lower, const Vector& upper, int num_features, uint64_t seed,
+                   int num_threads = -1, double length_scale = 0.3, double forgetting = 0.8,
+                   WorkPool::Pool* pool = nullptr);
+    
+    // 加入适应度有限的个体并重新求解权重；特征与格拉姆矩阵在线程池上并行计算，结果与线程数无关
+    void update(const std::vector<Individual>& samples);
+    double predict(const Vector& x) const;
+    size_t num_samples() const { return num_samples_; }
+};
+
 // 高性能自适应差分进化主类
 class HighPerformanceAdaptiveDE {
 private:
@@ -177,40 +285,54 @@ private:
     
     // 算法状态
     std::vector<Individual> population_;
-    std::vector<Individual> archive_;  // 历史档案
+    std::vector<Individual> archive_;  // 外部档案：被试验个体替换的父代，满后随机删除
+    std::vector<int> elite_;           // 本代目标值排在前 p·NP 的个体下标 (current-to-pbest/1 使用)
     Individual best_individual_;
     int current_generation_;
     int stagnant_generations_;
     
     // 自适应组件
     std::unique_ptr<AdaptiveParameterManager> param_manager_;
+    WorkPool::WorkerLocal<AdaptiveParameterManager::OutcomeBuffer> outcome_buffers_;  // 选择阶段各线程的试验结果
     std::unique_ptr<BoundaryProcessor> boundary_processor_;
     std::unique_ptr<SolutionCache> solution_cache_;
+    std::unique_ptr<SurrogateModel> surrogate_;
+    std::shared_ptr<NoisyObjective::PairwiseNoisyObjective> noisy_objective_;  // 鲁棒优化模式
     
-    // 性能优化
-    std::mt19937 master_rng_;
-    std::vector<std::mt19937> thread_rngs_;  // 每线程独立随机数生成器
+    // 随机数：第 g 代第 i 个个体使用 DECore::individual_rng(seed_, g, i)，结果与线程数和调度无关
+    uint64_t seed_;
+    int num_threads_;   // 各阶段在线程池上的并发上限 (设置了作业时不使用)
     
     // 统计信息
     std::chrono::steady_clock::time_point start_time_;
-    size_t total_evaluations_;
+    size_t total_evaluations_;                          // 串行累计的评估次数 (鲁棒模式)
+    WorkPool::WorkerLocal<size_t> worker_evaluations_;  // 并行阶段各线程的评估次数，避免共享计数器
+    size_t surrogate_skipped_;
     std::vector<double> convergence_history_;
     
     // 私有方法
     void initialize_population();
     void initialize_components();
-    Vector mutate(int target_idx, MutationStrategy strategy, double F);
-    Vector crossover(const Vector& target, const Vector& mutant, double CR);
     double evaluate_with_cache(const Vector& solution);
     void selection_step();
     void update_archive();
     void adapt_population_size();
+    void shrink_population(int target_size);
+    double search_progress() const;
+    size_t archive_capacity() const;
+    bool evaluation_budget_exhausted() const;
+    bool cancelled() const;
     bool check_convergence();
     void print_generation_info();
     
     // 高性能并行方法
+    // 各并行阶段的入口：设置了作业时提交到调度器，否则在线程池上执行；作业取消后剩余下标不再执行
+    void parallel_for(int count, const std::function<void(int)>& body, int grain = 0) const;
+    WorkPool::Pool& pool() const;   // 并行阶段所在的线程池 (作业的线程池或进程级线程池)
     void parallel_mutation_crossover();
     void parallel_evaluation(std::vector<Individual>& candidates);
+    void noisy_evaluation(std::vector<Individual>& trials);
+    std::vector<char> screen_trials(const std::vector<Individual>& trials) const;
     
     // SIMD优化方法
     void simd_vector_operations();
@@ -234,6 +356,25 @@ public:
     // 主要优化接口
     OptimizationResult optimize();
     
+    // 逐代推进 (由外部驱动时使用，如算法组合竞速)：start() 初始化并评估种群，
+    // step() 进化一代，满足收敛或停滞条件或作业被取消时返回 true；代数上限由调用方控制
+    void start();
+    bool step();
+    
+    // 用外部给出的解替换种群中最差的个体 (须在 start() 之后调用)
+    void inject(const Vector& solution, double fitness);
+    
+    // 调整之后各并行阶段的并发上限
+    void set_num_threads(int num_threads);
+    
+    // 至今的目标函数评估次数 (不含缓存命中)，须在并行阶段之外调用
+    size_t evaluation_count() const;
+    
+    // 鲁棒优化模式：设置后改用带噪声目标成对评估试验个体与父代 (公共随机数)，解缓存不再使用
+    void set_noisy_objective(std::shared_ptr<NoisyObjective::PairwiseNoisyObjective> objective) {
+        noisy_objective_ = std::move(objective);
+    }
+    
     // 获取当前状态
     const Individual& get_best_individual() const { return best_individual_; }
     const std::vector<Individual>& get_population() const { return population_; }
@@ -3,6 +3,10 @@
 #include <chrono>
 #include <vector>
 #include <unordered_map>
+#include <iomanip>
+#include <fstream>
+#include <numeric>
+#include <thread>
 
 using namespace OptimizerWrapper;
 
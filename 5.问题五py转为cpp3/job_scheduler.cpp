@@ -0,0 +1,320 @@
+#include "job_scheduler.hpp"
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+
+namespace JobScheduler {
+
+namespace detail {
+
+/**
+ * @brief 一次 parallel_for 调用 (存放在调用者栈上，调用返回前从作业中移除)
+ */
+struct Batch {
+    const std::function<void(int)>* body = nullptr;
+    int count = 0;
+    int grain = 1;
+    int next = 0;           // 下一个未分派的下标
+    int executed = 0;       // 已执行完的下标数
+    int in_flight = 0;      // 正在执行的任务块数
+    std::exception_ptr error;
+
+    bool finished() const { return next >= count && in_flight == 0; }
+};
+
+struct JobState {
+    JobOptions options;
+    bool paused = false;
+    bool cancelled = false;
+    JobStatus cancel_reason = JobStatus::CANCELLED;
+    double virtual_time = 0.0;  // 按权重折算的占用时间，公平份额排序键
+    std::vector<Batch*> batches;
+    std::condition_variable done_cv;
+    JobStats stats;
+};
+
+} // namespace detail
+
+using detail::Batch;
+using detail::JobState;
+
+// ------------------------------------------------------------------
+// Job
+// ------------------------------------------------------------------
+
+Job::Job(Scheduler& scheduler, std::shared_ptr<JobState> state)
+    : scheduler_(scheduler), state_(std::move(state)) {}
+
+Job::~Job() {
+    std::lock_guard<std::mutex> lock(scheduler_.mutex_);
+    auto& jobs = scheduler_.jobs_;
+    jobs.erase(std::remove(jobs.begin(), jobs.end(), state_), jobs.end());
+}
+
+JobStatus Job::parallel_for(int count, const std::function<void(int)>& body, int grain) {
+    Batch batch;
+    batch.body = &body;
+    batch.count = count;
+    batch.grain = grain > 0 ? grain : std::max(1, count / (4 * scheduler_.num_threads()));
+
+    // 池中没有工作线程，或调用者本身是池的工作线程 (等待会占住一个工作线程) 时，由调用者执行本批次
+    WorkPool::Pool& pool = scheduler_.pool_;
+    const bool caller_runs = scheduler_.lanes_ == 0 || pool.slot() < pool.num_threads() - 1;
+    const JobOptions& options = state_->options;
+
+    std::unique_lock<std::mutex> lock(scheduler_.mutex_);
+    scheduler_.expire_deadlines();
+    if (state_->cancelled) {
+        return state_->cancel_reason;
+    }
+    if (count <= 0) {
+        return JobStatus::COMPLETED;
+    }
+
+    state_->batches.push_back(&batch);
+    scheduler_.spawn_locked();
+    while (!batch.finished()) {
+        if (caller_runs && !state_->paused && batch.next < batch.count) {
+            scheduler_.run_chunk(lock, *state_, batch);
+            scheduler_.expire_deadlines();
+        } else if (options.cancel_at_deadline && !state_->cancelled) {
+            // 取任务循环在作业暂停等无任务可取时会退出，截止时间由等待者自己检查
+            state_->done_cv.wait_until(lock, options.deadline);
+            scheduler_.expire_deadlines();
+        } else {
+            state_->done_cv.wait(lock);
+        }
+    }
+    auto& batches = state_->batches;
+    batches.erase(std::find(batches.begin(), batches.end(), &batch));
+
+    JobStatus status = batch.executed == count ? JobStatus::COMPLETED : state_->cancel_reason;
+    lock.unlock();
+
+    if (batch.error) {
+        std::rethrow_exception(batch.error);
+    }
+    return status;
+}
+
+void Job::pause() {
+    std::lock_guard<std::mutex> lock(scheduler_.mutex_);
+    state_->paused = true;
+}
+
+void Job::resume() {
+    std::lock_guard<std::mutex> lock(scheduler_.mutex_);
+    // 暂停期间不累计份额：与其余作业的最少者对齐，避免恢复后长时间独占
+    state_->virtual_time = std::max(state_->virtual_time, scheduler_.min_virtual_time());
+    state_->paused = false;
+    scheduler_.spawn_locked();
+    state_->done_cv.notify_all();
+}
+
+void Job::cancel() {
+    std::lock_guard<std::mutex> lock(scheduler_.mutex_);
+    scheduler_.cancel_locked(*state_, JobStatus::CANCELLED);
+}
+
+bool Job::cancelled() const {
+    std::lock_guard<std::mutex> lock(scheduler_.mutex_);
+    return state_->cancelled;
+}
+
+JobStats Job::stats() const {
+    std::lock_guard<std::mutex> lock(scheduler_.mutex_);
+    return state_->stats;
+}
+
+const JobOptions& Job::options() const {
+    return state_->options;
+}
+
+WorkPool::Pool& Job::pool() const {
+    return scheduler_.pool_;
+}
+
+// ------------------------------------------------------------------
+// Scheduler
+// ------------------------------------------------------------------
+
+Scheduler::Scheduler(int num_threads) : Scheduler(WorkPool::Pool::global(), num_threads) {}
+
+Scheduler::Scheduler(WorkPool::Pool& pool, int num_threads) : pool_(pool) {
+    if (num_threads != -1 && num_threads <= 0) {
+        throw std::invalid_argument("调度器工作线程数必须为正");
+    }
+    const int workers = pool.num_threads() - 1;
+    lanes_ = num_threads == -1 ? workers : std::min(num_threads, workers);
+}
+
+Scheduler::~Scheduler() {
+    // 已提交的取任务循环引用本调度器，等它们全部退出
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_cv_.wait(lock, [this] { return running_ == 0; });
+}
+
+Scheduler& Scheduler::global() {
+    static Scheduler scheduler;
+    return scheduler;
+}
+
+std::unique_ptr<Job> Scheduler::submit(const JobOptions& options) {
+    if (!(options.weight > 0.0)) {
+        throw std::invalid_argument("作业权重必须为正");
+    }
+    auto state = std::make_shared<JobState>();
+    state->options = options;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    // 新作业从当前最少份额开始计，不会因为"欠账"而饿死已有作业
+    state->virtual_time = min_virtual_time();
+    jobs_.push_back(state);
+    return std::unique_ptr<Job>(new Job(*this, state));
+}
+
+double Scheduler::busy_seconds() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return busy_seconds_;
+}
+
+double Scheduler::min_virtual_time() const {
+    double min_time = 0.0;
+    bool found = false;
+    for (const auto& job : jobs_) {
+        if (!job->paused && !job->cancelled && (!found || job->virtual_time < min_time)) {
+            min_time = job->virtual_time;
+            found = true;
+        }
+    }
+    return min_time;
+}
+
+void Scheduler::cancel_locked(JobState& job, JobStatus reason) {
+    if (job.cancelled) {
+        return;
+    }
+    job.cancelled = true;
+    job.cancel_reason = reason;
+    for (Batch* batch : job.batches) {
+        batch->next = batch->count;
+    }
+    job.done_cv.notify_all();
+}
+
+void Scheduler::expire_deadlines() {
+    const auto now = Clock::now();
+    for (const auto& job : jobs_) {
+        if (job->options.cancel_at_deadline && now >= job->options.deadline) {
+            cancel_locked(*job, JobStatus::DEADLINE_EXCEEDED);
+        }
+    }
+}
+
+bool Scheduler::pick(JobState*& picked_job, Batch*& picked_batch) {
+    picked_job = nullptr;
+    picked_batch = nullptr;
+    for (const auto& job : jobs_) {
+        if (job->paused || job->cancelled) {
+            continue;
+        }
+        Batch* batch = nullptr;
+        for (Batch* b : job->batches) {
+            if (b->next < b->count) {
+                batch = b;
+                break;
+            }
+        }
+        if (batch == nullptr) {
+            continue;
+        }
+
+        if (picked_job != nullptr) {
+            const JobOptions& a = job->options;
+            const JobOptions& b = picked_job->options;
+            if (a.priority != b.priority) {
+                if (a.priority < b.priority) continue;
+            } else if (a.deadline != b.deadline) {
+                if (a.deadline > b.deadline) continue;
+            } else if (job->virtual_time >= picked_job->virtual_time) {
+                continue;
+            }
+        }
+        picked_job = job.get();
+        picked_batch = batch;
+    }
+    return picked_job != nullptr;
+}
+
+void Scheduler::spawn_locked() {
+    // 按可分派的任务块数补足取任务循环，最多 lanes_ 个
+    long long chunks = 0;
+    for (const auto& job : jobs_) {
+        if (job->paused || job->cancelled) {
+            continue;
+        }
+        for (const Batch* batch : job->batches) {
+            chunks += (batch->count - batch->next + batch->grain - 1) / batch->grain;
+        }
+    }
+    const int wanted = static_cast<int>(std::min<long long>(chunks, lanes_));
+    while (running_ < wanted) {
+        pool_.post([this] { drain(); });
+        ++running_;
+    }
+}
+
+void Scheduler::drain() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        expire_deadlines();
+        JobState* job = nullptr;
+        Batch* batch = nullptr;
+        if (!pick(job, batch)) {
+            break;
+        }
+        run_chunk(lock, *job, *batch);
+    }
+    // 没有可取的任务时把工作线程还给线程池，新任务到来时再提交
+    if (--running_ == 0) {
+        idle_cv_.notify_all();
+    }
+}
+
+void Scheduler::run_chunk(std::unique_lock<std::mutex>& lock, JobState& job, Batch& batch) {
+    const int begin = batch.next;
+    const int end = std::min(begin + batch.grain, batch.count);
+    batch.next = end;
+    ++batch.in_flight;
+    lock.unlock();
+
+    std::exception_ptr error;
+    int executed = 0;
+    const auto start = Clock::now();
+    try {
+        for (int i = begin; i < end; ++i) {
+            (*batch.body)(i);
+            ++executed;
+        }
+    } catch (...) {
+        error = std::current_exception();
+    }
+    const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+    lock.lock();
+    busy_seconds_ += elapsed;
+    job.stats.busy_seconds += elapsed;
+    job.stats.tasks_completed += executed;
+    job.virtual_time += elapsed / job.options.weight;
+    batch.executed += executed;
+    --batch.in_flight;
+    if (error && !batch.error) {
+        batch.error = error;
+        batch.next = batch.count;  // 出错后不再分派本批次的剩余任务
+    }
+    if (batch.finished()) {
+        job.done_cv.notify_all();
+    }
+}
+
+} // namespace JobScheduler
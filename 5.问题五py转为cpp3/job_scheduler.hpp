@@ -0,0 +1,175 @@
+#pragma once
+
+#include "work_pool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace JobScheduler {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief 作业参数
+ *
+ * 调度顺序：优先级高者先；同优先级时有截止时间者按最早截止时间优先；
+ * 其余按公平份额 (已占用的工作线程时间 / weight) 最少者优先。
+ */
+struct JobOptions {
+    std::string name;
+    int priority = 0;                           // 数值越大越优先
+    Clock::time_point deadline = Clock::time_point::max();  // 默认无截止时间
+    bool cancel_at_deadline = false;            // 超过截止时间后是否自动取消
+    double weight = 1.0;                        // 公平份额权重 (正数)
+};
+
+/**
+ * @brief parallel_for 的结果
+ */
+enum class JobStatus {
+    COMPLETED,          // 所有下标都已执行
+    CANCELLED,          // 作业被取消，部分下标未执行
+    DEADLINE_EXCEEDED   // 超过截止时间被自动取消，部分下标未执行
+};
+
+/**
+ * @brief 作业的累计统计
+ */
+struct JobStats {
+    long long tasks_completed = 0;  // 已执行的下标数
+    double busy_seconds = 0.0;      // 占用的工作线程时间
+};
+
+class Scheduler;
+
+namespace detail {
+struct Batch;
+struct JobState;
+}
+
+/**
+ * @brief 作业句柄：向调度器所在的线程池提交评估任务
+ *
+ * 析构时作业从调度器注销，句柄必须在调度器之前销毁。
+ * parallel_for 可以从多个线程并发调用。
+ */
+class Job {
+public:
+    ~Job();
+    Job(const Job&) = delete;
+    Job& operator=(const Job&) = delete;
+
+    /**
+     * @brief 在线程池的工作线程上执行 body(0) ... body(count - 1)，阻塞直到完成或作业被取消
+     *
+     * 调用线程只等待，不参与计算，因此总并发数不超过调度器占用的工作线程数。
+     * 例外：调用线程本身是该池的工作线程，或池中没有工作线程时，调用线程自己执行本次调用的任务。
+     * body 内部的嵌套并行应使用 WorkPool::Pool::current()，与作业共用同一个线程池。
+     * body 抛出的第一个异常在剩余任务结束后重新抛出。
+     *
+     * @param grain 每次领取的下标数，0 表示按工作线程数自动选择
+     */
+    JobStatus parallel_for(int count, const std::function<void(int)>& body, int grain = 0);
+
+    /**
+     * @brief 暂停后不再分派新的任务 (已在执行的任务会完成)
+     */
+    void pause();
+    void resume();
+
+    /**
+     * @brief 取消作业：丢弃未分派的任务，此后的 parallel_for 立即返回 CANCELLED
+     */
+    void cancel();
+
+    bool cancelled() const;
+    JobStats stats() const;
+    const JobOptions& options() const;
+
+    /**
+     * @brief 作业任务运行所在的线程池 (body 中的 WorkerLocal 应以它构造)
+     */
+    WorkPool::Pool& pool() const;
+
+private:
+    friend class Scheduler;
+    Job(Scheduler& scheduler, std::shared_ptr<detail::JobState> state);
+
+    Scheduler& scheduler_;
+    std::shared_ptr<detail::JobState> state_;
+};
+
+/**
+ * @brief 进程内共享的优化作业调度器
+ *
+ * 调度器不自己创建线程：有任务时向线程池提交取任务循环，同时占用的工作线程不超过 num_threads()，
+ * 作业中的嵌套并行也落在同一个池上，整个进程只有一组工作线程，多个优化同时运行时不会超额订阅。
+ * 任务粒度为一组目标函数评估，调度决策在每次领取任务时做出。
+ * 调度器必须在所用线程池之前销毁。
+ */
+class Scheduler {
+public:
+    /**
+     * @brief 在进程级线程池 WorkPool::Pool::global() 上创建调度器
+     *
+     * @param num_threads 同时占用的工作线程数上限，-1表示使用池中全部工作线程
+     */
+    explicit Scheduler(int num_threads = -1);
+
+    /**
+     * @brief 在指定线程池上创建调度器 (超过池中工作线程数的上限按工作线程数计)
+     */
+    Scheduler(WorkPool::Pool& pool, int num_threads = -1);
+    ~Scheduler();
+    Scheduler(const Scheduler&) = delete;
+    Scheduler& operator=(const Scheduler&) = delete;
+
+    /**
+     * @brief 注册作业
+     */
+    std::unique_ptr<Job> submit(const JobOptions& options = JobOptions());
+
+    /**
+     * @brief 并发执行任务的线程数
+     */
+    int num_threads() const { return std::max(1, lanes_); }
+
+    WorkPool::Pool& pool() const { return pool_; }
+
+    /**
+     * @brief 执行作业任务累计的线程时间 (秒)，用于计算利用率
+     */
+    double busy_seconds() const;
+
+    /**
+     * @brief 进程级默认调度器 (首次调用时创建，使用进程级线程池的全部工作线程)
+     */
+    static Scheduler& global();
+
+private:
+    friend class Job;
+
+    void drain();
+    void spawn_locked();
+    void run_chunk(std::unique_lock<std::mutex>& lock, detail::JobState& job, detail::Batch& batch);
+    bool pick(detail::JobState*& job, detail::Batch*& batch);
+    void expire_deadlines();
+    void cancel_locked(detail::JobState& job, JobStatus reason);
+    double min_virtual_time() const;
+
+    WorkPool::Pool& pool_;
+    int lanes_ = 0;             // 同时运行的取任务循环上限 (0 表示池中没有工作线程)
+    int running_ = 0;           // 已提交到线程池、尚未退出的取任务循环数
+
+    mutable std::mutex mutex_;
+    std::condition_variable idle_cv_;
+    std::vector<std::shared_ptr<detail::JobState>> jobs_;
+    double busy_seconds_ = 0.0;
+};
+
+} // namespace JobScheduler
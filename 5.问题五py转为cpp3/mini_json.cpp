@@ -0,0 +1,224 @@
+#include "mini_json.hpp"
+#include <stdexcept>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace MiniJson {
+
+namespace {
+
+class Parser {
+public:
+    Parser(const std::string& text, const std::string& context)
+        : text_(text), context_(context), pos_(0) {}
+
+    Value parse() {
+        Value value = parse_value();
+        skip_whitespace();
+        if (pos_ != text_.size()) {
+            fail("JSON 结尾有多余内容");
+        }
+        return value;
+    }
+
+private:
+    const std::string& text_;
+    const std::string& context_;
+    size_t pos_;
+
+    [[noreturn]] void fail(const std::string& message) const {
+        int line = 1;
+        for (size_t i = 0; i < pos_ && i < text_.size(); ++i) {
+            line += text_[i] == '\n';
+        }
+        throw std::runtime_error(context_ + "第 " + std::to_string(line) + " 行: " + message);
+    }
+
+    void skip_whitespace() {
+        while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+            ++pos_;
+        }
+    }
+
+    char peek() {
+        skip_whitespace();
+        if (pos_ >= text_.size()) {
+            fail("JSON 意外结束");
+        }
+        return text_[pos_];
+    }
+
+    void expect(char c) {
+        if (peek() != c) {
+            fail(std::string("应为 '") + c + "'");
+        }
+        ++pos_;
+    }
+
+    bool consume_literal(const char* literal) {
+        size_t len = std::strlen(literal);
+        if (text_.compare(pos_, len, literal) == 0) {
+            pos_ += len;
+            return true;
+        }
+        return false;
+    }
+
+    Value parse_value() {
+        char c = peek();
+        Value value;
+        if (c == '{') {
+            value.type = Type::OBJECT;
+            ++pos_;
+            if (peek() == '}') {
+                ++pos_;
+                return value;
+            }
+            while (true) {
+                if (peek() != '"') {
+                    fail("对象键必须是字符串");
+                }
+                std::string key = parse_string();
+                expect(':');
+                value.object.emplace_back(std::move(key), parse_value());
+                if (peek() == ',') {
+                    ++pos_;
+                    continue;
+                }
+                expect('}');
+                return value;
+            }
+        }
+        if (c == '[') {
+            value.type = Type::ARRAY;
+            ++pos_;
+            if (peek() == ']') {
+                ++pos_;
+                return value;
+            }
+            while (true) {
+                value.array.push_back(parse_value());
+                if (peek() == ',') {
+                    ++pos_;
+                    continue;
+                }
+                expect(']');
+                return value;
+            }
+        }
+        if (c == '"') {
+            value.type = Type::STRING;
+            value.string = parse_string();
+            return value;
+        }
+        if (consume_literal("true")) {
+            value.type = Type::BOOLEAN;
+            value.boolean = true;
+            return value;
+        }
+        if (consume_literal("false")) {
+            value.type = Type::BOOLEAN;
+            return value;
+        }
+        if (consume_literal("null")) {
+            return value;
+        }
+        value.type = Type::NUMBER;
+        value.number = parse_number();
+        return value;
+    }
+
+    std::string parse_string() {
+        expect('"');
+        std::string result;
+        while (pos_ < text_.size() && text_[pos_] != '"') {
+            char c = text_[pos_++];
+            if (c != '\\') {
+                result.push_back(c);
+                continue;
+            }
+            if (pos_ >= text_.size()) {
+                break;
+            }
+            char esc = text_[pos_++];
+            switch (esc) {
+                case '"': case '\\': case '/': result.push_back(esc); break;
+                case 'n': result.push_back('\n'); break;
+                case 't': result.push_back('\t'); break;
+                case 'r': result.push_back('\r'); break;
+                case 'b': result.push_back('\b'); break;
+                case 'f': result.push_back('\f'); break;
+                default: fail("不支持的转义字符");
+            }
+        }
+        if (pos_ >= text_.size()) {
+            fail("字符串未结束");
+        }
+        ++pos_;
+        return result;
+    }
+
+    double parse_number() {
+        const char* begin = text_.c_str() + pos_;
+        char* end = nullptr;
+        double value = std::strtod(begin, &end);
+        if (end == begin) {
+            fail("无法识别的值");
+        }
+        pos_ += end - begin;
+        return value;
+    }
+};
+
+} // namespace
+
+const Value* Value::find(const std::string& key) const {
+    for (const auto& [k, v] : object) {
+        if (k == key) {
+            return &v;
+        }
+    }
+    return nullptr;
+}
+
+Value parse(const std::string& text, const std::string& context) {
+    return Parser(text, context).parse();
+}
+
+std::string escape(const std::string& text) {
+    std::string out;
+    for (char c : text) {
+        switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\t': out += "\\t"; break;
+            case '\r': out += "\\r"; break;
+            default:   out.push_back(c);
+        }
+    }
+    return out;
+}
+
+std::string format_number(double value) {
+    char buffer[32];
+    if (value == std::floor(value) && std::abs(value) < 1e15) {
+        std::snprintf(buffer, sizeof(buffer), "%.0f", value);
+        return buffer;
+    }
+    std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+    // 优先输出短表示，只要能精确往返
+    for (int precision = 1; precision < 17; ++precision) {
+        char shorter[32];
+        std::snprintf(shorter, sizeof(shorter), "%.*g", precision, value);
+        if (std::strtod(shorter, nullptr) == value) {
+            return shorter;
+        }
+    }
+    return buffer;
+}
+
+} // namespace MiniJson
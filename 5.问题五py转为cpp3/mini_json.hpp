@@ -0,0 +1,48 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <utility>
+
+namespace MiniJson {
+
+/**
+ * @brief JSON 值类型
+ */
+enum class Type { NUL, BOOLEAN, NUMBER, STRING, ARRAY, OBJECT };
+
+/**
+ * @brief 解析后的 JSON 值 (对象保持键的原始顺序)
+ */
+struct Value {
+    Type type = Type::NUL;
+    bool boolean = false;
+    double number = 0.0;
+    std::string string;
+    std::vector<Value> array;
+    std::vector<std::pair<std::string, Value>> object;
+
+    /**
+     * @brief 查找对象成员，不存在或不是对象时返回 nullptr
+     */
+    const Value* find(const std::string& key) const;
+};
+
+/**
+ * @brief 解析 JSON 文本，语法错误时抛出 std::runtime_error (消息含 context 和行号)
+ *
+ * 只支持场景文件、任务清单需要的子集：不处理 \u 转义。
+ */
+Value parse(const std::string& text, const std::string& context = "JSON");
+
+/**
+ * @brief 转义字符串中的引号、反斜杠和控制字符 (不含外层引号)
+ */
+std::string escape(const std::string& text);
+
+/**
+ * @brief 以可精确往返的最短形式输出浮点数，整数值不带小数点
+ */
+std::string format_number(double value);
+
+} // namespace MiniJson
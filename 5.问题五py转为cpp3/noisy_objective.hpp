@@ -0,0 +1,37 @@
+#pragma once
+
+#include <vector>
+#include <Eigen/Dense>
+
+namespace NoisyObjective {
+
+/**
+ * @brief 带随机噪声的目标函数接口 (最小化)
+ *
+ * 优化器每一代先调用 begin_generation 切换到该代的公共随机数，再把试验个体与对应父代
+ * 成对交给 evaluate_pairs。两者在同一组噪声样本上评估，选择时的比较只反映策略本身的差异。
+ */
+class PairwiseNoisyObjective {
+public:
+    virtual ~PairwiseNoisyObjective() = default;
+
+    /**
+     * @brief 进入新的一代，之后的评估使用该代的公共随机数
+     */
+    virtual void begin_generation(int generation) = 0;
+
+    /**
+     * @brief 在当前代的公共随机数上成对评估试验个体与父代
+     *
+     * @param trials 试验个体
+     * @param parents 与 trials 一一对应的父代；为空时只评估 trials (如初始种群)
+     * @param trial_fitness 输出，试验个体的适应度
+     * @param parent_fitness 输出，父代在本代样本上的重新估计
+     */
+    virtual void evaluate_pairs(const std::vector<Eigen::VectorXd>& trials,
+                                const std::vector<Eigen::VectorXd>& parents,
+                                std::vector<double>& trial_fitness,
+                                std::vector<double>& parent_fitness) = 0;
+};
+
+} // namespace NoisyObjective
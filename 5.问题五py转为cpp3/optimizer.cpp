@@ -1,284 +1,691 @@
 #include "optimizer.hpp"
+#include "robust_objective.hpp"
+#include "fast_evaluator.hpp"
+#include "job_scheduler.hpp"
+#include "shaped_objective.hpp"
+#include "de_core.hpp"
+#include "work_pool.hpp"
+#include "eval_log.hpp"
 #include <iostream>
 #include <algorithm>
+#include <map>
 #include <limits>
 #include <cmath>
-#include <set>
-#include <omp.h>
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
 
 namespace Optimizer {
 
+namespace {
+
+/**
+ * @brief 按位检查有限值 (库以 -ffast-math 编译，std::isfinite 可能被优化掉)
+ */
+inline bool is_finite_bits(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x7FF0000000000000ull) != 0x7FF0000000000000ull;
+}
+
+} // namespace
+
+const char* status_message(StrategyStatus status) {
+    switch (status) {
+        case StrategyStatus::OK:                 return "有效";
+        case StrategyStatus::WRONG_DIMENSION:    return "决策变量维度不符";
+        case StrategyStatus::NON_FINITE:         return "决策变量含非有限值";
+        case StrategyStatus::UNKNOWN_UAV:        return "未知无人机ID";
+        case StrategyStatus::SPEED_OUT_OF_RANGE: return "飞行速度超出范围";
+        case StrategyStatus::NEGATIVE_TIME:      return "投放或引信时间为负";
+        case StrategyStatus::TOO_MANY_GRENADES:  return "单机弹药数超出上限";
+    }
+    return "未知状态";
+}
+
+StrategyStatus validate_strategy(const StrategyMap& strategy, const ScenarioLoader::Scenario& scenario) {
+    const auto& physics = scenario.physics;
+    for (const auto& [uav_id, uav_strat] : strategy) {
+        Registry::EntityIndex uav = scenario.entities.uav_index(uav_id);
+        if (uav == Registry::INVALID_INDEX) {
+            return StrategyStatus::UNKNOWN_UAV;
+        }
+        if (!is_finite_bits(uav_strat.speed) || !is_finite_bits(uav_strat.angle)) {
+            return StrategyStatus::NON_FINITE;
+        }
+        if (uav_strat.speed < physics.uav_speed_min || uav_strat.speed > physics.uav_speed_max) {
+            return StrategyStatus::SPEED_OUT_OF_RANGE;
+        }
+        if (uav_strat.grenades.size() > static_cast<size_t>(scenario.entities.uav(uav).grenade_budget)) {
+            return StrategyStatus::TOO_MANY_GRENADES;
+        }
+        for (const auto& g : uav_strat.grenades) {
+            if (!is_finite_bits(g.t_deploy) || !is_finite_bits(g.t_fuse)) {
+                return StrategyStatus::NON_FINITE;
+            }
+            if (g.t_deploy < 0.0 || g.t_fuse < 0.0) {
+                return StrategyStatus::NEGATIVE_TIME;
+            }
+        }
+    }
+    return StrategyStatus::OK;
+}
+
 // ObscurationOptimizer Implementation
 ObscurationOptimizer::ObscurationOptimizer(
     const std::string& missile_id, 
     const std::unordered_map<std::string, int>& uav_assignments)
-    : uav_assignments_(uav_assignments)
+    : scenario_(ScenarioLoader::active())
+    , uav_assignments_(uav_assignments)
     , time_step_(0.1)
-    , rng_(std::random_device{}())
 {
     missile_ = std::make_unique<CoreObjects::Missile>(missile_id);
-    target_ = std::make_unique<CoreObjects::TargetCylinder>(Config::TRUE_TARGET_SPECS);
+    target_ = std::make_unique<CoreObjects::TargetCylinder>(scenario_.target);
     target_key_points_ = target_->get_key_points();
+    evaluator_ = std::make_unique<FastEvaluator::ObscurationEvaluator>(
+        std::vector<Registry::EntityIndex>{scenario_.entities.missile_index(missile_id)}, scenario_, time_step_);
 }
 
+ObscurationOptimizer::~ObscurationOptimizer() = default;
+
 std::pair<StrategyMap, double> ObscurationOptimizer::solve(
     const std::vector<Bounds>& bounds, 
     const DESettings& settings)
 {
     auto [optimal_vars, max_time] = differential_evolution(bounds, settings);
     
+    if (settings.verbose) {
+        std::cout << "无效试验解: " << invalid_trial_count() << std::endl;
+    }
+    
     // 重新构建最优策略用于详细输出
     StrategyMap optimal_strategy = parse_decision_variables(optimal_vars);
     return {optimal_strategy, -max_time}; // 注意取负号，因为我们最小化负值
 }
 
-double ObscurationOptimizer::objective_function(const VectorXd& decision_variables) {
-    try {
-        StrategyMap strategies = parse_decision_variables(decision_variables);
-        
-        std::vector<std::unique_ptr<CoreObjects::SmokeCloud>> smoke_clouds;
-        
-        for (const auto& [uav_id, uav_strat] : strategies) {
-            auto uav = std::make_unique<CoreObjects::UAV>(uav_id);
-            uav->set_flight_strategy(uav_strat.speed, uav_strat.angle);
-            
-            for (const auto& g_strat : uav_strat.grenades) {
-                auto grenade = uav->deploy_grenade(g_strat.t_deploy, g_strat.t_fuse);
-                smoke_clouds.push_back(grenade->generate_smoke_cloud());
+std::pair<StrategyMap, double> ObscurationOptimizer::solve_robust(
+    const std::vector<Bounds>& bounds,
+    const RobustnessAnalyzer::NoiseModel& noise,
+    const RobustOptimization::RobustSettings& robust_settings,
+    const DESettings& settings)
+{
+    RobustOptimization::RobustObscurationObjective objective(
+        [this](const VectorXd& x, FlatStrategy& strategy) {
+            const StrategyStatus status = this->try_parse_flat(x, strategy);
+            if (status != StrategyStatus::OK) {
+                invalid_trials_.fetch_add(1, std::memory_order_relaxed);
             }
+            return status;
+        },
+        {missile_->get_id()},
+        noise,
+        robust_settings
+    );
+    
+    auto [optimal_vars, best_fitness] = DifferentialEvolution::optimize_noisy(objective, bounds, settings);
+    StrategyMap optimal_strategy = parse_decision_variables(optimal_vars);
+    
+    // 在独立样本上重新估计，避免"赢家诅咒"带来的乐观偏差
+    double robust_time = objective.evaluate(optimal_strategy, robust_settings.max_samples * 8,
+                                            robust_settings.seed ^ 0x5DEECE66Dull);
+    
+    if (settings.verbose) {
+        const auto& stats = objective.stats();
+        std::cout << "鲁棒优化完成: 选择时估计 " << -best_fitness << " s, 独立样本估计 " << robust_time
+                  << " s, 噪声样本评估 " << stats.realisations << " 次, 追加样本的比较 "
+                  << stats.refined_pairs << "/" << stats.pairs << std::endl;
+    }
+    
+    return {optimal_strategy, robust_time};
+}
+
+StrategyStatus validate_strategy(const FlatStrategy& strategy, const ScenarioLoader::Scenario& scenario) {
+    const auto& registry = scenario.entities;
+    const auto& physics = scenario.physics;
+    for (const auto& record : strategy) {
+        if (!registry.valid_uav(record.uav)) {
+            return StrategyStatus::UNKNOWN_UAV;
         }
-        
-        if (smoke_clouds.empty()) {
-            return 0.0;
+        if (record.num_grenades < 0 || record.num_grenades > registry.uav(record.uav).grenade_budget) {
+            return StrategyStatus::TOO_MANY_GRENADES;
         }
-        
-        // 计算仿真时间范围
-        double sim_start_time = std::numeric_limits<double>::max();
-        double sim_end_time = std::numeric_limits<double>::lowest();
-        
-        for (const auto& cloud : smoke_clouds) {
-            sim_start_time = std::min(sim_start_time, cloud->get_start_time());
-            sim_end_time = std::max(sim_end_time, cloud->get_end_time());
+        if (!is_finite_bits(record.speed) || !is_finite_bits(record.angle)) {
+            return StrategyStatus::NON_FINITE;
         }
-        
-        // 使用集合去重计算有效遮蔽时间点
-        std::set<int> obscured_time_points;
-        
-        for (double t = sim_start_time; t < sim_end_time; t += time_step_) {
-            // 获取当前所有有效的云团中心
-            std::vector<Vector3d> active_cloud_centers;
-            
-            for (const auto& cloud : smoke_clouds) {
-                auto center = cloud->get_center(t);
-                if (center.has_value()) {
-                    active_cloud_centers.push_back(center.value());
-                }
-            }
-            
-            if (active_cloud_centers.empty()) {
-                continue;
+        if (record.speed < physics.uav_speed_min || record.speed > physics.uav_speed_max) {
+            return StrategyStatus::SPEED_OUT_OF_RANGE;
+        }
+        for (int i = 0; i < record.num_grenades; ++i) {
+            const auto& g = record.grenades[i];
+            if (!is_finite_bits(g.t_deploy) || !is_finite_bits(g.t_fuse)) {
+                return StrategyStatus::NON_FINITE;
             }
-            
-            // 调用协同判断函数
-            Vector3d missile_pos = missile_->get_position(t);
-            if (Geometry::check_collective_obscuration(
-                    missile_pos, 
-                    active_cloud_centers, 
-                    target_key_points_)) {
-                obscured_time_points.insert(static_cast<int>(std::round(t / time_step_)));
+            if (g.t_deploy < 0.0 || g.t_fuse < 0.0) {
+                return StrategyStatus::NEGATIVE_TIME;
             }
         }
+    }
+    return StrategyStatus::OK;
+}
+
+StrategyStatus to_flat_strategy(const StrategyMap& strategy,
+                                FlatStrategy& flat,
+                                const ScenarioLoader::Scenario& scenario)
+{
+    const auto& registry = scenario.entities;
+    flat.clear();
+    for (const auto& [uav_id, uav_strat] : strategy) {
+        FlatUAVStrategy record;
+        record.uav = registry.uav_index(uav_id);
+        if (record.uav == Registry::INVALID_INDEX) {
+            return StrategyStatus::UNKNOWN_UAV;
+        }
+        if (uav_strat.grenades.size() > static_cast<size_t>(Config::MAX_GRENADES_PER_UAV)) {
+            return StrategyStatus::TOO_MANY_GRENADES;
+        }
+        record.speed = uav_strat.speed;
+        record.angle = uav_strat.angle;
+        record.num_grenades = uav_strat.grenades.size();
+        std::copy(uav_strat.grenades.begin(), uav_strat.grenades.end(), record.grenades);
+        flat.push_back(record);
+    }
+    std::sort(flat.begin(), flat.end(),
+              [](const FlatUAVStrategy& a, const FlatUAVStrategy& b) { return a.uav < b.uav; });
+    return validate_strategy(flat, scenario);
+}
+
+StrategyMap to_strategy_map(const FlatStrategy& flat, const ScenarioLoader::Scenario& scenario) {
+    StrategyMap strategy;
+    for (const auto& record : flat) {
+        UAVStrategy uav_strat;
+        uav_strat.speed = record.speed;
+        uav_strat.angle = record.angle;
+        uav_strat.grenades.assign(record.grenades, record.grenades + record.num_grenades);
+        strategy[scenario.entities.uav(record.uav).id] = uav_strat;
+    }
+    return strategy;
+}
+
+int ObscurationOptimizer::decision_dimension() const {
+    int dimension = 0;
+    for (const auto& [uav_id, num_grenades] : uav_assignments_) {
+        dimension += 2 + 2 * num_grenades;
+    }
+    return dimension;
+}
+
+StrategyStatus ObscurationOptimizer::try_parse_decision_variables(
+    const VectorXd& decision_variables,
+    StrategyMap& strategy)
+{
+    if (decision_variables.size() != decision_dimension()) {
+        return StrategyStatus::WRONG_DIMENSION;
+    }
+    for (int i = 0; i < decision_variables.size(); ++i) {
+        if (!is_finite_bits(decision_variables[i])) {
+            return StrategyStatus::NON_FINITE;
+        }
+    }
+    for (const auto& [uav_id, num_grenades] : uav_assignments_) {
+        if (scenario_.entities.uav_index(uav_id) == Registry::INVALID_INDEX) {
+            return StrategyStatus::UNKNOWN_UAV;
+        }
+    }
+    
+    strategy = parse_decision_variables(decision_variables);
+    return validate_strategy(strategy, scenario_);
+}
+
+StrategyStatus ObscurationOptimizer::try_parse_flat(const VectorXd& decision_variables,
+                                                    FlatStrategy& strategy)
+{
+    StrategyMap parsed;
+    StrategyStatus status = try_parse_decision_variables(decision_variables, parsed);
+    if (status != StrategyStatus::OK) {
+        return status;
+    }
+    return to_flat_strategy(parsed, strategy, scenario_);
+}
+
+void ObscurationOptimizer::set_evaluation_precision(FastEvaluator::Precision precision) {
+    evaluator_->set_precision(precision);
+}
+
+void ObscurationOptimizer::set_time_chunks(int max_chunks) {
+    evaluator_->set_time_chunks(max_chunks);
+}
+
+void ObscurationOptimizer::set_evaluation_log(EvalLog::Logger* log) {
+    if (log != nullptr && (log->options().dimension != decision_dimension() ||
+                           log->options().num_outputs != evaluator_->num_missiles())) {
+        throw std::invalid_argument("评估日志的维度或输出数与优化问题不符");
+    }
+    eval_log_ = log;
+}
+
+double ObscurationOptimizer::objective_function(const VectorXd& decision_variables) {
+    try {
+        // 每线程复用的扁平策略与云团缓冲区，评估过程中无字符串查表
+        thread_local FlatStrategy strategy;
+        thread_local std::vector<FastEvaluator::CloudState> clouds;
+        
+        if (try_parse_flat(decision_variables, strategy) != StrategyStatus::OK) {
+            invalid_trials_.fetch_add(1, std::memory_order_relaxed);
+            return 0.0; // 无效策略，返回最差分数
+        }
+        
+        FastEvaluator::build_validated_clouds(strategy, clouds, scenario_);
+        if (clouds.empty()) {
+            return 0.0;
+        }
         
-        double total_time = obscured_time_points.size() * time_step_;
+        double total_time = 0.0;
+        evaluator_->evaluate(clouds, &total_time);
         return -total_time; // 返回负值用于最小化
         
     } catch (const std::exception&) {
-        return 0.0; // 无效策略，返回最差分数
+        // 子类解析函数仍可能抛出异常，保留兜底
+        invalid_trials_.fetch_add(1, std::memory_order_relaxed);
+        return 0.0;
+    }
+}
+
+bool ObscurationOptimizer::shaped_layout(std::vector<Registry::EntityIndex>& uavs, int& grenades_per_uav) const {
+    if (!shaped_objective_enabled_ || !has_standard_layout() ||
+        evaluator_->precision() != FastEvaluator::Precision::DOUBLE || evaluator_->time_chunks() != 1 ||
+        uav_assignments_.empty()) {
+        return false;
+    }
+    
+    // 按ID排序，与标准布局的解析顺序一致
+    std::map<std::string, int> sorted(uav_assignments_.begin(), uav_assignments_.end());
+    grenades_per_uav = sorted.begin()->second;
+    uavs.clear();
+    for (const auto& [uav_id, num_grenades] : sorted) {
+        if (num_grenades != grenades_per_uav) {
+            return false;
+        }
+        uavs.push_back(scenario_.entities.uav_index(uav_id));
     }
+    return true;
 }
 
 std::pair<VectorXd, double> ObscurationOptimizer::differential_evolution(
     const std::vector<Bounds>& bounds,
     const DESettings& settings)
 {
-    return DifferentialEvolution::optimize(
-        [this](const VectorXd& x) { return this->objective_function(x); },
-        bounds,
-        settings
-    );
+    std::vector<Registry::EntityIndex> uavs;
+    int grenades_per_uav = 0;
+    const bool shaped = shaped_layout(uavs, grenades_per_uav);
+    const std::vector<Registry::EntityIndex> missiles = {
+        scenario_.entities.missile_index(evaluator_->missile_ids()[0])};
+    
+    // 没有评估日志和降维时目标函数以具体类型传给 DE，在种群评估循环中内联
+    if (eval_log_ == nullptr && !reduction_) {
+        std::pair<VectorXd, double> result;
+        if (shaped && ShapedObjective::visit_objective(uavs, grenades_per_uav, missiles, scenario_, time_step_,
+                                                       &invalid_trials_, [&](const auto& objective) {
+                result = DifferentialEvolution::optimize(
+                    [&objective](const VectorXd& x) { return (*objective)(x); }, bounds, settings);
+            })) {
+            return result;
+        }
+        return DifferentialEvolution::optimize(
+            [this](const VectorXd& x) { return this->objective_function(x); }, bounds, settings);
+    }
+    
+    std::function<double(const VectorXd&)> objective;
+    if (shaped) {
+        objective = ShapedObjective::make_objective(uavs, grenades_per_uav, missiles, scenario_, time_step_,
+                                                    &invalid_trials_);
+    }
+    if (!objective) {
+        objective = [this](const VectorXd& x) { return this->objective_function(x); };
+    }
+    
+    // 只有一枚目标导弹，目标值取负即该导弹的遮蔽时间
+    if (eval_log_ != nullptr) {
+        objective = [objective = std::move(objective), log = eval_log_](const VectorXd& x) {
+            if (!log->should_record()) {
+                return objective(x);
+            }
+            const uint64_t start = log->now_ns();
+            const double fitness = objective(x);
+            const double obscured = -fitness;
+            log->record(x.data(), &obscured, start, log->now_ns() - start);
+            return fitness;
+        };
+    }
+    if (reduction_) {
+        return DifferentialEvolution::optimize_reduced(objective, bounds, settings, *reduction_, &sensitivity_);
+    }
+    return DifferentialEvolution::optimize(objective, bounds, settings);
 }
 
 // DifferentialEvolution Implementation
-std::pair<VectorXd, double> DifferentialEvolution::optimize(
+namespace {
+
+/**
+ * @brief 在常驻线程池上执行 body(0) ... body(count - 1)，并发数不超过 max_threads
+ */
+struct PoolFor {
+    WorkPool::Pool& pool;
+    int max_threads;
+
+    template <class Body>
+    bool operator()(int count, Body&& body) const {
+        pool.parallel_for(count, body, max_threads);
+        return true;
+    }
+};
+
+WorkPool::Pool& settings_pool(const DESettings& settings) {
+    return settings.pool != nullptr ? *settings.pool : WorkPool::Pool::global();
+}
+
+int resolve_threads(const WorkPool::Pool& pool, int num_threads) {
+    const int available = pool.num_threads();
+    return num_threads > 0 ? std::min(num_threads, available) : available;
+}
+
+// 分阶段运行时第 phase 段的种子 (非零)
+unsigned int phase_seed(uint64_t seed, int phase) {
+    const unsigned int value = static_cast<unsigned int>(seed + static_cast<uint64_t>(phase));
+    return value != 0 ? value : 1u;
+}
+
+// 冻结变量恢复搜索时的重新抽样流
+constexpr uint64_t REDUCTION_STREAM = ~0ull;
+
+} // namespace
+
+DifferentialEvolution::Runner::Runner(const DESettings& settings)
+    : settings_(settings), pool_(&settings_pool(settings)), num_threads_(resolve_threads(*pool_, settings.num_threads)) {}
+
+DECore::Settings DifferentialEvolution::Runner::core_settings() const {
+    DECore::Settings core;
+    core.population_size = settings_.population_size;
+    core.max_iterations = settings_.max_iterations;
+    core.tolerance = settings_.tolerance;
+    core.differential_weight = settings_.differential_weight;
+    core.crossover_rate = settings_.crossover_rate;
+    core.seed = settings_.seed;
+    return core;
+}
+
+bool DifferentialEvolution::Runner::parallel_for(int count, const std::function<void(int)>& body) const {
+    // 作业非空时种群评估提交到共享调度器，作业被取消时未评估的个体保持最差适应度
+    if (settings_.job != nullptr) {
+        return settings_.job->parallel_for(count, body) == JobScheduler::JobStatus::COMPLETED;
+    }
+    return PoolFor{*pool_, num_threads_}(count, body);
+}
+
+void DifferentialEvolution::Runner::report(int iteration, double best_fitness, bool improved) const {
+    if (!settings_.verbose) {
+        return;
+    }
+    if (iteration < 0) {
+        std::cout << "DE初始化完成，种群大小: " << settings_.population_size 
+                  << ", 线程数: " << num_threads_ 
+                  << ", 初始最佳适应度: " << -best_fitness << std::endl;
+    } else if (iteration % 50 == 0 || improved) {
+        std::cout << "迭代 " << iteration << ", 最佳适应度: " << -best_fitness << std::endl;
+    }
+}
+
+void DifferentialEvolution::Runner::finish(bool converged, bool cancelled, int iterations, double best_fitness) const {
+    if (!settings_.verbose) {
+        return;
+    }
+    if (converged) {
+        std::cout << "收敛于迭代 " << iterations - 1 << std::endl;
+    }
+    if (cancelled) {
+        std::cout << "作业已取消，返回当前最佳个体" << std::endl;
+    }
+    std::cout << "优化完成，最终适应度: " << -best_fitness << std::endl;
+}
+
+std::pair<VectorXd, double> DifferentialEvolution::optimize_reduced(
     ObjectiveFunction objective,
     const std::vector<Bounds>& bounds,
-    const DESettings& settings)
+    const DESettings& settings,
+    const Sensitivity::ReductionSettings& reduction,
+    Sensitivity::Analysis* analysis_out)
 {
-    const int dim = bounds.size();
-    std::mt19937 rng(std::random_device{}());
+    using Box = DECore::Box<Eigen::Dynamic>;
+    const Box box = DECore::make_box(bounds);
+    const int dim = box.dimension();
+    const int total = settings.max_iterations;
+    const uint64_t seed = DECore::resolve_seed(settings.seed);
+    const int pilot_iterations = std::clamp(static_cast<int>(std::lround(total * reduction.pilot_fraction)), 1, total);
+    const int reduced_iterations = std::clamp(static_cast<int>(std::lround(total * reduction.reduced_fraction)),
+                                              0, total - pilot_iterations);
     
-    // 初始化种群
-    auto population = initialize_population(bounds, settings.population_size, rng);
-    std::vector<double> fitness(settings.population_size);
+    auto phase_settings = [&](int phase, int iterations) {
+        DESettings result = settings;
+        result.seed = phase_seed(seed, phase);
+        result.max_iterations = iterations;
+        return result;
+    };
     
-    // 设置OpenMP线程数
-    int num_threads = settings.num_threads;
-    if (num_threads == -1) {
-        num_threads = omp_get_max_threads();
+    // 1. 全维试探
+    auto pilot = run(objective, box, Runner(phase_settings(0, pilot_iterations)));
+    if (pilot.converged || pilot.cancelled || pilot_iterations == total) {
+        return {pilot.best, pilot.best_fitness};
     }
-    omp_set_num_threads(num_threads);
     
-    // 评估初始种群
-    #pragma omp parallel for
-    for (int i = 0; i < settings.population_size; ++i) {
-        fitness[i] = objective(population[i]);
+    // 2. 在试探最优解附近分析敏感性
+    const VectorXd anchor = pilot.best;
+    Box clipped = box;
+    for (int k = 0; k < dim; ++k) {
+        const double radius = reduction.local_radius * (box.upper[k] - box.lower[k]);
+        clipped.lower[k] = std::max(box.lower[k], anchor[k] - radius);
+        clipped.upper[k] = std::min(box.upper[k], anchor[k] + radius);
     }
     
-    // 找到最佳个体
-    auto best_it = std::min_element(fitness.begin(), fitness.end());
-    int best_idx = std::distance(fitness.begin(), best_it);
-    VectorXd best_individual = population[best_idx];
-    double best_fitness = *best_it;
-    
+    Sensitivity::AnalysisSettings analysis_settings = reduction.analysis;
+    analysis_settings.num_threads = settings.num_threads;
+    const Sensitivity::Analysis analysis =
+        Sensitivity::analyze(objective, clipped.lower, clipped.upper, analysis_settings);
+    if (analysis_out != nullptr) {
+        *analysis_out = analysis;
+    }
+    const std::vector<int> inert = analysis.inert_variables(reduction.importance_threshold);
+    std::vector<char> is_inert(dim, 0);
+    for (int k : inert) {
+        is_inert[k] = 1;
+    }
     if (settings.verbose) {
-        std::cout << "DE初始化完成，种群大小: " << settings.population_size 
-                  << ", 线程数: " << num_threads 
-                  << ", 初始最佳适应度: " << -best_fitness << std::endl;
+        std::cout << "敏感性分析完成 (" << analysis.evaluations << " 次评估)，低重要性变量 "
+                  << inert.size() << "/" << dim << ":";
+        for (int k : inert) {
+            std::cout << " " << k;
+        }
+        std::cout << std::endl;
     }
     
-    // 主进化循环
-    for (int iteration = 0; iteration < settings.max_iterations; ++iteration) {
-        std::vector<VectorXd> trial_population(settings.population_size);
-        std::vector<double> trial_fitness(settings.population_size);
-        
-        // 生成试验向量
-        #pragma omp parallel for
-        for (int i = 0; i < settings.population_size; ++i) {
-            std::mt19937 local_rng(rng() + i); // 每个线程独立的随机数生成器
-            trial_population[i] = mutate_and_crossover(
-                population, i, bounds, 
-                settings.differential_weight, 
-                settings.crossover_rate, 
-                local_rng
-            );
-            trial_fitness[i] = objective(trial_population[i]);
-        }
-        
-        // 选择操作
-        bool improved = false;
-        for (int i = 0; i < settings.population_size; ++i) {
-            if (trial_fitness[i] < fitness[i]) {
-                population[i] = trial_population[i];
-                fitness[i] = trial_fitness[i];
-                
-                if (trial_fitness[i] < best_fitness) {
-                    best_individual = trial_population[i];
-                    best_fitness = trial_fitness[i];
-                    improved = true;
+    // 3. 冻结：只搜索其余变量；粗化：低重要性变量限制在局部区间并取整到等距网格
+    std::vector<VectorXd> population = std::move(pilot.population);
+    double best_fitness = pilot.best_fitness;
+    VectorXd best = pilot.best;
+    if (!inert.empty() && reduced_iterations > 0) {
+        const DESettings reduced_settings = phase_settings(1, reduced_iterations);
+        if (reduction.mode == Sensitivity::ReductionMode::FREEZE) {
+            std::vector<int> active;
+            for (int k = 0; k < dim; ++k) {
+                if (!is_inert[k]) {
+                    active.push_back(k);
                 }
             }
-        }
-        
-        // 输出进度
-        if (settings.verbose && (iteration % 50 == 0 || improved)) {
-            std::cout << "迭代 " << iteration << ", 最佳适应度: " << -best_fitness << std::endl;
-        }
-        
-        // 收敛检查
-        if (improved && std::abs(best_fitness) < settings.tolerance) {
-            if (settings.verbose) {
-                std::cout << "收敛于迭代 " << iteration << std::endl;
+            const int reduced_dim = static_cast<int>(active.size());
+            auto expand = [&](const VectorXd& z) {
+                VectorXd x = anchor;
+                for (int k = 0; k < reduced_dim; ++k) {
+                    x[active[k]] = z[k];
+                }
+                return x;
+            };
+            
+            Box reduced_box{VectorXd(reduced_dim), VectorXd(reduced_dim)};
+            std::vector<VectorXd> projected(population.size(), VectorXd(reduced_dim));
+            for (int k = 0; k < reduced_dim; ++k) {
+                reduced_box.lower[k] = box.lower[active[k]];
+                reduced_box.upper[k] = box.upper[active[k]];
+                for (size_t i = 0; i < population.size(); ++i) {
+                    projected[i][k] = population[i][active[k]];
+                }
+            }
+            
+            auto reduced = run([&](const VectorXd& z) { return objective(expand(z)); },
+                               reduced_box, Runner(reduced_settings), projected);
+            
+            // 恢复全维：最优个体保留冻结值，其余个体的冻结变量在局部区间内重新抽样以恢复多样性
+            const int best_index = static_cast<int>(
+                std::min_element(reduced.fitness.begin(), reduced.fitness.end()) - reduced.fitness.begin());
+            population.resize(reduced.population.size());
+            for (size_t i = 0; i < reduced.population.size(); ++i) {
+                population[i] = expand(reduced.population[i]);
+                if (static_cast<int>(i) == best_index) {
+                    continue;
+                }
+                DECore::Rng rng(seed, REDUCTION_STREAM, static_cast<uint32_t>(i));
+                for (int k : inert) {
+                    population[i][k] = rng.uniform(clipped.lower[k], clipped.upper[k]);
+                }
+            }
+            best = expand(reduced.best);
+            best_fitness = reduced.best_fitness;
+            if (reduced.converged || reduced.cancelled) {
+                return {best, best_fitness};
+            }
+        } else {
+            const int levels = std::max(2, reduction.coarse_levels);
+            auto coarsen = [&](VectorXd x) {
+                for (int k : inert) {
+                    const double step = (clipped.upper[k] - clipped.lower[k]) / (levels - 1);
+                    if (step > 0.0) {
+                        const double level = std::round((x[k] - clipped.lower[k]) / step);
+                        x[k] = clipped.lower[k] + std::clamp(level, 0.0, levels - 1.0) * step;
+                    }
+                }
+                return x;
+            };
+            
+            Box coarse_box = box;
+            for (int k : inert) {
+                coarse_box.lower[k] = clipped.lower[k];
+                coarse_box.upper[k] = clipped.upper[k];
+            }
+            for (auto& x : population) {
+                for (int k : inert) {
+                    x[k] = std::clamp(x[k], coarse_box.lower[k], coarse_box.upper[k]);
+                }
+                x = coarsen(x);
+            }
+            
+            auto coarse = run([&](const VectorXd& x) { return objective(coarsen(x)); },
+                              coarse_box, Runner(reduced_settings), population);
+            population.clear();
+            for (const auto& x : coarse.population) {
+                population.push_back(coarsen(x));
+            }
+            best = coarsen(coarse.best);
+            best_fitness = coarse.best_fitness;
+            if (coarse.converged || coarse.cancelled) {
+                return {best, best_fitness};
             }
-            break;
         }
     }
     
-    if (settings.verbose) {
-        std::cout << "优化完成，最终适应度: " << -best_fitness << std::endl;
+    // 4. 恢复全维搜索
+    const int remaining = total - pilot_iterations - (inert.empty() ? 0 : reduced_iterations);
+    if (remaining <= 0) {
+        return {best, best_fitness};
     }
+    auto result = run(objective, box, Runner(phase_settings(2, remaining)), population);
     
-    return {best_individual, best_fitness};
-}
-
-VectorXd DifferentialEvolution::generate_random_individual(
-    const std::vector<Bounds>& bounds,
-    std::mt19937& rng)
-{
-    VectorXd individual(bounds.size());
-    
-    for (size_t i = 0; i < bounds.size(); ++i) {
-        std::uniform_real_distribution<double> dist(bounds[i].lower, bounds[i].upper);
-        individual[i] = dist(rng);
+    if (settings.verbose) {
+        std::cout << "优化完成，最终适应度: " << -result.best_fitness << std::endl;
     }
-    
-    return individual;
-}
-
-std::vector<VectorXd> DifferentialEvolution::initialize_population(
-    const std::vector<Bounds>& bounds,
-    int population_size,
-    std::mt19937& rng)
-{
-    std::vector<VectorXd> population;
-    population.reserve(population_size);
-    
-    for (int i = 0; i < population_size; ++i) {
-        population.push_back(generate_random_individual(bounds, rng));
+    if (result.best_fitness < best_fitness) {
+        return {result.best, result.best_fitness};
     }
-    
-    return population;
+    return {best, best_fitness};
 }
 
-VectorXd DifferentialEvolution::mutate_and_crossover(
-    const std::vector<VectorXd>& population,
-    int target_idx,
+std::pair<VectorXd, double> DifferentialEvolution::optimize_noisy(
+    NoisyObjective::PairwiseNoisyObjective& objective,
     const std::vector<Bounds>& bounds,
-    double differential_weight,
-    double crossover_rate,
-    std::mt19937& rng)
+    const DESettings& settings)
 {
-    const int population_size = population.size();
-    const int dim = bounds.size();
+    const auto box = DECore::make_box(bounds);
+    const uint64_t seed = DECore::resolve_seed(settings.seed);
     
-    // 随机选择三个不同的个体 (排除目标个体)
-    std::vector<int> candidates;
-    for (int i = 0; i < population_size; ++i) {
-        if (i != target_idx) {
-            candidates.push_back(i);
-        }
+    // 初始化种群
+    std::vector<VectorXd> population;
+    population.reserve(settings.population_size);
+    for (int i = 0; i < settings.population_size; ++i) {
+        DECore::Rng rng = DECore::individual_rng(seed, 0, i);
+        population.push_back(DECore::random_individual(box, rng));
     }
+    std::vector<double> fitness(settings.population_size);
+    std::vector<double> unused;
     
-    std::shuffle(candidates.begin(), candidates.end(), rng);
-    
-    int a = candidates[0];
-    int b = candidates[1];
-    int c = candidates[2];
+    // 鲁棒目标按自己的线程设置并行评估，这里的线程数只用于生成试验个体
+    WorkPool::Pool& pool = settings_pool(settings);
+    const int num_threads = resolve_threads(pool, settings.num_threads);
     
-    // 变异: V = X_a + F * (X_b - X_c)
-    VectorXd mutant = population[a] + differential_weight * (population[b] - population[c]);
-    ensure_bounds(mutant, bounds);
+    // 评估初始种群 (第0代样本)
+    objective.begin_generation(0);
+    objective.evaluate_pairs(population, {}, fitness, unused);
     
-    // 交叉
-    VectorXd trial = population[target_idx];
-    std::uniform_real_distribution<double> uniform(0.0, 1.0);
-    std::uniform_int_distribution<int> rand_dim(0, dim - 1);
+    auto best_it = std::min_element(fitness.begin(), fitness.end());
+    VectorXd best_individual = population[std::distance(fitness.begin(), best_it)];
+    double best_fitness = *best_it;
     
-    int random_dim = rand_dim(rng); // 确保至少有一个维度被交叉
+    if (settings.verbose) {
+        std::cout << "鲁棒DE初始化完成，种群大小: " << settings.population_size 
+                  << ", 线程数: " << num_threads 
+                  << ", 初始最佳鲁棒适应度: " << -best_fitness << std::endl;
+    }
     
-    for (int i = 0; i < dim; ++i) {
-        if (uniform(rng) < crossover_rate || i == random_dim) {
-            trial[i] = mutant[i];
+    std::vector<VectorXd> trial_population;
+    std::vector<double> trial_fitness(settings.population_size);
+    for (int iteration = 0; iteration < settings.max_iterations; ++iteration) {
+        // 生成试验向量
+        DECore::generate_trials<DECore::RandOne, DECore::ClipBoundary>(
+            population, best_individual, settings.differential_weight, settings.crossover_rate,
+            box, seed, iteration + 1, PoolFor{pool, num_threads}, trial_population);
+        
+        // 试验个体与父代在本代公共随机数上成对评估，父代适应度同时被重新估计
+        objective.begin_generation(iteration + 1);
+        objective.evaluate_pairs(trial_population, population, trial_fitness, fitness);
+        
+        // 选择操作
+        for (int i = 0; i < settings.population_size; ++i) {
+            if (trial_fitness[i] < fitness[i]) {
+                std::swap(population[i], trial_population[i]);
+                fitness[i] = trial_fitness[i];
+            }
+        }
+        
+        // 最佳个体取本代估计下的最优，而不是历史上最幸运的一次估计
+        best_it = std::min_element(fitness.begin(), fitness.end());
+        best_individual = population[std::distance(fitness.begin(), best_it)];
+        best_fitness = *best_it;
+        
+        if (settings.verbose && iteration % 50 == 0) {
+            std::cout << "迭代 " << iteration << ", 最佳鲁棒适应度: " << -best_fitness << std::endl;
         }
     }
     
-    ensure_bounds(trial, bounds);
-    return trial;
-}
-
-void DifferentialEvolution::ensure_bounds(VectorXd& individual, const std::vector<Bounds>& bounds) {
-    for (size_t i = 0; i < bounds.size(); ++i) {
-        individual[i] = std::clamp(individual[i], bounds[i].lower, bounds[i].upper);
+    if (settings.verbose) {
+        std::cout << "优化完成，最终鲁棒适应度: " << -best_fitness << std::endl;
     }
+    
+    return {best_individual, best_fitness};
 }
 
 } // namespace Optimizer
@@ -7,14 +7,27 @@
 #include <functional>
 #include <random>
 #include <future>
+#include <atomic>
+#include <optional>
 #include <Eigen/Dense>
 #include "config.hpp"
 #include "core_objects.hpp"
+#include "de_core.hpp"
 #include "geometry.hpp"
+#include "noisy_objective.hpp"
+#include "scenario.hpp"
+#include "sensitivity.hpp"
 
 using Vector3d = Eigen::Vector3d;
 using VectorXd = Eigen::VectorXd;
 
+namespace RobustnessAnalyzer { struct NoiseModel; }
+namespace RobustOptimization { struct RobustSettings; }
+namespace FastEvaluator { class ObscurationEvaluator; enum class Precision; }
+namespace JobScheduler { class Job; }
+namespace WorkPool { class Pool; }
+namespace EvalLog { class Logger; }
+
 namespace Optimizer {
 
 /**
@@ -44,6 +57,64 @@ struct UAVStrategy {
 
 using StrategyMap = std::unordered_map<std::string, UAVStrategy>;
 
+/**
+ * @brief 定长布局的单机策略记录 (热路径使用，无字符串、无堆分配)
+ */
+struct FlatUAVStrategy {
+    Registry::EntityIndex uav = Registry::INVALID_INDEX;   // 注册表中的无人机索引
+    int num_grenades = 0;
+    double speed = 0.0;
+    double angle = 0.0;
+    UAVStrategy::GrenadeDeployment grenades[Config::MAX_GRENADES_PER_UAV] = {};
+};
+
+/**
+ * @brief 扁平策略：按无人机索引升序排列的单机记录
+ */
+using FlatStrategy = std::vector<FlatUAVStrategy>;
+
+/**
+ * @brief 策略校验结果
+ * 
+ * 目标函数热路径上用状态码代替异常：早期种群中无效试验解很多，
+ * 在 OpenMP 并行区内频繁抛出和展开异常代价很高。
+ */
+enum class StrategyStatus {
+    OK,
+    WRONG_DIMENSION,      // 决策变量维度不符
+    NON_FINITE,           // 含 NaN 或无穷大
+    UNKNOWN_UAV,          // 无人机ID不存在
+    SPEED_OUT_OF_RANGE,   // 飞行速度超出场景的速度范围
+    NEGATIVE_TIME,        // 投放或引信时间为负
+    TOO_MANY_GRENADES     // 单机弹药数超过该机的弹药预算
+};
+
+/**
+ * @brief 状态码的文字说明
+ */
+const char* status_message(StrategyStatus status);
+
+/**
+ * @brief 检查策略在给定场景中是否可执行，不抛异常
+ */
+StrategyStatus validate_strategy(const StrategyMap& strategy,
+                                 const ScenarioLoader::Scenario& scenario = ScenarioLoader::active());
+StrategyStatus validate_strategy(const FlatStrategy& strategy,
+                                 const ScenarioLoader::Scenario& scenario = ScenarioLoader::active());
+
+/**
+ * @brief 字符串键策略转为扁平策略 (输入边界使用)
+ */
+StrategyStatus to_flat_strategy(const StrategyMap& strategy,
+                                FlatStrategy& flat,
+                                const ScenarioLoader::Scenario& scenario = ScenarioLoader::active());
+
+/**
+ * @brief 扁平策略转回字符串键策略 (输出边界使用)
+ */
+StrategyMap to_strategy_map(const FlatStrategy& flat,
+                            const ScenarioLoader::Scenario& scenario = ScenarioLoader::active());
+
 /**
  * @brief 差分进化优化器设置
  */
@@ -55,25 +126,97 @@ struct DESettings {
     double differential_weight = 0.8;
     int num_threads = -1; // -1表示使用所有可用线程
     bool verbose = true;
+    unsigned int seed = 0; // 0表示使用随机种子，非零时结果可复现 (与线程数无关)
+    JobScheduler::Job* job = nullptr; // 非空时种群评估提交到共享调度器 (忽略 num_threads)，作业取消时提前结束
+    WorkPool::Pool* pool = nullptr;   // 种群阶段所用的线程池，空表示 WorkPool::Pool::global() (设置了 job 时不使用)
     
     DESettings() = default;
 };
 
 /**
  * @brief 抽象遮蔽优化器基类
+ * 
+ * 实体、常量和目标几何取自构造时的当前场景 (ScenarioLoader::active)。
  */
 class ObscurationOptimizer {
 public:
     ObscurationOptimizer(const std::string& missile_id, 
                         const std::unordered_map<std::string, int>& uav_assignments);
     
-    virtual ~ObscurationOptimizer() = default;
+    virtual ~ObscurationOptimizer();
     
     /**
      * @brief 求解优化问题
      */
     std::pair<StrategyMap, double> solve(const std::vector<Bounds>& bounds, 
                                         const DESettings& settings = DESettings());
+    
+    /**
+     * @brief 目标函数中被判为无效的试验解数量 (累计)
+     */
+    long long invalid_trial_count() const { return invalid_trials_.load(std::memory_order_relaxed); }
+    
+    /**
+     * @brief 设置目标函数中锥体判断的精度 (FLOAT32 带双精度复核，结果不变)，须在 solve 之前调用
+     */
+    void set_evaluation_precision(FastEvaluator::Precision precision);
+    
+    /**
+     * @brief 单次评估的时间扫描最多拆成几段并行 (1 不拆分，-1 由代价模型决定)，须在 solve 之前调用
+     * 
+     * 适用于云团多、时间步细、单次评估耗时达毫秒级而种群又小的场景；结果不变。
+     */
+    void set_time_chunks(int max_chunks);
+    
+    /**
+     * @brief 把 solve 中的每次评估 (决策变量、遮蔽时间、耗时) 写入评估日志，nullptr 关闭，须在 solve 之前调用
+     * 
+     * 日志的维度须等于决策变量维度、输出数为 1；日志由调用者持有，solve 结束后由调用者 close。
+     */
+    void set_evaluation_log(EvalLog::Logger* log);
+    
+    /**
+     * @brief solve 时先做敏感性分析，低重要性变量在一段代数内冻结或粗化 (std::nullopt 关闭)，须在 solve 之前调用
+     */
+    void set_variable_reduction(std::optional<Sensitivity::ReductionSettings> reduction) {
+        reduction_ = std::move(reduction);
+    }
+    
+    /**
+     * @brief 最近一次 solve 的敏感性分析结果 (未启用降维时为空)
+     */
+    const Sensitivity::Analysis& last_sensitivity() const { return sensitivity_; }
+    
+    /**
+     * @brief 是否允许使用编译期特化的目标函数 (默认允许，结果与通用路径一致)，须在 solve 之前调用
+     * 
+     * 仅当子类声明标准决策变量布局、各机弹药数相同、形状已实例化、精度为 DOUBLE 且不拆分时间扫描时生效。
+     */
+    void set_shaped_objective(bool enabled) { shaped_objective_enabled_ = enabled; }
+    
+    /**
+     * @brief 鲁棒优化：最大化执行噪声下遮蔽时间的期望或分位数
+     * 
+     * 每代使用公共随机数成对比较试验个体与父代，返回值为独立样本上的鲁棒遮蔽时间估计。
+     */
+    std::pair<StrategyMap, double> solve_robust(const std::vector<Bounds>& bounds,
+                                               const RobustnessAnalyzer::NoiseModel& noise,
+                                               const RobustOptimization::RobustSettings& robust_settings,
+                                               const DESettings& settings = DESettings());
+    
+    /**
+     * @brief 将决策变量解析为策略
+     */
+    StrategyMap decode(const VectorXd& decision_variables) {
+        return parse_decision_variables(decision_variables);
+    }
+    
+    /**
+     * @brief 将决策变量解析为扁平策略 (不抛异常，见 try_parse_flat)
+     */
+    StrategyStatus decode_flat(const VectorXd& decision_variables, FlatStrategy& strategy) {
+        return try_parse_flat(decision_variables, strategy);
+    }
 
 protected:
     /**
@@ -81,19 +224,57 @@ protected:
      */
     virtual StrategyMap parse_decision_variables(const VectorXd& decision_variables) = 0;
     
+    /**
+     * @brief 不抛异常的解析：先检查维度和数值，再解析并校验策略
+     * 
+     * 默认实现假设每架无人机占 2 + 2*弹药数 个决策变量；布局不同的子类应重写 decision_dimension。
+     */
+    virtual StrategyStatus try_parse_decision_variables(const VectorXd& decision_variables,
+                                                        StrategyMap& strategy);
+    
+    /**
+     * @brief 决策变量维度
+     */
+    virtual int decision_dimension() const;
+    
+    /**
+     * @brief 直接解析为扁平策略 (目标函数热路径)
+     * 
+     * 默认实现经由 try_parse_decision_variables 再转换；子类可重写为按整数索引直接填充。
+     * 返回 OK 时策略须已通过 validate_strategy，目标函数不再重复校验。
+     */
+    virtual StrategyStatus try_parse_flat(const VectorXd& decision_variables, FlatStrategy& strategy);
+    
+    /**
+     * @brief 决策变量是否为标准布局 (无人机按ID排序，每机 [速度, 角度, 投放1, 引信1, 间隔k, 引信k...])
+     * 
+     * 返回 true 的子类可以使用 ShapedObjective 中的特化目标函数。
+     */
+    virtual bool has_standard_layout() const { return false; }
+    
     /**
      * @brief 目标函数：计算遮蔽时间 (返回负值用于最小化)
      */
     double objective_function(const VectorXd& decision_variables);
 
 protected:
+    const ScenarioLoader::Scenario& scenario_;
     std::unique_ptr<CoreObjects::Missile> missile_;
     std::unique_ptr<CoreObjects::TargetCylinder> target_;
     std::unordered_map<std::string, int> uav_assignments_;
     double time_step_;
     Eigen::Matrix3Xd target_key_points_;
+    std::atomic<long long> invalid_trials_{0};
+    std::unique_ptr<FastEvaluator::ObscurationEvaluator> evaluator_;
 
 private:
+    bool shaped_objective_enabled_ = true;
+    EvalLog::Logger* eval_log_ = nullptr;
+    std::optional<Sensitivity::ReductionSettings> reduction_;
+    Sensitivity::Analysis sensitivity_;
+    
+    // 当前问题可用特化目标函数时给出无人机索引 (标准布局顺序) 与每机弹药数，不适用时返回 false
+    bool shaped_layout(std::vector<Registry::EntityIndex>& uavs, int& grenades_per_uav) const;
     
     // 差分进化算法实现
     std::pair<VectorXd, double> differential_evolution(
@@ -106,46 +287,100 @@ private:
         const std::vector<VectorXd>& population,
         int num_threads
     );
-    
-    // 随机数生成器
-    mutable std::mt19937 rng_;
 };
 
 /**
  * @brief 高性能差分进化算法实现
+ * 
+ * DE/rand/1/bin + 截断边界，是 DECore (de_core.hpp) 的实例化；需要定长维度时直接调用 DECore::optimize。
  */
 class DifferentialEvolution {
 public:
     using ObjectiveFunction = std::function<double(const VectorXd&)>;
     
+    /**
+     * @brief 经典差分进化
+     * 
+     * 目标函数以具体类型 (lambda、ShapedObjective 的特化目标函数等) 传入时在种群评估循环中内联；
+     * 以 std::function 传入时每次评估多一次间接调用。
+     */
+    template <class Objective>
     static std::pair<VectorXd, double> optimize(
-        ObjectiveFunction objective,
+        Objective&& objective,
         const std::vector<Bounds>& bounds,
-        const DESettings& settings = DESettings()
-    );
-
-private:
-    static VectorXd generate_random_individual(
-        const std::vector<Bounds>& bounds,
-        std::mt19937& rng
-    );
+        const DESettings& settings = DESettings())
+    {
+        const Runner runner(settings);
+        auto result = run(objective, DECore::make_box(bounds), runner);
+        runner.finish(result.converged, result.cancelled, result.iterations, result.best_fitness);
+        return {result.best, result.best_fitness};
+    }
     
-    static std::vector<VectorXd> initialize_population(
+    /**
+     * @brief 分阶段降维的差分进化：全维试探 → 局部敏感性分析 → 冻结或粗化低重要性变量 → 恢复全维
+     * 
+     * 各阶段接续同一个种群，总代数为 settings.max_iterations (见 Sensitivity::ReductionSettings)。
+     * 
+     * @param analysis 非空时输出敏感性分析结果
+     */
+    static std::pair<VectorXd, double> optimize_reduced(
+        ObjectiveFunction objective,
         const std::vector<Bounds>& bounds,
-        int population_size,
-        std::mt19937& rng
+        const DESettings& settings,
+        const Sensitivity::ReductionSettings& reduction,
+        Sensitivity::Analysis* analysis = nullptr
     );
     
-    static VectorXd mutate_and_crossover(
-        const std::vector<VectorXd>& population,
-        int target_idx,
+    /**
+     * @brief 带噪声目标的差分进化，每代切换公共随机数并重新估计父代
+     */
+    static std::pair<VectorXd, double> optimize_noisy(
+        NoisyObjective::PairwiseNoisyObjective& objective,
         const std::vector<Bounds>& bounds,
-        double differential_weight,
-        double crossover_rate,
-        std::mt19937& rng
+        const DESettings& settings = DESettings()
     );
+
+private:
+    /**
+     * @brief 与目标函数类型无关的部分 (在 optimizer.cpp 中实现)：线程数、种群评估的分派与 verbose 输出
+     */
+    class Runner {
+    public:
+        explicit Runner(const DESettings& settings);
+        
+        const DESettings& settings() const { return settings_; }
+        DECore::Settings core_settings() const;
+        
+        /**
+         * @brief 执行 body(0) ... body(count - 1)：作业非空时提交到共享调度器，否则在常驻线程池上；作业被取消时返回 false
+         */
+        bool parallel_for(int count, const std::function<void(int)>& body) const;
+        
+        // 初始种群评估后以 iteration = -1 调用一次，之后每代结束时调用
+        void report(int iteration, double best_fitness, bool improved) const;
+        void finish(bool converged, bool cancelled, int iterations, double best_fitness) const;
+        
+    private:
+        DESettings settings_;
+        WorkPool::Pool* pool_;
+        int num_threads_;
+    };
     
-    static void ensure_bounds(VectorXd& individual, const std::vector<Bounds>& bounds);
+    /**
+     * @brief 经典 DE 的一次运行 (可指定初始种群)
+     */
+    template <class Objective>
+    static DECore::Result<Eigen::Dynamic> run(Objective&& objective, const DECore::Box<Eigen::Dynamic>& box,
+                                              const Runner& runner, const std::vector<VectorXd>& initial = {})
+    {
+        return DECore::optimize(
+            objective, box, runner.core_settings(),
+            [&runner](int count, auto&& body) { return runner.parallel_for(count, body); },
+            [&runner](int iteration, double best_fitness, bool improved) {
+                runner.report(iteration, best_fitness, improved);
+            },
+            initial);
+    }
 };
 
 } // namespace Optimizer
@@ -0,0 +1,705 @@
+#include "portfolio.hpp"
+#include "de_core.hpp"
+#include "high_performance_adaptive_de.hpp"
+#include "work_pool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+
+namespace Portfolio {
+
+std::string method_name(Method method) {
+    switch (method) {
+        case Method::ADAPTIVE_DE: return "自适应DE";
+        case Method::CLASSIC_DE: return "DE/rand/1";
+        case Method::CMA_ES: return "CMA-ES";
+        case Method::LOCAL_SEARCH: return "模式搜索";
+    }
+    return "未知";
+}
+
+namespace {
+
+// 目标值相同时按字典序比较解向量，使并发发布的结果与顺序无关
+bool better(double fitness, const Vector& solution, const IncumbentSlot::Entry& current) {
+    if (fitness != current.fitness) {
+        return fitness < current.fitness;
+    }
+    return std::lexicographical_compare(solution.data(), solution.data() + solution.size(),
+                                        current.solution.data(), current.solution.data() + current.solution.size());
+}
+
+} // namespace
+
+IncumbentSlot::~IncumbentSlot() {
+    const Entry* entry = head_.load(std::memory_order_acquire);
+    while (entry != nullptr) {
+        const Entry* previous = entry->previous;
+        delete entry;
+        entry = previous;
+    }
+}
+
+bool IncumbentSlot::offer(const Vector& solution, double fitness, int member) {
+    if (std::isnan(fitness)) {
+        return false;
+    }
+    Entry* current = head_.load(std::memory_order_acquire);
+    if (current != nullptr && !better(fitness, solution, *current)) {
+        return false;
+    }
+    auto* entry = new Entry{solution, fitness, member, Clock::now(), current};
+    while (!head_.compare_exchange_weak(current, entry, std::memory_order_acq_rel, std::memory_order_acquire)) {
+        if (current != nullptr && !better(fitness, solution, *current)) {
+            delete entry;
+            return false;
+        }
+        entry->previous = current;
+    }
+    return true;
+}
+
+namespace {
+
+using Entry = IncumbentSlot::Entry;
+
+// 成员各次重启的种子流
+constexpr uint64_t MEMBER_SEED_STREAM = ~0ull;
+// 模式搜索与 CMA-ES 随机起点使用的子流 (个体子流编号小于种群大小)
+constexpr uint32_t START_SUBSTREAM = ~0u;
+
+/**
+ * @brief 各成员共用的目标函数、区间、解缓存与最优解槽
+ */
+struct Context {
+    const Objective& objective;
+    Vector lower;
+    Vector upper;
+    HighPerformanceDE::SolutionCache* cache;
+    IncumbentSlot& slot;
+    int population_size;
+    uint64_t seed;
+    int max_generations;
+
+    int dimension() const { return static_cast<int>(lower.size()); }
+
+    double evaluate(const Vector& x, int member) const {
+        double fitness;
+        if (cache != nullptr && cache->lookup(x, fitness)) {
+            return fitness;
+        }
+        fitness = objective(x);
+        if (cache != nullptr) {
+            cache->store(x, fitness);
+        }
+        slot.offer(x, fitness, member);
+        return fitness;
+    }
+
+    // 归一化坐标 [0, 1]^D 与原始坐标互换
+    Vector to_box(const Vector& u) const { return lower + u.cwiseProduct(upper - lower); }
+    Vector to_unit(const Vector& x) const { return (x - lower).cwiseQuotient(upper - lower); }
+};
+
+/**
+ * @brief 成员的公共接口：step() 推进一步并返回本步的评估次数，收敛或停滞时置 stalled
+ */
+class Member {
+public:
+    Member(const Context& context, int index) : context_(context), index_(index) {}
+    virtual ~Member() = default;
+
+    virtual long long step(int num_threads) = 0;
+
+    /**
+     * @brief 收敛或停滞后重新开始，incumbent 为本轮开始时的全局最优 (可能为空)
+     */
+    virtual void restart(const Entry* incumbent) = 0;
+
+    /**
+     * @brief 吸收更优的全局最优解 (仅在其优于本成员最优时调用)
+     */
+    virtual void adopt(const Vector& solution, double fitness) = 0;
+
+    bool stalled() const { return stalled_; }
+    double best_fitness() const { return best_fitness_; }
+
+protected:
+    const Context& context_;
+    int index_;
+    int restarts_ = 0;
+    bool stalled_ = false;
+    double best_fitness_ = std::numeric_limits<double>::infinity();
+
+    double evaluate(const Vector& x) const { return context_.evaluate(x, index_); }
+
+    uint64_t member_seed() const {
+        CounterRNG::CounterRng rng(context_.seed, MEMBER_SEED_STREAM, static_cast<uint32_t>(index_));
+        for (int k = 0; k < 2 * restarts_; ++k) {
+            rng.next_u32();
+        }
+        const uint64_t seed = (static_cast<uint64_t>(rng.next_u32()) << 32) | rng.next_u32();
+        return seed != 0 ? seed : 1;
+    }
+};
+
+// =============================================================================
+// 自适应DE：驱动 HighPerformanceAdaptiveDE 的逐代接口
+// =============================================================================
+
+class AdaptiveDEMember : public Member {
+public:
+    AdaptiveDEMember(const Context& context, int index) : Member(context, index) { create(); }
+
+    long long step(int num_threads) override {
+        engine_->set_num_threads(num_threads);
+        const size_t before = engine_->evaluation_count();
+        if (!started_) {
+            engine_->start();
+            if (seeded_) {
+                engine_->inject(seeded_->first, seeded_->second);
+                seeded_.reset();
+            }
+            started_ = true;
+        } else {
+            stalled_ = engine_->step();
+        }
+        best_fitness_ = std::min(best_fitness_, engine_->get_best_individual().fitness);
+        return static_cast<long long>(engine_->evaluation_count() - before);
+    }
+
+    void restart(const Entry* incumbent) override {
+        ++restarts_;
+        create();
+        if (incumbent != nullptr) {
+            seeded_.emplace(incumbent->solution, incumbent->fitness);
+        }
+    }
+
+    void adopt(const Vector& solution, double fitness) override {
+        if (started_) {
+            engine_->inject(solution, fitness);
+        } else {
+            seeded_.emplace(solution, fitness);
+        }
+        best_fitness_ = fitness;
+    }
+
+private:
+    std::unique_ptr<HighPerformanceDE::HighPerformanceAdaptiveDE> engine_;
+    bool started_ = false;
+    std::optional<std::pair<Vector, double>> seeded_;
+
+    void create() {
+        HighPerformanceDE::AdaptiveDESettings settings;
+        settings.population_size = context_.population_size;
+        settings.max_iterations = context_.max_generations;
+        settings.adaptive_population = false;   // 线性缩减依赖代数上限，由组合控制预算时不适用
+        settings.enable_caching = false;        // 使用组合共享的缓存
+        settings.verbose = false;
+        settings.random_seed = static_cast<int>(member_seed() & 0x7fffffff);
+        engine_ = std::make_unique<HighPerformanceDE::HighPerformanceAdaptiveDE>(
+            [this](const Vector& x) { return evaluate(x); }, context_.lower, context_.upper, settings);
+        started_ = false;
+        stalled_ = false;
+    }
+};
+
+// =============================================================================
+// 经典 DE/rand/1/bin：DECore 的试验个体生成，逐代推进
+// =============================================================================
+
+class ClassicDEMember : public Member {
+public:
+    ClassicDEMember(const Context& context, int index)
+        : Member(context, index), box_{context.lower, context.upper}, seed_(member_seed()) {}
+
+    long long step(int num_threads) override {
+        const int n = context_.population_size;
+        auto& pool = WorkPool::Pool::global();
+        if (population_.empty()) {
+            population_.assign(n, Vector(context_.dimension()));
+            fitness_.assign(n, std::numeric_limits<double>::infinity());
+            pool.parallel_for(n, [&](int i) {
+                if (i == 0 && seeded_) {
+                    population_[i] = seeded_->first;
+                    fitness_[i] = seeded_->second;
+                    return;
+                }
+                DECore::Rng rng = DECore::individual_rng(seed_, 0, i);
+                population_[i] = DECore::random_individual(box_, rng);
+                fitness_[i] = evaluate(population_[i]);
+            }, num_threads, 1);
+            trials_.assign(n, Vector(context_.dimension()));
+            trial_fitness_.assign(n, 0.0);
+            generation_ = 0;
+            stagnant_ = 0;
+            update_best();
+            const long long evaluations = seeded_ ? n - 1 : n;
+            seeded_.reset();
+            return evaluations;
+        }
+
+        ++generation_;
+        pool.parallel_for(n, [&](int i) {
+            DECore::Rng rng = DECore::individual_rng(seed_, generation_, i);
+            DECore::make_trial<DECore::RandOne, DECore::ClipBoundary, DECore::BinomialCrossover>(
+                population_, i, best_, settings_.differential_weight, settings_.crossover_rate, box_, rng, trials_[i]);
+            trial_fitness_[i] = evaluate(trials_[i]);
+        }, num_threads, 1);
+
+        const double previous = best_fitness_;
+        for (int i = 0; i < n; ++i) {
+            if (trial_fitness_[i] < fitness_[i]) {
+                std::swap(population_[i], trials_[i]);
+                fitness_[i] = trial_fitness_[i];
+            }
+        }
+        update_best();
+        stagnant_ = best_fitness_ < previous ? 0 : stagnant_ + 1;
+        stalled_ = stagnant_ >= STAGNATION_GENERATIONS;
+        return n;
+    }
+
+    void restart(const Entry* incumbent) override {
+        ++restarts_;
+        seed_ = member_seed();
+        population_.clear();
+        seeded_.reset();
+        if (incumbent != nullptr) {
+            seeded_.emplace(incumbent->solution, incumbent->fitness);
+        }
+        stalled_ = false;
+    }
+
+    void adopt(const Vector& solution, double fitness) override {
+        if (population_.empty()) {
+            seeded_.emplace(solution, fitness);
+        } else {
+            const size_t worst = std::max_element(fitness_.begin(), fitness_.end()) - fitness_.begin();
+            population_[worst] = solution;
+            fitness_[worst] = fitness;
+            best_ = solution;
+        }
+        best_fitness_ = fitness;
+    }
+
+private:
+    static constexpr int STAGNATION_GENERATIONS = 50;
+
+    DECore::Box<Eigen::Dynamic> box_;
+    DECore::Settings settings_;
+    uint64_t seed_;
+    std::vector<Vector> population_;
+    std::vector<double> fitness_;
+    std::vector<Vector> trials_;
+    std::vector<double> trial_fitness_;
+    Vector best_;
+    int generation_ = 0;
+    int stagnant_ = 0;
+    std::optional<std::pair<Vector, double>> seeded_;
+
+    void update_best() {
+        const size_t best = std::min_element(fitness_.begin(), fitness_.end()) - fitness_.begin();
+        best_ = population_[best];
+        best_fitness_ = std::min(best_fitness_, fitness_[best]);
+    }
+};
+
+// =============================================================================
+// CMA-ES：归一化坐标中的 (mu/mu_w, lambda)-CMA-ES，采样点截断到区间内，按截断后的步长更新
+// =============================================================================
+
+class CMAESMember : public Member {
+public:
+    CMAESMember(const Context& context, int index) : Member(context, index), seed_(member_seed()) {
+        const int n = context.dimension();
+        lambda_ = 4 + static_cast<int>(std::floor(3.0 * std::log(n)));
+        mu_ = lambda_ / 2;
+        weights_.resize(mu_);
+        for (int k = 0; k < mu_; ++k) {
+            weights_[k] = std::log(mu_ + 0.5) - std::log(k + 1.0);
+        }
+        weights_ /= weights_.sum();
+        mueff_ = 1.0 / weights_.squaredNorm();
+        cc_ = (4.0 + mueff_ / n) / (n + 4.0 + 2.0 * mueff_ / n);
+        cs_ = (mueff_ + 2.0) / (n + mueff_ + 5.0);
+        c1_ = 2.0 / ((n + 1.3) * (n + 1.3) + mueff_);
+        cmu_ = std::min(1.0 - c1_, 2.0 * (mueff_ - 2.0 + 1.0 / mueff_) / ((n + 2.0) * (n + 2.0) + mueff_));
+        damps_ = 1.0 + 2.0 * std::max(0.0, std::sqrt((mueff_ - 1.0) / (n + 1.0)) - 1.0) + cs_;
+        chi_n_ = std::sqrt(static_cast<double>(n)) * (1.0 - 1.0 / (4.0 * n) + 1.0 / (21.0 * n * n));
+    }
+
+    long long step(int num_threads) override {
+        const int n = context_.dimension();
+        if (!initialized_) {
+            if (seeded_) {
+                reset(context_.to_unit(seeded_->first), SIGMA_LOCAL);
+                seeded_.reset();
+            } else {
+                CounterRNG::CounterRng rng(seed_, 0, START_SUBSTREAM);
+                Vector mean(n);
+                for (int k = 0; k < n; ++k) {
+                    mean[k] = rng.uniform();
+                }
+                reset(mean, SIGMA_GLOBAL);
+            }
+            initialized_ = true;
+        }
+
+        ++generation_;
+        std::vector<Vector> steps(lambda_, Vector(n));
+        std::vector<double> fitness(lambda_);
+        WorkPool::Pool::global().parallel_for(lambda_, [&](int i) {
+            DECore::Rng rng = DECore::individual_rng(seed_, generation_, i);
+            Vector z(n);
+            for (int k = 0; k < n; ++k) {
+                z[k] = rng.normal();
+            }
+            const Vector u = (mean_ + sigma_ * (B_ * D_.cwiseProduct(z))).cwiseMax(0.0).cwiseMin(1.0);
+            steps[i] = (u - mean_) / sigma_;
+            fitness[i] = evaluate(context_.to_box(u));
+        }, num_threads, 1);
+
+        std::vector<int> order(lambda_);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return fitness[a] < fitness[b]; });
+        const double previous = best_fitness_;
+        best_fitness_ = std::min(best_fitness_, fitness[order[0]]);
+        stagnant_ = best_fitness_ < previous ? 0 : stagnant_ + 1;
+
+        Vector y_w = Vector::Zero(n);
+        for (int k = 0; k < mu_; ++k) {
+            y_w += weights_[k] * steps[order[k]];
+        }
+        mean_ += sigma_ * y_w;
+
+        const Vector inv_sqrt_c_y = B_ * (B_.transpose() * y_w).cwiseQuotient(D_);
+        ps_ = (1.0 - cs_) * ps_ + std::sqrt(cs_ * (2.0 - cs_) * mueff_) * inv_sqrt_c_y;
+        const double ps_norm = ps_.norm();
+        const bool hsig = ps_norm / std::sqrt(1.0 - std::pow(1.0 - cs_, 2.0 * generation_)) / chi_n_ <
+                          1.4 + 2.0 / (n + 1.0);
+        pc_ = (1.0 - cc_) * pc_ + (hsig ? std::sqrt(cc_ * (2.0 - cc_) * mueff_) : 0.0) * y_w;
+
+        Eigen::MatrixXd rank_mu = Eigen::MatrixXd::Zero(n, n);
+        for (int k = 0; k < mu_; ++k) {
+            rank_mu.noalias() += weights_[k] * steps[order[k]] * steps[order[k]].transpose();
+        }
+        C_ = (1.0 - c1_ - cmu_) * C_ +
+             c1_ * (pc_ * pc_.transpose() + (hsig ? 0.0 : cc_ * (2.0 - cc_)) * C_) + cmu_ * rank_mu;
+        sigma_ *= std::exp((cs_ / damps_) * (ps_norm / chi_n_ - 1.0));
+
+        Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eigen(C_);
+        B_ = eigen.eigenvectors();
+        D_ = eigen.eigenvalues().cwiseMax(1e-20).cwiseSqrt();
+
+        stalled_ = sigma_ * D_.maxCoeff() < 1e-10 || D_.maxCoeff() > 1e7 * D_.minCoeff() ||
+                   stagnant_ >= 10 + 30 * n / lambda_;
+        return lambda_;
+    }
+
+    void restart(const Entry* incumbent) override {
+        ++restarts_;
+        seed_ = member_seed();
+        initialized_ = false;
+        stalled_ = false;
+        seeded_.reset();
+        // 奇数次重启从随机点出发，偶数次在全局最优附近重新展开
+        if (incumbent != nullptr && restarts_ % 2 == 0) {
+            seeded_.emplace(incumbent->solution, incumbent->fitness);
+        }
+    }
+
+    void adopt(const Vector& solution, double fitness) override {
+        if (initialized_) {
+            mean_ = context_.to_unit(solution);
+        } else {
+            seeded_.emplace(solution, fitness);
+        }
+        best_fitness_ = fitness;
+        stagnant_ = 0;
+    }
+
+private:
+    static constexpr double SIGMA_GLOBAL = 0.3;
+    static constexpr double SIGMA_LOCAL = 0.1;
+
+    uint64_t seed_;
+    int lambda_;
+    int mu_;
+    Vector weights_;
+    double mueff_, cc_, cs_, c1_, cmu_, damps_, chi_n_;
+
+    bool initialized_ = false;
+    int generation_ = 0;
+    int stagnant_ = 0;
+    Vector mean_, ps_, pc_, D_;
+    Eigen::MatrixXd C_, B_;
+    double sigma_ = SIGMA_GLOBAL;
+    std::optional<std::pair<Vector, double>> seeded_;
+
+    void reset(const Vector& mean, double sigma) {
+        const int n = context_.dimension();
+        mean_ = mean;
+        sigma_ = sigma;
+        ps_ = Vector::Zero(n);
+        pc_ = Vector::Zero(n);
+        C_ = Eigen::MatrixXd::Identity(n, n);
+        B_ = Eigen::MatrixXd::Identity(n, n);
+        D_ = Vector::Ones(n);
+        generation_ = 0;
+        stagnant_ = 0;
+    }
+};
+
+// =============================================================================
+// 坐标模式搜索：每步并行探测中心点沿各坐标 ±步长的 2D 个点 (归一化坐标)
+// =============================================================================
+
+class LocalSearchMember : public Member {
+public:
+    LocalSearchMember(const Context& context, int index) : Member(context, index) {}
+
+    long long step(int num_threads) override {
+        const int n = context_.dimension();
+        if (!initialized_) {
+            step_size_ = INITIAL_STEP;
+            initialized_ = true;
+            if (seeded_) {
+                center_ = context_.to_unit(seeded_->first);
+                center_fitness_ = seeded_->second;
+                seeded_.reset();
+                return 0;
+            }
+            CounterRNG::CounterRng rng(member_seed(), 0, START_SUBSTREAM);
+            center_.resize(n);
+            for (int k = 0; k < n; ++k) {
+                center_[k] = rng.uniform();
+            }
+            center_fitness_ = evaluate(context_.to_box(center_));
+            best_fitness_ = std::min(best_fitness_, center_fitness_);
+            return 1;
+        }
+
+        std::vector<Vector> polls;
+        for (int k = 0; k < n; ++k) {
+            for (double direction : {1.0, -1.0}) {
+                Vector u = center_;
+                u[k] = std::clamp(u[k] + direction * step_size_, 0.0, 1.0);
+                if (u[k] != center_[k]) {
+                    polls.push_back(std::move(u));
+                }
+            }
+        }
+        std::vector<double> fitness(polls.size());
+        WorkPool::Pool::global().parallel_for(static_cast<int>(polls.size()), [&](int i) {
+            fitness[i] = evaluate(context_.to_box(polls[i]));
+        }, num_threads, 1);
+
+        const size_t best = std::min_element(fitness.begin(), fitness.end()) - fitness.begin();
+        if (!polls.empty() && fitness[best] < center_fitness_) {
+            center_ = polls[best];
+            center_fitness_ = fitness[best];
+            best_fitness_ = std::min(best_fitness_, center_fitness_);
+        } else {
+            step_size_ *= 0.5;
+            stalled_ = step_size_ < MIN_STEP;
+        }
+        return static_cast<long long>(polls.size());
+    }
+
+    void restart(const Entry* incumbent) override {
+        ++restarts_;
+        initialized_ = false;
+        stalled_ = false;
+        seeded_.reset();
+        // 已在当前全局最优收敛过时改从随机点出发
+        if (incumbent != nullptr && incumbent != last_start_) {
+            seeded_.emplace(incumbent->solution, incumbent->fitness);
+            last_start_ = incumbent;
+        }
+    }
+
+    void adopt(const Vector& solution, double fitness) override {
+        if (initialized_) {
+            center_ = context_.to_unit(solution);
+            center_fitness_ = fitness;
+        } else {
+            seeded_.emplace(solution, fitness);
+        }
+        best_fitness_ = fitness;
+    }
+
+private:
+    static constexpr double INITIAL_STEP = 0.1;
+    static constexpr double MIN_STEP = 1e-6;
+
+    bool initialized_ = false;
+    Vector center_;
+    double center_fitness_ = std::numeric_limits<double>::infinity();
+    double step_size_ = INITIAL_STEP;
+    const Entry* last_start_ = nullptr;
+    std::optional<std::pair<Vector, double>> seeded_;
+};
+
+std::unique_ptr<Member> make_member(Method method, const Context& context, int index) {
+    switch (method) {
+        case Method::ADAPTIVE_DE: return std::make_unique<AdaptiveDEMember>(context, index);
+        case Method::CLASSIC_DE: return std::make_unique<ClassicDEMember>(context, index);
+        case Method::CMA_ES: return std::make_unique<CMAESMember>(context, index);
+        case Method::LOCAL_SEARCH: return std::make_unique<LocalSearchMember>(context, index);
+    }
+    throw std::invalid_argument("未知的组合成员类型");
+}
+
+} // namespace
+
+Result optimize(const Objective& objective, const Vector& lower, const Vector& upper, const Settings& settings) {
+    const int dim = static_cast<int>(lower.size());
+    if (dim == 0 || lower.size() != upper.size() || (upper - lower).minCoeff() <= 0.0) {
+        throw std::invalid_argument("算法组合的上下界无效");
+    }
+    const int num_members = static_cast<int>(settings.methods.size());
+    if (num_members == 0) {
+        throw std::invalid_argument("算法组合至少需要一个成员");
+    }
+    if (settings.max_evaluations <= 0 || settings.min_share < 0.0 || settings.min_share * num_members > 1.0) {
+        throw std::invalid_argument("算法组合的评估上限或最低份额无效");
+    }
+
+    auto& pool = WorkPool::Pool::global();
+    const int num_threads = settings.num_threads > 0 ? std::min(settings.num_threads, pool.num_threads())
+                                                     : pool.num_threads();
+    const int population_size = settings.population_size > 0 ? settings.population_size
+                                                              : std::min(200, std::max(30, 4 * dim));
+    const long long round_evaluations = settings.round_evaluations > 0
+        ? settings.round_evaluations : static_cast<long long>(num_members) * population_size;
+
+    IncumbentSlot slot;
+    std::unique_ptr<HighPerformanceDE::SolutionCache> cache;
+    if (settings.share_cache) {
+        cache = std::make_unique<HighPerformanceDE::SolutionCache>(settings.cache_size, 1e-12);
+    }
+    const Context context{objective, lower, upper, cache.get(), slot, population_size,
+                          DECore::resolve_seed(settings.seed),
+                          static_cast<int>(std::min<long long>(settings.max_evaluations / population_size + 1,
+                                                               std::numeric_limits<int>::max()))};
+
+    std::vector<std::unique_ptr<Member>> members;
+    Result result;
+    for (int m = 0; m < num_members; ++m) {
+        members.push_back(make_member(settings.methods[m], context, m));
+        result.members.push_back(MemberReport{method_name(settings.methods[m])});
+    }
+
+    std::vector<double> share(num_members, 1.0 / num_members);
+    std::vector<double> score(num_members, 0.0);
+    std::vector<double> balance(num_members, 0.0);
+    std::vector<long long> spent(num_members);
+    std::vector<int> caps(num_members);
+    const auto start = Clock::now();
+
+    while (true) {
+        // 1. 吸收上一轮结束时的全局最优，按份额分配本轮的评估配额和线程数
+        const Entry* incumbent = slot.best();
+        for (int m = 0; m < num_members; ++m) {
+            if (incumbent != nullptr && incumbent->fitness < members[m]->best_fitness()) {
+                members[m]->adopt(incumbent->solution, incumbent->fitness);
+            }
+        }
+        const double quota = static_cast<double>(std::min(round_evaluations, settings.max_evaluations - result.evaluations));
+        std::vector<int> active;
+        for (int m = 0; m < num_members; ++m) {
+            balance[m] += share[m] * quota;
+            caps[m] = std::max(1, static_cast<int>(std::lround(share[m] * num_threads)));
+            spent[m] = 0;
+            if (balance[m] > 0.0) {
+                active.push_back(m);
+            }
+        }
+
+        // 2. 各成员并发推进，直到用完配额 (至少一步)；欠下的配额从后续轮次扣除
+        pool.parallel_for(static_cast<int>(active.size()), [&](int a) {
+            const int m = active[a];
+            while (spent[m] < balance[m]) {
+                spent[m] += members[m]->step(caps[m]);
+                if (members[m]->stalled()) {
+                    members[m]->restart(incumbent);
+                    ++result.members[m].restarts;
+                }
+            }
+        }, num_threads, 1);
+
+        // 3. 竞速：按各成员对本轮开始时全局最优的改进量 (每次评估) 更新得分与份额
+        const double reference = incumbent != nullptr ? incumbent->fitness : std::numeric_limits<double>::infinity();
+        for (int m = 0; m < num_members; ++m) {
+            balance[m] -= static_cast<double>(spent[m]);
+            result.evaluations += spent[m];
+            result.members[m].evaluations += spent[m];
+            result.members[m].mean_share += share[m];
+            const double gain = std::isfinite(reference) ? std::max(0.0, reference - members[m]->best_fitness()) : 0.0;
+            if (gain > 0.0) {
+                ++result.members[m].improvements;
+            }
+            const double rate = spent[m] > 0 ? gain / static_cast<double>(spent[m]) : 0.0;
+            score[m] = settings.score_decay * score[m] + (1.0 - settings.score_decay) * rate;
+        }
+        const double total_score = std::accumulate(score.begin(), score.end(), 0.0);
+        if (settings.racing && total_score > 0.0 && std::isfinite(total_score)) {
+            for (int m = 0; m < num_members; ++m) {
+                share[m] = settings.min_share + (1.0 - num_members * settings.min_share) * score[m] / total_score;
+            }
+        }
+
+        ++result.rounds;
+        const Entry* best = slot.best();
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        result.history.push_back({seconds, result.evaluations,
+                                  best != nullptr ? best->fitness : std::numeric_limits<double>::infinity()});
+
+        if (settings.verbose && (result.rounds % 10 == 0 || result.rounds == 1)) {
+            std::cout << "轮 " << std::setw(4) << result.rounds << ": 最优 = " << std::setprecision(6)
+                      << result.history.back().best_fitness << ", 评估 = " << result.evaluations << ", 份额";
+            for (int m = 0; m < num_members; ++m) {
+                std::cout << " " << result.members[m].name << "=" << std::setprecision(2) << share[m];
+            }
+            std::cout << std::endl;
+        }
+
+        if (best != nullptr && best->fitness <= settings.target) {
+            result.reached_target = true;
+            result.evaluations_to_target = result.evaluations;
+            break;
+        }
+        if (result.evaluations >= settings.max_evaluations ||
+            (settings.max_seconds > 0.0 && seconds >= settings.max_seconds)) {
+            break;
+        }
+    }
+
+    result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    if (const Entry* best = slot.best()) {
+        result.best = best->solution;
+        result.best_fitness = best->fitness;
+        // 改进链按时间倒序，最后一个不高于目标的条目即首次达到目标的时刻
+        for (const Entry* entry = best; entry != nullptr && entry->fitness <= settings.target; entry = entry->previous) {
+            result.seconds_to_target = std::chrono::duration<double>(entry->time - start).count();
+        }
+    }
+    if (cache) {
+        result.cache_hits = cache->get_statistics().first;
+    }
+    for (int m = 0; m < num_members; ++m) {
+        result.members[m].share = share[m];
+        result.members[m].mean_share /= result.rounds;
+        result.members[m].best_fitness = members[m]->best_fitness();
+    }
+    return result;
+}
+
+} // namespace Portfolio
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <string>
+#include <vector>
+#include <Eigen/Dense>
+
+/**
+ * @brief 算法组合竞速：多种优化器在同一目标上同时运行，共享解缓存和当前最优解
+ *
+ * 成员 (自适应DE、经典 DE/rand/1、CMA-ES、坐标模式搜索) 按轮推进：每轮各成员在进程级线程池上并发执行，
+ * 按份额领取评估配额和线程数；改进的解随时写入无锁的最优解槽，各成员在下一轮开始时读取并吸收。
+ * 竞速规则按各成员上一轮对全局最优的改进量 (每次评估) 调整份额，改进快的成员得到更多线程和评估。
+ * 份额只由评估次数和目标值决定，与墙钟时间无关：给定种子时搜索过程与线程数无关。
+ */
+namespace Portfolio {
+
+using Vector = Eigen::VectorXd;
+using Objective = std::function<double(const Vector&)>;
+using Clock = std::chrono::steady_clock;
+
+enum class Method {
+    ADAPTIVE_DE,    // HighPerformanceDE::HighPerformanceAdaptiveDE (参数与策略自适应)
+    CLASSIC_DE,     // DE/rand/1/bin (DECore)
+    CMA_ES,         // (mu/mu_w, lambda)-CMA-ES，在归一化坐标中搜索
+    LOCAL_SEARCH    // 坐标模式搜索：以当前最优解为中心逐维探测，无改进时步长减半
+};
+
+std::string method_name(Method method);
+
+/**
+ * @brief 无锁的最优解槽
+ *
+ * 只在目标值更优时以 CAS 发布新条目，热路径上每次评估只有一次原子读。
+ * 目标值相同时按解向量的字典序取较小者，使最终结果与发布顺序无关。
+ * 被替换的条目不释放，沿 previous 链可回溯全部改进记录 (用于统计达到目标的时间)，随槽一起销毁。
+ */
+class IncumbentSlot {
+public:
+    struct Entry {
+        Vector solution;
+        double fitness;
+        int member;                 // 发布该解的成员下标
+        Clock::time_point time;
+        const Entry* previous;
+    };
+
+    IncumbentSlot() = default;
+    ~IncumbentSlot();
+    IncumbentSlot(const IncumbentSlot&) = delete;
+    IncumbentSlot& operator=(const IncumbentSlot&) = delete;
+
+    /**
+     * @brief 解优于当前最优时发布，返回是否发布成功 (可从任意线程并发调用)
+     */
+    bool offer(const Vector& solution, double fitness, int member = -1);
+
+    /**
+     * @brief 当前最优条目 (尚无发布时为空指针)，条目在槽销毁前一直有效
+     */
+    const Entry* best() const { return head_.load(std::memory_order_acquire); }
+
+private:
+    std::atomic<Entry*> head_{nullptr};
+};
+
+/**
+ * @brief 组合参数
+ */
+struct Settings {
+    std::vector<Method> methods = {Method::ADAPTIVE_DE, Method::CLASSIC_DE, Method::CMA_ES, Method::LOCAL_SEARCH};
+    long long max_evaluations = 100000;     // 全部成员合计的评估次数上限 (含缓存命中)
+    double max_seconds = 0.0;               // 墙钟时间上限，0 表示不限
+    double target = -std::numeric_limits<double>::infinity();  // 全局最优不高于该值时停止
+    int num_threads = -1;                   // -1表示使用所有可用线程
+    uint64_t seed = 1;                      // 0 表示使用随机种子
+    int population_size = 0;                // DE 类成员的种群规模，0 表示 max(30, 4 D) 且不超过 200
+    int round_evaluations = 0;              // 每轮全部成员合计的评估配额，0 表示 成员数 × 种群规模
+    bool racing = true;                     // false 时各成员份额固定相等
+    double min_share = 0.05;                // 每个成员的最低份额 (保证仍在探索的成员不被饿死)
+    double score_decay = 0.7;               // 改进速率得分的指数平滑系数 (旧得分的权重)
+    bool share_cache = true;                // 各成员共享一个解缓存
+    size_t cache_size = 10000;
+    bool verbose = false;
+};
+
+/**
+ * @brief 单个成员的统计
+ */
+struct MemberReport {
+    std::string name;
+    long long evaluations = 0;
+    double share = 0.0;             // 结束时的份额
+    double mean_share = 0.0;        // 各轮份额的平均值
+    int improvements = 0;           // 使全局最优变好的轮数
+    int restarts = 0;
+    double best_fitness = std::numeric_limits<double>::infinity();
+};
+
+/**
+ * @brief 每轮结束时的全局状态
+ */
+struct HistoryPoint {
+    double seconds;
+    long long evaluations;
+    double best_fitness;
+};
+
+struct Result {
+    Vector best;
+    double best_fitness = std::numeric_limits<double>::infinity();
+    long long evaluations = 0;
+    double seconds = 0.0;
+    int rounds = 0;
+    bool reached_target = false;
+    double seconds_to_target = -1.0;            // 首次发布不高于 target 的解的时刻 (未达到为 -1)
+    long long evaluations_to_target = -1;       // 达到 target 的那一轮结束时的累计评估次数
+    int cache_hits = 0;
+    std::vector<MemberReport> members;
+    std::vector<HistoryPoint> history;
+};
+
+/**
+ * @brief 在区间 [lower, upper] 内最小化 objective (目标函数须可并行调用)
+ */
+Result optimize(const Objective& objective, const Vector& lower, const Vector& upper,
+                const Settings& settings = Settings());
+
+} // namespace Portfolio
@@ -0,0 +1,207 @@
+#include "robust_objective.hpp"
+#include "work_pool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+namespace RobustOptimization {
+
+uint64_t generation_seed(uint64_t seed, int generation) {
+    // splitmix64，把相邻代数映射到互不相关的种子
+    uint64_t z = seed + 0x9E3779B97F4A7C15ull * (static_cast<uint64_t>(generation) + 1);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+RobustObscurationObjective::RobustObscurationObjective(
+    Decoder decoder,
+    const std::vector<std::string>& missile_ids,
+    const RobustnessAnalyzer::NoiseModel& noise,
+    const RobustSettings& settings)
+    : decoder_(std::move(decoder))
+    , evaluator_(missile_ids, settings.time_step)
+    , noise_(noise)
+    , settings_(settings)
+    , generation_seed_(generation_seed(settings.seed, 0))
+{
+    if (settings_.initial_samples <= 0 || settings_.max_samples < settings_.initial_samples) {
+        throw std::invalid_argument("鲁棒优化样本数设置无效");
+    }
+    if (settings_.sample_increment <= 0) {
+        settings_.sample_increment = settings_.initial_samples;
+    }
+}
+
+void RobustObscurationObjective::begin_generation(int generation) {
+    generation_seed_ = generation_seed(settings_.seed, generation);
+    stats_.generations = std::max(stats_.generations, generation + 1);
+}
+
+void RobustObscurationObjective::evaluate_pairs(
+    const std::vector<Eigen::VectorXd>& trials,
+    const std::vector<Eigen::VectorXd>& parents,
+    std::vector<double>& trial_fitness,
+    std::vector<double>& parent_fitness)
+{
+    const int num_trials = trials.size();
+    const bool paired = !parents.empty();
+    if (paired && static_cast<int>(parents.size()) != num_trials) {
+        throw std::invalid_argument("试验个体与父代数量不一致");
+    }
+
+    // 行 [0, num_trials) 为试验个体，[num_trials, 2*num_trials) 为对应父代
+    const int num_rows = paired ? 2 * num_trials : num_trials;
+    std::vector<Optimizer::FlatStrategy> strategies(num_rows);
+    std::vector<char> valid(num_rows, 1);
+
+    WorkPool::Pool::global().parallel_for(num_rows, [&](int r) {
+        const Eigen::VectorXd& x = r < num_trials ? trials[r] : parents[r - num_trials];
+        valid[r] = decoder_(x, strategies[r]) == Optimizer::StrategyStatus::OK;
+    }, settings_.num_threads, 4);
+    // 无效策略不参与抽样，所有样本记为零遮蔽
+    stats_.invalid_trials += std::count(valid.begin(), valid.end(), 0);
+
+    std::vector<std::vector<double>> values(num_rows, std::vector<double>(settings_.max_samples, 0.0));
+    std::vector<int> done(num_rows, settings_.initial_samples);
+
+    std::vector<int> rows(num_rows);
+    std::iota(rows.begin(), rows.end(), 0);
+    std::vector<int> begin(num_rows, 0);
+    std::vector<int> end(num_rows, settings_.initial_samples);
+    stats_.realisations += evaluate_grid(strategies, valid, rows, begin, end, generation_seed_, values);
+
+    // 自适应追加样本：只对配对差不显著 (处于选择边界附近) 的对继续抽样
+    std::vector<char> refined(num_trials, 0);
+    while (paired) {
+        rows.clear();
+        begin.clear();
+        end.clear();
+
+        for (int i = 0; i < num_trials; ++i) {
+            const int n = done[i];
+            if (n >= settings_.max_samples) {
+                continue;
+            }
+
+            const double* trial_values = values[i].data();
+            const double* parent_values = values[i + num_trials].data();
+            double mean = 0.0;
+            for (int s = 0; s < n; ++s) {
+                mean += trial_values[s] - parent_values[s];
+            }
+            mean /= n;
+            double var = 0.0;
+            for (int s = 0; s < n; ++s) {
+                double d = trial_values[s] - parent_values[s] - mean;
+                var += d * d;
+            }
+            double standard_error = n > 1 ? std::sqrt(var / (n - 1) / n) : 0.0;
+
+            if (standard_error > 0.0 && std::abs(mean) < settings_.z_threshold * standard_error) {
+                int next = std::min(n + settings_.sample_increment, settings_.max_samples);
+                for (int r : {i, i + num_trials}) {
+                    rows.push_back(r);
+                    begin.push_back(n);
+                    end.push_back(next);
+                    done[r] = next;
+                }
+                refined[i] = 1;
+            }
+        }
+
+        if (rows.empty()) {
+            break;
+        }
+        stats_.realisations += evaluate_grid(strategies, valid, rows, begin, end, generation_seed_, values);
+    }
+
+    trial_fitness.resize(num_trials);
+    for (int i = 0; i < num_trials; ++i) {
+        trial_fitness[i] = -summarize(values[i].data(), done[i]);
+    }
+    if (paired) {
+        parent_fitness.resize(num_trials);
+        for (int i = 0; i < num_trials; ++i) {
+            parent_fitness[i] = -summarize(values[i + num_trials].data(), done[i + num_trials]);
+        }
+        stats_.pairs += num_trials;
+        stats_.refined_pairs += std::count(refined.begin(), refined.end(), 1);
+    }
+}
+
+double RobustObscurationObjective::evaluate(const Optimizer::StrategyMap& strategy,
+                                            int num_samples,
+                                            uint64_t seed) const
+{
+    if (num_samples <= 0) {
+        throw std::invalid_argument("样本数必须为正");
+    }
+    std::vector<std::vector<double>> values(1, std::vector<double>(num_samples, 0.0));
+    std::vector<Optimizer::FlatStrategy> flat(1);
+    char valid = Optimizer::to_flat_strategy(strategy, flat[0]) == Optimizer::StrategyStatus::OK;
+    evaluate_grid(flat, {valid}, {0}, {0}, {num_samples}, seed, values);
+    return summarize(values[0].data(), num_samples);
+}
+
+long long RobustObscurationObjective::evaluate_grid(
+    const std::vector<Optimizer::FlatStrategy>& strategies,
+    const std::vector<char>& valid,
+    const std::vector<int>& rows,
+    const std::vector<int>& begin,
+    const std::vector<int>& end,
+    uint64_t seed,
+    std::vector<std::vector<double>>& values) const
+{
+    // 展开为 (候选解, 样本) 任务，使少量候选解也能占满所有线程
+    std::vector<std::pair<int, int>> tasks;
+    for (size_t k = 0; k < rows.size(); ++k) {
+        if (!valid[rows[k]]) {
+            continue;
+        }
+        for (int s = begin[k]; s < end[k]; ++s) {
+            tasks.emplace_back(rows[k], s);
+        }
+    }
+
+    const int num_tasks = tasks.size();
+    const int num_missiles = evaluator_.num_missiles();
+
+    struct Scratch {
+        std::vector<FastEvaluator::CloudState> clouds;
+        std::vector<double> obscured;
+    };
+    auto& pool = WorkPool::Pool::global();
+    WorkPool::WorkerLocal<Scratch> scratch(pool, Scratch{{}, std::vector<double>(num_missiles)});
+    pool.parallel_for(num_tasks, [&](int k) {
+        auto& local = scratch.local();
+        const auto [row, sample] = tasks[k];
+        RobustnessAnalyzer::sample_perturbed_clouds(strategies[row], noise_, seed,
+                                                    static_cast<uint64_t>(sample), local.clouds);
+        evaluator_.evaluate(local.clouds, local.obscured.data());
+        values[row][sample] = std::accumulate(local.obscured.begin(), local.obscured.end(), 0.0);
+    }, settings_.num_threads, 8);
+
+    return num_tasks;
+}
+
+double RobustObscurationObjective::summarize(const double* values, int count) const {
+    if (count <= 0) {
+        return 0.0;
+    }
+    if (settings_.measure == RobustMeasure::MEAN) {
+        return std::accumulate(values, values + count, 0.0) / count;
+    }
+
+    // 线性插值的下分位数
+    std::vector<double> sorted(values, values + count);
+    std::sort(sorted.begin(), sorted.end());
+    double pos = std::clamp(settings_.percentile, 0.0, 1.0) * (count - 1);
+    int lo = static_cast<int>(std::floor(pos));
+    int hi = std::min(lo + 1, count - 1);
+    return sorted[lo] + (pos - lo) * (sorted[hi] - sorted[lo]);
+}
+
+} // namespace RobustOptimization
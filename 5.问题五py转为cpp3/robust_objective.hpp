@@ -0,0 +1,118 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <functional>
+#include <cstdint>
+#include <Eigen/Dense>
+#include "optimizer.hpp"
+#include "fast_evaluator.hpp"
+#include "robustness_analyzer.hpp"
+#include "noisy_objective.hpp"
+
+namespace RobustOptimization {
+
+/**
+ * @brief 鲁棒目标的统计量
+ */
+enum class RobustMeasure {
+    MEAN,        // 期望遮蔽时间
+    PERCENTILE   // 遮蔽时间的下分位数 (以给定概率能保证的遮蔽时间)
+};
+
+/**
+ * @brief 鲁棒优化设置
+ */
+struct RobustSettings {
+    RobustMeasure measure = RobustMeasure::MEAN;
+    double percentile = 0.1;          // PERCENTILE 时使用，0.1 表示 90% 概率能达到的遮蔽时间
+    int initial_samples = 16;         // 每个候选解的初始样本数
+    int max_samples = 128;            // 单个候选解的样本上限
+    int sample_increment = 16;        // 每轮追加的样本数
+    double z_threshold = 2.0;         // 配对差均值小于 z 倍标准误时视为处于选择边界附近
+    uint64_t seed = 20240907;
+    int num_threads = -1;             // 线程池上的并发上限，-1表示不限
+    double time_step = 0.1;
+
+    RobustSettings() = default;
+};
+
+/**
+ * @brief 评估开销统计
+ */
+struct RobustStats {
+    long long realisations = 0;       // 噪声样本评估总次数
+    long long pairs = 0;              // 参与比较的试验/父代对数
+    long long refined_pairs = 0;      // 追加过样本的对数
+    long long invalid_trials = 0;     // 解析或校验失败的候选解数
+    int generations = 0;
+};
+
+/**
+ * @brief 执行噪声下的鲁棒遮蔽目标
+ *
+ * 适应度为遮蔽时间统计量的相反数。同一代内所有候选解共用由 (seed, 代数, 样本编号)
+ * 确定的噪声样本 (公共随机数)，试验个体与父代的差异用配对差估计，方差远小于独立抽样。
+ * 先给每对评估 initial_samples 个样本，只有配对差不显著的对才继续追加样本，直到 max_samples。
+ * 候选解 × 样本的网格在 WorkPool::Pool::global() 上并行评估。
+ */
+class RobustObscurationObjective : public NoisyObjective::PairwiseNoisyObjective {
+public:
+    using Decoder = std::function<Optimizer::StrategyStatus(const Eigen::VectorXd&, Optimizer::FlatStrategy&)>;
+
+    /**
+     * @param decoder 决策变量到扁平策略的解析函数 (不抛异常，返回 OK 时策略须已通过 validate_strategy)，
+     *                返回其他状态的候选解记为无效，所有样本按零遮蔽计
+     * @param missile_ids 参与统计的导弹 (遮蔽时间求和)
+     * @param noise 噪声模型
+     * @param settings 鲁棒优化设置
+     */
+    RobustObscurationObjective(Decoder decoder,
+                               const std::vector<std::string>& missile_ids,
+                               const RobustnessAnalyzer::NoiseModel& noise = RobustnessAnalyzer::NoiseModel(),
+                               const RobustSettings& settings = RobustSettings());
+
+    void begin_generation(int generation) override;
+
+    void evaluate_pairs(const std::vector<Eigen::VectorXd>& trials,
+                        const std::vector<Eigen::VectorXd>& parents,
+                        std::vector<double>& trial_fitness,
+                        std::vector<double>& parent_fitness) override;
+
+    /**
+     * @brief 用独立的一组样本估计策略的鲁棒遮蔽时间 (正值，用于最终报告)
+     */
+    double evaluate(const Optimizer::StrategyMap& strategy, int num_samples, uint64_t seed) const;
+
+    const RobustStats& stats() const { return stats_; }
+    const RobustSettings& settings() const { return settings_; }
+
+private:
+    Decoder decoder_;
+    FastEvaluator::ObscurationEvaluator evaluator_;
+    RobustnessAnalyzer::NoiseModel noise_;
+    RobustSettings settings_;
+    uint64_t generation_seed_;
+    RobustStats stats_;
+
+    /**
+     * @brief 并行评估网格：rows 中每个候选解的样本区间 [begin[r], end[r])
+     * @return long long 本次评估的样本数
+     */
+    long long evaluate_grid(const std::vector<Optimizer::FlatStrategy>& strategies,
+                            const std::vector<char>& valid,
+                            const std::vector<int>& rows,
+                            const std::vector<int>& begin,
+                            const std::vector<int>& end,
+                            uint64_t seed,
+                            std::vector<std::vector<double>>& values) const;
+
+    double summarize(const double* values, int count) const;
+};
+
+/**
+ * @brief 第 generation 代公共随机数使用的种子
+ */
+uint64_t generation_seed(uint64_t seed, int generation);
+
+} // namespace RobustOptimization
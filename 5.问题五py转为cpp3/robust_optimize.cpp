@@ -0,0 +1,143 @@
+#include "robust_objective.hpp"
+#include "high_performance_adaptive_de.hpp"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <cmath>
+
+namespace {
+
+/**
+ * @brief 问题三形式的子问题：FY1 投放三枚弹药干扰 M1
+ *
+ * 决策变量与 Problem5SubOptimizer 相同：[速度, 角度, 投放1, 引信1, 间隔2, 引信2, 间隔3, 引信3]
+ */
+class SingleUAVOptimizer : public Optimizer::ObscurationOptimizer {
+public:
+    SingleUAVOptimizer() : ObscurationOptimizer("M1", {{"FY1", 3}}) {}
+
+protected:
+    Optimizer::StrategyMap parse_decision_variables(const Eigen::VectorXd& x) override {
+        Optimizer::UAVStrategy fy1;
+        fy1.speed = x[0];
+        fy1.angle = x[1];
+        double t_deploy = x[2];
+        fy1.grenades.push_back({t_deploy, x[3]});
+        for (int i = 1; i < 3; ++i) {
+            t_deploy += x[2 + 2 * i];
+            fy1.grenades.push_back({t_deploy, x[3 + 2 * i]});
+        }
+        return {{"FY1", fy1}};
+    }
+};
+
+std::vector<Optimizer::Bounds> problem_bounds() {
+    return {
+        {Config::UAV_SPEED_MIN, Config::UAV_SPEED_MAX},
+        {0.0, 2.0 * M_PI},
+        {0.1, 10.0}, {0.1, 10.0},
+        {Config::GRENADE_INTERVAL, 5.0}, {0.1, 10.0},
+        {Config::GRENADE_INTERVAL, 5.0}, {0.1, 10.0}
+    };
+}
+
+void print_strategy(const Optimizer::StrategyMap& strategy) {
+    for (const auto& [uav_id, s] : strategy) {
+        std::cout << "  " << uav_id << ": 速度 " << std::fixed << std::setprecision(2) << s.speed
+                  << " m/s, 航向 " << std::setprecision(4) << s.angle << " rad" << std::endl;
+        for (size_t i = 0; i < s.grenades.size(); ++i) {
+            std::cout << "    弹药" << (i + 1) << ": 投放 " << std::setprecision(3) << s.grenades[i].t_deploy
+                      << " s, 引信 " << s.grenades[i].t_fuse << " s" << std::endl;
+        }
+    }
+}
+
+} // namespace
+
+/**
+ * @brief 执行噪声下的鲁棒优化
+ *
+ * 用法: robust_optimize [de|adaptive] [迭代数] [mean|p10] [线程数]
+ */
+int main(int argc, char* argv[]) {
+    try {
+        std::string engine = argc > 1 ? argv[1] : "de";
+        int iterations = argc > 2 ? std::stoi(argv[2]) : 100;
+        std::string measure = argc > 3 ? argv[3] : "mean";
+        int num_threads = argc > 4 ? std::stoi(argv[4]) : -1;
+
+        RobustnessAnalyzer::NoiseModel noise;
+        RobustOptimization::RobustSettings robust_settings;
+        robust_settings.num_threads = num_threads;
+        if (measure == "p10") {
+            robust_settings.measure = RobustOptimization::RobustMeasure::PERCENTILE;
+            robust_settings.percentile = 0.1;
+        }
+
+        SingleUAVOptimizer optimizer;
+        auto bounds = problem_bounds();
+        Optimizer::StrategyMap best_strategy;
+        double robust_time = 0.0;
+
+        if (engine == "adaptive") {
+            auto objective = std::make_shared<RobustOptimization::RobustObscurationObjective>(
+                [&optimizer](const Eigen::VectorXd& x, Optimizer::FlatStrategy& flat) {
+                    return optimizer.decode_flat(x, flat);
+                },
+                std::vector<std::string>{"M1"}, noise, robust_settings);
+
+            HighPerformanceDE::AdaptiveDESettings settings;
+            settings.population_size = 60;
+            settings.max_iterations = iterations;
+            settings.max_stagnant_generations = iterations;
+            settings.tolerance = 0.0;     // 遮蔽时间可能为零，不使用适应度阈值收敛
+            settings.num_threads = num_threads;
+            settings.enable_caching = false;
+            settings.adaptive_population = false;
+
+            std::vector<std::pair<double, double>> pair_bounds;
+            for (const auto& b : bounds) {
+                pair_bounds.emplace_back(b.lower, b.upper);
+            }
+            HighPerformanceDE::HighPerformanceAdaptiveDE de(
+                [](const HighPerformanceDE::Vector&) { return 0.0; },
+                HighPerformanceDE::Utils::bounds_to_lower(pair_bounds),
+                HighPerformanceDE::Utils::bounds_to_upper(pair_bounds),
+                settings);
+            de.set_noisy_objective(objective);
+            auto result = de.optimize();
+
+            best_strategy = optimizer.decode(result.best_solution);
+            robust_time = objective->evaluate(best_strategy, robust_settings.max_samples * 8,
+                                              robust_settings.seed ^ 0x5DEECE66Dull);
+        } else {
+            Optimizer::DESettings settings;
+            settings.population_size = 60;
+            settings.max_iterations = iterations;
+            settings.num_threads = num_threads;
+            std::tie(best_strategy, robust_time) = optimizer.solve_robust(bounds, noise, robust_settings, settings);
+        }
+
+        // 与确定性最优策略 (问题三) 在同一噪声模型下比较
+        Optimizer::UAVStrategy nominal;
+        nominal.speed = 139.6956;
+        nominal.angle = 3.1338;
+        nominal.grenades = {{0.2281, 3.7869}, {3.3818, 5.2772}, {4.8330, 5.9929}};
+        RobustOptimization::RobustObscurationObjective reference(
+            [&optimizer](const Eigen::VectorXd& x, Optimizer::FlatStrategy& flat) {
+                return optimizer.decode_flat(x, flat);
+            },
+            {"M1"}, noise, robust_settings);
+        double nominal_robust_time = reference.evaluate({{"FY1", nominal}}, robust_settings.max_samples * 8,
+                                                        robust_settings.seed ^ 0x5DEECE66Dull);
+
+        std::cout << "\n鲁棒最优策略 (" << (measure == "p10" ? "P10" : "期望") << " 遮蔽时间 "
+                  << std::fixed << std::setprecision(3) << robust_time << " s):" << std::endl;
+        print_strategy(best_strategy);
+        std::cout << "确定性最优策略在同一噪声下: " << std::setprecision(3) << nominal_robust_time << " s" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "鲁棒优化失败: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,247 @@
+#include "robustness_analyzer.hpp"
+#include "counter_rng.hpp"
+#include "work_pool.hpp"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+namespace RobustnessAnalyzer {
+
+namespace {
+
+/**
+ * @brief 线性插值分位数 (values 会被部分重排)
+ */
+double quantile(std::vector<double>& values, double q) {
+    if (values.empty()) return 0.0;
+    double pos = q * (values.size() - 1);
+    size_t lo = static_cast<size_t>(std::floor(pos));
+    size_t hi = std::min(lo + 1, values.size() - 1);
+    std::nth_element(values.begin(), values.begin() + lo, values.end());
+    double v_lo = values[lo];
+    if (hi == lo) return v_lo;
+    double v_hi = *std::min_element(values.begin() + hi, values.end());
+    return v_lo + (pos - lo) * (v_hi - v_lo);
+}
+
+DistributionStats summarize(std::vector<double> values, double nominal) {
+    DistributionStats stats;
+    stats.nominal = nominal;
+    if (values.empty()) return stats;
+
+    const double n = values.size();
+    stats.mean = std::accumulate(values.begin(), values.end(), 0.0) / n;
+    double var = 0.0;
+    for (double v : values) {
+        var += (v - stats.mean) * (v - stats.mean);
+    }
+    stats.stddev = std::sqrt(var / n);
+    auto [min_it, max_it] = std::minmax_element(values.begin(), values.end());
+    stats.min = *min_it;
+    stats.max = *max_it;
+    stats.p05 = quantile(values, 0.05);
+    stats.p25 = quantile(values, 0.25);
+    stats.p50 = quantile(values, 0.50);
+    stats.p75 = quantile(values, 0.75);
+    stats.p95 = quantile(values, 0.95);
+    return stats;
+}
+
+void print_stats_row(const std::string& name, const DistributionStats& s) {
+    std::cout << std::left << std::setw(8) << name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(8) << s.nominal
+              << std::setw(8) << s.mean
+              << std::setw(8) << s.stddev
+              << std::setw(8) << s.min
+              << std::setw(8) << s.p05
+              << std::setw(8) << s.p50
+              << std::setw(8) << s.p95
+              << std::setw(8) << s.max;
+}
+
+} // namespace
+
+Optimizer::StrategyStatus sample_perturbed_clouds(const Optimizer::FlatStrategy& nominal,
+                                                  const NoiseModel& noise,
+                                                  uint64_t seed,
+                                                  uint64_t sample_index,
+                                                  std::vector<FastEvaluator::CloudState>& clouds,
+                                                  const ScenarioLoader::Scenario& scenario)
+{
+    clouds.clear();
+    Optimizer::StrategyStatus status = Optimizer::validate_strategy(nominal, scenario);
+    if (status != Optimizer::StrategyStatus::OK) {
+        return status;
+    }
+
+    CounterRNG::CounterRng rng(seed, sample_index);
+    const auto& physics = scenario.physics;
+
+    for (const auto& record : nominal) {
+        const Vector3d& uav_start = scenario.entities.uav(record.uav).start_pos;
+        double speed = std::clamp(record.speed + noise.sigma_speed * rng.normal(),
+                                  physics.uav_speed_min, physics.uav_speed_max);
+        double angle = record.angle + noise.sigma_heading * rng.normal();
+
+        for (int i = 0; i < record.num_grenades; ++i) {
+            const auto& g = record.grenades[i];
+            double t_deploy = std::max(0.0, g.t_deploy + noise.sigma_t_deploy * rng.normal());
+            double t_fuse = std::max(0.0, g.t_fuse + noise.sigma_t_fuse * rng.normal());
+            double sink = std::max(0.0, physics.cloud_sink_speed + noise.sigma_sink_speed * rng.normal());
+            clouds.push_back(FastEvaluator::deploy_cloud(uav_start, speed, angle, t_deploy, t_fuse, sink, physics));
+        }
+    }
+    return Optimizer::StrategyStatus::OK;
+}
+
+Optimizer::StrategyStatus sample_perturbed_clouds(const Optimizer::StrategyMap& nominal,
+                                                  const NoiseModel& noise,
+                                                  uint64_t seed,
+                                                  uint64_t sample_index,
+                                                  std::vector<FastEvaluator::CloudState>& clouds)
+{
+    Optimizer::FlatStrategy flat;
+    Optimizer::StrategyStatus status = Optimizer::to_flat_strategy(nominal, flat);
+    if (status != Optimizer::StrategyStatus::OK) {
+        clouds.clear();
+        return status;
+    }
+    return sample_perturbed_clouds(flat, noise, seed, sample_index, clouds);
+}
+
+RobustnessReport analyze(const Optimizer::StrategyMap& strategy,
+                         const std::vector<std::string>& missile_ids,
+                         const NoiseModel& noise,
+                         const RobustnessSettings& settings)
+{
+    if (settings.num_samples <= 0) {
+        throw std::invalid_argument("样本数必须为正");
+    }
+    Optimizer::FlatStrategy flat;
+    Optimizer::StrategyStatus status = Optimizer::to_flat_strategy(strategy, flat);
+    if (status != Optimizer::StrategyStatus::OK) {
+        throw std::invalid_argument(std::string("策略无效: ") + Optimizer::status_message(status));
+    }
+
+    FastEvaluator::ObscurationEvaluator evaluator(missile_ids, settings.time_step);
+    const int num_missiles = evaluator.num_missiles();
+    const int num_samples = settings.num_samples;
+    auto& pool = WorkPool::Pool::global();
+    const int num_threads = settings.num_threads > 0 ? std::min(settings.num_threads, pool.num_threads())
+                                                     : pool.num_threads();
+
+    // 名义值
+    std::vector<double> nominal = evaluator.evaluate(strategy);
+
+    std::vector<double> samples(static_cast<size_t>(num_samples) * num_missiles, 0.0);
+
+    auto start_clock = std::chrono::steady_clock::now();
+
+    WorkPool::WorkerLocal<std::vector<FastEvaluator::CloudState>> clouds(pool);
+    pool.parallel_for(num_samples, [&](int s) {
+        auto& local = clouds.local();
+        sample_perturbed_clouds(flat, noise, settings.seed, static_cast<uint64_t>(s), local);
+        evaluator.evaluate(local, samples.data() + static_cast<size_t>(s) * num_missiles);
+    }, num_threads, 256);
+
+    auto end_clock = std::chrono::steady_clock::now();
+
+    RobustnessReport report;
+    report.num_samples = num_samples;
+    report.num_threads = num_threads;
+    report.elapsed_seconds = std::chrono::duration<double>(end_clock - start_clock).count();
+    if (report.elapsed_seconds > 0.0) {
+        report.evaluations_per_second = num_samples / report.elapsed_seconds;
+        report.evaluations_per_second_per_core = report.evaluations_per_second / num_threads;
+    }
+
+    // 汇总每枚导弹和总遮蔽时间的分布
+    std::vector<double> totals(num_samples, 0.0);
+    for (int m = 0; m < num_missiles; ++m) {
+        std::vector<double> column(num_samples);
+        int failures = 0;
+        for (int s = 0; s < num_samples; ++s) {
+            double v = samples[static_cast<size_t>(s) * num_missiles + m];
+            column[s] = v;
+            totals[s] += v;
+            if (v <= settings.failure_threshold) {
+                ++failures;
+            }
+        }
+
+        MissileRobustness mr;
+        mr.missile_id = missile_ids[m];
+        mr.failure_probability = static_cast<double>(failures) / num_samples;
+        mr.obscured_time = summarize(std::move(column), nominal[m]);
+        report.missiles.push_back(std::move(mr));
+    }
+
+    double nominal_total = std::accumulate(nominal.begin(), nominal.end(), 0.0);
+    report.total_obscured_time = summarize(totals, nominal_total);
+
+    // 总遮蔽时间直方图
+    const int bins = std::max(1, settings.histogram_bins);
+    report.histogram_min = report.total_obscured_time.min;
+    report.histogram_max = report.total_obscured_time.max;
+    report.histogram.assign(bins, 0);
+    double width = (report.histogram_max - report.histogram_min) / bins;
+    for (double v : totals) {
+        int b = width > 0.0 ? static_cast<int>((v - report.histogram_min) / width) : 0;
+        report.histogram[std::clamp(b, 0, bins - 1)]++;
+    }
+
+    if (settings.keep_samples) {
+        report.samples = std::move(samples);
+    }
+
+    if (settings.verbose) {
+        print_report(report);
+    }
+    return report;
+}
+
+void print_report(const RobustnessReport& report) {
+    std::cout << "\n" << std::string(72, '=') << std::endl;
+    std::cout << "执行噪声鲁棒性分析 (蒙特卡洛样本数: " << report.num_samples << ")" << std::endl;
+    std::cout << std::string(72, '=') << std::endl;
+
+    std::cout << std::left << std::setw(8) << "导弹" << std::right
+              << std::setw(8) << "名义" << std::setw(8) << "均值" << std::setw(8) << "标准差"
+              << std::setw(8) << "最小" << std::setw(8) << "P5" << std::setw(8) << "P50"
+              << std::setw(8) << "P95" << std::setw(8) << "最大"
+              << std::setw(10) << "失败概率" << std::endl;
+    std::cout << std::string(72, '-') << std::endl;
+
+    for (const auto& m : report.missiles) {
+        print_stats_row(m.missile_id, m.obscured_time);
+        std::cout << std::setw(9) << std::setprecision(2) << (m.failure_probability * 100) << "%" << std::endl;
+    }
+    print_stats_row("总计", report.total_obscured_time);
+    std::cout << std::endl;
+
+    std::cout << std::string(72, '-') << std::endl;
+    std::cout << "总遮蔽时间分布 [" << std::setprecision(2) << report.histogram_min
+              << ", " << report.histogram_max << "] s:" << std::endl;
+    int peak = report.histogram.empty() ? 0 : *std::max_element(report.histogram.begin(), report.histogram.end());
+    double width = report.histogram.empty() ? 0.0
+        : (report.histogram_max - report.histogram_min) / report.histogram.size();
+    for (size_t b = 0; b < report.histogram.size(); ++b) {
+        if (report.histogram[b] == 0) continue;
+        int bar = peak > 0 ? report.histogram[b] * 50 / peak : 0;
+        std::cout << "  " << std::setw(6) << (report.histogram_min + b * width) << " | "
+                  << std::string(bar, '#') << " " << report.histogram[b] << std::endl;
+    }
+
+    std::cout << std::string(72, '-') << std::endl;
+    std::cout << "吞吐量: " << std::setprecision(0) << report.evaluations_per_second << " 次评估/秒, "
+              << report.evaluations_per_second_per_core << " 次评估/秒/核 ("
+              << report.num_threads << " 线程, " << std::setprecision(3)
+              << report.elapsed_seconds << " s)" << std::endl;
+    std::cout << std::string(72, '=') << std::endl;
+}
+
+} // namespace RobustnessAnalyzer
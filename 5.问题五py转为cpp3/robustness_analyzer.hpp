@@ -0,0 +1,133 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include "config.hpp"
+#include "optimizer.hpp"
+#include "fast_evaluator.hpp"
+
+namespace RobustnessAnalyzer {
+
+/**
+ * @brief 执行噪声模型 (各项均为零均值高斯扰动的标准差)
+ */
+struct NoiseModel {
+    double sigma_t_deploy = 0.1;      // 投放时刻抖动 (s)
+    double sigma_t_fuse = 0.1;        // 引信时间抖动 (s)
+    double sigma_heading = 0.01;      // 航向误差 (rad)
+    double sigma_speed = 1.0;         // 速度误差 (m/s)
+    double sigma_sink_speed = 0.3;    // 云团下沉速度波动 (m/s)
+
+    NoiseModel() = default;
+};
+
+/**
+ * @brief 将噪声模型作用到一个策略上
+ *
+ * 每架无人机抽取一次航向与速度误差，每枚弹药抽取投放/引信抖动与下沉速度。
+ * 随机数由 (seed, sample_index) 唯一确定，与线程数和调度无关。
+ *
+ * @param nominal 名义策略
+ * @param noise 噪声模型
+ * @param seed 随机种子
+ * @param sample_index 样本编号
+ * @param clouds 输出，扰动后的云团 (名义策略无效时为空)
+ * @return Optimizer::StrategyStatus 名义策略的校验结果
+ */
+Optimizer::StrategyStatus sample_perturbed_clouds(const Optimizer::StrategyMap& nominal,
+                                                  const NoiseModel& noise,
+                                                  uint64_t seed,
+                                                  uint64_t sample_index,
+                                                  std::vector<FastEvaluator::CloudState>& clouds);
+
+/**
+ * @brief 扁平策略版本 (热路径使用)，抽样顺序与字符串键版本相同
+ */
+Optimizer::StrategyStatus sample_perturbed_clouds(const Optimizer::FlatStrategy& nominal,
+                                                  const NoiseModel& noise,
+                                                  uint64_t seed,
+                                                  uint64_t sample_index,
+                                                  std::vector<FastEvaluator::CloudState>& clouds,
+                                                  const ScenarioLoader::Scenario& scenario =
+                                                      ScenarioLoader::active());
+
+/**
+ * @brief 蒙特卡洛分析设置
+ */
+struct RobustnessSettings {
+    int num_samples = 100000;
+    uint64_t seed = 20240907;
+    int num_threads = -1;             // WorkPool::Pool::global() 上的并发上限，-1表示不限
+    double time_step = 0.1;
+    double failure_threshold = 0.0;   // 遮蔽时间不超过该值视为该导弹防御失败
+    int histogram_bins = 40;
+    bool keep_samples = false;        // 是否在报告中保留全部样本
+    bool verbose = true;
+};
+
+/**
+ * @brief 遮蔽时间分布统计
+ */
+struct DistributionStats {
+    double nominal = 0.0;
+    double mean = 0.0;
+    double stddev = 0.0;
+    double min = 0.0;
+    double max = 0.0;
+    double p05 = 0.0;
+    double p25 = 0.0;
+    double p50 = 0.0;
+    double p75 = 0.0;
+    double p95 = 0.0;
+};
+
+/**
+ * @brief 单枚导弹的鲁棒性结果
+ */
+struct MissileRobustness {
+    std::string missile_id;
+    DistributionStats obscured_time;
+    double failure_probability = 0.0;
+};
+
+/**
+ * @brief 鲁棒性分析报告
+ */
+struct RobustnessReport {
+    int num_samples = 0;
+    int num_threads = 0;
+    DistributionStats total_obscured_time;
+    std::vector<MissileRobustness> missiles;
+
+    double histogram_min = 0.0;
+    double histogram_max = 0.0;
+    std::vector<int> histogram;            // 总遮蔽时间直方图
+
+    double elapsed_seconds = 0.0;
+    double evaluations_per_second = 0.0;
+    double evaluations_per_second_per_core = 0.0;
+
+    std::vector<double> samples;           // keep_samples 时按 [样本][导弹] 存放
+};
+
+/**
+ * @brief 对一个策略做执行噪声下的蒙特卡洛鲁棒性分析
+ *
+ * @param strategy 名义策略
+ * @param missile_ids 参与统计的导弹
+ * @param noise 噪声模型
+ * @param settings 分析设置
+ * @return RobustnessReport 分析报告
+ */
+RobustnessReport analyze(const Optimizer::StrategyMap& strategy,
+                         const std::vector<std::string>& missile_ids,
+                         const NoiseModel& noise = NoiseModel(),
+                         const RobustnessSettings& settings = RobustnessSettings());
+
+/**
+ * @brief 打印鲁棒性分析报告
+ */
+void print_report(const RobustnessReport& report);
+
+} // namespace RobustnessAnalyzer
@@ -0,0 +1,458 @@
+#include "scenario.hpp"
+#include "mini_json.hpp"
+#include <fstream>
+#include <sstream>
+#include <iterator>
+#include <stdexcept>
+#include <cstring>
+#include <cmath>
+
+namespace ScenarioLoader {
+
+namespace {
+
+constexpr char BINARY_MAGIC[4] = {'S', 'C', 'N', 'B'};
+constexpr uint32_t BINARY_VERSION = 1;
+
+/**
+ * @brief 按位检查有限值 (库以 -ffast-math 编译，std::isfinite 可能被优化掉)
+ */
+inline bool is_finite_bits(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x7FF0000000000000ull) != 0x7FF0000000000000ull;
+}
+
+inline bool is_finite_bits(const Vector3d& v) {
+    return is_finite_bits(v.x()) && is_finite_bits(v.y()) && is_finite_bits(v.z());
+}
+
+// ------------------------------------------------------------------
+// JSON 值到场景字段的转换
+// ------------------------------------------------------------------
+
+double get_number(const MiniJson::Value& value, const std::string& what) {
+    if (value.type != MiniJson::Type::NUMBER) {
+        throw std::runtime_error("场景字段 " + what + " 应为数字");
+    }
+    return value.number;
+}
+
+const MiniJson::Value& require(const MiniJson::Value& object, const std::string& key, const std::string& context) {
+    const MiniJson::Value* value = object.find(key);
+    if (value == nullptr) {
+        throw std::runtime_error("场景字段缺失: " + context + "." + key);
+    }
+    return *value;
+}
+
+Vector3d get_vector(const MiniJson::Value& value, const std::string& what) {
+    if (value.type != MiniJson::Type::ARRAY || value.array.size() != 3) {
+        throw std::runtime_error("场景字段 " + what + " 应为三维坐标数组");
+    }
+    return Vector3d(get_number(value.array[0], what),
+                    get_number(value.array[1], what),
+                    get_number(value.array[2], what));
+}
+
+std::string get_string(const MiniJson::Value& value, const std::string& what) {
+    if (value.type != MiniJson::Type::STRING || value.string.empty()) {
+        throw std::runtime_error("场景字段 " + what + " 应为非空字符串");
+    }
+    return value.string;
+}
+
+void read_optional(const MiniJson::Value& object, const char* key, double& field) {
+    if (const MiniJson::Value* value = object.find(key)) {
+        field = get_number(*value, std::string("physics.") + key);
+    }
+}
+
+// ------------------------------------------------------------------
+// 规范化二进制编码 (哈希与二进制文件共用)
+// ------------------------------------------------------------------
+
+class ByteWriter {
+public:
+    void u32(uint32_t v) { raw(&v, sizeof(v)); }
+    void u64(uint64_t v) { raw(&v, sizeof(v)); }
+    void f64(double v) { raw(&v, sizeof(v)); }
+    void vec3(const Vector3d& v) { f64(v.x()); f64(v.y()); f64(v.z()); }
+    void str(const std::string& s) {
+        u32(static_cast<uint32_t>(s.size()));
+        raw(s.data(), s.size());
+    }
+    void raw(const void* data, size_t size) {
+        bytes_.append(static_cast<const char*>(data), size);
+    }
+    const std::string& bytes() const { return bytes_; }
+
+private:
+    std::string bytes_;
+};
+
+class ByteReader {
+public:
+    ByteReader(const std::string& bytes, size_t pos) : bytes_(bytes), pos_(pos) {}
+
+    uint32_t u32() { uint32_t v; raw(&v, sizeof(v)); return v; }
+    uint64_t u64() { uint64_t v; raw(&v, sizeof(v)); return v; }
+    double f64() { double v; raw(&v, sizeof(v)); return v; }
+    Vector3d vec3() { double x = f64(); double y = f64(); double z = f64(); return Vector3d(x, y, z); }
+    std::string str() {
+        uint32_t size = u32();
+        if (size > bytes_.size() - pos_) {
+            throw std::runtime_error("二进制场景文件已截断");
+        }
+        std::string s = bytes_.substr(pos_, size);
+        pos_ += size;
+        return s;
+    }
+    void raw(void* out, size_t size) {
+        if (size > bytes_.size() - pos_) {
+            throw std::runtime_error("二进制场景文件已截断");
+        }
+        std::memcpy(out, bytes_.data() + pos_, size);
+        pos_ += size;
+    }
+    size_t position() const { return pos_; }
+
+private:
+    const std::string& bytes_;
+    size_t pos_;
+};
+
+/**
+ * @brief 场景内容的规范化编码 (不含名称和哈希本身)
+ */
+std::string encode_body(const Scenario& scenario) {
+    ByteWriter w;
+    const PhysicalConstants& p = scenario.physics;
+    for (double v : {p.g, p.cloud_sink_speed, p.cloud_radius, p.cloud_duration,
+                     p.uav_speed_min, p.uav_speed_max, p.grenade_interval,
+                     p.grenade_mass, p.grenade_drag_factor}) {
+        w.f64(v);
+    }
+
+    w.vec3(scenario.target.center_bottom);
+    w.f64(scenario.target.radius);
+    w.f64(scenario.target.height);
+
+    const auto& entities = scenario.entities;
+    w.u32(entities.num_missiles());
+    for (int i = 0; i < entities.num_missiles(); ++i) {
+        const auto& m = entities.missile(i);
+        w.str(m.id);
+        w.vec3(m.start_pos);
+        w.f64(m.speed);
+        w.vec3(m.target);
+    }
+    w.u32(entities.num_uavs());
+    for (int i = 0; i < entities.num_uavs(); ++i) {
+        const auto& u = entities.uav(i);
+        w.str(u.id);
+        w.vec3(u.start_pos);
+        w.u32(u.grenade_budget);
+    }
+    return w.bytes();
+}
+
+uint64_t fnv1a(const std::string& bytes) {
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (unsigned char c : bytes) {
+        hash ^= c;
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
+std::string format_vector(const Vector3d& v) {
+    return "[" + MiniJson::format_number(v.x()) + ", " + MiniJson::format_number(v.y()) + ", " + MiniJson::format_number(v.z()) + "]";
+}
+
+Scenario& active_storage() {
+    static Scenario scenario = from_config();
+    return scenario;
+}
+
+} // namespace
+
+Scenario from_config() {
+    Scenario scenario;
+    scenario.name = "config";
+    scenario.target = Config::TRUE_TARGET_SPECS;
+    scenario.entities = Registry::EntityRegistry::from_config();
+    scenario.content_hash = compute_content_hash(scenario);
+    return scenario;
+}
+
+Scenario parse_json(const std::string& text) {
+    MiniJson::Value root = MiniJson::parse(text, "场景文件");
+    if (root.type != MiniJson::Type::OBJECT) {
+        throw std::runtime_error("场景文件顶层应为对象");
+    }
+
+    Scenario scenario;
+    if (const MiniJson::Value* name = root.find("name")) {
+        scenario.name = get_string(*name, "name");
+    }
+
+    if (const MiniJson::Value* physics = root.find("physics")) {
+        PhysicalConstants& p = scenario.physics;
+        read_optional(*physics, "g", p.g);
+        read_optional(*physics, "cloud_sink_speed", p.cloud_sink_speed);
+        read_optional(*physics, "cloud_radius", p.cloud_radius);
+        read_optional(*physics, "cloud_duration", p.cloud_duration);
+        read_optional(*physics, "uav_speed_min", p.uav_speed_min);
+        read_optional(*physics, "uav_speed_max", p.uav_speed_max);
+        read_optional(*physics, "grenade_interval", p.grenade_interval);
+        read_optional(*physics, "grenade_mass", p.grenade_mass);
+        read_optional(*physics, "grenade_drag_factor", p.grenade_drag_factor);
+    }
+
+    if (const MiniJson::Value* target = root.find("target")) {
+        scenario.target.center_bottom = get_vector(require(*target, "center_bottom", "target"), "target.center_bottom");
+        scenario.target.radius = get_number(require(*target, "radius", "target"), "target.radius");
+        scenario.target.height = get_number(require(*target, "height", "target"), "target.height");
+    }
+
+    const MiniJson::Value& missiles = require(root, "missiles", "scenario");
+    if (missiles.type != MiniJson::Type::ARRAY) {
+        throw std::runtime_error("场景字段 missiles 应为数组");
+    }
+    for (const auto& m : missiles.array) {
+        std::string id = get_string(require(m, "id", "missiles[]"), "missiles[].id");
+        if (scenario.entities.missile_index(id) != Registry::INVALID_INDEX) {
+            throw std::runtime_error("导弹ID重复: " + id);
+        }
+        scenario.entities.add_missile(id,
+                                      get_vector(require(m, "pos", id), id + ".pos"),
+                                      get_number(require(m, "speed", id), id + ".speed"),
+                                      get_vector(require(m, "target", id), id + ".target"));
+    }
+
+    const MiniJson::Value& uavs = require(root, "uavs", "scenario");
+    if (uavs.type != MiniJson::Type::ARRAY) {
+        throw std::runtime_error("场景字段 uavs 应为数组");
+    }
+    for (const auto& u : uavs.array) {
+        std::string id = get_string(require(u, "id", "uavs[]"), "uavs[].id");
+        if (scenario.entities.uav_index(id) != Registry::INVALID_INDEX) {
+            throw std::runtime_error("无人机ID重复: " + id);
+        }
+        int budget = Config::MAX_GRENADES_PER_UAV;
+        if (const MiniJson::Value* grenades = u.find("grenades")) {
+            double value = get_number(*grenades, id + ".grenades");
+            if (value != std::floor(value)) {
+                throw std::runtime_error("弹药预算应为整数: " + id);
+            }
+            budget = static_cast<int>(value);
+        }
+        scenario.entities.add_uav(id, get_vector(require(u, "pos", id), id + ".pos"), budget);
+    }
+
+    validate(scenario);
+    scenario.content_hash = compute_content_hash(scenario);
+    return scenario;
+}
+
+std::string to_json(const Scenario& scenario) {
+    const PhysicalConstants& p = scenario.physics;
+    std::ostringstream out;
+    out << "{\n";
+    out << "  \"name\": \"" << MiniJson::escape(scenario.name) << "\",\n";
+    out << "  \"physics\": {\n"
+        << "    \"g\": " << MiniJson::format_number(p.g) << ",\n"
+        << "    \"cloud_sink_speed\": " << MiniJson::format_number(p.cloud_sink_speed) << ",\n"
+        << "    \"cloud_radius\": " << MiniJson::format_number(p.cloud_radius) << ",\n"
+        << "    \"cloud_duration\": " << MiniJson::format_number(p.cloud_duration) << ",\n"
+        << "    \"uav_speed_min\": " << MiniJson::format_number(p.uav_speed_min) << ",\n"
+        << "    \"uav_speed_max\": " << MiniJson::format_number(p.uav_speed_max) << ",\n"
+        << "    \"grenade_interval\": " << MiniJson::format_number(p.grenade_interval) << ",\n"
+        << "    \"grenade_mass\": " << MiniJson::format_number(p.grenade_mass) << ",\n"
+        << "    \"grenade_drag_factor\": " << MiniJson::format_number(p.grenade_drag_factor) << "\n"
+        << "  },\n";
+    out << "  \"target\": {\"center_bottom\": " << format_vector(scenario.target.center_bottom)
+        << ", \"radius\": " << MiniJson::format_number(scenario.target.radius)
+        << ", \"height\": " << MiniJson::format_number(scenario.target.height) << "},\n";
+
+    const auto& entities = scenario.entities;
+    out << "  \"missiles\": [\n";
+    for (int i = 0; i < entities.num_missiles(); ++i) {
+        const auto& m = entities.missile(i);
+        out << "    {\"id\": \"" << MiniJson::escape(m.id) << "\", \"pos\": " << format_vector(m.start_pos)
+            << ", \"speed\": " << MiniJson::format_number(m.speed) << ", \"target\": " << format_vector(m.target) << "}"
+            << (i + 1 < entities.num_missiles() ? "," : "") << "\n";
+    }
+    out << "  ],\n";
+    out << "  \"uavs\": [\n";
+    for (int i = 0; i < entities.num_uavs(); ++i) {
+        const auto& u = entities.uav(i);
+        out << "    {\"id\": \"" << MiniJson::escape(u.id) << "\", \"pos\": " << format_vector(u.start_pos)
+            << ", \"grenades\": " << u.grenade_budget << "}"
+            << (i + 1 < entities.num_uavs() ? "," : "") << "\n";
+    }
+    out << "  ]\n";
+    out << "}\n";
+    return out.str();
+}
+
+std::string to_binary(const Scenario& scenario) {
+    ByteWriter w;
+    w.raw(BINARY_MAGIC, sizeof(BINARY_MAGIC));
+    w.u32(BINARY_VERSION);
+    w.u64(compute_content_hash(scenario));
+    w.str(scenario.name);
+    std::string body = encode_body(scenario);
+    w.raw(body.data(), body.size());
+    return w.bytes();
+}
+
+Scenario parse_binary(const std::string& bytes) {
+    if (bytes.size() < sizeof(BINARY_MAGIC) || std::memcmp(bytes.data(), BINARY_MAGIC, sizeof(BINARY_MAGIC)) != 0) {
+        throw std::runtime_error("不是二进制场景文件");
+    }
+
+    ByteReader r(bytes, sizeof(BINARY_MAGIC));
+    uint32_t version = r.u32();
+    if (version != BINARY_VERSION) {
+        throw std::runtime_error("不支持的二进制场景版本: " + std::to_string(version));
+    }
+    uint64_t stored_hash = r.u64();
+
+    Scenario scenario;
+    scenario.name = r.str();
+
+    PhysicalConstants& p = scenario.physics;
+    for (double* field : {&p.g, &p.cloud_sink_speed, &p.cloud_radius, &p.cloud_duration,
+                          &p.uav_speed_min, &p.uav_speed_max, &p.grenade_interval,
+                          &p.grenade_mass, &p.grenade_drag_factor}) {
+        *field = r.f64();
+    }
+
+    scenario.target.center_bottom = r.vec3();
+    scenario.target.radius = r.f64();
+    scenario.target.height = r.f64();
+
+    uint32_t num_missiles = r.u32();
+    for (uint32_t i = 0; i < num_missiles; ++i) {
+        std::string id = r.str();
+        if (scenario.entities.missile_index(id) != Registry::INVALID_INDEX) {
+            throw std::runtime_error("导弹ID重复: " + id);
+        }
+        Vector3d pos = r.vec3();
+        double speed = r.f64();
+        Vector3d target = r.vec3();
+        scenario.entities.add_missile(id, pos, speed, target);
+    }
+    uint32_t num_uavs = r.u32();
+    for (uint32_t i = 0; i < num_uavs; ++i) {
+        std::string id = r.str();
+        if (scenario.entities.uav_index(id) != Registry::INVALID_INDEX) {
+            throw std::runtime_error("无人机ID重复: " + id);
+        }
+        Vector3d pos = r.vec3();
+        int budget = static_cast<int>(r.u32());
+        scenario.entities.add_uav(id, pos, budget);
+    }
+
+    if (r.position() != bytes.size()) {
+        throw std::runtime_error("二进制场景文件结尾有多余数据");
+    }
+
+    validate(scenario);
+    scenario.content_hash = compute_content_hash(scenario);
+    if (scenario.content_hash != stored_hash) {
+        throw std::runtime_error("二进制场景文件哈希校验失败");
+    }
+    return scenario;
+}
+
+Scenario load_file(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("无法打开场景文件: " + path);
+    }
+    std::string bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    if (bytes.size() >= sizeof(BINARY_MAGIC) && std::memcmp(bytes.data(), BINARY_MAGIC, sizeof(BINARY_MAGIC)) == 0) {
+        return parse_binary(bytes);
+    }
+    return parse_json(bytes);
+}
+
+void save_file(const Scenario& scenario, const std::string& path, bool binary) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("无法写入场景文件: " + path);
+    }
+    std::string bytes = binary ? to_binary(scenario) : to_json(scenario);
+    file.write(bytes.data(), bytes.size());
+    if (!file) {
+        throw std::runtime_error("写入场景文件失败: " + path);
+    }
+}
+
+uint64_t compute_content_hash(const Scenario& scenario) {
+    return fnv1a(encode_body(scenario));
+}
+
+void validate(const Scenario& scenario) {
+    const PhysicalConstants& p = scenario.physics;
+    for (double v : {p.g, p.cloud_sink_speed, p.cloud_radius, p.cloud_duration, p.uav_speed_min,
+                     p.uav_speed_max, p.grenade_interval, p.grenade_mass, p.grenade_drag_factor}) {
+        if (!is_finite_bits(v)) {
+            throw std::runtime_error("场景物理常量含非有限值");
+        }
+    }
+    if (p.cloud_radius <= 0.0 || p.cloud_duration <= 0.0 || p.grenade_mass <= 0.0) {
+        throw std::runtime_error("云团半径、持续时间和弹药质量必须为正");
+    }
+    if (p.uav_speed_min <= 0.0 || p.uav_speed_min > p.uav_speed_max) {
+        throw std::runtime_error("无人机速度范围无效");
+    }
+    const Config::TargetSpecs& target = scenario.target;
+    if (!is_finite_bits(target.center_bottom) || !is_finite_bits(target.radius) || !is_finite_bits(target.height)) {
+        throw std::runtime_error("目标几何含非有限值");
+    }
+    if (scenario.target.radius <= 0.0 || scenario.target.height <= 0.0) {
+        throw std::runtime_error("目标半径和高度必须为正");
+    }
+
+    const auto& entities = scenario.entities;
+    if (entities.num_missiles() == 0 || entities.num_uavs() == 0) {
+        throw std::runtime_error("场景至少需要一枚导弹和一架无人机");
+    }
+    for (int i = 0; i < entities.num_missiles(); ++i) {
+        const auto& m = entities.missile(i);
+        if (!is_finite_bits(m.start_pos) || !is_finite_bits(m.speed) || !is_finite_bits(m.target)) {
+            throw std::runtime_error("导弹 " + m.id + " 的位置、速度或瞄准点含非有限值");
+        }
+        if (m.speed <= 0.0 || (m.target - m.start_pos).norm() <= 0.0) {
+            throw std::runtime_error("导弹 " + m.id + " 的速度或航向无效");
+        }
+    }
+    for (int i = 0; i < entities.num_uavs(); ++i) {
+        const auto& u = entities.uav(i);
+        if (!is_finite_bits(u.start_pos)) {
+            throw std::runtime_error("无人机 " + u.id + " 的位置含非有限值");
+        }
+        if (u.grenade_budget < 0 || u.grenade_budget > Config::MAX_GRENADES_PER_UAV) {
+            throw std::runtime_error("无人机 " + u.id + " 的弹药预算超出 [0, " +
+                                     std::to_string(Config::MAX_GRENADES_PER_UAV) + "]");
+        }
+    }
+}
+
+const Scenario& active() {
+    return active_storage();
+}
+
+void set_active(const Scenario& scenario) {
+    validate(scenario);
+    Scenario& storage = active_storage();
+    storage = scenario;
+    storage.content_hash = compute_content_hash(storage);
+}
+
+} // namespace ScenarioLoader
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <Eigen/Dense>
+#include "config.hpp"
+#include "entity_registry.hpp"
+
+using Vector3d = Eigen::Vector3d;
+
+namespace ScenarioLoader {
+
+/**
+ * @brief 场景的物理常量 (默认值取自 Config)
+ */
+struct PhysicalConstants {
+    double g = Config::G;
+    double cloud_sink_speed = Config::CLOUD_SINK_SPEED;
+    double cloud_radius = Config::CLOUD_RADIUS;
+    double cloud_duration = Config::CLOUD_DURATION;
+    double uav_speed_min = Config::UAV_SPEED_MIN;
+    double uav_speed_max = Config::UAV_SPEED_MAX;
+    double grenade_interval = Config::GRENADE_INTERVAL;
+    double grenade_mass = Config::GRENADE_MASS;
+    double grenade_drag_factor = Config::GRENADE_DRAG_FACTOR;
+};
+
+/**
+ * @brief 运行时场景：实体表、物理常量、目标几何与每机弹药预算
+ *
+ * 实体在注册表中的索引即其在场景文件中的出现顺序。
+ * content_hash 由场景内容 (规范化二进制编码) 计算，可作为缓存键。
+ */
+struct Scenario {
+    std::string name = "default";
+    PhysicalConstants physics;
+    Config::TargetSpecs target;
+    Registry::EntityRegistry entities;
+    uint64_t content_hash = 0;
+};
+
+/**
+ * @brief 由编译期 Config 构建的默认场景 (实体按ID排序)
+ */
+Scenario from_config();
+
+/**
+ * @brief 解析 JSON 场景文本，格式错误或数据无效时抛出 std::runtime_error
+ */
+Scenario parse_json(const std::string& text);
+
+/**
+ * @brief 输出 JSON 场景文本 (浮点数按可往返精度输出)
+ */
+std::string to_json(const Scenario& scenario);
+
+/**
+ * @brief 紧凑二进制编码 (小端)，文件头含魔数、版本与内容哈希
+ */
+std::string to_binary(const Scenario& scenario);
+Scenario parse_binary(const std::string& bytes);
+
+/**
+ * @brief 读取场景文件，按文件头自动识别二进制或 JSON 格式
+ */
+Scenario load_file(const std::string& path);
+
+/**
+ * @brief 写出场景文件，binary 为 false 时写 JSON
+ */
+void save_file(const Scenario& scenario, const std::string& path, bool binary);
+
+/**
+ * @brief 计算场景内容哈希 (FNV-1a 64)，与名称无关
+ */
+uint64_t compute_content_hash(const Scenario& scenario);
+
+/**
+ * @brief 检查场景数据是否自洽，无效时抛出 std::runtime_error
+ */
+void validate(const Scenario& scenario);
+
+/**
+ * @brief 当前生效的场景，未设置时为 from_config()
+ *
+ * 所有求解器通过它读取实体表和常量。
+ */
+const Scenario& active();
+
+/**
+ * @brief 替换当前场景 (必须在创建任何求解器之前、单线程调用)
+ */
+void set_active(const Scenario& scenario);
+
+} // namespace ScenarioLoader
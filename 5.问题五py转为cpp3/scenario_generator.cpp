@@ -0,0 +1,90 @@
+#include "scenario_generator.hpp"
+#include "counter_rng.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace ScenarioGenerator {
+
+namespace {
+
+// 随机流编号：实体序号作为流，子流区分实体种类
+constexpr uint32_t AIM_SUBSTREAM = 1;
+constexpr uint32_t MISSILE_SUBSTREAM = 2;
+constexpr uint32_t UAV_SUBSTREAM = 3;
+
+std::string make_id(const char* prefix, int index, int count) {
+    // 补零到相同宽度，使按ID排序与生成顺序一致
+    std::string number = std::to_string(index + 1);
+    std::string width = std::to_string(count);
+    return prefix + std::string(width.size() - number.size(), '0') + number;
+}
+
+} // namespace
+
+ScenarioLoader::Scenario generate(const GeneratorSettings& settings) {
+    if (settings.num_missiles <= 0 || settings.num_uavs <= 0 || settings.num_aim_points <= 0) {
+        throw std::invalid_argument("导弹、无人机和瞄准点数量必须为正");
+    }
+
+    ScenarioLoader::Scenario scenario;
+    scenario.name = "synthetic-m" + std::to_string(settings.num_missiles) +
+                    "-u" + std::to_string(settings.num_uavs) +
+                    "-t" + std::to_string(settings.num_aim_points) +
+                    "-s" + std::to_string(settings.seed);
+    scenario.target = Config::TRUE_TARGET_SPECS;
+
+    // 瞄准点：第一个为原点 (与题目的假目标一致)，其余均匀分布在圆环上并加随机扰动
+    std::vector<Vector3d> aim_points;
+    for (int k = 0; k < settings.num_aim_points; ++k) {
+        if (k == 0) {
+            aim_points.emplace_back(0.0, 0.0, 0.0);
+            continue;
+        }
+        CounterRNG::CounterRng rng(settings.seed, k, AIM_SUBSTREAM);
+        double angle = 2.0 * M_PI * (k - 1) / std::max(1, settings.num_aim_points - 1) + rng.uniform(-0.2, 0.2);
+        double radius = settings.aim_ring_radius * rng.uniform(0.5, 1.0);
+        aim_points.emplace_back(radius * std::cos(angle), radius * std::sin(angle), 0.0);
+    }
+
+    // 导弹：从 +x 方向远处来袭，轮流瞄准各瞄准点
+    for (int i = 0; i < settings.num_missiles; ++i) {
+        CounterRNG::CounterRng rng(settings.seed, i, MISSILE_SUBSTREAM);
+        const Vector3d& aim = aim_points[i % settings.num_aim_points];
+        double range = rng.uniform(settings.missile_range_min, settings.missile_range_max);
+        double bearing = rng.uniform(-settings.missile_bearing_spread, settings.missile_bearing_spread);
+        double altitude = rng.uniform(settings.missile_altitude_min, settings.missile_altitude_max);
+        double speed = rng.uniform(settings.missile_speed_min, settings.missile_speed_max);
+
+        Vector3d start = aim + Vector3d(range * std::cos(bearing), range * std::sin(bearing), altitude);
+        scenario.entities.add_missile(make_id("M", i, settings.num_missiles), start, speed, aim);
+    }
+
+    // 无人机：沿某枚导弹的来袭走廊 (水平投影) 分布，横向偏移在走廊半宽以内
+    for (int j = 0; j < settings.num_uavs; ++j) {
+        CounterRNG::CounterRng rng(settings.seed, j, UAV_SUBSTREAM);
+        const auto& missile = scenario.entities.missile(j % settings.num_missiles);
+
+        Vector3d path = missile.target - missile.start_pos;
+        path.z() = 0.0;
+        Vector3d lateral(-path.y(), path.x(), 0.0);
+        lateral.normalize();
+
+        double fraction = rng.uniform(settings.corridor_fraction_min, settings.corridor_fraction_max);
+        double offset = rng.uniform(-settings.corridor_half_width, settings.corridor_half_width);
+        double altitude = rng.uniform(settings.uav_altitude_min, settings.uav_altitude_max);
+        int budget = 1 + static_cast<int>(rng.uniform() * Config::MAX_GRENADES_PER_UAV);
+
+        Vector3d pos = missile.start_pos + fraction * path + offset * lateral;
+        pos.z() = altitude;
+        scenario.entities.add_uav(make_id("FY", j, settings.num_uavs), pos, budget);
+    }
+
+    ScenarioLoader::validate(scenario);
+    scenario.content_hash = ScenarioLoader::compute_content_hash(scenario);
+    return scenario;
+}
+
+} // namespace ScenarioGenerator
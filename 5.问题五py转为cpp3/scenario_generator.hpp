@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include "scenario.hpp"
+
+namespace ScenarioGenerator {
+
+/**
+ * @brief 合成场景的规模与几何参数 (距离单位 m，默认值仿照题目数据)
+ */
+struct GeneratorSettings {
+    int num_missiles = 10;
+    int num_uavs = 20;
+    int num_aim_points = 2;             // 导弹瞄准的假目标点数 (第一个位于原点)
+    uint64_t seed = 20240907;
+
+    double aim_ring_radius = 2000.0;    // 其余瞄准点分布在原点周围的圆环上
+    double missile_range_min = 17000.0;
+    double missile_range_max = 21000.0;
+    double missile_bearing_spread = 0.15;  // 来袭方位角相对 +x 轴的最大偏差 (rad)
+    double missile_altitude_min = 1800.0;
+    double missile_altitude_max = 2200.0;
+    double missile_speed_min = 280.0;
+    double missile_speed_max = 320.0;
+
+    double corridor_fraction_min = 0.3; // 无人机沿来袭走廊的位置 (导弹到瞄准点的比例)
+    double corridor_fraction_max = 0.9;
+    double corridor_half_width = 3000.0;
+    double uav_altitude_min = 700.0;
+    double uav_altitude_max = 1800.0;
+};
+
+/**
+ * @brief 生成几何上合理的合成场景
+ *
+ * 导弹从远处汇聚到各瞄准点，无人机分布在各导弹的来袭走廊两侧，弹药预算在
+ * [1, MAX_GRENADES_PER_UAV] 中随机。每个实体使用独立的计数器随机流，
+ * 同一种子下增加实体数量不会改变已有实体的随机抽样，便于做规模对比。
+ * 物理常量和受保护目标取默认值。
+ */
+ScenarioLoader::Scenario generate(const GeneratorSettings& settings);
+
+} // namespace ScenarioGenerator
@@ -0,0 +1,80 @@
+#include "scenario.hpp"
+#include "scenario_generator.hpp"
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+namespace {
+
+void print_usage() {
+    std::cout << "用法:\n"
+              << "  scenario_tool export <输出文件> [--binary]     导出编译期默认场景\n"
+              << "  scenario_tool convert <输入> <输出> [--binary]  JSON 与二进制互转\n"
+              << "  scenario_tool info <场景文件>                   打印场景摘要与内容哈希\n"
+              << "  scenario_tool generate <输出文件> <导弹数> <无人机数> [瞄准点数] [种子] [--binary]\n"
+              << "                                                  生成合成场景" << std::endl;
+}
+
+void print_info(const ScenarioLoader::Scenario& scenario) {
+    const auto& entities = scenario.entities;
+    std::cout << "场景: " << scenario.name << std::endl;
+    std::cout << "内容哈希: " << std::hex << std::setw(16) << std::setfill('0')
+              << scenario.content_hash << std::dec << std::setfill(' ') << std::endl;
+    std::cout << "导弹 " << entities.num_missiles() << " 枚, 无人机 " << entities.num_uavs() << " 架" << std::endl;
+
+    int total_grenades = 0;
+    for (int i = 0; i < entities.num_uavs(); ++i) {
+        total_grenades += entities.uav(i).grenade_budget;
+    }
+    std::cout << "弹药总预算 " << total_grenades << " 枚, 速度范围 ["
+              << scenario.physics.uav_speed_min << ", " << scenario.physics.uav_speed_max << "] m/s" << std::endl;
+}
+
+} // namespace
+
+/**
+ * @brief 场景文件工具：导出、格式转换与查看
+ */
+int main(int argc, char* argv[]) {
+    try {
+        if (argc < 3) {
+            print_usage();
+            return 1;
+        }
+
+        std::string command = argv[1];
+        bool binary = std::string(argv[argc - 1]) == "--binary";
+
+        if (command == "export") {
+            auto scenario = ScenarioLoader::from_config();
+            ScenarioLoader::save_file(scenario, argv[2], binary);
+            print_info(scenario);
+        } else if (command == "convert" && argc >= 4) {
+            auto scenario = ScenarioLoader::load_file(argv[2]);
+            ScenarioLoader::save_file(scenario, argv[3], binary);
+            print_info(scenario);
+        } else if (command == "generate" && argc >= 5) {
+            ScenarioGenerator::GeneratorSettings settings;
+            settings.num_missiles = std::stoi(argv[3]);
+            settings.num_uavs = std::stoi(argv[4]);
+            if (argc > 5 && std::string(argv[5]) != "--binary") {
+                settings.num_aim_points = std::stoi(argv[5]);
+            }
+            if (argc > 6 && std::string(argv[6]) != "--binary") {
+                settings.seed = std::stoull(argv[6]);
+            }
+            auto scenario = ScenarioGenerator::generate(settings);
+            ScenarioLoader::save_file(scenario, argv[2], binary);
+            print_info(scenario);
+        } else if (command == "info") {
+            print_info(ScenarioLoader::load_file(argv[2]));
+        } else {
+            print_usage();
+            return 1;
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "场景工具出错: " << e.what() << std::endl;
+        return 1;
+    }
+}
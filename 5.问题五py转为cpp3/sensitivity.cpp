@@ -0,0 +1,217 @@
+#include "sensitivity.hpp"
+#include "counter_rng.hpp"
+#include "work_pool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+namespace Sensitivity {
+
+namespace {
+
+// Sobol 样本矩阵 A、B 的子流
+constexpr uint32_t SOBOL_A = 0;
+constexpr uint32_t SOBOL_B = 1;
+
+/**
+ * @brief 单位超立方体中的样本点 (每行一个点)，评估前映射到区间
+ */
+struct Design {
+    int dimension;
+    std::vector<double> unit;
+
+    Design(int dimension, size_t rows) : dimension(dimension), unit(rows * dimension) {}
+
+    double* row(size_t i) { return unit.data() + i * dimension; }
+    size_t rows() const { return unit.size() / dimension; }
+};
+
+std::vector<double> evaluate(const Objective& objective, const Design& design,
+                             const Eigen::VectorXd& lower, const Eigen::VectorXd& upper, int num_threads) {
+    const Eigen::VectorXd width = upper - lower;
+    std::vector<double> values(design.rows());
+    WorkPool::Pool::global().parallel_for(static_cast<int>(design.rows()), [&](int i) {
+        Eigen::VectorXd x(design.dimension);
+        const double* u = design.unit.data() + static_cast<size_t>(i) * design.dimension;
+        for (int k = 0; k < design.dimension; ++k) {
+            x[k] = lower[k] + u[k] * width[k];
+        }
+        values[i] = objective(x);
+    }, num_threads);
+    return values;
+}
+
+void record_best(const std::vector<double>& values, const Design& design,
+                 const Eigen::VectorXd& lower, const Eigen::VectorXd& upper, Analysis& analysis) {
+    const size_t best = std::min_element(values.begin(), values.end()) - values.begin();
+    analysis.best_value = values[best];
+    analysis.best_point.resize(design.dimension);
+    for (int k = 0; k < design.dimension; ++k) {
+        analysis.best_point[k] = lower[k] + design.unit[best * design.dimension + k] * (upper[k] - lower[k]);
+    }
+    analysis.evaluations = static_cast<long long>(values.size());
+}
+
+void normalize(const std::vector<double>& score, Analysis& analysis) {
+    const double total = std::accumulate(score.begin(), score.end(), 0.0);
+    analysis.importance.assign(score.size(), 0.0);
+    if (total > 0.0) {
+        for (size_t k = 0; k < score.size(); ++k) {
+            analysis.importance[k] = std::max(0.0, score[k]) / total;
+        }
+    }
+}
+
+// 每条轨迹从网格点出发，按随机顺序每次只改变一个变量 ±delta
+Analysis morris(const Objective& objective, const Eigen::VectorXd& lower, const Eigen::VectorXd& upper,
+                const AnalysisSettings& settings) {
+    const int dim = static_cast<int>(lower.size());
+    const int r = settings.samples;
+    const int p = settings.levels;
+    if (p < 2 || p % 2 != 0) {
+        throw std::invalid_argument("Morris 网格层数须为不小于 2 的偶数");
+    }
+    const double delta = p / (2.0 * (p - 1));
+
+    Design design(dim, static_cast<size_t>(r) * (dim + 1));
+    std::vector<int> moved(static_cast<size_t>(r) * dim);       // 第 t 条轨迹第 s 步改变的变量
+    std::vector<double> step(static_cast<size_t>(r) * dim);     // 及其步长 (±delta)
+    std::vector<int> order(dim);
+    for (int t = 0; t < r; ++t) {
+        CounterRNG::CounterRng rng(settings.seed, static_cast<uint64_t>(t));
+        double* x = design.row(static_cast<size_t>(t) * (dim + 1));
+        for (int k = 0; k < dim; ++k) {
+            x[k] = static_cast<double>(rng.uniform_int(static_cast<uint32_t>(p))) / (p - 1);
+        }
+        std::iota(order.begin(), order.end(), 0);
+        for (int k = dim - 1; k > 0; --k) {
+            std::swap(order[k], order[rng.uniform_int(static_cast<uint32_t>(k + 1))]);
+        }
+        for (int s = 0; s < dim; ++s) {
+            double* next = x + dim;
+            std::copy(x, x + dim, next);
+            const int k = order[s];
+            const double h = x[k] + delta <= 1.0 + 1e-12 ? delta : -delta;
+            next[k] = x[k] + h;
+            moved[static_cast<size_t>(t) * dim + s] = k;
+            step[static_cast<size_t>(t) * dim + s] = h;
+            x = next;
+        }
+    }
+
+    const std::vector<double> values = evaluate(objective, design, lower, upper, settings.num_threads);
+
+    Analysis analysis;
+    analysis.mu_star.assign(dim, 0.0);
+    analysis.sigma.assign(dim, 0.0);
+    std::vector<double> mean(dim, 0.0);
+    std::vector<double> square(dim, 0.0);
+    for (int t = 0; t < r; ++t) {
+        for (int s = 0; s < dim; ++s) {
+            const size_t i = static_cast<size_t>(t) * (dim + 1) + s;
+            const int k = moved[static_cast<size_t>(t) * dim + s];
+            const double effect = (values[i + 1] - values[i]) / step[static_cast<size_t>(t) * dim + s];
+            analysis.mu_star[k] += std::abs(effect) / r;
+            mean[k] += effect / r;
+            square[k] += effect * effect / r;
+        }
+    }
+    for (int k = 0; k < dim; ++k) {
+        const double variance = r > 1 ? (square[k] - mean[k] * mean[k]) * r / (r - 1) : 0.0;
+        analysis.sigma[k] = std::sqrt(std::max(0.0, variance));
+    }
+
+    normalize(analysis.mu_star, analysis);
+    record_best(values, design, lower, upper, analysis);
+    return analysis;
+}
+
+// 样本矩阵 A、B 和 D 个 AB_k (A 的第 k 列换成 B 的第 k 列)
+Analysis sobol(const Objective& objective, const Eigen::VectorXd& lower, const Eigen::VectorXd& upper,
+               const AnalysisSettings& settings) {
+    const int dim = static_cast<int>(lower.size());
+    const size_t n = static_cast<size_t>(settings.samples);
+
+    Design design(dim, n * (dim + 2));
+    for (size_t j = 0; j < n; ++j) {
+        CounterRNG::CounterRng rng_a(settings.seed, j, SOBOL_A);
+        CounterRNG::CounterRng rng_b(settings.seed, j, SOBOL_B);
+        double* a = design.row(j);
+        double* b = design.row(n + j);
+        for (int k = 0; k < dim; ++k) {
+            a[k] = rng_a.uniform();
+            b[k] = rng_b.uniform();
+        }
+        for (int k = 0; k < dim; ++k) {
+            double* ab = design.row((2 + k) * n + j);
+            std::copy(a, a + dim, ab);
+            ab[k] = b[k];
+        }
+    }
+
+    const std::vector<double> values = evaluate(objective, design, lower, upper, settings.num_threads);
+    const double* f_a = values.data();
+    const double* f_b = values.data() + n;
+
+    double mean = 0.0;
+    for (size_t j = 0; j < 2 * n; ++j) {
+        mean += values[j] / (2 * n);
+    }
+    double variance = 0.0;
+    for (size_t j = 0; j < 2 * n; ++j) {
+        variance += (values[j] - mean) * (values[j] - mean) / (2 * n);
+    }
+
+    Analysis analysis;
+    analysis.first_order.assign(dim, 0.0);
+    analysis.total_order.assign(dim, 0.0);
+    if (variance > 0.0) {
+        for (int k = 0; k < dim; ++k) {
+            const double* f_ab = values.data() + (2 + k) * n;
+            double first = 0.0;
+            double total = 0.0;
+            for (size_t j = 0; j < n; ++j) {
+                first += f_b[j] * (f_ab[j] - f_a[j]);
+                total += (f_a[j] - f_ab[j]) * (f_a[j] - f_ab[j]);
+            }
+            analysis.first_order[k] = first / n / variance;
+            analysis.total_order[k] = 0.5 * total / n / variance;
+        }
+    }
+
+    normalize(analysis.total_order, analysis);
+    record_best(values, design, lower, upper, analysis);
+    return analysis;
+}
+
+} // namespace
+
+std::vector<int> Analysis::inert_variables(double threshold) const {
+    std::vector<int> inert;
+    const double total = std::accumulate(importance.begin(), importance.end(), 0.0);
+    if (total <= 0.0) {
+        return inert;   // 目标在区间内为常数，无法区分
+    }
+    const double mean = total / importance.size();
+    for (size_t k = 0; k < importance.size(); ++k) {
+        if (importance[k] < threshold * mean) {
+            inert.push_back(static_cast<int>(k));
+        }
+    }
+    return inert;
+}
+
+Analysis analyze(const Objective& objective, const Eigen::VectorXd& lower, const Eigen::VectorXd& upper,
+                 const AnalysisSettings& settings) {
+    if (lower.size() == 0 || lower.size() != upper.size()) {
+        throw std::invalid_argument("敏感性分析的上下界维度无效");
+    }
+    if (settings.samples < 1) {
+        throw std::invalid_argument("敏感性分析的样本数须为正数");
+    }
+    return settings.method == Method::MORRIS ? morris(objective, lower, upper, settings)
+                                             : sobol(objective, lower, upper, settings);
+}
+
+} // namespace Sensitivity
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include <Eigen/Dense>
+
+/**
+ * @brief 目标函数的全局敏感性分析 (Morris 基本效应筛选与 Sobol 方差分解)
+ *
+ * 样本点先全部生成，再在进程级线程池上并行评估；抽样只由种子和样本序号决定，结果与线程数无关。
+ * 问题5的决策空间中随机策略几乎都没有遮蔽 (目标值为零)，在整个边界上分析得不到信息，
+ * 应在已有较优解附近的子区间内分析 (见 ReductionSettings)。
+ */
+namespace Sensitivity {
+
+using Objective = std::function<double(const Eigen::VectorXd&)>;
+
+enum class Method {
+    MORRIS,     // 基本效应：r 条单因子轨迹，r(D+1) 次评估，重要性取 mu* (基本效应绝对值的均值)
+    SOBOL       // Saltelli 抽样：N(D+2) 次评估，重要性取总效应指数 (Jansen 估计)
+};
+
+/**
+ * @brief 分析参数
+ */
+struct AnalysisSettings {
+    Method method = Method::MORRIS;
+    int samples = 20;           // Morris 轨迹数或 Sobol 基本样本数 N
+    int levels = 4;             // Morris 网格层数 (偶数)，步长为 levels / (2 (levels - 1))
+    uint64_t seed = 1;
+    int num_threads = -1;       // -1表示使用所有可用线程
+};
+
+/**
+ * @brief 分析结果 (各向量按决策变量下标)
+ */
+struct Analysis {
+    std::vector<double> importance;     // 归一化重要性，总和为 1 (目标在区间内为常数时全为 0)
+    std::vector<double> mu_star;        // Morris：基本效应绝对值的均值 (按区间宽度归一化的坐标)
+    std::vector<double> sigma;          // Morris：基本效应的标准差 (非线性或交互作用)
+    std::vector<double> first_order;    // Sobol：一阶指数
+    std::vector<double> total_order;    // Sobol：总效应指数
+    Eigen::VectorXd best_point;         // 样本中目标值最小的点
+    double best_value = 0.0;
+    long long evaluations = 0;
+
+    /**
+     * @brief 重要性低于 threshold 倍平均值 (1/D) 的变量下标
+     */
+    std::vector<int> inert_variables(double threshold) const;
+};
+
+/**
+ * @brief 在区间 [lower, upper] 内分析 objective (目标函数须可并行调用)
+ */
+Analysis analyze(const Objective& objective, const Eigen::VectorXd& lower, const Eigen::VectorXd& upper,
+                 const AnalysisSettings& settings = AnalysisSettings());
+
+/**
+ * @brief 低重要性变量的处理方式
+ */
+enum class ReductionMode {
+    FREEZE,     // 固定为试探阶段最优解的取值，降维阶段只搜索其余变量
+    COARSEN     // 仍参与搜索，但评估前取整到局部区间内 coarse_levels 个等距值
+};
+
+/**
+ * @brief 分阶段降维的差分进化参数 (见 Optimizer::DifferentialEvolution::optimize_reduced)
+ *
+ * 总代数仍为 DESettings::max_iterations：先全维试探 pilot_fraction，再在试探最优解附近
+ * (每维 ± local_radius × 区间宽度) 做敏感性分析，随后 reduced_fraction 的代数处理低重要性变量，
+ * 剩余代数恢复全维搜索。敏感性分析的评估次数不计入代数。
+ */
+struct ReductionSettings {
+    AnalysisSettings analysis;
+    double pilot_fraction = 0.15;
+    double reduced_fraction = 0.5;
+    double local_radius = 0.1;
+    double importance_threshold = 0.2;  // 重要性低于该倍数的平均值即视为低重要性
+    ReductionMode mode = ReductionMode::FREEZE;
+    int coarse_levels = 5;
+};
+
+} // namespace Sensitivity
@@ -0,0 +1,39 @@
+#include "shaped_objective.hpp"
+
+namespace ShapedObjective {
+
+bool applicable(const std::vector<Registry::EntityIndex>& uavs,
+                const std::vector<Registry::EntityIndex>& missiles,
+                const ScenarioLoader::Scenario& scenario)
+{
+    for (Registry::EntityIndex index : uavs) {
+        if (!scenario.entities.valid_uav(index)) {
+            return false;
+        }
+    }
+    for (Registry::EntityIndex index : missiles) {
+        if (!scenario.entities.valid_missile(index)) {
+            return false;
+        }
+    }
+    return CoreObjects::TargetCylinder(scenario.target, KEY_CIRC_SAMPLES, KEY_HEIGHT_SAMPLES)
+               .get_key_points().cols() == NUM_KEY_POINTS;
+}
+
+std::function<double(const Eigen::VectorXd&)> make_objective(
+    const std::vector<Registry::EntityIndex>& uavs,
+    int grenades_per_uav,
+    const std::vector<Registry::EntityIndex>& missiles,
+    const ScenarioLoader::Scenario& scenario,
+    double time_step,
+    std::atomic<long long>* invalid_trials)
+{
+    std::function<double(const Eigen::VectorXd&)> result;
+    visit_objective(uavs, grenades_per_uav, missiles, scenario, time_step, invalid_trials,
+                    [&result](auto objective) {
+                        result = [objective](const Eigen::VectorXd& x) { return (*objective)(x); };
+                    });
+    return result;
+}
+
+} // namespace ShapedObjective
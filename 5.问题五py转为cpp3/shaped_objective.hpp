@@ -0,0 +1,328 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <vector>
+#include <Eigen/Dense>
+#include "core_objects.hpp"
+#include "fast_evaluator.hpp"
+#include "optimizer.hpp"
+#include "scenario.hpp"
+
+namespace ShapedObjective {
+
+// 目标圆柱关键点的采样数 (与 TargetCylinder 的默认参数一致)
+constexpr int KEY_CIRC_SAMPLES = 16;
+constexpr int KEY_HEIGHT_SAMPLES = 5;
+constexpr int NUM_KEY_POINTS = 2 + 2 * KEY_CIRC_SAMPLES + 4 * (KEY_HEIGHT_SAMPLES - 1);
+
+/**
+ * @brief 按位检查有限值 (库以 -ffast-math 编译，std::isfinite 可能被优化掉)
+ */
+inline bool is_finite_bits(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return (bits & 0x7FF0000000000000ull) != 0x7FF0000000000000ull;
+}
+
+/**
+ * @brief 编译期确定形状的遮蔽目标函数
+ *
+ * 无人机数、每机弹药数和导弹数都是模板参数，决策变量、云团、锥参数和关键点都放在定长 std::array 中，
+ * 云团循环的次数在编译期已知，整个评估过程没有堆分配和字符串查表。
+ *
+ * 决策变量布局与 Problem5SubOptimizer 相同 (无人机按构造时给出的顺序)：
+ * [速度, 角度, 投放1, 引信1, 间隔2, 引信2, ...]。
+ * 校验规则、时间离散和遮蔽判据与 ObscurationEvaluator 的双精度路径逐项相同，结果一致。
+ */
+template <int NumUAVs, int GrenadesPerUAV, int NumMissiles>
+class ShapedObscurationObjective {
+public:
+    static constexpr int DIMENSION = NumUAVs * (2 + 2 * GrenadesPerUAV);
+    static constexpr int NUM_CLOUDS = NumUAVs * GrenadesPerUAV;
+    using Clouds = std::array<FastEvaluator::CloudState, NUM_CLOUDS>;
+
+    /**
+     * @param uavs 无人机索引，顺序即决策变量中的顺序
+     * @param missiles 导弹索引
+     * @param scenario 场景 (只在构造时读取)
+     * @param time_step 时间扫描步长
+     * @param invalid_trials 可选，无效决策变量的计数器
+     */
+    ShapedObscurationObjective(const std::array<Registry::EntityIndex, NumUAVs>& uavs,
+                               const std::array<Registry::EntityIndex, NumMissiles>& missiles,
+                               const ScenarioLoader::Scenario& scenario,
+                               double time_step = 0.1,
+                               std::atomic<long long>* invalid_trials = nullptr)
+        : physics_(scenario.physics)
+        , cloud_radius_(scenario.physics.cloud_radius)
+        , time_step_(time_step)
+        , invalid_trials_(invalid_trials)
+    {
+        for (int u = 0; u < NumUAVs; ++u) {
+            const auto& uav = scenario.entities.uav(uavs[u]);
+            uav_start_[u] = uav.start_pos;
+            if (GrenadesPerUAV > uav.grenade_budget) {
+                static_status_ = Optimizer::StrategyStatus::TOO_MANY_GRENADES;
+            }
+        }
+        for (int m = 0; m < NumMissiles; ++m) {
+            const auto& missile = scenario.entities.missile(missiles[m]);
+            missile_start_[m] = missile.start_pos;
+            missile_unit_[m] = missile.unit_vec;
+            missile_speed_[m] = missile.speed;
+        }
+
+        const Eigen::Matrix3Xd points = CoreObjects::TargetCylinder(
+            scenario.target, KEY_CIRC_SAMPLES, KEY_HEIGHT_SAMPLES).get_key_points();
+        for (int i = 0; i < NUM_KEY_POINTS; ++i) {
+            key_points_[i] = points.col(i);
+        }
+    }
+
+    /**
+     * @brief 解码并校验决策变量，生成全部云团
+     */
+    Optimizer::StrategyStatus decode(const double* x, Clouds& clouds) const {
+        if (static_status_ != Optimizer::StrategyStatus::OK) {
+            return static_status_;
+        }
+        for (int i = 0; i < DIMENSION; ++i) {
+            if (!is_finite_bits(x[i])) {
+                return Optimizer::StrategyStatus::NON_FINITE;
+            }
+        }
+
+        for (int u = 0; u < NumUAVs; ++u) {
+            const double* v = x + u * (2 + 2 * GrenadesPerUAV);
+            const double speed = v[0];
+            if (speed < physics_.uav_speed_min || speed > physics_.uav_speed_max) {
+                return Optimizer::StrategyStatus::SPEED_OUT_OF_RANGE;
+            }
+            double t_deploy = v[2];
+            for (int g = 0; g < GrenadesPerUAV; ++g) {
+                if (g > 0) {
+                    t_deploy = t_deploy + v[2 + 2 * g];
+                }
+                const double t_fuse = v[3 + 2 * g];
+                if (!is_finite_bits(t_deploy)) {
+                    return Optimizer::StrategyStatus::NON_FINITE;
+                }
+                if (t_deploy < 0.0 || t_fuse < 0.0) {
+                    return Optimizer::StrategyStatus::NEGATIVE_TIME;
+                }
+                clouds[u * GrenadesPerUAV + g] = FastEvaluator::deploy_cloud(
+                    uav_start_[u], speed, v[1], t_deploy, t_fuse, physics_.cloud_sink_speed, physics_);
+            }
+        }
+        return Optimizer::StrategyStatus::OK;
+    }
+
+    /**
+     * @brief 每枚导弹的有效遮蔽时间
+     */
+    void evaluate(const Clouds& clouds, std::array<double, NumMissiles>& obscured_time) const {
+        double sim_start_time = std::numeric_limits<double>::max();
+        double sim_end_time = std::numeric_limits<double>::lowest();
+        for (int c = 0; c < NUM_CLOUDS; ++c) {
+            sim_start_time = std::min(sim_start_time, clouds[c].start_time);
+            sim_end_time = std::max(sim_end_time, clouds[c].end_time);
+        }
+
+        std::array<Eigen::Vector3d, NUM_CLOUDS> centers;
+        std::array<long long, NumMissiles> obscured_count{};
+        std::array<long long, NumMissiles> last_index;
+        last_index.fill(std::numeric_limits<long long>::min());
+
+        for (double t = sim_start_time; t < sim_end_time; t += time_step_) {
+            int num_active = 0;
+            for (int c = 0; c < NUM_CLOUDS; ++c) {
+                if (t >= clouds[c].start_time && t < clouds[c].end_time) {
+                    centers[num_active++] = clouds[c].detonate_pos +
+                        Eigen::Vector3d(0.0, 0.0, -clouds[c].sink_speed * (t - clouds[c].start_time));
+                }
+            }
+            if (num_active == 0) {
+                continue;
+            }
+
+            const long long time_index = std::llround(t / time_step_);
+            for (int m = 0; m < NumMissiles; ++m) {
+                if (time_index == last_index[m]) {
+                    continue;
+                }
+                Eigen::Vector3d missile_pos = missile_start_[m] + missile_unit_[m] * missile_speed_[m] * t;
+                if (check_obscuration(missile_pos, centers, num_active)) {
+                    ++obscured_count[m];
+                    last_index[m] = time_index;
+                }
+            }
+        }
+
+        for (int m = 0; m < NumMissiles; ++m) {
+            obscured_time[m] = obscured_count[m] * time_step_;
+        }
+    }
+
+    /**
+     * @brief 目标函数：负的总遮蔽时间 (用于最小化)，无效决策变量返回 0
+     */
+    double operator()(const Eigen::VectorXd& x) const {
+        Clouds clouds;
+        if (x.size() != DIMENSION || decode(x.data(), clouds) != Optimizer::StrategyStatus::OK) {
+            if (invalid_trials_ != nullptr) {
+                invalid_trials_->fetch_add(1, std::memory_order_relaxed);
+            }
+            return 0.0;
+        }
+        std::array<double, NumMissiles> obscured;
+        evaluate(clouds, obscured);
+        double total_time = 0.0;
+        for (int m = 0; m < NumMissiles; ++m) {
+            total_time += obscured[m];
+        }
+        return -total_time;
+    }
+
+private:
+    ScenarioLoader::PhysicalConstants physics_;
+    double cloud_radius_;
+    double time_step_;
+    std::atomic<long long>* invalid_trials_;
+    Optimizer::StrategyStatus static_status_ = Optimizer::StrategyStatus::OK;
+
+    std::array<Eigen::Vector3d, NumUAVs> uav_start_;
+    std::array<Eigen::Vector3d, NumMissiles> missile_start_;
+    std::array<Eigen::Vector3d, NumMissiles> missile_unit_;
+    std::array<double, NumMissiles> missile_speed_;
+    std::array<Eigen::Vector3d, NUM_KEY_POINTS> key_points_;
+
+    bool check_obscuration(const Eigen::Vector3d& missile_pos,
+                           const std::array<Eigen::Vector3d, NUM_CLOUDS>& centers,
+                           int num_active) const {
+        std::array<Eigen::Vector3d, NUM_CLOUDS> axes;
+        std::array<double, NUM_CLOUDS> cos_half;
+
+        // 循环上界取编译期常量，小形状可完全展开
+        const double r = cloud_radius_;
+        for (int c = 0; c < NUM_CLOUDS && c < num_active; ++c) {
+            Eigen::Vector3d vec_vc = centers[c] - missile_pos;
+            double dist = vec_vc.norm();
+
+            // 导弹在云团内，视为完全遮蔽
+            if (dist <= r) {
+                return true;
+            }
+
+            axes[c] = vec_vc / dist;
+            double sin_half = r / dist;
+            cos_half[c] = std::sqrt(1.0 - sin_half * sin_half);
+        }
+
+        for (int i = 0; i < NUM_KEY_POINTS; ++i) {
+            Eigen::Vector3d vec_vp = key_points_[i] - missile_pos;
+            double norm = vec_vp.norm();
+            if (norm < 1e-9) {
+                continue;
+            }
+
+            bool covered = false;
+            for (int c = 0; c < NUM_CLOUDS && c < num_active; ++c) {
+                if (vec_vp.dot(axes[c]) >= cos_half[c] * norm) {
+                    covered = true;
+                    break;
+                }
+            }
+            if (!covered) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+/**
+ * @brief 实体索引有效，且目标几何的关键点数目与编译期常量一致 (采样参数不同的目标几何无法使用特化目标函数)
+ */
+bool applicable(const std::vector<Registry::EntityIndex>& uavs,
+                const std::vector<Registry::EntityIndex>& missiles,
+                const ScenarioLoader::Scenario& scenario);
+
+namespace detail {
+
+template <int NumUAVs, int GrenadesPerUAV, int NumMissiles, class Visit>
+bool visit_shape(const std::vector<Registry::EntityIndex>& uavs,
+                 int grenades_per_uav,
+                 const std::vector<Registry::EntityIndex>& missiles,
+                 const ScenarioLoader::Scenario& scenario,
+                 double time_step,
+                 std::atomic<long long>* invalid_trials,
+                 Visit& visit)
+{
+    if (static_cast<int>(uavs.size()) != NumUAVs || grenades_per_uav != GrenadesPerUAV ||
+        static_cast<int>(missiles.size()) != NumMissiles) {
+        return false;
+    }
+    std::array<Registry::EntityIndex, NumUAVs> uav_array;
+    std::array<Registry::EntityIndex, NumMissiles> missile_array;
+    std::copy(uavs.begin(), uavs.end(), uav_array.begin());
+    std::copy(missiles.begin(), missiles.end(), missile_array.begin());
+
+    // 关键点表约 1.2 KB，放在堆上由各线程共享只读访问
+    visit(std::make_shared<const ShapedObscurationObjective<NumUAVs, GrenadesPerUAV, NumMissiles>>(
+        uav_array, missile_array, scenario, time_step, invalid_trials));
+    return true;
+}
+
+} // namespace detail
+
+/**
+ * @brief 为给定形状构造已实例化的特化目标函数，并以具体类型调用
+ *        visit(std::shared_ptr<const ShapedObscurationObjective<U, G, M>>)
+ *
+ * 已实例化的形状 (无人机数 × 每机弹药数 × 导弹数)：1×1×1 (问题2)、1×3×1 (问题3)、3×1×1 (问题4)、
+ * 2×3×1 与 3×3×1 (问题5 的常见子问题)、5×3×3 (问题5 全局评估)。
+ * visit 可以把目标函数内联进自己的循环 (如 Optimizer::DifferentialEvolution::optimize)；
+ * 形状没有实例化时不调用 visit 并返回 false，调用方应退回通用路径。
+ *
+ * @param uavs 无人机索引，顺序即决策变量中的顺序
+ */
+template <class Visit>
+bool visit_objective(const std::vector<Registry::EntityIndex>& uavs,
+                     int grenades_per_uav,
+                     const std::vector<Registry::EntityIndex>& missiles,
+                     const ScenarioLoader::Scenario& scenario,
+                     double time_step,
+                     std::atomic<long long>* invalid_trials,
+                     Visit&& visit)
+{
+    if (!applicable(uavs, missiles, scenario)) {
+        return false;
+    }
+    return detail::visit_shape<1, 1, 1>(uavs, grenades_per_uav, missiles, scenario, time_step, invalid_trials, visit) ||
+           detail::visit_shape<1, 3, 1>(uavs, grenades_per_uav, missiles, scenario, time_step, invalid_trials, visit) ||
+           detail::visit_shape<3, 1, 1>(uavs, grenades_per_uav, missiles, scenario, time_step, invalid_trials, visit) ||
+           detail::visit_shape<2, 3, 1>(uavs, grenades_per_uav, missiles, scenario, time_step, invalid_trials, visit) ||
+           detail::visit_shape<3, 3, 1>(uavs, grenades_per_uav, missiles, scenario, time_step, invalid_trials, visit) ||
+           detail::visit_shape<5, 3, 3>(uavs, grenades_per_uav, missiles, scenario, time_step, invalid_trials, visit);
+}
+
+/**
+ * @brief 同 visit_objective，以 std::function 返回特化目标函数；形状没有实例化时返回空函数
+ */
+std::function<double(const Eigen::VectorXd&)> make_objective(
+    const std::vector<Registry::EntityIndex>& uavs,
+    int grenades_per_uav,
+    const std::vector<Registry::EntityIndex>& missiles,
+    const ScenarioLoader::Scenario& scenario,
+    double time_step = 0.1,
+    std::atomic<long long>* invalid_trials = nullptr);
+
+} // namespace ShapedObjective
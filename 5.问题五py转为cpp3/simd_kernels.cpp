@@ -0,0 +1,113 @@
+#include "simd_kernels.hpp"
+#include "cpu_dispatch.hpp"
+#include <cmath>
+
+namespace SimdKernels {
+
+namespace {
+
+// 内核主体强制内联到各档位的入口函数中，由编译器按入口的 target 属性分别向量化
+#define SMOKE_KERNEL_BODY inline __attribute__((always_inline))
+
+// 锥体数组的通道数在编译期已知 (Chunks > 0) 时整组测试完全展开，常见的单组 (不超过 16 个云团) 走这条路径
+template <int Chunks>
+SMOKE_KERNEL_BODY ScanResult scan_body(const ConeSet& cones, const KeyPointSet& points, int begin) {
+    const float* __restrict vc_x = cones.vc_x;
+    const float* __restrict vc_y = cones.vc_y;
+    const float* __restrict vc_z = cones.vc_z;
+    const float* __restrict dist = cones.dist;
+    const int* __restrict valid = cones.valid;
+    const int num_lanes = (Chunks > 0 ? Chunks : cones.num_chunks) * CONE_LANES;
+    const float r = cones.radius;
+    const float guard = cones.guard;
+
+    for (int i = begin; i < points.count; ++i) {
+        const float px = points.dx[i] + points.base_x;
+        const float py = points.dy[i] + points.base_y;
+        const float pz = points.dz[i] + points.base_z;
+        const float norm = std::sqrt(px * px + py * py + pz * pz);
+        if (norm < 1e-9f) {
+            continue;
+        }
+
+        int covered = 0;
+        int ambiguous = 0;
+        for (int c = 0; c < num_lanes; ++c) {
+            float dot = px * vc_x[c] + py * vc_y[c] + pz * vc_z[c];
+            float cx = py * vc_z[c] - pz * vc_y[c];
+            float cy = pz * vc_x[c] - px * vc_z[c];
+            float cz = px * vc_y[c] - py * vc_x[c];
+            float margin = std::sqrt(cx * cx + cy * cy + cz * cz) - r * norm;
+            float tol = guard * norm * dist[c];
+            int front = valid[c] & (dot > 0.0f);
+            covered |= front & (margin < -tol);
+            ambiguous |= front & (std::fabs(margin) <= tol);
+        }
+        if (!covered) {
+            return {i, ambiguous != 0};
+        }
+    }
+    return {points.count, false};
+}
+
+SMOKE_KERNEL_BODY void clamp_body(double* x, const double* lower, const double* upper, int n) {
+    for (int i = 0; i < n; ++i) {
+        const double v = x[i];
+        x[i] = v < lower[i] ? lower[i] : (upper[i] < v ? upper[i] : v);
+    }
+}
+
+#undef SMOKE_KERNEL_BODY
+
+struct KernelTable {
+    ScanResult (*scan_key_points)(const ConeSet&, const KeyPointSet&, int);
+    void (*clamp)(double*, const double*, const double*, int);
+};
+
+// 每个档位一组入口函数，函数体相同，只有 target 属性不同
+#define SMOKE_DEFINE_KERNELS(suffix, attributes)                                                   \
+    attributes ScanResult scan_##suffix(const ConeSet& cones, const KeyPointSet& points, int begin) { \
+        return cones.num_chunks == 1 ? scan_body<1>(cones, points, begin)                          \
+                                     : scan_body<0>(cones, points, begin);                         \
+    }                                                                                              \
+    attributes void clamp_##suffix(double* x, const double* lower, const double* upper, int n) {   \
+        clamp_body(x, lower, upper, n);                                                            \
+    }
+
+SMOKE_DEFINE_KERNELS(scalar, )
+
+#if defined(__x86_64__) || defined(__i386__)
+SMOKE_DEFINE_KERNELS(sse42, __attribute__((target("sse4.2"))))
+SMOKE_DEFINE_KERNELS(avx2, __attribute__((target("avx2,fma"))))
+SMOKE_DEFINE_KERNELS(avx512, __attribute__((target("avx512f,avx512vl,avx512dq,avx512bw,fma,prefer-vector-width=512"))))
+
+const KernelTable TABLES[] = {
+    {&scan_scalar, &clamp_scalar},
+    {&scan_sse42, &clamp_sse42},
+    {&scan_avx2, &clamp_avx2},
+    {&scan_avx512, &clamp_avx512},
+};
+#else
+// 非 x86 平台只有基线版本，CpuDispatch 也只会报告 SCALAR
+const KernelTable TABLES[] = {
+    {&scan_scalar, &clamp_scalar},
+};
+#endif
+
+#undef SMOKE_DEFINE_KERNELS
+
+const KernelTable& kernels() {
+    return TABLES[static_cast<int>(CpuDispatch::active())];
+}
+
+} // namespace
+
+ScanResult scan_key_points(const ConeSet& cones, const KeyPointSet& points, int begin) {
+    return kernels().scan_key_points(cones, points, begin);
+}
+
+void clamp(double* x, const double* lower, const double* upper, int n) {
+    kernels().clamp(x, lower, upper, n);
+}
+
+} // namespace SimdKernels
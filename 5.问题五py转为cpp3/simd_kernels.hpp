@@ -0,0 +1,67 @@
+#pragma once
+
+namespace SimdKernels {
+
+/**
+ * @brief 运行时按 CPU 选择指令集的 SIMD 内核
+ *
+ * 每个内核按 SCALAR / SSE4.2 / AVX2 / AVX-512 各编译一份 (函数级 target 属性，库本身按 x86-64 基线编译)，
+ * 调用时按 CpuDispatch::active() 选择，同一个二进制可以在不同代的 CPU 上运行。
+ * 内核只操作裸数组，不依赖 Eigen，以免带高指令集的内联函数混入其他翻译单元。
+ */
+
+// 一个关键点同时测试的锥体数 (AVX-512 单精度宽度)
+constexpr int CONE_LANES = 16;
+
+/**
+ * @brief 单精度锥体组：云团中心相对导弹的位置 (SoA)
+ *
+ * 数组长度为 num_chunks * CONE_LANES，补位通道的 valid 为 0。
+ */
+struct ConeSet {
+    const float* vc_x;
+    const float* vc_y;
+    const float* vc_z;
+    const float* dist;      // |vc|
+    const int* valid;
+    int num_chunks;
+    float radius;           // 云团半径
+    float guard;            // 相对保护带宽度
+};
+
+/**
+ * @brief 单精度关键点：相对公共原点的偏移，加上 base (原点相对导弹的位置) 即为导弹到关键点的向量
+ */
+struct KeyPointSet {
+    const float* dx;
+    const float* dy;
+    const float* dz;
+    int count;
+    float base_x;
+    float base_y;
+    float base_z;
+};
+
+/**
+ * @brief 关键点扫描结果：第一个不能确定被遮挡的关键点
+ */
+struct ScanResult {
+    int index;          // 关键点下标；全部确定被遮挡时为 count
+    bool ambiguous;     // 该点的判断是否落在保护带内 (否则为确定未被遮挡)
+};
+
+/**
+ * @brief 从 begin 开始逐个关键点做锥体测试，在第一个不能确定被遮挡的关键点处返回
+ *
+ * 判据为点在锥顶前方且 |vp × vc| < r * |vp|，|margin| 不超过 guard * |vp| * |vc| 时视为落在保护带内。
+ * 各档位的舍入不同 (FMA 合并；Release 下单精度 sqrt 用倒数平方根近似加一步牛顿迭代)，
+ * 误差都远小于保护带，调用方复核后的结论与档位无关。
+ */
+ScanResult scan_key_points(const ConeSet& cones, const KeyPointSet& points, int begin);
+
+/**
+ * @brief 逐元素截断到 [lower, upper]，有限值输入时与 std::clamp 结果相同 (不要求对齐)
+ */
+void clamp(double* x, const double* lower, const double* upper, int n);
+
+} // namespace SimdKernels
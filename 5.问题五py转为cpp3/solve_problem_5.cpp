@@ -2,10 +2,13 @@
 #include "threat_assessor.hpp"
 #include "task_allocator.hpp"
 #include "boundary_calculator.hpp"
+#include "scenario.hpp"
+#include "shaped_objective.hpp"
 #include <iostream>
 #include <iomanip>
 #include <chrono>
 #include <cmath>
+#include <algorithm>
 
 namespace Problem5 {
 
@@ -13,6 +16,66 @@ Problem5SubOptimizer::Problem5SubOptimizer(
     const std::string& missile_id, 
     const std::unordered_map<std::string, int>& uav_assignments)
     : ObscurationOptimizer(missile_id, uav_assignments) {
+    // 决策变量按无人机ID排序排布，扁平策略按注册表索引排列
+    std::vector<std::string> sorted_uav_ids;
+    for (const auto& [uav_id, _] : uav_assignments_) {
+        sorted_uav_ids.push_back(uav_id);
+    }
+    std::sort(sorted_uav_ids.begin(), sorted_uav_ids.end());
+    
+    bool unknown_uav = false;
+    bool too_many_grenades = false;
+    for (const auto& uav_id : sorted_uav_ids) {
+        const int num_grenades = uav_assignments_.at(uav_id);
+        const Registry::EntityIndex uav = scenario_.entities.uav_index(uav_id);
+        unknown_uav = unknown_uav || uav == Registry::INVALID_INDEX;
+        too_many_grenades = too_many_grenades || num_grenades > Config::MAX_GRENADES_PER_UAV;
+        slots_.push_back({uav, num_grenades, dimension_});
+        dimension_ += 2 + 2 * num_grenades;
+    }
+    std::sort(slots_.begin(), slots_.end(), [](const Slot& a, const Slot& b) { return a.uav < b.uav; });
+    
+    if (unknown_uav) {
+        layout_status_ = Optimizer::StrategyStatus::UNKNOWN_UAV;
+    } else if (too_many_grenades) {
+        layout_status_ = Optimizer::StrategyStatus::TOO_MANY_GRENADES;
+    }
+}
+
+Optimizer::StrategyStatus Problem5SubOptimizer::try_parse_flat(const Eigen::VectorXd& decision_variables,
+                                                               Optimizer::FlatStrategy& strategy) {
+    if (decision_variables.size() != dimension_) {
+        return Optimizer::StrategyStatus::WRONG_DIMENSION;
+    }
+    for (int i = 0; i < dimension_; ++i) {
+        if (!ShapedObjective::is_finite_bits(decision_variables[i])) {
+            return Optimizer::StrategyStatus::NON_FINITE;
+        }
+    }
+    if (layout_status_ != Optimizer::StrategyStatus::OK) {
+        return layout_status_;
+    }
+    
+    strategy.resize(slots_.size());
+    for (size_t s = 0; s < slots_.size(); ++s) {
+        const Slot& slot = slots_[s];
+        const double* v = decision_variables.data() + slot.offset;
+        Optimizer::FlatUAVStrategy& record = strategy[s];
+        record.uav = slot.uav;
+        record.num_grenades = slot.num_grenades;
+        record.speed = v[0];
+        record.angle = v[1];
+        
+        // 首弹为绝对投放时间，其余为相对前一枚的间隔
+        double t_deploy = v[2];
+        for (int g = 0; g < slot.num_grenades; ++g) {
+            if (g > 0) {
+                t_deploy += v[2 + 2 * g];
+            }
+            record.grenades[g] = {t_deploy, v[3 + 2 * g]};
+        }
+    }
+    return Optimizer::validate_strategy(strategy, scenario_);
 }
 
 Optimizer::StrategyMap Problem5SubOptimizer::parse_decision_variables(const Eigen::VectorXd& decision_variables) {
@@ -81,24 +144,67 @@ void print_strategy_details(const std::string& missile_id,
     }
 }
 
-int solve_problem_5() {
+std::vector<Optimizer::Bounds> build_bounds(const std::string& missile_id,
+                                            const std::unordered_map<std::string, int>& uav_assignments) {
+    const auto& physics = ScenarioLoader::active().physics;
+    std::vector<Optimizer::Bounds> bounds;
+    std::vector<std::string> uav_ids_for_task;
+    for (const auto& [uav_id, _] : uav_assignments) {
+        uav_ids_for_task.push_back(uav_id);
+    }
+    std::sort(uav_ids_for_task.begin(), uav_ids_for_task.end());
+    
+    std::cout << "--- 正在计算 t_deploy 的有效边界 ---" << std::endl;
+    for (const auto& uav_id : uav_ids_for_task) {
+        int num_grenades = uav_assignments.at(uav_id);
+        double t_max = BoundaryCalculator::find_max_effective_deploy_time(uav_id, missile_id);
+        std::cout << "  " << uav_id << " 的 t_deploy 上边界建议为: " 
+                  << std::fixed << std::setprecision(2) << t_max << " s" << std::endl;
+        
+        // 速度和角度边界
+        bounds.emplace_back(physics.uav_speed_min, physics.uav_speed_max);
+        bounds.emplace_back(0.0, 2.0 * M_PI);
+        
+        // 第一枚弹药的时间边界
+        bounds.emplace_back(0.1, t_max);  // t_deploy
+        bounds.emplace_back(0.1, 20.0);   // t_fuse
+        
+        // 剩余弹药的时间间隔边界
+        for (int i = 1; i < num_grenades; ++i) {
+            bounds.emplace_back(physics.grenade_interval, 10.0);  // delta_t
+            bounds.emplace_back(0.1, 20.0);  // t_fuse
+        }
+    }
+    std::cout << "-----------------------------------" << std::endl;
+    return bounds;
+}
+
+Problem5Result run_problem_5(const Problem5Options& options) {
+    const auto& scenario = ScenarioLoader::active();
     std::cout << "开始求解问题5：多导弹协同遮蔽优化" << std::endl;
+    std::cout << "场景: " << scenario.name << " (导弹 " << scenario.entities.num_missiles()
+              << ", 无人机 " << scenario.entities.num_uavs() << ", 哈希 " << std::hex << std::setw(16)
+              << std::setfill('0') << scenario.content_hash << std::dec << std::setfill(' ') << ")" << std::endl;
     std::cout << std::string(60, '=') << std::endl;
     
+    Problem5Result result;
+    
     // --- 步骤 0: 威胁评估 ---
     std::cout << "步骤 0: 进行威胁评估..." << std::endl;
-    auto threat_weights = ThreatAssessor::assess_threat_weights();
+    result.threat_weights = ThreatAssessor::assess_threat_weights();
+    const auto& threat_weights = result.threat_weights;
     
     // --- 步骤 1: 高层决策 (基于威胁权重) ---
     std::cout << "\n步骤 1: 执行任务分配..." << std::endl;
     auto assignments = TaskAllocator::assign_tasks_by_threat(threat_weights);
     TaskAllocator::print_assignment_results(assignments, threat_weights);
     
-    std::unordered_map<std::string, std::pair<Optimizer::StrategyMap, double>> all_results;
+    auto& all_results = result.results;
     
     // --- 步骤 2: 低层决策 (优化每个导弹的拦截策略) ---
     std::cout << "\n步骤 2: 开始低层决策优化..." << std::endl;
     
+    unsigned int subproblem_index = 0;
     for (const auto& [missile_id, uav_alloc] : assignments) {
         if (uav_alloc.empty()) {
             std::cout << "跳过导弹 " << missile_id << "（未分配资源）" << std::endl;
@@ -120,47 +226,19 @@ int solve_problem_5() {
         std::cout << std::string(60, '=') << std::endl;
 
         // 动态构建优化边界
-        std::vector<Optimizer::Bounds> bounds;
-        std::vector<std::string> uav_ids_for_task;
-        for (const auto& [uav_id, _] : uav_alloc) {
-            uav_ids_for_task.push_back(uav_id);
-        }
-        std::sort(uav_ids_for_task.begin(), uav_ids_for_task.end());
-        
-        std::cout << "--- 正在计算 t_deploy 的有效边界 ---" << std::endl;
-        for (const auto& uav_id : uav_ids_for_task) {
-            int num_grenades = uav_alloc.at(uav_id);
-            double t_max = BoundaryCalculator::find_max_effective_deploy_time(uav_id, missile_id);
-            std::cout << "  " << uav_id << " 的 t_deploy 上边界建议为: " 
-                      << std::fixed << std::setprecision(2) << t_max << " s" << std::endl;
-            
-            // 速度和角度边界
-            bounds.emplace_back(Config::UAV_SPEED_MIN, Config::UAV_SPEED_MAX);
-            bounds.emplace_back(0.0, 2.0 * M_PI);
-            
-            // 第一枚弹药的时间边界
-            bounds.emplace_back(0.1, t_max);  // t_deploy
-            bounds.emplace_back(0.1, 20.0);   // t_fuse
-            
-            // 剩余弹药的时间间隔边界
-            for (int i = 1; i < num_grenades; ++i) {
-                bounds.emplace_back(Config::GRENADE_INTERVAL, 10.0);  // delta_t
-                bounds.emplace_back(0.1, 20.0);  // t_fuse
-            }
-        }
-        std::cout << "-----------------------------------" << std::endl;
+        std::vector<Optimizer::Bounds> bounds = build_bounds(missile_id, uav_alloc);
         
         // 创建优化器并求解
         Problem5SubOptimizer optimizer(missile_id, uav_alloc);
         int D = bounds.size();
         std::cout << "该子问题的优化维度为: " << D << std::endl;
         
-        Optimizer::DESettings settings;
-        settings.population_size = 15 * D;
-        settings.max_iterations = 1000;
-        settings.tolerance = 0.01;
-        settings.verbose = true;
-        settings.num_threads = -1;  // 使用所有可用线程
+        Optimizer::DESettings settings = options.de;
+        settings.population_size = options.population_per_dimension * D;
+        if (settings.seed != 0) {
+            settings.seed += subproblem_index;
+        }
+        ++subproblem_index;
         
         auto start_time = std::chrono::high_resolution_clock::now();
         auto [optimal_strategy, max_time] = optimizer.solve(bounds, settings);
@@ -174,20 +252,33 @@ int solve_problem_5() {
                   << max_time << " s" << std::endl;
         
         all_results[missile_id] = {optimal_strategy, max_time};
+        result.invalid_trials += optimizer.invalid_trial_count();
+    }
+    
+    for (const auto& [missile_id, result_pair] : all_results) {
+        auto weight_it = threat_weights.find(missile_id);
+        double weight = (weight_it != threat_weights.end()) ? weight_it->second : 0.0;
+        result.weighted_score += weight * result_pair.second;
     }
+    return result;
+}
+
+int solve_problem_5() {
+    Problem5Result result = run_problem_5();
+    const auto& threat_weights = result.threat_weights;
+    const auto& all_results = result.results;
 
     // --- 步骤 3: 汇总、加权评分并保存结果 ---
     std::cout << "\n" << std::string(60, '=') << std::endl;
     std::cout << "所有优化任务完成，正在生成最终报告..." << std::endl;
     std::cout << std::string(60, '=') << std::endl;
     
-    double total_weighted_score = 0.0;
+    double total_weighted_score = result.weighted_score;
     
     for (const auto& [missile_id, result_pair] : all_results) {
         auto weight_it = threat_weights.find(missile_id);
         double weight = (weight_it != threat_weights.end()) ? weight_it->second : 0.0;
         double time = result_pair.second;
-        total_weighted_score += weight * time;
         
         print_strategy_details(missile_id, result_pair.first, time, weight);
     }
@@ -251,13 +342,3 @@ int solve_problem_5() {
 }
 
 } // namespace Problem5
-
-// 主函数
-int main() {
-    try {
-        return Problem5::solve_problem_5();
-    } catch (const std::exception& e) {
-        std::cerr << "程序执行过程中发生错误: " << e.what() << std::endl;
-        return 1;
-    }
-}
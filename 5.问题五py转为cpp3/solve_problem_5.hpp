@@ -28,8 +28,72 @@ protected:
      * @return Optimizer::StrategyMap 解析后的策略映射
      */
     Optimizer::StrategyMap parse_decision_variables(const Eigen::VectorXd& decision_variables) override;
+    
+    /**
+     * @brief 按注册表索引直接填充扁平策略，不构造字符串键策略，状态码与通用路径相同
+     */
+    Optimizer::StrategyStatus try_parse_flat(const Eigen::VectorXd& decision_variables,
+                                             Optimizer::FlatStrategy& strategy) override;
+    
+    bool has_standard_layout() const override { return true; }
+
+private:
+    /**
+     * @brief 一架无人机在决策变量中的位置
+     */
+    struct Slot {
+        Registry::EntityIndex uav;
+        int num_grenades;
+        int offset;   // 该机第一个决策变量的下标 (无人机按ID排序排布)
+    };
+    
+    std::vector<Slot> slots_;   // 按无人机索引升序，即扁平策略的顺序
+    int dimension_ = 0;
+    Optimizer::StrategyStatus layout_status_ = Optimizer::StrategyStatus::OK;   // 未知无人机或弹药数超上限
 };
 
+/**
+ * @brief 为一个拦截子问题构建决策变量边界
+ * 
+ * 每架无人机 (按ID排序) 依次为速度、角度、首弹投放与引信时间、其余弹药的投放间隔与引信时间。
+ * 首弹投放时间上界由 BoundaryCalculator 估计。
+ * 
+ * @param missile_id 目标导弹ID
+ * @param uav_assignments 无人机分配方案 {无人机ID: 弹药数量}
+ */
+std::vector<Optimizer::Bounds> build_bounds(const std::string& missile_id,
+                                            const std::unordered_map<std::string, int>& uav_assignments);
+
+/**
+ * @brief 问题5的求解参数
+ */
+struct Problem5Options {
+    int population_per_dimension = 15;  // 子问题种群规模 = 系数 × 维度
+    Optimizer::DESettings de;           // population_size 不使用；seed 非零时第 k 个子问题使用 seed + k
+    
+    Problem5Options() {
+        de.max_iterations = 1000;
+        de.tolerance = 0.01;
+        de.verbose = true;
+        de.num_threads = -1;
+    }
+};
+
+/**
+ * @brief 问题5的求解结果
+ */
+struct Problem5Result {
+    std::unordered_map<std::string, double> threat_weights;
+    std::unordered_map<std::string, std::pair<Optimizer::StrategyMap, double>> results; // {导弹ID: (策略, 遮蔽时间)}
+    double weighted_score = 0.0;
+    long long invalid_trials = 0;
+};
+
+/**
+ * @brief 在当前场景上执行威胁评估、任务分配和各子问题优化 (过程信息输出到 std::cout)
+ */
+Problem5Result run_problem_5(const Problem5Options& options = Problem5Options());
+
 /**
  * @brief 问题5的主求解函数
  * 
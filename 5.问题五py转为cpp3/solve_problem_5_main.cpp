@@ -0,0 +1,17 @@
+#include "solve_problem_5.hpp"
+#include "scenario.hpp"
+#include <iostream>
+
+// 主函数
+// 用法: solve_problem_5 [场景文件 (JSON 或二进制)]
+int main(int argc, char* argv[]) {
+    try {
+        if (argc > 1) {
+            ScenarioLoader::set_active(ScenarioLoader::load_file(argv[1]));
+        }
+        return Problem5::solve_problem_5();
+    } catch (const std::exception& e) {
+        std::cerr << "程序执行过程中发生错误: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -1,5 +1,6 @@
 #include "strategy_calculator.hpp"
 #include "core_objects.hpp"
+#include "scenario.hpp"
 #include <iostream>
 #include <iomanip>
 #include <stdexcept>
@@ -78,9 +79,10 @@ bool validate_strategy(const MultiGrenadeStrategy& strategy) {
         return false;
     }
     
-    if (strategy.speed < Config::UAV_SPEED_MIN || strategy.speed > Config::UAV_SPEED_MAX) {
+    const auto& physics = ScenarioLoader::active().physics;
+    if (strategy.speed < physics.uav_speed_min || strategy.speed > physics.uav_speed_max) {
         std::cerr << "错误: 无人机速度超出范围 [" 
-                  << Config::UAV_SPEED_MIN << ", " << Config::UAV_SPEED_MAX << "]" << std::endl;
+                  << physics.uav_speed_min << ", " << physics.uav_speed_max << "]" << std::endl;
         return false;
     }
     
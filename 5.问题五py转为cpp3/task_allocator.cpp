@@ -1,4 +1,5 @@
 #include "task_allocator.hpp"
+#include "scenario.hpp"
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
@@ -8,11 +9,12 @@
 namespace TaskAllocator {
 
 double calculate_engagement_time_cost(
-    const Config::UAVInitial& uav_spec,
-    const Config::MissileInitial& missile_spec) {
+    const Registry::UAVEntry& uav_spec,
+    const Registry::MissileEntry& missile_spec,
+    double uav_speed_max) {
     
-    Vector3d uav_pos = uav_spec.pos;
-    Vector3d missile_start_pos = missile_spec.pos;
+    Vector3d uav_pos = uav_spec.start_pos;
+    Vector3d missile_start_pos = missile_spec.start_pos;
     Vector3d missile_target_pos = missile_spec.target;
     
     // 计算拦截点（导弹轨迹的1/3处）
@@ -20,7 +22,7 @@ double calculate_engagement_time_cost(
     
     // 计算无人机到拦截点的距离和时间
     double distance_to_intercept = (uav_pos - intercept_point).norm();
-    double time_to_intercept = distance_to_intercept / Config::UAV_SPEED_MAX;
+    double time_to_intercept = distance_to_intercept / uav_speed_max;
     
     return time_to_intercept;
 }
@@ -31,12 +33,16 @@ std::unordered_map<std::string, std::unordered_map<std::string, int>> assign_tas
     std::vector<std::string> uav_ids;
     std::vector<std::string> missile_ids;
     
-    // 收集所有ID
-    for (const auto& [uav_id, _] : Config::UAVS_INITIAL) {
-        uav_ids.push_back(uav_id);
+    // 收集所有ID (没有弹药的无人机不参与分配)
+    const auto& scenario = ScenarioLoader::active();
+    const auto& registry = scenario.entities;
+    for (int u = 0; u < registry.num_uavs(); ++u) {
+        if (registry.uav(u).grenade_budget > 0) {
+            uav_ids.push_back(registry.uav(u).id);
+        }
     }
-    for (const auto& [missile_id, _] : Config::MISSILES_INITIAL) {
-        missile_ids.push_back(missile_id);
+    for (int m = 0; m < registry.num_missiles(); ++m) {
+        missile_ids.push_back(registry.missile(m).id);
     }
     
     int num_uavs = uav_ids.size();
@@ -96,9 +102,10 @@ std::unordered_map<std::string, std::unordered_map<std::string, int>> assign_tas
     
     for (const auto& uav_id : uav_ids) {
         for (const auto& missile_id : missile_ids) {
-            const auto& uav_spec = Config::UAVS_INITIAL.at(uav_id);
-            const auto& missile_spec = Config::MISSILES_INITIAL.at(missile_id);
-            uav_missile_costs[uav_id][missile_id] = calculate_engagement_time_cost(uav_spec, missile_spec);
+            const auto& uav_spec = registry.uav(registry.uav_index(uav_id));
+            const auto& missile_spec = registry.missile(registry.missile_index(missile_id));
+            uav_missile_costs[uav_id][missile_id] =
+                calculate_engagement_time_cost(uav_spec, missile_spec, scenario.physics.uav_speed_max);
         }
     }
     
@@ -136,7 +143,7 @@ std::unordered_map<std::string, std::unordered_map<std::string, int>> assign_tas
         for (const auto& [uav_id, _] : candidates) {
             if (assigned_count >= num_needed) break;
             
-            assignments[missile_id][uav_id] = 3; // 每架无人机分配3枚弹药
+            assignments[missile_id][uav_id] = registry.uav(registry.uav_index(uav_id)).grenade_budget; // 携带的全部弹药
             assigned_uavs.insert(uav_id);
             assigned_count++;
         }
@@ -5,6 +5,7 @@
 #include <string>
 #include <Eigen/Dense>
 #include "config.hpp"
+#include "entity_registry.hpp"
 
 using Vector3d = Eigen::Vector3d;
 
@@ -13,18 +14,22 @@ namespace TaskAllocator {
 /**
  * @brief 计算无人机拦截导弹的成本，以"最小反应时间"为标准
  * 
- * @param uav_spec 无人机配置
- * @param missile_spec 导弹配置  
+ * @param uav_spec 无人机条目
+ * @param missile_spec 导弹条目
+ * @param uav_speed_max 无人机最大速度
  * @return double 拦截成本（反应时间）
  */
 double calculate_engagement_time_cost(
-    const Config::UAVInitial& uav_spec,
-    const Config::MissileInitial& missile_spec
+    const Registry::UAVEntry& uav_spec,
+    const Registry::MissileEntry& missile_spec,
+    double uav_speed_max = Config::UAV_SPEED_MAX
 );
 
 /**
  * @brief 根据威胁权重，使用贪心策略动态分配无人机
  * 
+ * 实体取自当前场景，每架无人机按其弹药预算分配弹药，预算为零的无人机不参与分配。
+ * 
  * @param threat_weights 导弹ID到威胁权重的映射
  * @return std::unordered_map<std::string, std::unordered_map<std::string, int>> 
  *         导弹ID到{无人机ID: 弹药数量}的分配方案
@@ -1,4 +1,5 @@
 #include "threat_assessor.hpp"
+#include "scenario.hpp"
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
@@ -7,34 +8,47 @@
 
 namespace ThreatAssessor {
 
+namespace {
+
+/**
+ * @brief 在当前场景中查找导弹，未知ID返回 nullptr
+ */
+const Registry::MissileEntry* find_missile(const std::string& missile_id) {
+    const auto& registry = Registry::EntityRegistry::default_registry();
+    Registry::EntityIndex index = registry.missile_index(missile_id);
+    return index == Registry::INVALID_INDEX ? nullptr : &registry.missile(index);
+}
+
+} // namespace
+
 double calculate_time_to_impact(const std::string& missile_id) {
-    auto it = Config::MISSILES_INITIAL.find(missile_id);
-    if (it == Config::MISSILES_INITIAL.end()) {
+    const Registry::MissileEntry* missile = find_missile(missile_id);
+    if (missile == nullptr) {
         return 1000.0; // 默认很大的时间
     }
     
-    const auto& missile_spec = it->second;
-    Vector3d direction = missile_spec.target - missile_spec.pos;
+    const auto& missile_spec = *missile;
+    Vector3d direction = missile_spec.target - missile_spec.start_pos;
     double distance = direction.norm();
     return distance / missile_spec.speed;
 }
 
 double calculate_criticality(const std::string& missile_id) {
-    auto it = Config::MISSILES_INITIAL.find(missile_id);
-    if (it == Config::MISSILES_INITIAL.end()) {
+    const Registry::MissileEntry* missile = find_missile(missile_id);
+    if (missile == nullptr) {
         return 0.5; // 默认中等关键性
     }
     
-    const auto& missile_spec = it->second;
+    const auto& missile_spec = *missile;
     
     // 基于初始位置的关键性：距离目标越近，关键性越高
-    double distance_to_target = (missile_spec.pos - missile_spec.target).norm();
+    double distance_to_target = (missile_spec.start_pos - missile_spec.target).norm();
     
     // 基于速度的关键性：速度越快，关键性越高
     double speed_factor = missile_spec.speed / 400.0; // 归一化到400m/s
     
     // 基于高度的关键性：高度适中的导弹更难拦截
-    double altitude = missile_spec.pos[2];
+    double altitude = missile_spec.start_pos[2];
     double altitude_factor = 1.0 - std::abs(altitude - 2000.0) / 2000.0; // 2000m为最优高度
     
     // 综合评分
@@ -46,16 +60,16 @@ double calculate_criticality(const std::string& missile_id) {
 }
 
 double calculate_difficulty(const std::string& missile_id) {
-    auto it = Config::MISSILES_INITIAL.find(missile_id);
-    if (it == Config::MISSILES_INITIAL.end()) {
+    const Registry::MissileEntry* missile = find_missile(missile_id);
+    if (missile == nullptr) {
         return 0.5; // 默认中等难度
     }
     
-    const auto& missile_spec = it->second;
+    const auto& missile_spec = *missile;
     
     // 基于初始位置偏离程度的难度
-    Vector3d target_center = Config::TRUE_TARGET_SPECS.center_bottom;
-    Vector3d missile_pos = missile_spec.pos;
+    Vector3d target_center = ScenarioLoader::active().target.center_bottom;
+    Vector3d missile_pos = missile_spec.start_pos;
     
     // Y方向偏离（侧向偏离）
     double lateral_deviation = std::abs(missile_pos[1] - target_center[1]);
@@ -100,7 +114,9 @@ std::unordered_map<std::string, double> assess_threat_weights(
     std::vector<std::pair<std::string, double>> threat_scores;
     
     // 计算每个导弹的威胁评分
-    for (const auto& [missile_id, _] : Config::MISSILES_INITIAL) {
+    const auto& registry = Registry::EntityRegistry::default_registry();
+    for (int m = 0; m < registry.num_missiles(); ++m) {
+        const std::string& missile_id = registry.missile(m).id;
         ThreatMetrics metrics = assess_single_missile_threat(missile_id, factor_weights);
         threat_scores.emplace_back(missile_id, metrics.overall_threat);
     }
@@ -117,9 +133,9 @@ std::unordered_map<std::string, double> assess_threat_weights(
         }
     } else {
         // 如果所有威胁评分都为0，平均分配权重
-        double equal_weight = 1.0 / Config::MISSILES_INITIAL.size();
-        for (const auto& [missile_id, _] : Config::MISSILES_INITIAL) {
-            threat_weights[missile_id] = equal_weight;
+        double equal_weight = 1.0 / registry.num_missiles();
+        for (int m = 0; m < registry.num_missiles(); ++m) {
+            threat_weights[registry.missile(m).id] = equal_weight;
         }
     }
     
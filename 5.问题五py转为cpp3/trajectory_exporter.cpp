@@ -0,0 +1,415 @@
+#include "trajectory_exporter.hpp"
+#include "core_objects.hpp"
+#include "geometry.hpp"
+#include "scenario.hpp"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <omp.h>
+
+namespace TrajectoryExporter {
+
+namespace {
+
+constexpr char MAGIC[8] = {'\x93', 'S', 'M', 'K', 'T', 'R', 'J', '\x01'};
+constexpr int64_t ALIGNMENT = 64;
+
+int64_t align_up(int64_t value) {
+    return (value + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+/**
+ * @brief 列描述：名称、dtype、形状以及在文件中的偏移
+ */
+struct Column {
+    std::string name;
+    std::string dtype;
+    std::vector<int64_t> shape;
+    int64_t item_size;
+    int64_t offset = 0;
+
+    int64_t num_bytes() const {
+        int64_t n = item_size;
+        for (int64_t s : shape) n *= s;
+        return n;
+    }
+};
+
+/**
+ * @brief 一次导出所需的全部仿真对象
+ */
+struct Scene {
+    std::vector<std::string> uav_ids;
+    std::vector<std::string> missile_ids;
+    std::vector<CoreObjects::UAV> uavs;
+    std::vector<CoreObjects::Missile> missiles;
+    std::vector<CoreObjects::SmokeCloud> clouds;
+    std::vector<int> cloud_owner;   // 云团所属无人机的下标
+    Eigen::Matrix3Xd key_points;
+};
+
+Scene build_scene(const ExportJob& job) {
+    Scene scene;
+
+    for (const auto& [uav_id, _] : job.strategy) {
+        scene.uav_ids.push_back(uav_id);
+    }
+    std::sort(scene.uav_ids.begin(), scene.uav_ids.end());
+
+    if (job.missile_ids.empty()) {
+        const auto& registry = Registry::EntityRegistry::default_registry();
+        for (int m = 0; m < registry.num_missiles(); ++m) {
+            scene.missile_ids.push_back(registry.missile(m).id);
+        }
+        std::sort(scene.missile_ids.begin(), scene.missile_ids.end());
+    } else {
+        scene.missile_ids = job.missile_ids;
+    }
+
+    for (size_t u = 0; u < scene.uav_ids.size(); ++u) {
+        const auto& uav_strat = job.strategy.at(scene.uav_ids[u]);
+        CoreObjects::UAV uav(scene.uav_ids[u]);
+        uav.set_flight_strategy(uav_strat.speed, uav_strat.angle);
+
+        for (const auto& g : uav_strat.grenades) {
+            auto grenade = uav.deploy_grenade(g.t_deploy, g.t_fuse);
+            scene.clouds.push_back(*grenade->generate_smoke_cloud());
+            scene.cloud_owner.push_back(static_cast<int>(u));
+        }
+        scene.uavs.push_back(std::move(uav));
+    }
+
+    for (const auto& missile_id : scene.missile_ids) {
+        scene.missiles.emplace_back(missile_id);
+    }
+
+    scene.key_points = CoreObjects::TargetCylinder(ScenarioLoader::active().target).get_key_points();
+    return scene;
+}
+
+std::string format_shape(const std::vector<int64_t>& shape) {
+    std::ostringstream oss;
+    oss << "(";
+    for (size_t i = 0; i < shape.size(); ++i) {
+        oss << shape[i] << ",";
+        if (i + 1 < shape.size()) oss << " ";
+    }
+    oss << ")";
+    return oss.str();
+}
+
+template <typename T, typename F>
+std::string format_list(const std::vector<T>& values, F&& fmt) {
+    std::ostringstream oss;
+    oss << "[";
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (i > 0) oss << ", ";
+        fmt(oss, values[i]);
+    }
+    oss << "]";
+    return oss.str();
+}
+
+/**
+ * @brief 生成Python字典字面量形式的文件头 (可用 ast.literal_eval 解析)
+ */
+std::string build_header_dict(const ExportJob& job, const Scene& scene,
+                              int64_t num_frames, const std::vector<Column>& columns) {
+    std::ostringstream oss;
+    oss << std::setprecision(17);
+    oss << "{'format': 'smoke_trajectory', 'version': 1"
+        << ", 'num_frames': " << num_frames
+        << ", 'start_time': " << job.start_time
+        << ", 'dt': " << job.dt
+        << ", 'uav_ids': " << format_list(scene.uav_ids, [](std::ostream& os, const std::string& s) { os << "'" << s << "'"; })
+        << ", 'missile_ids': " << format_list(scene.missile_ids, [](std::ostream& os, const std::string& s) { os << "'" << s << "'"; })
+        << ", 'cloud_owner': " << format_list(scene.cloud_owner, [](std::ostream& os, int v) { os << v; });
+
+    std::vector<double> detonate_times;
+    for (const auto& cloud : scene.clouds) {
+        detonate_times.push_back(cloud.get_start_time());
+    }
+    oss << ", 'cloud_detonate_time': "
+        << format_list(detonate_times, [](std::ostream& os, double v) { os << std::setprecision(17) << v; });
+
+    oss << ", 'columns': {";
+    for (size_t i = 0; i < columns.size(); ++i) {
+        const auto& c = columns[i];
+        if (i > 0) oss << ", ";
+        oss << "'" << c.name << "': {'dtype': '" << c.dtype << "', 'shape': " << format_shape(c.shape)
+            << ", 'offset': " << c.offset << "}";
+    }
+    oss << "}}";
+    return oss.str();
+}
+
+/**
+ * @brief 布置列并生成完整文件头，返回头部字节串 (含魔数与填充)
+ */
+std::string layout_file(const ExportJob& job, const Scene& scene, int64_t num_frames,
+                        std::vector<Column>& columns) {
+    const int64_t F = num_frames;
+    const int64_t U = scene.uavs.size();
+    const int64_t M = scene.missiles.size();
+    const int64_t C = scene.clouds.size();
+
+    columns = {
+        {"time", "<f8", {F}, 8},
+        {"uav_pos", "<f8", {U, F, 3}, 8},
+        {"missile_pos", "<f8", {M, F, 3}, 8},
+        {"cloud_center", "<f8", {C, F, 3}, 8},
+        {"cloud_active", "|u1", {C, F}, 1},
+        {"obscured", "|u1", {M, F}, 1},
+    };
+
+    // 头部长度依赖偏移的位数，迭代直到布局稳定
+    int64_t data_start = ALIGNMENT;
+    while (true) {
+        int64_t offset = data_start;
+        for (auto& c : columns) {
+            c.offset = offset;
+            offset = align_up(offset + c.num_bytes());
+        }
+
+        std::string dict = build_header_dict(job, scene, num_frames, columns);
+        int64_t needed = sizeof(MAGIC) + 4 + static_cast<int64_t>(dict.size()) + 1;
+        if (align_up(needed) == data_start) {
+            uint32_t header_len = static_cast<uint32_t>(data_start - sizeof(MAGIC) - 4);
+            dict.append(header_len - dict.size() - 1, ' ');
+            dict.push_back('\n');
+
+            std::string header(MAGIC, sizeof(MAGIC));
+            for (int b = 0; b < 4; ++b) {
+                header.push_back(static_cast<char>((header_len >> (8 * b)) & 0xFF));
+            }
+            header += dict;
+            return header;
+        }
+        data_start = align_up(needed);
+    }
+}
+
+/**
+ * @brief 单块帧数据的缓冲区，列式存放便于直接写出
+ */
+struct ChunkBuffers {
+    std::vector<double> time;
+    std::vector<std::vector<double>> uav_pos;
+    std::vector<std::vector<double>> missile_pos;
+    std::vector<std::vector<double>> cloud_center;
+    std::vector<std::vector<uint8_t>> cloud_active;
+    std::vector<std::vector<uint8_t>> obscured;
+
+    void resize(const Scene& scene, int64_t n) {
+        time.resize(n);
+        uav_pos.assign(scene.uavs.size(), std::vector<double>(n * 3));
+        missile_pos.assign(scene.missiles.size(), std::vector<double>(n * 3));
+        cloud_center.assign(scene.clouds.size(), std::vector<double>(n * 3));
+        cloud_active.assign(scene.clouds.size(), std::vector<uint8_t>(n));
+        obscured.assign(scene.missiles.size(), std::vector<uint8_t>(n));
+    }
+};
+
+void compute_frame(const Scene& scene, double t, int64_t k, ChunkBuffers& buf,
+                   std::vector<Vector3d>& active_centers) {
+    buf.time[k] = t;
+
+    for (size_t u = 0; u < scene.uavs.size(); ++u) {
+        Vector3d p = scene.uavs[u].get_position(t);
+        std::copy(p.data(), p.data() + 3, buf.uav_pos[u].data() + 3 * k);
+    }
+
+    active_centers.clear();
+    for (size_t c = 0; c < scene.clouds.size(); ++c) {
+        auto center = scene.clouds[c].get_center(t);
+        double* dst = buf.cloud_center[c].data() + 3 * k;
+        if (center.has_value()) {
+            std::copy(center->data(), center->data() + 3, dst);
+            buf.cloud_active[c][k] = 1;
+            active_centers.push_back(center.value());
+        } else {
+            std::fill(dst, dst + 3, std::numeric_limits<double>::quiet_NaN());
+            buf.cloud_active[c][k] = 0;
+        }
+    }
+
+    for (size_t m = 0; m < scene.missiles.size(); ++m) {
+        Vector3d p = scene.missiles[m].get_position(t);
+        std::copy(p.data(), p.data() + 3, buf.missile_pos[m].data() + 3 * k);
+        buf.obscured[m][k] = Geometry::check_collective_obscuration(p, active_centers, scene.key_points) ? 1 : 0;
+    }
+}
+
+template <typename T>
+void write_slab(std::ofstream& out, int64_t offset, const std::vector<T>& data) {
+    out.seekp(offset);
+    out.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size() * sizeof(T)));
+}
+
+/**
+ * @brief 导出一个策略，frame_threads 为帧并行的线程数 (1 表示串行)
+ */
+ExportStats export_single(const ExportJob& job, const ExportSettings& settings, int frame_threads) {
+    if (job.dt <= 0.0 || job.end_time <= job.start_time) {
+        throw std::invalid_argument("导出时间范围或步长无效");
+    }
+
+    auto start_clock = std::chrono::steady_clock::now();
+    Scene scene = build_scene(job);
+
+    // 与 numpy.arange(start, end, dt) 的帧数一致
+    const int64_t num_frames = static_cast<int64_t>(std::ceil((job.end_time - job.start_time) / job.dt));
+
+    std::vector<Column> columns;
+    std::string header = layout_file(job, scene, num_frames, columns);
+
+    std::ofstream out(job.output_path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        throw std::runtime_error("无法创建轨迹文件: " + job.output_path);
+    }
+    out.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+    // 预先扩展文件到完整大小，之后按块定位写入
+    const Column& last = columns.back();
+    const int64_t total_bytes = align_up(last.offset + last.num_bytes());
+    out.seekp(total_bytes - 1);
+    out.put('\0');
+
+    const Column& col_time = columns[0];
+    const Column& col_uav = columns[1];
+    const Column& col_missile = columns[2];
+    const Column& col_cloud = columns[3];
+    const Column& col_active = columns[4];
+    const Column& col_obscured = columns[5];
+
+    ExportStats stats;
+    stats.output_path = job.output_path;
+    stats.num_frames = num_frames;
+    stats.num_uavs = scene.uavs.size();
+    stats.num_missiles = scene.missiles.size();
+    stats.num_clouds = scene.clouds.size();
+    stats.bytes_written = total_bytes;
+
+    std::vector<int64_t> obscured_frames(scene.missiles.size(), 0);
+    const int64_t chunk = std::max(1, settings.frames_per_chunk);
+    ChunkBuffers buf;
+
+    for (int64_t f0 = 0; f0 < num_frames; f0 += chunk) {
+        const int64_t n = std::min(chunk, num_frames - f0);
+        buf.resize(scene, n);
+
+        #pragma omp parallel num_threads(frame_threads) if(frame_threads > 1)
+        {
+            std::vector<Vector3d> active_centers;
+            active_centers.reserve(scene.clouds.size());
+
+            #pragma omp for schedule(static)
+            for (int64_t k = 0; k < n; ++k) {
+                compute_frame(scene, job.start_time + (f0 + k) * job.dt, k, buf, active_centers);
+            }
+        }
+
+        write_slab(out, col_time.offset + f0 * 8, buf.time);
+        for (size_t u = 0; u < scene.uavs.size(); ++u) {
+            write_slab(out, col_uav.offset + (u * num_frames + f0) * 24, buf.uav_pos[u]);
+        }
+        for (size_t m = 0; m < scene.missiles.size(); ++m) {
+            write_slab(out, col_missile.offset + (m * num_frames + f0) * 24, buf.missile_pos[m]);
+            write_slab(out, col_obscured.offset + m * num_frames + f0, buf.obscured[m]);
+            obscured_frames[m] += std::count(buf.obscured[m].begin(), buf.obscured[m].end(), 1);
+        }
+        for (size_t c = 0; c < scene.clouds.size(); ++c) {
+            write_slab(out, col_cloud.offset + (c * num_frames + f0) * 24, buf.cloud_center[c]);
+            write_slab(out, col_active.offset + c * num_frames + f0, buf.cloud_active[c]);
+        }
+    }
+
+    out.close();
+    if (!out) {
+        throw std::runtime_error("写入轨迹文件失败: " + job.output_path);
+    }
+
+    for (int64_t frames : obscured_frames) {
+        stats.obscured_time.push_back(frames * job.dt);
+    }
+
+    auto end_clock = std::chrono::steady_clock::now();
+    stats.elapsed_seconds = std::chrono::duration<double>(end_clock - start_clock).count();
+    return stats;
+}
+
+} // namespace
+
+ExportStats export_trajectory(const ExportJob& job, const ExportSettings& settings) {
+    const int num_threads = settings.num_threads > 0 ? settings.num_threads : omp_get_max_threads();
+    ExportStats stats = export_single(job, settings, num_threads);
+    if (settings.verbose) {
+        print_export_stats(stats);
+    }
+    return stats;
+}
+
+std::vector<ExportStats> export_trajectories(const std::vector<ExportJob>& jobs,
+                                             const ExportSettings& settings) {
+    const int num_jobs = jobs.size();
+    std::vector<ExportStats> results(num_jobs);
+    if (num_jobs == 0) {
+        return results;
+    }
+
+    int num_threads = settings.num_threads > 0 ? settings.num_threads : omp_get_max_threads();
+
+    // 策略数足以占满线程时按策略并行，否则逐个策略按帧并行
+    if (num_jobs >= num_threads) {
+        std::vector<std::string> errors(num_jobs);
+
+        #pragma omp parallel for schedule(dynamic, 1) num_threads(num_threads)
+        for (int i = 0; i < num_jobs; ++i) {
+            try {
+                results[i] = export_single(jobs[i], settings, 1);
+            } catch (const std::exception& e) {
+                errors[i] = e.what();
+            }
+        }
+
+        for (int i = 0; i < num_jobs; ++i) {
+            if (!errors[i].empty()) {
+                throw std::runtime_error("导出 " + jobs[i].output_path + " 失败: " + errors[i]);
+            }
+        }
+    } else {
+        for (int i = 0; i < num_jobs; ++i) {
+            results[i] = export_single(jobs[i], settings, num_threads);
+        }
+    }
+
+    if (settings.verbose) {
+        for (const auto& stats : results) {
+            print_export_stats(stats);
+        }
+    }
+    return results;
+}
+
+void print_export_stats(const ExportStats& stats) {
+    std::cout << "轨迹导出完成: " << stats.output_path << std::endl;
+    std::cout << "  帧数: " << stats.num_frames
+              << ", 无人机: " << stats.num_uavs
+              << ", 导弹: " << stats.num_missiles
+              << ", 云团: " << stats.num_clouds << std::endl;
+    std::cout << "  文件大小: " << std::fixed << std::setprecision(2)
+              << stats.bytes_written / (1024.0 * 1024.0) << " MB"
+              << ", 耗时: " << std::setprecision(3) << stats.elapsed_seconds << " s" << std::endl;
+    for (size_t m = 0; m < stats.obscured_time.size(); ++m) {
+        std::cout << "  导弹 #" << m << " 遮蔽时长: " << std::setprecision(2)
+                  << stats.obscured_time[m] << " s" << std::endl;
+    }
+}
+
+} // namespace TrajectoryExporter
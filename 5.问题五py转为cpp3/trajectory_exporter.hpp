@@ -0,0 +1,82 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <Eigen/Dense>
+#include "config.hpp"
+#include "optimizer.hpp"
+
+using Vector3d = Eigen::Vector3d;
+
+namespace TrajectoryExporter {
+
+/**
+ * @brief 单个导出任务：一个策略对应一个轨迹文件
+ */
+struct ExportJob {
+    std::string output_path;
+    Optimizer::StrategyMap strategy;
+    std::vector<std::string> missile_ids;   // 为空时导出全部导弹
+    double start_time = 0.0;
+    double end_time = 65.0;
+    double dt = 1.0 / 30.0;                 // 默认对应30帧/秒的视频
+};
+
+/**
+ * @brief 导出设置
+ */
+struct ExportSettings {
+    int frames_per_chunk = 4096;   // 每次流式写出的帧数
+    int num_threads = -1;          // -1表示使用所有可用线程
+    bool verbose = true;
+};
+
+/**
+ * @brief 导出统计信息
+ */
+struct ExportStats {
+    std::string output_path;
+    int64_t num_frames = 0;
+    int num_uavs = 0;
+    int num_missiles = 0;
+    int num_clouds = 0;
+    int64_t bytes_written = 0;
+    double elapsed_seconds = 0.0;
+    std::vector<double> obscured_time;   // 每枚导弹被遮蔽的总时长
+};
+
+/**
+ * @brief 将一个策略的逐帧仿真数据流式写入列式二进制文件
+ *
+ * 文件格式与 .npy 相同的思路：8字节魔数 "\x93SMKTRJ\x01"、4字节小端头长度、
+ * 一个Python字典字面量头（列名、dtype、形状、偏移），整体按64字节对齐。
+ * 之后每一列连续存放，可直接用 numpy.memmap 映射：
+ *   time          <f8  [F]
+ *   uav_pos       <f8  [U, F, 3]
+ *   missile_pos   <f8  [M, F, 3]
+ *   cloud_center  <f8  [C, F, 3]  (未生效时为NaN)
+ *   cloud_active  |u1  [C, F]
+ *   obscured      |u1  [M, F]     (每枚导弹的协同遮蔽标志)
+ *
+ * obscured 按协同遮蔽判定 (全部生效云团共同挡住目标关键点)，与求解器目标函数和 video.py 的
+ * generate_trajectory_data 一致。线程数只作用于本次导出 (num_threads 子句)，不改变进程的 OpenMP 设置。
+ *
+ * @param job 导出任务
+ * @param settings 导出设置
+ * @return ExportStats 导出统计信息
+ */
+ExportStats export_trajectory(const ExportJob& job, const ExportSettings& settings = ExportSettings());
+
+/**
+ * @brief 批量导出多个策略，任务数足够时按策略并行，否则在每个策略内按帧并行
+ */
+std::vector<ExportStats> export_trajectories(const std::vector<ExportJob>& jobs,
+                                             const ExportSettings& settings = ExportSettings());
+
+/**
+ * @brief 打印导出统计信息
+ */
+void print_export_stats(const ExportStats& stats);
+
+} // namespace TrajectoryExporter
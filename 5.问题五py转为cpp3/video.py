@@ -4,7 +4,7 @@ import numpy as np
 # 假设这些文件存在且正确
 from config import *
 from core_objects import UAV, Missile, TargetCylinder
-from geometry import check_full_obscuration
+from geometry import check_collective_obscuration
 
 # --- 配置区 ---
 # 1. 解决服务器无图形界面的问题
@@ -37,11 +37,15 @@ SIMULATION_END_TIME = 65.0  # 模拟到导弹快要击中目标
 SIMULATION_DT = 0.1       # 模拟的时间步长 (秒)
 VIDEO_FRAMERATE = 30      # 输出视频的帧率
 VIDEO_OUTPUT_FILENAME = "problem3_simulation_enhanced.mp4"
+# C++ export_trajectory 生成的轨迹文件，存在时直接内存映射读取，跳过Python仿真
+TRAJECTORY_EXPORT_FILE = "problem3_trajectory.traj"
 
 
 def generate_trajectory_data(strategy_dict, end_time, dt):
     """
     根据策略，计算出每一帧的仿真数据，并包含历史轨迹。
+    遮蔽状态按协同遮蔽判定 (全部生效云团共同挡住目标关键点)，与求解器目标函数及 C++ 导出的 obscured 列一致；
+    旧版按单个云团完全遮蔽取 any，多个云团各挡一部分时判为未遮蔽。
     """
     print("正在生成轨迹数据...")
     
@@ -49,6 +53,7 @@ def generate_trajectory_data(strategy_dict, end_time, dt):
     uav = UAV('FY1')
     missile = Missile('M1')
     target = TargetCylinder(TRUE_TARGET_SPECS)
+    target_key_points = target.get_key_points()
     uav.set_flight_strategy(strategy_dict['FY1']['speed'], strategy_dict['FY1']['angle'])
 
     # 创建所有烟幕云对象
@@ -86,7 +91,7 @@ def generate_trajectory_data(strategy_dict, end_time, dt):
         frame_data['clouds'] = active_clouds
         
         # 计算遮蔽状态
-        is_obscured = any(check_full_obscuration(missile_pos, c['center'], target) for c in active_clouds)
+        is_obscured = check_collective_obscuration(missile_pos, [c['center'] for c in active_clouds], target_key_points)
         frame_data['is_obscured'] = is_obscured
         
         trajectories.append(frame_data)
@@ -95,6 +100,62 @@ def generate_trajectory_data(strategy_dict, end_time, dt):
     return trajectories
 
 
+def load_trajectory_data(path):
+    """
+    内存映射读取 C++ export_trajectory 导出的列式轨迹文件。
+    返回 (header, columns)，columns 中每一列都是 numpy.memmap。
+    """
+    import ast
+    import struct
+
+    with open(path, 'rb') as f:
+        magic = f.read(8)
+        if magic != b'\x93SMKTRJ\x01':
+            raise ValueError(f"不是有效的轨迹文件: {path}")
+        header_len = struct.unpack('<I', f.read(4))[0]
+        header = ast.literal_eval(f.read(header_len).decode('ascii'))
+
+    columns = {
+        name: np.memmap(path, dtype=col['dtype'], mode='r', offset=col['offset'], shape=col['shape'])
+        for name, col in header['columns'].items()
+    }
+    return header, columns
+
+
+class ExportedTrajectory:
+    """
+    将导出的列式数据包装成与 generate_trajectory_data 相同的逐帧接口，按需切片，不复制数据。
+    'is_obscured' 取自 obscured 列 (协同遮蔽判据，与 generate_trajectory_data 相同)。
+    """
+
+    def __init__(self, path, uav_index=0, missile_index=0):
+        self.header, self.columns = load_trajectory_data(path)
+        self.uav_index = uav_index
+        self.missile_index = missile_index
+
+    def __len__(self):
+        return self.header['num_frames']
+
+    def __iter__(self):
+        for i in range(len(self)):
+            yield self[i]
+
+    def __getitem__(self, i):
+        c = self.columns
+        uav_pos = c['uav_pos'][self.uav_index]
+        missile_pos = c['missile_pos'][self.missile_index]
+        active = c['cloud_active'][:, i]
+        return {
+            'time': float(c['time'][i]),
+            'uav_pos': uav_pos[i],
+            'uav_path': uav_pos[:i + 1],
+            'missile_pos': missile_pos[i],
+            'missile_path': missile_pos[:i + 1],
+            'clouds': [{'center': c['cloud_center'][k, i]} for k in np.flatnonzero(active)],
+            'is_obscured': bool(c['obscured'][self.missile_index, i]),
+        }
+
+
 def create_simulation_video(trajectory_data, output_filename):
     """
     使用PyVista将轨迹数据渲染成具有增强视觉效果的视频。
@@ -189,8 +250,12 @@ if __name__ == '__main__':
     # 初始化全局对象 (仅为 TargetCylinder 需要)
     target = TargetCylinder(TRUE_TARGET_SPECS)
     
-    # 1. 生成轨迹数据
-    trajectories = generate_trajectory_data(OPTIMAL_STRATEGY_P3, SIMULATION_END_TIME, 1/VIDEO_FRAMERATE)
+    # 1. 生成轨迹数据 (优先使用C++导出的轨迹文件)
+    if os.path.exists(TRAJECTORY_EXPORT_FILE):
+        print(f"使用C++导出的轨迹文件: {TRAJECTORY_EXPORT_FILE}")
+        trajectories = ExportedTrajectory(TRAJECTORY_EXPORT_FILE)
+    else:
+        trajectories = generate_trajectory_data(OPTIMAL_STRATEGY_P3, SIMULATION_END_TIME, 1/VIDEO_FRAMERATE)
     
     # 2. 创建视频
     create_simulation_video(trajectories, VIDEO_OUTPUT_FILENAME)
\ No newline at end of file
@@ -0,0 +1,423 @@
+#include "work_pool.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <omp.h>
+
+#ifdef __linux__
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace WorkPool {
+
+namespace detail {
+
+/**
+ * @brief 一次 parallel_for 调用，由调用者与各通道任务共享 (调用返回后可能仍被队列中待丢弃的任务引用)
+ */
+struct Batch {
+    const std::function<void(int)>* body = nullptr;
+    int count = 0;
+    int grain = 1;
+    std::atomic<int> next{0};       // 下一个未分派的下标
+    std::atomic<int> active{0};     // 正在执行的通道数 (不含调用者)
+    std::unique_ptr<std::atomic<bool>[]> claimed;   // 通道是否已被领取 (被执行或被调用者收回)
+    std::mutex mutex;
+    std::condition_variable done_cv;
+    std::exception_ptr error;
+    std::function<void(int)> owned;     // post 提交的任务由批次自己持有
+
+    // 领取下标块执行，直到分派完毕；出错时停止分派
+    void drain() {
+        for (;;) {
+            const int begin = next.fetch_add(grain, std::memory_order_relaxed);
+            if (begin >= count) {
+                return;
+            }
+            const int end = std::min(count, begin + grain);
+            try {
+                for (int i = begin; i < end; ++i) {
+                    (*body)(i);
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+                next.store(count, std::memory_order_relaxed);
+                return;
+            }
+        }
+    }
+};
+
+// 执行一个通道任务；通道已被领取时直接丢弃
+void run(const Task& task) {
+    Batch& batch = *task.batch;
+    // 先计入 active 再领取：调用者收回失败时一定能看到 active > 0
+    batch.active.fetch_add(1);
+    if (!batch.claimed[task.lane].exchange(true)) {
+        batch.drain();
+    }
+    if (batch.active.fetch_sub(1) == 1) {
+        std::lock_guard<std::mutex> lock(batch.mutex);
+        batch.done_cv.notify_all();
+    }
+}
+
+} // namespace detail
+
+using detail::Batch;
+using detail::Task;
+using detail::Worker;
+
+namespace {
+
+thread_local Pool* current_pool = nullptr;
+thread_local int current_index = -1;
+thread_local Pool* calling_pool = nullptr;  // 本线程上正在执行的最内层 parallel_for 所属的池
+
+constexpr int SPIN_ROUNDS = 2000;
+
+#ifdef __linux__
+// 解析 "0-3,8,10-11" 形式的 CPU 列表
+std::vector<int> parse_cpulist(const std::string& text) {
+    std::vector<int> cpus;
+    std::stringstream ss(text);
+    std::string part;
+    while (std::getline(ss, part, ',')) {
+        if (part.empty() || part == "\n") {
+            continue;
+        }
+        const size_t dash = part.find('-');
+        try {
+            const int first = std::stoi(part.substr(0, dash));
+            const int last = dash == std::string::npos ? first : std::stoi(part.substr(dash + 1));
+            for (int cpu = first; cpu <= last; ++cpu) {
+                cpus.push_back(cpu);
+            }
+        } catch (const std::exception&) {
+            return {};
+        }
+    }
+    return cpus;
+}
+
+// 本进程可用的 CPU 按 NUMA 节点分组；读不到拓扑时视为单节点
+std::vector<std::vector<int>> numa_topology() {
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        return {};
+    }
+
+    std::vector<std::pair<int, std::vector<int>>> nodes;
+    if (DIR* dir = opendir("/sys/devices/system/node")) {
+        while (dirent* entry = readdir(dir)) {
+            const std::string name = entry->d_name;
+            if (name.compare(0, 4, "node") != 0 || name.size() == 4 ||
+                name.find_first_not_of("0123456789", 4) != std::string::npos) {
+                continue;
+            }
+            std::ifstream file("/sys/devices/system/node/" + name + "/cpulist");
+            std::string text;
+            std::getline(file, text);
+            std::vector<int> cpus;
+            for (int cpu : parse_cpulist(text)) {
+                if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed)) {
+                    cpus.push_back(cpu);
+                }
+            }
+            if (!cpus.empty()) {
+                nodes.emplace_back(std::stoi(name.substr(4)), std::move(cpus));
+            }
+        }
+        closedir(dir);
+    }
+    std::sort(nodes.begin(), nodes.end());
+
+    std::vector<std::vector<int>> result;
+    for (auto& node : nodes) {
+        result.push_back(std::move(node.second));
+    }
+    if (result.empty()) {
+        std::vector<int> cpus;
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &allowed)) {
+                cpus.push_back(cpu);
+            }
+        }
+        result.push_back(std::move(cpus));
+    }
+    return result;
+}
+#endif
+
+} // namespace
+
+Pool::Pool(const PoolOptions& options) {
+    int total = options.num_threads > 0 ? options.num_threads
+                                        : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    for (int i = 0; i + 1 < total; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+    place_workers(options.pin_threads);
+
+    threads_.reserve(workers_.size());
+    for (size_t i = 0; i < workers_.size(); ++i) {
+        threads_.emplace_back(&Pool::worker_loop, this, static_cast<int>(i));
+    }
+}
+
+Pool::~Pool() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        stop_.store(true);
+    }
+    sleep_cv_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+// 按 NUMA 节点轮流分配 CPU (调用线程视为占用第一个 CPU)，并确定各工作线程的窃取顺序
+void Pool::place_workers(bool pin) {
+    const int n = static_cast<int>(workers_.size());
+    std::vector<int> cpu_order;
+    std::vector<int> cpu_node;
+#ifdef __linux__
+    const auto nodes = numa_topology();
+    num_nodes_ = std::max(1, static_cast<int>(nodes.size()));
+    for (size_t round = 0;; ++round) {
+        bool any = false;
+        for (size_t node = 0; node < nodes.size(); ++node) {
+            if (round < nodes[node].size()) {
+                cpu_order.push_back(nodes[node][round]);
+                cpu_node.push_back(static_cast<int>(node));
+                any = true;
+            }
+        }
+        if (!any) {
+            break;
+        }
+    }
+#endif
+
+    // CPU 不够分时不绑定，交给内核调度
+    const bool can_pin = pin && static_cast<int>(cpu_order.size()) >= n + 1;
+    for (int i = 0; i < n; ++i) {
+        if (i + 1 < static_cast<int>(cpu_order.size())) {
+            workers_[i]->node = cpu_node[i + 1];
+            workers_[i]->cpu = can_pin ? cpu_order[i + 1] : -1;
+        }
+    }
+
+    for (int i = 0; i < n; ++i) {
+        auto& victims = workers_[i]->victims;
+        for (int pass = 0; pass < 2; ++pass) {
+            for (int k = 1; k < n; ++k) {
+                const int j = (i + k) % n;
+                if ((workers_[j]->node == workers_[i]->node) == (pass == 0)) {
+                    victims.push_back(j);
+                }
+            }
+        }
+    }
+}
+
+int Pool::slot() const {
+    return current_pool == this ? current_index : static_cast<int>(workers_.size());
+}
+
+void Pool::push(int worker, Task task) {
+    {
+        std::lock_guard<std::mutex> lock(workers_[worker]->mutex);
+        workers_[worker]->tasks.push_back(std::move(task));
+    }
+    pending_.fetch_add(1);
+}
+
+void Pool::wake_sleepers() {
+    if (sleeping_.load() > 0) {
+        { std::lock_guard<std::mutex> lock(sleep_mutex_); }
+        sleep_cv_.notify_all();
+    }
+}
+
+bool Pool::pop_local(int index, Task& task) {
+    Worker& worker = *workers_[index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (worker.tasks.empty()) {
+        return false;
+    }
+    task = std::move(worker.tasks.back());
+    worker.tasks.pop_back();
+    pending_.fetch_sub(1);
+    return true;
+}
+
+bool Pool::steal(int index, Task& task) {
+    for (int victim : workers_[index]->victims) {
+        Worker& worker = *workers_[victim];
+        std::unique_lock<std::mutex> lock(worker.mutex, std::try_to_lock);
+        if (!lock.owns_lock() || worker.tasks.empty()) {
+            continue;
+        }
+        task = std::move(worker.tasks.front());
+        worker.tasks.pop_front();
+        pending_.fetch_sub(1);
+        return true;
+    }
+    return false;
+}
+
+void Pool::worker_loop(int index) {
+    current_pool = this;
+    current_index = index;
+#ifdef __linux__
+    if (workers_[index]->cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(workers_[index]->cpu, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+#endif
+
+    Task task;
+    while (!stop_.load(std::memory_order_relaxed)) {
+        if (pop_local(index, task) || steal(index, task)) {
+            detail::run(task);
+            task.batch.reset();
+            continue;
+        }
+
+        // 短暂自旋等待下一阶段的任务，超时后休眠
+        bool found = false;
+        for (int spin = 0; spin < SPIN_ROUNDS && !found; ++spin) {
+            found = pending_.load(std::memory_order_relaxed) > 0 || stop_.load(std::memory_order_relaxed);
+            if (!found) {
+                std::this_thread::yield();
+            }
+        }
+        if (found) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        sleeping_.fetch_add(1);
+        sleep_cv_.wait(lock, [&] { return pending_.load() > 0 || stop_.load(); });
+        sleeping_.fetch_sub(1);
+    }
+}
+
+void Pool::parallel_for(int count, const std::function<void(int)>& body, int max_threads, int grain) {
+    if (count <= 0) {
+        return;
+    }
+    // 调用线程执行的 body 内的嵌套并行也落在本池上 (见 current())
+    struct Calling {
+        Pool* saved = calling_pool;
+        ~Calling() { calling_pool = saved; }
+    } calling;
+    calling_pool = this;
+
+    int threads = num_threads();
+    if (max_threads > 0) {
+        threads = std::min(threads, max_threads);
+    }
+    const int lanes = std::min(threads, count);
+
+    if (lanes <= 1) {
+        for (int i = 0; i < count; ++i) {
+            body(i);
+        }
+        return;
+    }
+
+    auto batch = std::make_shared<Batch>();
+    batch->body = &body;
+    batch->count = count;
+    batch->grain = grain > 0 ? grain : std::max(1, count / (4 * lanes));
+    batch->claimed.reset(new std::atomic<bool>[lanes]);
+    for (int lane = 0; lane < lanes; ++lane) {
+        batch->claimed[lane].store(false, std::memory_order_relaxed);
+    }
+
+    // 通道 1 ... lanes - 1 分给各工作线程 (从工作线程发起时跳过自己)，调用者执行其余部分
+    const int self = current_pool == this ? current_index : -1;
+    const int n = static_cast<int>(workers_.size());
+    unsigned start = next_worker_.fetch_add(static_cast<unsigned>(lanes - 1), std::memory_order_relaxed);
+    for (int lane = 1; lane < lanes; ++lane) {
+        int worker = static_cast<int>((start + lane) % static_cast<unsigned>(n));
+        if (worker == self) {
+            worker = (worker + 1) % n;
+        }
+        push(worker, Task{batch, lane});
+    }
+    wake_sleepers();
+
+    batch->drain();
+
+    // 收回尚未开始的通道，只等待已开始的通道
+    for (int lane = 1; lane < lanes; ++lane) {
+        batch->claimed[lane].exchange(true);
+    }
+    for (int spin = 0; spin < SPIN_ROUNDS && batch->active.load() > 0; ++spin) {
+        std::this_thread::yield();
+    }
+    {
+        std::unique_lock<std::mutex> lock(batch->mutex);
+        batch->done_cv.wait(lock, [&] { return batch->active.load() == 0; });
+    }
+
+    if (batch->error) {
+        std::rethrow_exception(batch->error);
+    }
+}
+
+void Pool::post(std::function<void()> task) {
+    const int n = static_cast<int>(workers_.size());
+    if (n == 0) {
+        throw std::logic_error("线程池没有工作线程");
+    }
+    auto batch = std::make_shared<Batch>();
+    batch->owned = [task = std::move(task)](int) { task(); };
+    batch->body = &batch->owned;
+    batch->count = 1;
+    batch->claimed.reset(new std::atomic<bool>[1]);
+    batch->claimed[0].store(false, std::memory_order_relaxed);
+
+    const int self = current_pool == this ? current_index : -1;
+    int worker = static_cast<int>(next_worker_.fetch_add(1, std::memory_order_relaxed) % static_cast<unsigned>(n));
+    if (worker == self) {
+        worker = (worker + 1) % n;
+    }
+    push(worker, Task{batch, 0});
+    wake_sleepers();
+}
+
+Pool& Pool::current() {
+    if (calling_pool != nullptr) {
+        return *calling_pool;
+    }
+    return current_pool != nullptr ? *current_pool : global();
+}
+
+Pool& Pool::global() {
+    static Pool pool([] {
+        PoolOptions options;
+        options.num_threads = omp_get_max_threads();
+        const char* pin = std::getenv("SMOKE_POOL_PIN");
+        options.pin_threads = pin != nullptr && std::string(pin) == "1";
+        return options;
+    }());
+    return pool;
+}
+
+} // namespace WorkPool
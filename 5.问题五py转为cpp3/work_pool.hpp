@@ -0,0 +1,171 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace WorkPool {
+
+/**
+ * @brief 线程池参数
+ */
+struct PoolOptions {
+    int num_threads = -1;       // 参与计算的线程总数 (含调用 parallel_for 的线程)，-1表示使用所有可用线程
+    bool pin_threads = false;   // 工作线程绑定到 CPU，按 NUMA 节点轮流分配 (仅 Linux)；各进程都从同一批 CPU 开始，只宜独占机器时打开
+};
+
+namespace detail {
+struct Batch;
+
+struct Task {
+    std::shared_ptr<Batch> batch;
+    int lane;
+};
+
+struct alignas(64) Worker {
+    std::mutex mutex;
+    std::deque<Task> tasks;     // 本线程从尾部取，其他线程从头部窃取
+    std::vector<int> victims;   // 窃取顺序：同一 NUMA 节点的线程在前
+    int cpu = -1;
+    int node = 0;
+};
+} // namespace detail
+
+/**
+ * @brief 常驻的工作窃取线程池
+ *
+ * 工作线程在进程内常驻，各优化器的每个阶段以 parallel_for 提交，不再每个阶段开一个 OpenMP 并行区，
+ * 多个优化器同时运行时也不会各自创建线程组而超额订阅或互相改写 OpenMP 线程数。
+ *
+ * 一次 parallel_for 拆成若干"通道"任务，调用线程执行第一个通道，其余放入各工作线程的双端队列；
+ * 通道从共享游标领取下标块 (动态调度)，空闲线程从其他线程的队列窃取尚未开始的通道，
+ * 先窃取同一 NUMA 节点上的线程。通道数即该次调用的并发上限。
+ * 调用线程执行完自己的通道后收回未开始的通道，只等待已开始的通道结束，不会被忙于其他作业的线程拖住。
+ */
+class Pool {
+public:
+    explicit Pool(const PoolOptions& options = PoolOptions());
+    ~Pool();
+    Pool(const Pool&) = delete;
+    Pool& operator=(const Pool&) = delete;
+
+    /**
+     * @brief 执行 body(0) ... body(count - 1)，阻塞直到全部完成
+     *
+     * 可以从工作线程内嵌套调用。body 抛出的第一个异常在已开始的任务结束后重新抛出，未分派的下标不再执行。
+     *
+     * @param max_threads 本次调用的并发上限 (含调用线程)，-1表示不限
+     * @param grain 每次领取的下标数，0 表示按并发数自动选择
+     */
+    void parallel_for(int count, const std::function<void(int)>& body, int max_threads = -1, int grain = 0);
+
+    /**
+     * @brief 把一个任务交给工作线程执行，不等待其完成
+     *
+     * 任务抛出的异常被丢弃。池销毁时尚未开始的任务不再执行，提交者须自行等待任务结束。
+     * 池中没有工作线程时抛出 std::logic_error。
+     */
+    void post(std::function<void()> task);
+
+    /**
+     * @brief 参与计算的线程总数 (工作线程数 + 1)
+     */
+    int num_threads() const { return static_cast<int>(workers_.size()) + 1; }
+
+    int num_numa_nodes() const { return num_nodes_; }
+
+    /**
+     * @brief 当前线程的槽位：本池的工作线程为 0 ... num_threads() - 2，其他线程为 num_threads() - 1
+     */
+    int slot() const;
+
+    /**
+     * @brief 工作线程绑定的 CPU (未绑定时为 -1)
+     */
+    int worker_cpu(int worker) const { return workers_[worker]->cpu; }
+
+    /**
+     * @brief 进程级默认线程池 (首次调用时创建)
+     *
+     * 线程总数取 omp_get_max_threads() (受 OMP_NUM_THREADS 影响)。默认不绑定 CPU；独占机器运行时可用
+     * 环境变量 SMOKE_POOL_PIN=1 打开，同时运行多个进程时不要打开，否则各进程的工作线程会绑到同一批 CPU 上。
+     */
+    static Pool& global();
+
+    /**
+     * @brief 当前线程所在的线程池：在某个池的 parallel_for 内 (含调用线程自己执行的部分) 返回最内层的池，
+     *        在某个池的工作线程上返回该池，否则返回 global()
+     *
+     * 评估内部的嵌套并行用它，在私有线程池 (如调度器或优化器设置所指定的池) 上运行时不会把任务转到进程级线程池。
+     */
+    static Pool& current();
+
+private:
+    std::vector<std::unique_ptr<detail::Worker>> workers_;
+    std::vector<std::thread> threads_;
+    int num_nodes_ = 1;
+    std::atomic<unsigned> next_worker_{0};
+
+    std::atomic<int> pending_{0};       // 各队列中的任务总数 (含已被收回、待丢弃的任务)
+    std::atomic<int> sleeping_{0};
+    std::mutex sleep_mutex_;
+    std::condition_variable sleep_cv_;
+    std::atomic<bool> stop_{false};
+
+    void worker_loop(int index);
+    bool pop_local(int index, detail::Task& task);
+    bool steal(int index, detail::Task& task);
+    void place_workers(bool pin);
+    void push(int worker, detail::Task task);
+    void wake_sleepers();
+};
+
+/**
+ * @brief 每个线程一份的数据 (工作线程的局部缓冲区、计数器、待合并的结果等)
+ *
+ * 槽位按缓存行对齐，避免伪共享。非本池工作线程的调用线程共用最后一个槽，
+ * 因此同一对象只应由一个外部线程驱动 (通常是运行优化器的线程)。
+ */
+template <class T>
+class WorkerLocal {
+public:
+    explicit WorkerLocal(const Pool& pool, const T& initial = T())
+        : pool_(pool), slots_(pool.num_threads(), Slot{initial}) {}
+
+    /**
+     * @brief 当前线程的槽
+     */
+    T& local() { return slots_[pool_.slot()].value; }
+
+    /**
+     * @brief 依次访问全部槽 (须在并行阶段之外调用)
+     */
+    template <class F>
+    void for_each(F&& f) {
+        for (auto& slot : slots_) {
+            f(slot.value);
+        }
+    }
+
+    template <class F>
+    void for_each(F&& f) const {
+        for (const auto& slot : slots_) {
+            f(slot.value);
+        }
+    }
+
+private:
+    struct alignas(64) Slot {
+        T value;
+    };
+
+    const Pool& pool_;
+    std::vector<Slot> slots_;
+};
+
+} // namespace WorkPool